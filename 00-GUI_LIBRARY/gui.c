@@ -25,13 +25,18 @@
  */
 #define GUI_INTERNAL
 #include "gui.h"
+#include "widgets/gui_sprite.h"
+#include "gui_pipeline.h"
+#include "gui_remote.h"
+#include "gui_hud.h"
 
 /******************************************************************************/
 /******************************************************************************/
 /***                           Private structures                            **/
 /******************************************************************************/
 /******************************************************************************/
-GUI_t GUI;
+static GUI_t GUI_Default;                           /* Default GUI context */
+GUI_t* __GUI_Context = &GUI_Default;                /* Currently selected GUI context */
 
 /******************************************************************************/
 /******************************************************************************/
@@ -126,6 +131,10 @@ uint32_t __RedrawWidgets(GUI_HANDLE_p parent) {
         if (__GUI_WIDGET_IsInsideClippingRegion(parent)) {  /* If draw function is set and drawing is inside clipping region */
             __CheckDispClipping(parent);            /* Check coordinates for drawings */
             __GUI_WIDGET_Callback(parent, GUI_WC_Draw, &GUI.DisplayTemp, NULL);
+#if GUI_USE_HUD
+        } else if (GUI.Hud) {
+            __GUI_HUD_Skipped(parent);              /* Notify overlay about skipped widget */
+#endif /* GUI_USE_HUD */
         }
     }
 
@@ -142,6 +151,10 @@ uint32_t __RedrawWidgets(GUI_HANDLE_p parent) {
                 if (__GUI_WIDGET_IsInsideClippingRegion(h)) {   /* If draw function is set and drawing is inside clipping region */
                     __CheckDispClipping(h);         /* Check coordinates for drawings */
                     __GUI_WIDGET_Callback(h, GUI_WC_Draw, &GUI.DisplayTemp, NULL);  /* Draw widget */
+#if GUI_USE_HUD
+                } else if (GUI.Hud) {
+                    __GUI_HUD_Skipped(h);           /* Notify overlay about skipped widget */
+#endif /* GUI_USE_HUD */
                 }
                 cnt++;
             }
@@ -151,53 +164,60 @@ uint32_t __RedrawWidgets(GUI_HANDLE_p parent) {
     return cnt;                                     /* Return number of redrawn objects */
 }
 
+/* Check if new frame can not be drawn yet */
+static
+uint8_t __IsDrawingLayerBusy(void) {
+#if GUI_USE_PIPELINE
+    if (GUI.Pipeline) {                             /* Rasterization task waits for layer confirmation */
+        return __GUI_PIPELINE_IsBusy();
+    }
+#endif /* GUI_USE_PIPELINE */
+    return (GUI.LCD.Flags & GUI_FLAG_LCD_WAIT_LAYER_CONFIRM) ? 1 : 0;
+}
+
 #if GUI_USE_TOUCH
 PT_THREAD(__TouchEvents_Thread(__GUI_TouchData_t* ts, __GUI_TouchData_t* old, uint8_t v, GUI_WC_t* result)) {
-    static volatile uint32_t Time;
-    static uint8_t i = 0;
-    static GUI_iDim_t x[2], y[2];
-    
     *result = (GUI_WC_t)0;
     
     PT_BEGIN(&ts->pt);
     
-    for (i = 0; i < 2;) {
+    for (ts->ClickCount = 0; ts->ClickCount < 2;) {
         /**
          * Wait for valid input with pressed state
          */
         PT_WAIT_UNTIL(&ts->pt, v && ts->TS.Status && !old->TS.Status && ts->TS.Count == 1);
         
-        Time = ts->TS.Time;                             /* Get start time of this touch */
-        x[i] = ts->RelX[0];                             /* Save X value */
-        y[i] = ts->RelY[0];                             /* Save Y value */
+        ts->ClickTime = ts->TS.Time;                    /* Get start time of this touch */
+        ts->ClickX[ts->ClickCount] = ts->RelX[0];       /* Save X value */
+        ts->ClickY[ts->ClickCount] = ts->RelY[0];       /* Save Y value */
         PT_YIELD(&ts->pt);                              /* Stop thread for now and wait next call */
             
         /**
          * Either wait for released status or timeout
          */
-        PT_WAIT_UNTIL(&ts->pt, v || (GUI.Time - Time) > 2000); /* Wait touch with released state */
+        PT_WAIT_UNTIL(&ts->pt, v || (GUI.Time - ts->ClickTime) > 2000);  /* Wait touch with released state */
         
         /**
          * Check what was the reason for thread to continue
          */
         if (v) {                                        /* New touch event occurred */
             if (!ts->TS.Status) {                       /* We received released state */
-                if (i) {                                /* Try to get second click, check difference for double click */
-                    if (__GUI_ABS(x[0] - x[1]) > 10 || __GUI_ABS(y[0] - y[1]) > 10) {
-                        i = 0;
+                if (ts->ClickCount) {                   /* Try to get second click, check difference for double click */
+                    if (__GUI_ABS(ts->ClickX[0] - ts->ClickX[1]) > 10 || __GUI_ABS(ts->ClickY[0] - ts->ClickY[1]) > 10) {
+                        ts->ClickCount = 0;
                     }
                 }
-                if (!i) {                               /* On first call, this is click event */
+                if (!ts->ClickCount) {              /* On first call, this is click event */
                     *result = GUI_WC_Click;             /* Click event occurred */
                     
-                    Time = ts->TS.Time;                 /* Save last time */
+                    ts->ClickTime = ts->TS.Time;        /* Save last time */
                     PT_YIELD(&ts->pt);                  /* Stop thread for now and wait next call */
                     
                     /**
                      * Wait for valid input with pressed state
                      */
-                    PT_WAIT_UNTIL(&ts->pt, (v && ts->TS.Status) || (GUI.Time - Time) > 300);
-                    if ((GUI.Time - Time) > 300) {      /* Check timeout for new pressed state */
+                    PT_WAIT_UNTIL(&ts->pt, (v && ts->TS.Status) || (GUI.Time - ts->ClickTime) > 300);
+                    if ((GUI.Time - ts->ClickTime) > 300) {/* Check timeout for new pressed state */
                         PT_EXIT(&ts->pt);               /* Exit protothread */
                     }
                 } else {
@@ -206,12 +226,12 @@ PT_THREAD(__TouchEvents_Thread(__GUI_TouchData_t* ts, __GUI_TouchData_t* old, ui
                 }
             }
         } else {
-            if (!i) {
+            if (!ts->ClickCount) {
                 *result = GUI_WC_LongClick;         /* Click event occurred */
             }
             PT_EXIT(&ts->pt);                       /* Exit protothread here */
         }
-        i++;
+        ts->ClickCount++;
     }
 
     
@@ -228,7 +248,11 @@ void __SetRelativeCoordinate(__GUI_TouchData_t* ts, GUI_iDim_t x, GUI_iDim_t y)
 #if GUI_TOUCH_MAX_PRESSES > 1
     if (ts->TS.Count == 2) {                        /* 2 points detected */
         ts->DistanceOld = ts->Distance;             /* Save old distance */
+#if GUI_USE_FIXED_POINT
+        GUI_MATH_DistanceBetweenXYFixed(GUI_FIXED_FROM_INT(ts->RelX[0]), GUI_FIXED_FROM_INT(ts->RelY[0]), GUI_FIXED_FROM_INT(ts->RelX[1]), GUI_FIXED_FROM_INT(ts->RelY[1]), &ts->Distance);  /* Calculate distance between 2 points */
+#else
         GUI_MATH_DistanceBetweenXY(ts->RelX[0], ts->RelY[0], ts->RelX[1], ts->RelY[1], &ts->Distance);  /* Calculate distance between 2 points */
+#endif /* GUI_USE_FIXED_POINT */
     }
 #endif /* GUI_TOUCH_MAX_PRESSES > 1 */
 }
@@ -307,32 +331,66 @@ __GUI_TouchStatus_t __ProcessTouch(__GUI_TouchData_t* touch, GUI_HANDLE_p parent
 /***                                Public API                               **/
 /******************************************************************************/
 /******************************************************************************/
-GUI_Result_t GUI_Init(void) {
-    memset((void *)&GUI, 0x00, sizeof(GUI_t));      /* Reset GUI structure */
+GUI_Result_t __GUI_InitCore(const GUI_Byte* frame, GUI_Dim_t width, GUI_Dim_t height) {
+    uint8_t (*llinit)(GUI_LCD_t *, GUI_LL_t *) = GUI.LLInit;
+#if GUI_USE_REMOTE
+    struct GUI_REMOTE_t* remote = GUI.Remote;
+#endif /* GUI_USE_REMOTE */
+    
+#if GUI_USE_PIPELINE
+    if (GUI.Pipeline) {                             /* Rasterization task may still use context, disable pipeline first */
+        return guiERROR;
+    }
+#endif /* GUI_USE_PIPELINE */
+#if GUI_USE_HUD
+    if (GUI.Hud) {
+        __GUI_MEMFREE(GUI.Hud);                     /* Saved pixels are not valid after screen is cleared */
+    }
+#endif /* GUI_USE_HUD */
+    memset((void *)&GUI, 0x00, offsetof(GUI_t, Draw));  /* Reset GUI structure, caches are kept */
+    GUI.LLInit = llinit ? llinit : GUI_LL_Init;     /* Keep low-level init function of context */
+#if GUI_USE_REMOTE
+    GUI.Remote = remote;                            /* Keep connection to remote viewer */
+    if (remote) {
+        remote->Refresh = 1;                        /* Viewer needs new screen */
+    }
+#endif /* GUI_USE_REMOTE */
     
     /* Call LCD low-level function */
-    GUI_LL_Init(&GUI.LCD, &GUI.LL);                 /* Call low-level initialization */
+    GUI.LLInit(&GUI.LCD, &GUI.LL);                  /* Call low-level initialization */
     GUI.LL.Init(&GUI.LCD);                          /* Call user LCD driver function */
     
-    /* Draw LCD with default color */
-    
     /* Check situation with layers */
-    if (GUI.LCD.LayersCount == 1) {
-        GUI.LCD.ActiveLayer = 0;
-        GUI.LCD.DrawingLayer = 0;
-        GUI.LL.Fill(&GUI.LCD, GUI.LCD.DrawingLayer, (void *)GUI.LCD.Layers[GUI.LCD.DrawingLayer].StartAddress, GUI.LCD.Width, GUI.LCD.Height, 0, 0xFFFFFFFF);
-    } else if (GUI.LCD.LayersCount > 1) {
-        GUI.LCD.ActiveLayer = 0;
-        GUI.LCD.DrawingLayer = 0;
+    if (!GUI.LCD.LayersCount) {
+        return guiERROR;
+    }
+    GUI.LCD.ActiveLayer = 0;
+    GUI.LCD.DrawingLayer = 0;
+    if (frame && width == GUI.LCD.Width && height == GUI.LCD.Height) {  /* Show saved frame immediately */
+        GUI.LL.Copy(&GUI.LCD, GUI.LCD.DrawingLayer, (void *)frame, (void *)GUI.LCD.Layers[GUI.LCD.DrawingLayer].StartAddress, GUI.LCD.Width, GUI.LCD.Height, 0, 0);
+    } else {                                        /* Draw LCD with default color */
         GUI.LL.Fill(&GUI.LCD, GUI.LCD.DrawingLayer, (void *)GUI.LCD.Layers[GUI.LCD.DrawingLayer].StartAddress, GUI.LCD.Width, GUI.LCD.Height, 0, 0xFFFFFFFF);
+    }
+    if (GUI.LCD.LayersCount > 1) {
         GUI.LCD.DrawingLayer = 1;
-    } else {
-        return guiERROR;
     }
     
     /* Init input devices */
     __GUI_INPUT_Init();
     
+#if GUI_USE_FONT_CACHE
+    /* Init glyph cache */
+    __GUI_FONTCACHE_Init();
+#endif /* GUI_USE_FONT_CACHE */
+    
+    return guiOK;
+}
+
+GUI_Result_t GUI_Init(void) {
+    if (__GUI_InitCore(NULL, 0, 0) != guiOK) {      /* Init low-level and clear screen */
+        return guiERROR;
+    }
+    
     /* Init widgets */
     __GUI_WIDGET_Init();
     
@@ -443,11 +501,23 @@ int32_t GUI_Process(void) {
     }
 #endif /* GUI_USE_KEYBOARD */
     
+#if GUI_USE_REMOTE
+    /**
+     * Remote viewer requests
+     */
+    __GUI_REMOTE_Process();                         /* Check if complete screen is requested */
+#endif /* GUI_USE_REMOTE */
+    
     /**
      * Timer processing
      */
     __GUI_TIMER_Process();                          /* Process all timers */
     
+    /**
+     * Animation processing
+     */
+    __GUI_SPRITE_Process();                         /* Advance frames of playing sprites */
+    
     /**
      * Check if anything to delete 
      */
@@ -458,33 +528,65 @@ int32_t GUI_Process(void) {
     /**
      * Redrawing operations
      */
-    if (!(GUI.LCD.Flags & GUI_FLAG_LCD_WAIT_LAYER_CONFIRM) && __GetNumberOfPendingWidgets(NULL)) {  /* Check if anything to draw first */
+    if (!__IsDrawingLayerBusy() && __GetNumberOfPendingWidgets(NULL)) {   /* Check if anything to draw first */
         uint32_t time;
         GUI_Byte active = GUI.LCD.ActiveLayer;
         GUI_Byte drawing = GUI.LCD.DrawingLayer;
+        GUI_Byte prev = active;                     /* Layer with previous frame */
+        GUI_Display_t dirty;
         
+        __GUI_UNUSED3(prev, dirty, time);           /* Used only with pipeline, remote display or overlay */
         time = TM_GENERAL_DWTCounterGetValue();
         /* Copy current status from one layer to another */
         GUI.LL.Copy(&GUI.LCD, drawing, (void *)GUI.LCD.Layers[active].StartAddress, (void *)GUI.LCD.Layers[drawing].StartAddress, GUI.LCD.Width, GUI.LCD.Height, 0, 0);
+#if GUI_USE_HUD
+        if (GUI.Hud) {
+            __GUI_HUD_Restore(drawing);             /* Remove overlay copied with previous frame */
+        }
+#endif /* GUI_USE_HUD */
             
         /* Actually draw new screen based on setup */
         cnt = __RedrawWidgets(NULL);                /* Redraw all widgets now */
-        //__GUI_DEBUG("T: %d\r\n", TM_GENERAL_DWTCounterGetValue() - time);
-        
-        //GUI_DRAW_Rectangle(& GUI.Display, GUI.Display.X1, GUI.Display.Y1, GUI.Display.X2 - GUI.Display.X1, GUI.Display.Y2 - GUI.Display.Y1, GUI_COLOR_CYAN);
+        time = TM_GENERAL_DWTCounterGetValue() - time;  /* Get number of cycles to draw frame */
         
         /* Invalid clipping region */
+        memcpy(&dirty, &GUI.Display, sizeof(dirty));    /* Save region changed in this frame */
         GUI.Display.X1 = 0x7FFF;
         GUI.Display.Y1 = 0x7FFF;
         GUI.Display.X2 = 0x8000;
         GUI.Display.Y2 = 0x8000;
         
-        /* Set drawing layer as pending */
-        GUI.LCD.Layers[drawing].Pending = 1;
+#if GUI_USE_HUD
+        if (GUI.Hud) {                              /* Draw overlay after frame is measured */
+            __GUI_HUD_Frame(drawing, &dirty, cnt, time / TM_GENERAL_GetSystemClockMHz());
+        }
+#endif /* GUI_USE_HUD */
+        
+#if GUI_USE_REMOTE
+        if (GUI.Remote && __GUI_REMOTE_IsFullFrame()) {
+            prev = drawing;                         /* Do not compare with previous frame */
+        }
+#endif /* GUI_USE_REMOTE */
         
-        /* Notify low-level about layer change */
-        GUI.LCD.Flags |= GUI_FLAG_LCD_WAIT_LAYER_CONFIRM;
-        GUI_LL_Control(&GUI.LCD, GUI_LL_Command_SetActiveLayer, &drawing); /* Set new active layer to low-level driver */
+#if GUI_USE_PIPELINE
+        if (GUI.Pipeline) {                         /* Layer is shown after frame is rasterized */
+            __GUI_PIPELINE_Present(drawing, prev, &dirty);
+        } else
+#endif /* GUI_USE_PIPELINE */
+        {
+#if GUI_USE_REMOTE
+            if (GUI.Remote) {                       /* Send changes to remote viewer */
+                __GUI_REMOTE_Frame(&GUI, &GUI.LL, drawing, prev, &dirty);
+            }
+#endif /* GUI_USE_REMOTE */
+            
+            /* Set drawing layer as pending */
+            GUI.LCD.Layers[drawing].Pending = 1;
+            
+            /* Notify low-level about layer change */
+            GUI.LCD.Flags |= GUI_FLAG_LCD_WAIT_LAYER_CONFIRM;
+            GUI_LL_Control(&GUI.LCD, GUI_LL_Command_SetActiveLayer, &drawing); /* Set new active layer to low-level driver */
+        }
         
         /* Swap active and drawing layers */
         /* New drawings won't be affected until confirmation from low-level is not received */
@@ -492,16 +594,73 @@ int32_t GUI_Process(void) {
         GUI.LCD.DrawingLayer = active;
     }
     
+    /**
+     * Background jobs in remaining time
+     */
+    __GUI_JOB_Process();                            /* Process steps of background jobs */
+    
     return cnt;                                     /* Return number of elements updated on GUI */
 }
 
 void GUI_UpdateTime(uint32_t millis) {
-    GUI.Time += millis;                             /* Increase GUI time for amount of milliseconds */
+    GUI_CTX_UpdateTime(GUI_CONTEXT_GET(), millis);  /* Update time of current context */
 }
 
 void GUI_LCD_ConfirmActiveLayer(GUI_Byte layer_num) {
-    if ((GUI.LCD.Flags & GUI_FLAG_LCD_WAIT_LAYER_CONFIRM)) {/* If we have anything pending */
-        GUI.LCD.Layers[layer_num].Pending = 0;
-        GUI.LCD.Flags &= ~GUI_FLAG_LCD_WAIT_LAYER_CONFIRM;  /* Clear flag */
+    GUI_CTX_ConfirmActiveLayer(GUI_CONTEXT_GET(), layer_num);   /* Confirm layer of current context */
+}
+
+GUI_t* GUI_CTX_GetDefault(void) {
+    return &GUI_Default;
+}
+
+GUI_t* GUI_CTX_Get(void) {
+    return GUI_CONTEXT_GET();
+}
+
+void GUI_CTX_Set(GUI_t* ctx) {
+    __GUI_Context = ctx ? ctx : &GUI_Default;       /* Select new context */
+}
+
+GUI_Result_t GUI_CTX_Init(GUI_t* ctx, uint8_t (*llinit)(GUI_LCD_t* LCD, GUI_LL_t* LL)) {
+    __GUI_ASSERTPARAMS(ctx);                        /* Check input parameters */
+    
+    GUI_CTX_Set(ctx);                               /* Select context */
+    if (GUI_CONTEXT_GET() != ctx) {                 /* Context is not used by this thread */
+        return guiERROR;
+    }
+    ctx->LLInit = llinit;                           /* Set low-level function, kept during init */
+    memset(&ctx->Draw, 0x00, sizeof(*ctx) - offsetof(GUI_t, Draw)); /* Caches are kept during init, clear them once */
+#if GUI_USE_PIPELINE
+    ctx->Pipeline = 0;                              /* Context memory is not initialized yet */
+#endif /* GUI_USE_PIPELINE */
+#if GUI_USE_REMOTE
+    ctx->Remote = 0;
+#endif /* GUI_USE_REMOTE */
+#if GUI_USE_HUD
+    ctx->Hud = 0;
+#endif /* GUI_USE_HUD */
+    return GUI_Init();                              /* Initialize selected context */
+}
+
+int32_t GUI_CTX_Process(GUI_t* ctx) {
+    if (!ctx) {
+        return -1;
+    }
+    GUI_CTX_Set(ctx);                               /* Select context */
+    if (GUI_CONTEXT_GET() != ctx) {                 /* Context is not used by this thread */
+        return -1;
+    }
+    return GUI_Process();                           /* Process selected context */
+}
+
+void GUI_CTX_UpdateTime(GUI_t* ctx, uint32_t millis) {
+    ctx->Time += millis;                            /* Increase GUI time for amount of milliseconds */
+}
+
+void GUI_CTX_ConfirmActiveLayer(GUI_t* ctx, GUI_Byte layer_num) {
+    if ((ctx->LCD.Flags & GUI_FLAG_LCD_WAIT_LAYER_CONFIRM)) {/* If we have anything pending */
+        ctx->LCD.Layers[layer_num].Pending = 0;
+        ctx->LCD.Flags &= ~GUI_FLAG_LCD_WAIT_LAYER_CONFIRM; /* Clear flag */
     }
 }
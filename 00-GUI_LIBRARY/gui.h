@@ -59,7 +59,15 @@ extern "C" {
 #include "utils/gui_linkedlist.h"
 #include "utils/gui_string.h"
 #include "utils/gui_timer.h"
+#include "utils/gui_job.h"
+#include "utils/gui_mem.h"
 #include "utils/gui_math.h"
+#include "utils/gui_respack.h"
+#include "utils/gui_fontcache.h"
+#include "utils/gui_imgdec.h"
+#include "utils/gui_strtable.h"
+#include "utils/gui_outline.h"
+#include "utils/gui_path.h"
 
 /* GUI Low-Level drivers */
 #include "gui_ll.h"
@@ -87,20 +95,38 @@ extern "C" {
  */ 
 #define __GHR(x)                    ((struct GUI_HANDLE_ROOT *)(x))
 
+#if GUI_USE_MEM_STATS || defined(DOXYGEN)
 /**
  * \brief           Allocate memory with specific size in bytes
+ * \param[in]       size: Number of bytes to allocate
+ * \param[in]       type: Allocation category for statistics, member of \ref GUI_MEM_Type_t enumeration
  * \hideinitializer
  */
-#define __GUI_MEMALLOC(size)        malloc(size)
+#define __GUI_MEMALLOC(size, type)  __GUI_MEM_Alloc(size, type)
+
+/**
+ * \brief           Allocate memory for widget handle
+ * \param[in]       widget: Pointer to \ref GUI_WIDGET_t widget description
+ * \hideinitializer
+ */
+#define __GUI_MEMWIDALLOC(widget)   __GUI_MEM_AllocWidget(widget)
 
 /**
  * \brief           Free memory from specific address previously allocated with \ref __GUI_MEMALLOC
  * \hideinitializer
  */
+#define __GUI_MEMFREE(p)            do {            \
+    __GUI_MEM_Free(p);                              \
+    (p) = NULL;                                     \
+} while (0);
+#else
+#define __GUI_MEMALLOC(size, type)  malloc(size)
+#define __GUI_MEMWIDALLOC(widget)   malloc((widget)->Size)
 #define __GUI_MEMFREE(p)            do {            \
     free(p);                                        \
     (p) = NULL;                                     \
 } while (0);
+#endif /* GUI_USE_MEM_STATS || defined(DOXYGEN) */
 
 /**
  * \brief           Free memory for widget which was just deleted
@@ -109,8 +135,7 @@ extern "C" {
 #define __GUI_MEMWIDFREE(p)         do {            \
     __GUI_DEBUG("Memory free: 0x%08X; Type: %s\r\n", (uint32_t)__GH(p), __GH(p)->Widget->Name);  \
     memset(p, 0x00, __GH(p)->Widget->Size);         \
-    free(p);                                        \
-    (p) = 0;                                        \
+    __GUI_MEMFREE(p);                               \
 } while (0)
 
 /**
@@ -221,19 +246,63 @@ typedef struct GUI_t {
     GUI_HANDLE_p WindowActive;              /*!< Pointer to currently active window when creating new widgets */
     GUI_HANDLE_p FocusedWidget;             /*!< Pointer to focused widget for keyboard events if any */
     GUI_HANDLE_p FocusedWidgetPrev;         /*!< Pointer to previously focused widget */
+    const GUI_FONT_t* WidgetFont;           /*!< Default font for new widgets, set with \ref GUI_WIDGET_SetFontDefault */
     
     GUI_LinkedListRoot_t Root;              /*!< Root linked list of widgets */
     GUI_TIMER_CORE_t Timers;                /*!< Software structure management */
+    GUI_JOB_CORE_t Jobs;                    /*!< Background jobs management */
+    
+    struct GUI_SPRITE_t* Sprites;           /*!< List of playing sprites */
+    uint8_t (*LLInit)(GUI_LCD_t* LCD, GUI_LL_t* LL);    /*!< Low-level initialization function for this context */
+#if GUI_USE_PIPELINE || defined(DOXYGEN)
+    struct GUI_PIPELINE_t* Pipeline;        /*!< Pointer to pipeline when pipelined rendering is enabled */
+#endif /* GUI_USE_PIPELINE || defined(DOXYGEN) */
+#if GUI_USE_REMOTE || defined(DOXYGEN)
+    struct GUI_REMOTE_t* Remote;            /*!< Pointer to remote display when enabled */
+#endif /* GUI_USE_REMOTE || defined(DOXYGEN) */
+#if GUI_USE_HUD || defined(DOXYGEN)
+    struct GUI_HUD_t* Hud;                  /*!< Pointer to debug overlay when enabled */
+#endif /* GUI_USE_HUD || defined(DOXYGEN) */
     
 #if GUI_USE_TOUCH || defined(DOXYGEN)
     __GUI_TouchData_t TouchOld;             /*!< Old touch data, used for event management */
     __GUI_TouchData_t Touch;                /*!< Current touch data and processing tool */
     GUI_HANDLE_p ActiveWidget;              /*!< Pointer to widget currently active by touch */
     GUI_HANDLE_p ActiveWidgetPrev;          /*!< Previously active widget */
+    GUI_BUFFER_t TouchBuffer;               /*!< Buffer for touch input events */
+    GUI_Byte TouchBufferData[GUI_TOUCH_BUFFER_SIZE * sizeof(GUI_TouchData_t) + 1];  /*!< Memory for touch input events */
 #endif /* GUI_USE_TOUCH */
+#if GUI_USE_KEYBOARD || defined(DOXYGEN)
+    GUI_BUFFER_t KeyBuffer;                 /*!< Buffer for keyboard input events */
+    GUI_Byte KeyBufferData[GUI_TOUCH_BUFFER_SIZE * sizeof(GUI_KeyboardData_t) + 1]; /*!< Memory for keyboard input events */
+#endif /* GUI_USE_KEYBOARD */
+    
+    /**
+     * Caches below are kept when context is initialized again,
+     * each context has its own copy so contexts can be processed in parallel
+     */
+    GUI_DRAW_CORE_t Draw;                   /*!< Drawing caches and buffers */
+#if GUI_USE_FONT_CACHE || defined(DOXYGEN)
+    GUI_FONTCACHE_CORE_t FontCache;         /*!< Glyph cache for fonts in external storage */
+#endif /* GUI_USE_FONT_CACHE || defined(DOXYGEN) */
+#if GUI_USE_STRTABLE || defined(DOXYGEN)
+    GUI_STRTABLE_CORE_t StrTable;           /*!< Current language and strings in use */
+#endif /* GUI_USE_STRTABLE || defined(DOXYGEN) */
+#if GUI_USE_PATH || defined(DOXYGEN)
+    GUI_PATH_CORE_t Path;                   /*!< Path rasterizer buffer */
+#endif /* GUI_USE_PATH || defined(DOXYGEN) */
 } GUI_t;
+
+extern GUI_t* __GUI_Context;
+#ifndef GUI_CONTEXT_GET
+#define GUI_CONTEXT_GET()           (__GUI_Context)
+#endif /* GUI_CONTEXT_GET */
 #if defined(GUI_INTERNAL)
-extern GUI_t GUI;
+/**
+ * \brief           GUI context of current thread, used by all internal functions
+ * \hideinitializer
+ */
+#define GUI                         (*GUI_CONTEXT_GET())
 #endif /* defined(GUI_INTERNAL) */
 
 /* Include widget structure */
@@ -244,10 +313,23 @@ extern GUI_t GUI;
  * \brief           Initializes GUI stack.
  *                    In addition, it prepares memory for work with widgets on later usage and
  *                    calls low-layer functions to initialize LCD or custom driver for LCD
+ * \note            When pipelined rendering is enabled, disable it with \ref GUI_PIPELINE_Disable first
  * \retval          Member of \ref GUI_Result_t enumeration
  */
 GUI_Result_t GUI_Init(void);
 
+#if defined(GUI_INTERNAL) || defined(DOXYGEN)
+/**
+ * \brief           Initialize GUI core and low-level driver without creating any widget
+ * \note            Since this function is private, it can only be used by user inside GUI library
+ * \param[in]       *frame: Pointer to ARGB8888 image of full screen to show or NULL to clear screen
+ * \param[in]       width: Frame width in units of pixels
+ * \param[in]       height: Frame height in units of pixels. Frame is shown only when its size matches LCD size, otherwise screen is cleared
+ * \retval          Member of \ref GUI_Result_t enumeration
+ */
+GUI_Result_t __GUI_InitCore(const GUI_Byte* frame, GUI_Dim_t width, GUI_Dim_t height);
+#endif /* defined(GUI_INTERNAL) || defined(DOXYGEN) */
+
 /**
  * \brief           Processes all drawing operations for GUI
  * \retval          Number of jobs done in current call
@@ -257,6 +339,80 @@ void GUI_UpdateTime(uint32_t millis);
 
 //Notify GUI from low-level that layer is in use
 void GUI_LCD_ConfirmActiveLayer(GUI_Byte layer_num);
+
+/**
+ * \defgroup        GUI_CTX Contexts
+ * \brief           Multiple independent GUI instances
+ * \{
+ *
+ * All GUI state (display, widgets, timers, focus, touch and input buffers) is stored in \ref GUI_t context.
+ * Functions without context parameter operate on context returned by \ref GUI_CONTEXT_GET,
+ * which is default context unless another one is selected with \ref GUI_CTX_Set.
+ *
+ * To drive 2 displays (or display and offscreen renderer) from different threads in parallel,
+ * each thread processes its own context and \ref GUI_CONTEXT_GET reads context pointer from thread local storage.
+ * Functions with context parameter are safe to be called from interrupts or other threads.
+ *
+ * \note            Font cache, image cache, string table and path buffer are part of context.
+ *                  Each context uses its own copy, so memory set with \ref GUI_FONT_CACHE_ENTRIES,
+ *                  \ref GUI_IMAGE_CACHE_ENTRIES and \ref GUI_PATH_CELLS is required for every context.
+ *                  Memory statistics are shared and protected with \ref GUI_MEM_LOCK
+ */
+
+/**
+ * \brief           Get default GUI context
+ * \retval          Pointer to default context
+ */
+GUI_t* GUI_CTX_GetDefault(void);
+
+/**
+ * \brief           Get GUI context of current thread
+ * \retval          Pointer to context
+ */
+GUI_t* GUI_CTX_Get(void);
+
+/**
+ * \brief           Select GUI context for all following calls
+ * \note            Has no effect on threads when \ref GUI_CONTEXT_GET is set to thread local storage
+ * \param[in]       *ctx: Pointer to context or NULL for default context
+ * \retval          None
+ */
+void GUI_CTX_Set(GUI_t* ctx);
+
+/**
+ * \brief           Select and initialize GUI context
+ * \param[in,out]   *ctx: Pointer to context memory
+ * \param[in]       llinit: Low-level initialization function for display of this context. Set to NULL to use \ref GUI_LL_Init
+ * \retval          Member of \ref GUI_Result_t enumeration
+ */
+GUI_Result_t GUI_CTX_Init(GUI_t* ctx, uint8_t (*llinit)(GUI_LCD_t* LCD, GUI_LL_t* LL));
+
+/**
+ * \brief           Select context and process all its drawing operations
+ * \param[in,out]   *ctx: Pointer to context
+ * \retval          Number of jobs done in current call or -1 when context could not be selected
+ */
+int32_t GUI_CTX_Process(GUI_t* ctx);
+
+/**
+ * \brief           Increase time of context
+ * \param[in,out]   *ctx: Pointer to context
+ * \param[in]       millis: Number of milliseconds elapsed
+ * \retval          None
+ */
+void GUI_CTX_UpdateTime(GUI_t* ctx, uint32_t millis);
+
+/**
+ * \brief           Notify context from low-level driver that layer is shown
+ * \param[in,out]   *ctx: Pointer to context
+ * \param[in]       layer_num: Shown layer number
+ * \retval          None
+ */
+void GUI_CTX_ConfirmActiveLayer(GUI_t* ctx, GUI_Byte layer_num);
+
+/**
+ * \}
+ */
  
 /**
  * \} GUI
@@ -71,6 +71,7 @@ extern "C" {
 #define GUI_FLAG_EXPANDED               ((uint32_t)0x00001000)  /*!< Indicates children widget is set to (temporary) XY = 0,0 and width/height = parent width / parent height (maximize windows function) */
 #define GUI_FLAG_REMOVE                 ((uint32_t)0x00002000)  /*!< Indicates widget should be deleted */
 #define GUI_FLAG_IGNORE_INVALIDATE      ((uint32_t)0x00004000)  /*!< Indicates widget invalidation is ignored completely when invalidating it directly */
+#define GUI_FLAG_TEXTID                 ((uint32_t)0x00008000)  /*!< Indicates widget text is taken from string table with \ref GUI_HANDLE.TextID */
 
 #define GUI_FLAG_LCD_WAIT_LAYER_CONFIRM ((uint32_t)0x00000001)  /*!< Indicates waiting for layer change confirmation */
 
@@ -153,6 +154,14 @@ typedef struct GUI_TIMER_CORE_t {
     GUI_LinkedListRoot_t List;              /*!< Root linked list object */
 } GUI_TIMER_CORE_t;
 
+/**
+ * \brief           Core job structure for GUI background jobs
+ */
+typedef struct GUI_JOB_CORE_t {
+    GUI_LinkedListRoot_t List;              /*!< Root linked list object */
+    uint32_t Count;                         /*!< Number of jobs in list */
+} GUI_JOB_CORE_t;
+
 typedef uint32_t    GUI_ID_t;               /*!< GUI object ID */
 typedef uint32_t    GUI_Color_t;            /*!< Color definition */
 typedef int16_t     GUI_Dim_t;              /*!< GUI dimensions in units of pixels */
@@ -162,6 +171,12 @@ typedef GUI_Byte    GUI_Byte_t;             /*!< GUI byte data type */
 typedef int8_t      GUI_iByte;              /*!< GUI signed byte data type */
 typedef GUI_iByte   GUI_iByte_t;            /*!< GUI signed byte data type */
 typedef uint8_t     GUI_Char;               /*!< GUI char data type for all string operations */
+typedef int32_t     GUI_Fixed_t;            /*!< GUI fixed-point number in Q16.16 format */
+#if GUI_USE_FIXED_POINT || defined(DOXYGEN)
+typedef GUI_Fixed_t GUI_Real_t;             /*!< GUI real number, fixed-point or float according to \ref GUI_USE_FIXED_POINT */
+#else
+typedef float       GUI_Real_t;
+#endif /* GUI_USE_FIXED_POINT || defined(DOXYGEN) */
 #define _T(x)       (GUI_Char *)(x)         /*!< Macro to force strings to right format for processing */
 #define GUI_Const   const                   /*!< Macro for constant keyword */
     
@@ -253,10 +268,14 @@ typedef struct __GUI_TouchData_t {
     GUI_iDim_t RelX[GUI_TOUCH_MAX_PRESSES]; /*!< Relative X position to current widget */
     GUI_iDim_t RelY[GUI_TOUCH_MAX_PRESSES]; /*!< Relative Y position to current widget */
 #if GUI_TOUCH_MAX_PRESSES > 1 || defined(DOXYGEN)
-    float Distance;                         /*!< Distance between 2 points when 2 touch elements are detected */
-    float DistanceOld;                      /*!< Old distance between 2 points */
+    GUI_Real_t Distance;                    /*!< Distance between 2 points when 2 touch elements are detected */
+    GUI_Real_t DistanceOld;                 /*!< Old distance between 2 points */
 #endif /* GUI_TOUCH_MAX_PRESSES > 1 || defined(DOXYGEN) */
     struct pt pt;                           /*!< Protothreads structure */
+    uint32_t ClickTime;                     /*!< Time of last click event processing */
+    uint8_t ClickCount;                     /*!< Number of clicks detected in sequence */
+    GUI_iDim_t ClickX[2];                   /*!< Relative X positions of clicks for double click detection */
+    GUI_iDim_t ClickY[2];                   /*!< Relative Y positions of clicks for double click detection */
 } __GUI_TouchData_t;
 
 /**
@@ -320,6 +339,67 @@ typedef struct GUI_Display_t {
     GUI_iDim_t Y2;                          /*!< Clipping area end Y */
 } GUI_Display_t;
 
+/**
+ * \brief           List of supported image pixel formats
+ */
+typedef enum GUI_IMAGE_Format_t {
+    GUI_IMAGE_FORMAT_ARGB8888 = 0x00,       /*!< 32-bit color with alpha channel, 4 bytes per pixel */
+    GUI_IMAGE_FORMAT_RGB565,                /*!< 16-bit color without alpha channel, 2 bytes per pixel, little-endian */
+    GUI_IMAGE_FORMAT_L8,                    /*!< 8-bit index to color lookup table of ARGB8888 colors */
+    GUI_IMAGE_FORMAT_A8,                    /*!< 8-bit alpha only, color is set on drawing */
+    GUI_IMAGE_FORMAT_A4,                    /*!< 4-bit alpha only, 2 pixels per byte with first pixel in low nibble as read by DMA2D, color is set on drawing */
+    GUI_IMAGE_FORMAT_QOI,                   /*!< Compressed QOI file including header, decoded while drawing */
+    GUI_IMAGE_FORMAT_RLE,                   /*!< Run-length encoded ARGB8888 pixels, decoded while drawing. See \ref GUI_IMGDEC */
+} GUI_IMAGE_Format_t;
+
+/**
+ * \brief           Image descriptor
+ *
+ * \note            Lines are stored one after another without padding,
+ *                  except for \ref GUI_IMAGE_FORMAT_A4 where each line starts at new byte
+ */
+typedef struct GUI_IMAGE_DESC_t {
+    GUI_Dim_t Width;                        /*!< Image width in units of pixels */
+    GUI_Dim_t Height;                       /*!< Image height in units of pixels */
+    GUI_IMAGE_Format_t Format;              /*!< Pixel format of image data */
+    GUI_Const GUI_Byte* Data;               /*!< Pointer to image data, aligned to pixel size */
+    GUI_Const GUI_Color_t* CLUT;            /*!< Color lookup table for \ref GUI_IMAGE_FORMAT_L8 format */
+    uint16_t CLUTSize;                      /*!< Number of colors in lookup table, up to 256 */
+    uint32_t Size;                          /*!< Size of image data in units of bytes, used for compressed formats */
+} GUI_IMAGE_DESC_t;
+
+/**
+ * \brief           Changed rectangle of sprite frame
+ */
+typedef struct GUI_SPRITE_RECT_t {
+    GUI_Dim_t X;                            /*!< Rectangle X position relative to sprite top left corner */
+    GUI_Dim_t Y;                            /*!< Rectangle Y position relative to sprite top left corner */
+    GUI_IMAGE_DESC_t Image;                 /*!< New pixels of rectangle. Any format is allowed, including compressed */
+} GUI_SPRITE_RECT_t;
+
+/**
+ * \brief           Single frame of sprite animation
+ */
+typedef struct GUI_SPRITE_FRAME_t {
+    GUI_Const GUI_SPRITE_RECT_t* Rects;     /*!< Pointer to list of rectangles changed from previous frame */
+    uint16_t RectsCount;                    /*!< Number of changed rectangles */
+    uint16_t Duration;                      /*!< Frame display time in units of milliseconds */
+} GUI_SPRITE_FRAME_t;
+
+/**
+ * \brief           Sprite animation descriptor
+ *
+ * \note            Each frame is stored as list of rectangles changed from previous frame.
+ *                  First frame is key frame and must cover all pixels of sprite,
+ *                  as it is applied also after last frame when animation loops
+ */
+typedef struct GUI_SPRITE_DESC_t {
+    GUI_Dim_t Width;                        /*!< Sprite width in units of pixels */
+    GUI_Dim_t Height;                       /*!< Sprite height in units of pixels */
+    GUI_Const GUI_SPRITE_FRAME_t* Frames;   /*!< Pointer to list of frames */
+    uint16_t FramesCount;                   /*!< Number of frames */
+} GUI_SPRITE_DESC_t;
+
 /**
  * \brief           Low-level LCD command enumeration
  */
@@ -339,6 +419,9 @@ typedef struct GUI_LL_t {
     void            (*DrawHLine)    (GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t, GUI_Dim_t, GUI_Dim_t, GUI_Color_t);              /*!< Pointer to horizontal line drawing. Set to 0 if you do not have optimized version */
     void            (*DrawVLine)    (GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t, GUI_Dim_t, GUI_Dim_t, GUI_Color_t);              /*!< Pointer to vertical line drawing. Set to 0 if you do not have optimized version */
     void            (*FillRect)     (GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t, GUI_Dim_t, GUI_Dim_t, GUI_Dim_t, GUI_Color_t);   /*!< Pointer to function for filling rectangle on LCD */
+    uint8_t         (*DrawImage)    (GUI_LCD_t* LCD, uint8_t layer, const GUI_IMAGE_DESC_t* img, GUI_Dim_t, GUI_Dim_t, GUI_Dim_t, GUI_Dim_t, GUI_Dim_t, GUI_Dim_t, GUI_Color_t); /*!< Pointer to function for drawing part of image at X and Y position, with X and Y offset in image, width and height of part and color for alpha-only formats.
+                                                                                                                                        Returns 0 if image can not be drawn by hardware. Set to 0 if you do not have optimized version */
+    void            (*BlendPixel)   (GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t, GUI_Dim_t, GUI_Color_t);                         /*!< Pointer to function for blending color over pixel, alpha value of color is coverage of pixel. Set to 0 if you do not have optimized version */
 } GUI_LL_t;
 
 /**
@@ -359,21 +442,164 @@ typedef struct GUI_FONT_CharInfo_t {
     GUI_Const GUI_Byte* Data;               /*!< Pointer to actual data for font */
 } GUI_FONT_CharInfo_t;
 
+/**
+ * \brief           Callback function prototype to read font data from external storage
+ * \param[in]       param: User parameter from \ref GUI_FONT_Ext_t structure
+ * \param[in]       addr: Address in external storage to read from
+ * \param[out]      data: Pointer to RAM memory to save data to
+ * \param[in]       len: Number of bytes to read
+ * \retval          1: Data were read successfully
+ * \retval          0: Read failed
+ */
+typedef uint8_t (*GUI_FONT_ReadCallback_t)(void* param, uint32_t addr, GUI_Byte* data, uint32_t len);
+
+/**
+ * \brief           External storage description for fonts with bitmaps outside memory map
+ *
+ *                  When used, only character table is resident in memory and
+ *                  \ref GUI_FONT_CharInfo_t.Data member is address of bitmap in external storage
+ * \sa              GUI_USE_FONT_CACHE
+ */
+typedef struct GUI_FONT_Ext_t {
+    GUI_FONT_ReadCallback_t Read;           /*!< Callback function to read bitmap data */
+    void* Param;                            /*!< User parameter passed to read callback */
+} GUI_FONT_Ext_t;
+
 /**
  * \brief           FONT structure for writing usage
+ *
+ *                  Characters not in font are taken from fonts in \ref GUI_FONT_t.Fallback chain,
+ *                  for example Arial font with fallback to CJK font with fallback to symbol font
+ * \sa              GUI_USE_FONT_FALLBACK
  */
-typedef struct {
+typedef struct GUI_FONT_t {
     GUI_Const GUI_Char* Name;               /*!< Pointer to font name */
     GUI_Byte Size;                          /*!< Font size in units of pixels */
     uint16_t StartChar;                     /*!< Start character number in list */
     uint16_t EndChar;                       /*!< End character number in list */
     GUI_Byte Flags;                         /*!< List of flags for font */
     GUI_Const GUI_FONT_CharInfo_t* Data;    /*!< Pointer to first character */
+    GUI_Const GUI_FONT_Ext_t* Ext;          /*!< Pointer to external storage description. Set to NULL when bitmaps are memory-mapped */
+    GUI_Const struct GUI_FONT_t* Fallback;  /*!< Pointer to font used for characters not in this font. Set to NULL when not used */
+    GUI_Const GUI_Byte* Base;               /*!< Base address of character bitmaps when \ref GUI_FONT_CharInfo_t.Data is offset from it, for fonts in resource pack. Set to NULL when Data is pointer */
 } GUI_FONT_t;
 
 #define GUI_FLAG_FONT_AA                0x01/*!< Indicates anti-alliasing on font */
 #define GUI_FLAG_FONT_RIGHTALIGN        0x02/*!< Indicates right align text if string length is too wide for rectangle */
 #define GUI_FLAG_FONT_MULTILINE         0x04/*!< Indicates multi line support on widget */
+#define GUI_FLAG_FONT_AA4               0x08/*!< Indicates 4-bit anti-alliasing on font, 2 pixels per byte with first pixel in low nibble and each line starting at new byte */
+#define GUI_FLAG_FONT_AA8               0x10/*!< Indicates 8-bit anti-alliasing on font, 1 pixel per byte */
+
+#if GUI_USE_IMAGE_CACHE || defined(DOXYGEN)
+/**
+ * \brief           Image converted to ARGB8888 format in image cache
+ */
+typedef struct __GUI_IMAGE_CacheEntry_t {
+    const GUI_IMAGE_DESC_t* Src;            /*!< Pointer to source image, NULL when entry is not used */
+    GUI_IMAGE_DESC_t Img;                   /*!< Converted image in ARGB8888 format */
+    GUI_Color_t* Data;                      /*!< Pointer to allocated memory for converted image */
+    uint32_t Size;                          /*!< Memory size of converted image */
+    uint32_t Used;                          /*!< Last usage counter value for replacement */
+} __GUI_IMAGE_CacheEntry_t;
+#endif /* GUI_USE_IMAGE_CACHE || defined(DOXYGEN) */
+
+#if GUI_USE_FONT_FALLBACK || defined(DOXYGEN)
+/**
+ * \brief           Character resolved in fallback chain of font
+ */
+typedef struct __GUI_FONT_FallbackEntry_t {
+    const GUI_FONT_t* Font;                 /*!< Font character was requested for */
+    uint32_t Ch;                            /*!< Character code */
+    const GUI_FONT_CharInfo_t* Glyph;       /*!< Glyph from first font in chain with character */
+} __GUI_FONT_FallbackEntry_t;
+#endif /* GUI_USE_FONT_FALLBACK || defined(DOXYGEN) */
+
+#define __STROKE_BAND_ROWS          8       /*!< Number of scanlines rasterized at a time for thick lines */
+#define __STROKE_BAND_SPANS         16      /*!< Maximal number of separate spans on scanline of band */
+
+/**
+ * \brief           Spans of stroke on band of scanlines, merged before drawing so each pixel is drawn once
+ */
+typedef struct __GUI_StrokeBand_t {
+    const GUI_Display_t* Disp;              /*!< Clipping region */
+    GUI_Color_t Color;                      /*!< Stroke color */
+    GUI_iDim_t Y;                           /*!< First scanline of band */
+    GUI_iDim_t Rows;                        /*!< Number of scanlines in band */
+    uint8_t Count[__STROKE_BAND_ROWS];      /*!< Number of spans on each scanline */
+    GUI_iDim_t Span[__STROKE_BAND_ROWS][__STROKE_BAND_SPANS][2];    /*!< Sorted spans on each scanline, end is excluded */
+} __GUI_StrokeBand_t;
+
+/**
+ * \brief           Core drawing structure with caches and buffers of GUI context
+ */
+typedef struct GUI_DRAW_CORE_t {
+#if GUI_USE_IMAGE_CACHE || defined(DOXYGEN)
+    __GUI_IMAGE_CacheEntry_t ImageCache[GUI_IMAGE_CACHE_ENTRIES];   /*!< Converted images */
+    uint32_t ImageCacheSize;                /*!< Total memory used by converted images */
+    uint32_t ImageCacheCounter;             /*!< Usage counter for least recently used replacement */
+#endif /* GUI_USE_IMAGE_CACHE || defined(DOXYGEN) */
+#if GUI_USE_FONT_FALLBACK || defined(DOXYGEN)
+    __GUI_FONT_FallbackEntry_t FallbackCache[GUI_FONT_FALLBACK_CACHE_SIZE]; /*!< Characters resolved in font fallback chains */
+#endif /* GUI_USE_FONT_FALLBACK || defined(DOXYGEN) */
+    __GUI_StrokeBand_t StrokeBand;          /*!< Span buffer for thick lines */
+} GUI_DRAW_CORE_t;
+
+#if GUI_USE_FONT_CACHE || defined(DOXYGEN)
+/**
+ * \brief           Font cache statistics
+ */
+typedef struct GUI_FONTCACHE_Stats_t {
+    uint32_t Hits;                          /*!< Number of lookups found in cache */
+    uint32_t Misses;                        /*!< Number of lookups not found in cache */
+    uint32_t Fetches;                       /*!< Number of successful reads from external storage */
+    uint32_t Errors;                        /*!< Number of failed reads or glyphs too big for cache entry */
+    uint32_t FetchTime;                     /*!< Total read time in units of \ref GUI_FONT_CACHE_TIMESTAMP */
+    uint32_t FetchTimeMax;                  /*!< Maximal single read time in units of \ref GUI_FONT_CACHE_TIMESTAMP */
+} GUI_FONTCACHE_Stats_t;
+
+/**
+ * \brief           Single glyph in font cache
+ */
+typedef struct __GUI_FONTCACHE_Entry_t {
+    const GUI_FONT_CharInfo_t* Key;         /*!< Character in font table, NULL when entry is not used */
+    uint16_t Prev;                          /*!< Previous entry in LRU list, towards most recently used */
+    uint16_t Next;                          /*!< Next entry in LRU list, towards least recently used */
+    uint16_t HashNext;                      /*!< Next entry in the same hash bucket */
+    GUI_Byte Data[GUI_FONT_CACHE_GLYPH_SIZE];   /*!< Glyph bitmap */
+} __GUI_FONTCACHE_Entry_t;
+
+/**
+ * \brief           Core font cache structure of GUI context
+ */
+typedef struct GUI_FONTCACHE_CORE_t {
+    __GUI_FONTCACHE_Entry_t Entries[GUI_FONT_CACHE_ENTRIES];    /*!< Cached glyphs */
+    uint16_t Buckets[GUI_FONT_CACHE_ENTRIES];   /*!< First entry in each hash bucket */
+    uint16_t Head;                          /*!< Most recently used entry */
+    uint16_t Tail;                          /*!< Least recently used entry */
+    GUI_FONTCACHE_Stats_t Stats;            /*!< Cache statistics */
+} GUI_FONTCACHE_CORE_t;
+#endif /* GUI_USE_FONT_CACHE || defined(DOXYGEN) */
+
+#if GUI_USE_STRTABLE || defined(DOXYGEN)
+#define __GUI_STRTABLE_BUCKETS      16      /*!< Number of hash buckets for string ID and font pairs */
+
+/**
+ * \brief           Core string table structure of GUI context
+ */
+typedef struct GUI_STRTABLE_CORE_t {
+    const struct GUI_STRTABLE_t* Table;     /*!< Current language */
+    struct __GUI_STRTABLE_Entry_t* Buckets[__GUI_STRTABLE_BUCKETS]; /*!< String ID and font pairs in use */
+} GUI_STRTABLE_CORE_t;
+#endif /* GUI_USE_STRTABLE || defined(DOXYGEN) */
+
+#if GUI_USE_PATH || defined(DOXYGEN)
+/**
+ * \brief           Core path rasterizer structure of GUI context
+ */
+typedef struct GUI_PATH_CORE_t {
+    int32_t Cells[GUI_PATH_CELLS];          /*!< Coverage changes of block, 16 sampled scanlines for (Width + 1) pixels per row */
+} GUI_PATH_CORE_t;
+#endif /* GUI_USE_PATH || defined(DOXYGEN) */
 
 #if !defined(DOXYGEN)
 #define ________                        0x00
@@ -664,6 +890,36 @@ typedef struct GUI_TIMER_t {
  */
 typedef GUI_TIMER_t* GUI_TIMER_p;
 
+/**
+ * \}
+ */
+
+/**
+ * \addtogroup      GUI_JOB
+ * \{
+ */
+
+struct GUI_JOB_t;
+
+/**
+ * \brief           Job protothread function
+ * \param[in,out]   *job: Job structure with protothread state in \ref GUI_JOB_t.pt
+ * \retval          Protothread status, job is removed when thread ends or exits
+ */
+typedef PT_THREAD((*GUI_JOB_Thread_t)(struct GUI_JOB_t* job));
+
+/**
+ * \brief           Background job structure
+ */
+typedef struct GUI_JOB_t {
+    GUI_LinkedList_t List;                  /*!< Linked list entry, must be first on the list */
+    struct pt pt;                           /*!< Protothread state */
+    GUI_JOB_Thread_t Thread;                /*!< Job function */
+    void* Params;                           /*!< Custom parameters passed to job function */
+    struct GUI_JOB_t** Handle;              /*!< Owner pointer to job, set to NULL when job memory is released */
+    uint8_t Flags;                          /*!< Job flags */
+} GUI_JOB_t;
+
 /**
  * \}
  */
@@ -867,8 +1123,40 @@ typedef enum GUI_WC_t {
      * \param[out]  *result: Pointer to output \ref uint8_t variable to save status of increase/decrease operation
      */
     GUI_WC_IncSelection,
+    
+    /**
+     * \brief       Widget has been restored from snapshot instead of created
+     *
+     * \note        Widget memory is copied from snapshot. Pointers to memory previously allocated by widget
+     *                 are not valid anymore and must be reset or allocated again
+     *
+     * \param[in]   *param: Pointer to \ref GUI_WIDGET_SnapshotData_t with data saved on \ref GUI_WC_Save. Size is 0 when there is no data
+     * \param[out]  *result: None
+     * \sa          GUI_SNAPSHOT_Restore
+     */
+    GUI_WC_Restore,
+    
+    /**
+     * \brief       Widget is saved to snapshot
+     *
+     * \note        Widget saves memory allocated by widget, such as list entries, which can not be copied with widget memory.
+     *                 Called first with Data set to NULL to get required size, then with memory of that size
+     *
+     * \param[in,out] *param: Pointer to \ref GUI_WIDGET_SnapshotData_t. Widget sets Size and writes data when Data is not NULL
+     * \param[out]  *result: None
+     * \sa          GUI_SNAPSHOT_Save
+     */
+    GUI_WC_Save,
 } GUI_WC_t;
 
+/**
+ * \brief           Widget private data in snapshot, used with \ref GUI_WC_Save and \ref GUI_WC_Restore commands
+ */
+typedef struct GUI_WIDGET_SnapshotData_t {
+    void* Data;                             /*!< Pointer to data or NULL when only size is requested */
+    uint32_t Size;                          /*!< Size of data in units of bytes */
+} GUI_WIDGET_SnapshotData_t;
+
 /**
  * \defgroup        GUI_WIDGETS_CORE_FLAGS Widget type flags
  * \brief           Flags used for widget type description
@@ -936,8 +1224,11 @@ typedef struct GUI_HANDLE {
     GUI_Char* Text;                         /*!< Pointer to widget text if exists */
     uint32_t TextMemSize;                   /*!< Number of bytes for text when dynamically allocated */
     uint32_t TextCursor;                    /*!< Text cursor position */
+    uint32_t TextHash;                      /*!< Hash of last text content set with \ref __GUI_WIDGET_SetText, used to detect in-place changes of user buffer */
     GUI_TIMER_t* Timer;                     /*!< Software timer pointer */
     GUI_Color_t* Colors;                    /*!< Pointer to allocated color memory when used */
+    struct GUI_DRAW_TEXTRUN_t* TextRun;     /*!< Pre-decoded widget text when \ref GUI_USE_TEXT_RUN is enabled */
+    uint16_t TextID;                        /*!< String ID of widget text when \ref GUI_FLAG_TEXTID flag is set */
     void* UserData;                         /*!< Pointer to optional user data */
 } GUI_HANDLE;
 
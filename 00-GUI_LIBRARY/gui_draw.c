@@ -25,24 +25,56 @@
  */
 #define GUI_INTERNAL
 #include "gui_draw.h"
+#include "gui_pipeline.h"
 
 /******************************************************************************/
 /******************************************************************************/
 /***                           Private structures                            **/
 /******************************************************************************/
 /******************************************************************************/
+/* Position in string, characters are read from pre-decoded run when available */
+typedef struct __GUI_TextPos_t {
+    const GUI_Char* Str;                    /* Pointer to next character in string */
+    const GUI_DRAW_TEXTRUN_t* Run;          /* Pre-decoded string or NULL */
+    uint32_t Index;                         /* Index of next character in run */
+} __GUI_TextPos_t;
+
+/* Half-plane of points with Nx * x + Ny * y >= Min, relative to arc center */
+typedef struct __GUI_ArcHalfPlane_t {
+    int32_t Nx;                             /* X component of normal vector */
+    int32_t Ny;                             /* Y component of normal vector */
+    int32_t Min;                            /* Minimal distance along normal, 1 excludes points on the line */
+} __GUI_ArcHalfPlane_t;
+
+/* Pixel blending of anti-aliased primitive, prepared once instead of reading context for each pixel */
+typedef struct __GUI_AA_t {
+    GUI_LCD_t* LCD;                         /* LCD of current context */
+    GUI_LL_t* LL;                           /* Low-level driver of current context */
+    void (*Blend)(GUI_LCD_t *, uint8_t, GUI_Dim_t, GUI_Dim_t, GUI_Color_t);  /* Driver blending function or NULL */
+    uint8_t Layer;                          /* Drawing layer */
+    uint32_t Alpha;                         /* Alpha of color */
+    GUI_Color_t Color;                      /* Color without alpha */
+} __GUI_AA_t;
 
 /******************************************************************************/
 /******************************************************************************/
 /***                           Private definitions                           **/
 /******************************************************************************/
 /******************************************************************************/
+#define __IMAGE_CHUNK_SIZE          32      /* Number of pixels decoded at a time for compressed images */
+#define __TEXT_LAYOUT_FLAGS         (GUI_FLAG_FONT_MULTILINE | GUI_FLAG_FONT_RIGHTALIGN)    /* Drawing flags which affect measured lines */
 
 /******************************************************************************/
 /******************************************************************************/
 /***                            Private variables                            **/
 /******************************************************************************/
 /******************************************************************************/
+/* Caches and buffers are part of GUI context, contexts may be drawn in parallel */
+#define ImageCache                  (GUI.Draw.ImageCache)
+#define ImageCacheSize              (GUI.Draw.ImageCacheSize)
+#define ImageCacheCounter           (GUI.Draw.ImageCacheCounter)
+#define FallbackCache               (GUI.Draw.FallbackCache)
+#define StrokeBand                  (GUI.Draw.StrokeBand)
 
 /******************************************************************************/
 /******************************************************************************/
@@ -51,40 +83,89 @@
 /******************************************************************************/
 static
 const GUI_FONT_CharInfo_t* __StringGetCharPtr(const GUI_FONT_t* font, uint32_t ch) {
+#if GUI_USE_FONT_FALLBACK
+    const GUI_FONT_t* f;
+    __GUI_FONT_FallbackEntry_t* e;
+#endif /* GUI_USE_FONT_FALLBACK */
+    
     if (ch >= font->StartChar && ch <= font->EndChar) { /* Character is in font structure */
         return &font->Data[(ch) - font->StartChar]; /* Return character pointer from font */
-    } else if ('?' >= font->StartChar && '?' <= font->EndChar) {    /* Try to return ? character */
+    }
+#if GUI_USE_FONT_FALLBACK
+    if (font->Fallback) {                           /* Search fallback fonts */
+        e = &FallbackCache[ch % GUI_FONT_FALLBACK_CACHE_SIZE];
+        if (e->Font == font && e->Ch == ch) {       /* Character was resolved before */
+            return e->Glyph;
+        }
+        e->Font = font;
+        e->Ch = ch;
+        for (f = font->Fallback; f; f = f->Fallback) {  /* Take first font in chain with character */
+            if (ch >= f->StartChar && ch <= f->EndChar) {
+                e->Glyph = &f->Data[ch - f->StartChar];
+                return e->Glyph;
+            }
+        }
+        e->Glyph = '?' >= font->StartChar && '?' <= font->EndChar ? &font->Data['?' - font->StartChar] : 0;
+        return e->Glyph;
+    }
+#endif /* GUI_USE_FONT_FALLBACK */
+    if ('?' >= font->StartChar && '?' <= font->EndChar) {  /* Try to return ? character */
         return &font->Data['?' - font->StartChar];  /* Get pointer of ? character */
     }
     return 0;                                       /* No character in font */
 }
 
+#if GUI_USE_FONT_FALLBACK
+/* Get font in fallback chain which glyph belongs to */
 static
-void __StringGetCharSize(const GUI_FONT_t* font, uint32_t ch, GUI_iDim_t* width, GUI_iDim_t* height) {
-    const GUI_FONT_CharInfo_t* c = 0;
+const GUI_FONT_t* __StringGetGlyphFont(const GUI_FONT_t* font, const GUI_FONT_CharInfo_t* c) {
+    const GUI_FONT_t* f;
     
-    c = __StringGetCharPtr(font, ch);
-    if (c) {
-        *width = c->xSize + c->xMargin;
-        *height = c->ySize;
-    } else {
-        *width = 0;
-        *height = 0;
+    for (f = font; f; f = f->Fallback) {
+        if (c >= f->Data && c <= &f->Data[f->EndChar - f->StartChar]) {
+            return f;
+        }
+    }
+    return font;
+}
+#endif /* GUI_USE_FONT_FALLBACK */
+
+/* Get character width including margin */
+static
+GUI_iDim_t __StringGetCharWidth(const GUI_FONT_CharInfo_t* c) {
+    return c ? c->xSize + c->xMargin : 0;
+}
+
+/* Get next character and its glyph from string or pre-decoded run */
+static
+uint8_t __StringGetCh(const GUI_FONT_t* font, __GUI_TextPos_t* pos, uint32_t* ch, const GUI_FONT_CharInfo_t** c) {
+    if (pos->Run) {                                 /* Characters are already decoded */
+        if (pos->Index >= pos->Run->Count) {
+            return 0;
+        }
+        *ch = pos->Run->Ch[pos->Index];
+        *c = pos->Run->Glyph[pos->Index++];
+        return 1;
     }
+    if (!GUI_STRING_GetCh(&pos->Str, ch, NULL)) {   /* Decode next character */
+        return 0;
+    }
+    *c = __StringGetCharPtr(font, *ch);
+    return 1;
 }
 
 /* Get string rectangle width and height */
 static
-uint16_t __StringRectangle(const GUI_FONT_t* font, const GUI_Char* str, const GUI_DRAW_FONT_t* draw, GUI_iDim_t* width, GUI_iDim_t* height, uint8_t onlyToNextLine) {
-    GUI_iDim_t w, h, mW = 0, cW = 0, cH = 0;
+uint16_t __StringRectangle(const GUI_FONT_t* font, const __GUI_TextPos_t* pos, const GUI_DRAW_FONT_t* draw, GUI_iDim_t* width, GUI_iDim_t* height, uint8_t onlyToNextLine) {
+    GUI_iDim_t w, mW = 0, cW = 0, cH = 0;
     uint32_t ch;
-    uint8_t i;
-    const GUI_Char* s = str;
+    const GUI_FONT_CharInfo_t* c;
+    __GUI_TextPos_t p = *pos;                       /* Measure from copy of position */
     uint16_t cnt = 0;
     
     cH = draw->LineHeight;
     if (draw->Flags & GUI_FLAG_FONT_MULTILINE) {    /* We want to know exact rectangle for drawing multi line texts including new lines and carriage return */
-        while (GUI_STRING_GetCh(&s, &ch, &i)) {     /* Get next character from string */
+        while (__StringGetCh(font, &p, &ch, &c)) {  /* Get next character from string */
             if ((uint8_t)'\r' == (uint8_t)ch || (uint8_t)'\n' == (uint8_t)ch) { /* CR is for reset X value */
                 if (mW < cW) {                      /* Current width check */
                     mW = cW;                        /* Save as max width currently */
@@ -103,7 +184,7 @@ uint16_t __StringRectangle(const GUI_FONT_t* font, const GUI_Char* str, const GU
                 continue;
             }
             
-            __StringGetCharSize(font, ch, &w, &h);  /* Get character width and height */
+            w = __StringGetCharWidth(c);            /* Get character width */
             if (cW + w < draw->Width) {             /* Check if in range */
                 cW += w;                            /* Increase X position */
             } else {
@@ -125,11 +206,10 @@ uint16_t __StringRectangle(const GUI_FONT_t* font, const GUI_Char* str, const GU
             *width = mW;
         }
     } else {
-        while (GUI_STRING_GetCh(&s, &ch, &i)) {     /* Get next character from string */
+        while (__StringGetCh(font, &p, &ch, &c)) {  /* Get next character from string */
             cnt++;
-            __StringGetCharSize(font, ch, &w, &h);  /* Get character width and height */
             if ((uint8_t)'\r' != (uint8_t)ch && (uint8_t)'\n' != (uint8_t)ch) {
-                cW += w;                        /* Increase width */
+                cW += __StringGetCharWidth(c);  /* Increase width */
             }
         }
         if (width) {
@@ -149,12 +229,52 @@ void __DRAW_Char(const GUI_Display_t* disp, const GUI_FONT_t* font, GUI_DRAW_FON
     GUI_iDim_t x1;
     GUI_iByte k;
     GUI_Byte columns;
+    const GUI_Byte* data = font->Base ? font->Base + (uintptr_t)c->Data : c->Data;  /* Pointer to character bitmap */
+    
+#if GUI_USE_FONT_CACHE
+    if (font->Ext) {                                /* Bitmap is in external storage */
+        if ((data = __GUI_FONTCACHE_GetData(font, c)) == 0) {   /* Get bitmap from cache */
+            return;
+        }
+    }
+#endif /* GUI_USE_FONT_CACHE */
     
     y += c->yPos;                                   /* Set Y position */
     
-    if (font->Flags & GUI_FLAG_FONT_AA) {           /* Font has anti alliasing enabled */
+    if (font->Flags & (GUI_FLAG_FONT_AA4 | GUI_FLAG_FONT_AA8)) {    /* Alpha-only glyph is blended as single image */
+        GUI_IMAGE_DESC_t img = {0};
+        GUI_Display_t d = *disp;
+        GUI_iDim_t split = draw->X + draw->Color1Width;
+    
+        if (font->Flags & GUI_FLAG_FONT_AA8) {
+            img.Format = GUI_IMAGE_FORMAT_A8;
+            img.Width = c->xSize;
+        } else {
+            img.Format = GUI_IMAGE_FORMAT_A4;
+            img.Width = (c->xSize + 1) & ~0x01;     /* Padding nibble is transparent and keeps lines byte aligned for DMA2D */
+        }
+        img.Height = c->ySize;
+        img.Data = data;
+    
+        if (d.Y2 > (draw->Y + draw->Height)) {      /* Do not draw outside text rectangle */
+            d.Y2 = draw->Y + draw->Height;
+        }
+        if (x < split) {                            /* Part with first color */
+            d.X2 = __GUI_MIN(disp->X2, split);
+            if (d.X1 < d.X2) {
+                GUI_DRAW_Image(&d, x, y, &img, draw->Color1);
+            }
+        }
+        if ((x + img.Width) > split) {              /* Part with second color */
+            d.X1 = __GUI_MAX(disp->X1, split);
+            d.X2 = disp->X2;
+            if (d.X1 < d.X2) {
+                GUI_DRAW_Image(&d, x, y, &img, draw->Color2);
+            }
+        }
+    } else if (font->Flags & GUI_FLAG_FONT_AA) {    /* Font has anti alliasing enabled */
         GUI_Color_t color;                          /* Temporary color for AA */
-        GUI_Byte tmp, r1, g1, b1;
+        GUI_Byte tmp;
         
         columns = c->xSize / 4;                     /* Calculate number of bytes used for single character line */
         if (c->xSize % 4) {                         /* If only 1 column used */
@@ -163,7 +283,7 @@ void __DRAW_Char(const GUI_Display_t* disp, const GUI_FONT_t* font, GUI_DRAW_FON
         
         for (i = 0; i < columns * c->ySize; i++) {  /* Go through all data bytes */
             if (y >= disp->Y1 && y <= disp->Y2 && y < (draw->Y + draw->Height)) {   /* Do not draw when we are outside clipping are */            
-                b = c->Data[i];                     /* Get character byte */
+                b = data[i];                        /* Get character byte */
                 for (k = 0; k < 4; k++) {           /* Scan each bit in byte */
                     GUI_Color_t baseColor;
                     x1 = x + (i % columns) * 4 + k; /* Get new X value for pixel draw */
@@ -179,16 +299,18 @@ void __DRAW_Char(const GUI_Display_t* disp, const GUI_FONT_t* font, GUI_DRAW_FON
                     if (tmp == 0x03) {              /* Draw solid color if both bits are enabled */
                         GUI_DRAW_SetPixel(disp, x1, y, baseColor);
                     } else if (tmp) {               /* Calculate new color */
-                        float t = (float)tmp / 3.0f;
+#if GUI_USE_PIPELINE
+                        if (GUI.Pipeline) {         /* Mix when rasterized, reading screen while recording waits for rasterization */
+                            if (y < disp->Y2 && x1 < disp->X2) {
+                                __GUI_PIPELINE_MixPixel(x1, y, baseColor, tmp);
+                            }
+                            continue;
+                        }
+#endif /* GUI_USE_PIPELINE */
                         color = GUI_DRAW_GetPixel(disp, x1, y); /* Read current color */
                         
-                        /* Calculate new values for pixel */
-                        r1 = (float)t * (float)((color >> 16) & 0xFF) + (float)(1.0f - (float)t) * (float)((baseColor >> 16) & 0xFF);
-                        g1 = (float)t * (float)((color >>  8) & 0xFF) + (float)(1.0f - (float)t) * (float)((baseColor >>  8) & 0xFF);
-                        b1 = (float)t * (float)((color >>  0) & 0xFF) + (float)(1.0f - (float)t) * (float)((baseColor >>  0) & 0xFF);
-                        
                         /* Draw actual pixel to screen */
-                        GUI_DRAW_SetPixel(disp, x1, y, (color & 0xFF000000UL) | r1 << 16 | g1 << 8 | b1);
+                        GUI_DRAW_SetPixel(disp, x1, y, __GUI_DRAW_AAColor(color, baseColor, tmp));
                     }
                 }
             }
@@ -203,7 +325,7 @@ void __DRAW_Char(const GUI_Display_t* disp, const GUI_FONT_t* font, GUI_DRAW_FON
         }
         for (i = 0; i < columns * c->ySize; i++) {  /* Go through all data bytes */
             if (y >= disp->Y1 && y <= disp->Y2 && y < (draw->Y + draw->Height)) {   /* Do not draw when we are outside clipping are */
-                b = c->Data[i];                     /* Get character byte */
+                b = data[i];                        /* Get character byte */
                 for (k = 0; k < 8; k++) {           /* Scan each bit in byte */
                     if (b & (1 << (7 - k))) {       /* If bit is set, draw pixel */
                         x1 = x + (i % columns) * 8 + k; /* Get new X value for pixel draw */
@@ -225,22 +347,37 @@ void __DRAW_Char(const GUI_Display_t* disp, const GUI_FONT_t* font, GUI_DRAW_FON
     }
 }
 
-const GUI_Char* __StringGetPointerForWidth(const GUI_FONT_t* font, const GUI_Char* str, GUI_DRAW_FONT_t* draw) {
-    const GUI_Char* tmp = str;
-    GUI_iDim_t tot = 0, w, h;
+/* Move position to first character of string end which fits to drawing width */
+static
+void __StringGetPointerForWidth(const GUI_FONT_t* font, __GUI_TextPos_t* pos, GUI_DRAW_FONT_t* draw) {
+    const GUI_Char* tmp = pos->Str;
+    GUI_iDim_t tot = 0, w;
     uint8_t i;
-    uint32_t ch;
+    uint32_t ch, index;
+    
+    if (pos->Run) {                                 /* Go back through decoded characters */
+        for (index = pos->Run->Count; index > pos->Index; index--) {
+            w = __StringGetCharWidth(pos->Run->Glyph[index - 1]);
+            if ((tot + w) < draw->Width) {
+                tot += w;
+            } else {
+                draw->X += draw->Width - tot;       /* Add X position to align right */
+                break;
+            }
+        }
+        pos->Index = index;
+        return;
+    }
     
-    //TODO: UTF-8 support!
     while (*tmp) {                                  /* Go to the end of string */
         tmp++;
     }
     tmp--;                                          /* Go to the last character */
-    while (str <= tmp) {
+    while (pos->Str <= tmp) {
         if (!GUI_STRING_GetChReverse(&tmp, &ch, &i)) {  /* Get character in reverse order */
             break;
         }
-        __StringGetCharSize(font, ch, &w, &h);
+        w = __StringGetCharWidth(__StringGetCharPtr(font, ch));
         if ((tot + w) < draw->Width) {
             tot += w;
         } else {
@@ -248,8 +385,637 @@ const GUI_Char* __StringGetPointerForWidth(const GUI_FONT_t* font, const GUI_Cha
             break;
         }
     }
-    return tmp + i + 1;
+    pos->Str = tmp + i + 1;
+}
+
+/* Measure lines of text run for text rectangle, layout memory is allocated again when number of lines changes */
+static
+GUI_DRAW_TEXTLAYOUT_t* __TextLayoutMeasure(const GUI_DRAW_TEXTRUN_t* run, GUI_DRAW_TEXTLAYOUT_t* l, GUI_iDim_t width, GUI_Dim_t lineHeight, GUI_Byte flags) {
+    GUI_DRAW_FONT_t draw;
+    __GUI_TextPos_t pos;
+    GUI_iDim_t w, h;
+    uint16_t cnt, n = 0;
+    
+    GUI_DRAW_FONT_Init(&draw);                      /* Rectangle parameters used for measurement */
+    draw.Width = width;
+    draw.LineHeight = lineHeight;
+    draw.Flags = flags;
+    pos.Str = run->Text;
+    pos.Run = run;
+    pos.Index = 0;
+    
+    __StringRectangle(run->Font, &pos, &draw, &w, &h, 0);   /* Get string height for this box */
+    if (!(w > width && (flags & GUI_FLAG_FONT_RIGHTALIGN))) {   /* Right aligned overflow depends on string end, measure it while drawing */
+        while ((cnt = __StringRectangle(run->Font, &pos, &draw, &w, NULL, 1)) > 0) {    /* Count lines first */
+            pos.Index += cnt;
+            n++;
+            if (!(flags & GUI_FLAG_FONT_MULTILINE)) {
+                break;
+            }
+        }
+    }
+    
+    if (!l || l->Count != n) {                      /* Allocate memory for new number of lines */
+        __GUI_MEMFREE(l);
+        l = (GUI_DRAW_TEXTLAYOUT_t *)__GUI_MEMALLOC(sizeof(*l) + n * (sizeof(*l->Widths) + sizeof(*l->Chars)), GUI_MEM_TYPE_TEXT);
+        if (!l) {
+            return 0;
+        }
+        l->Widths = (GUI_iDim_t *)(l + 1);          /* Widths are after structure */
+        l->Chars = (uint16_t *)(l->Widths + n);     /* Characters are after widths */
+    }
+    l->Width = width;
+    l->LineHeight = lineHeight;
+    l->Flags = flags;
+    l->TextHeight = h;
+    l->Count = n;
+    
+    pos.Index = 0;
+    for (n = 0; n < l->Count; n++) {                /* Save lines */
+        l->Chars[n] = __StringRectangle(run->Font, &pos, &draw, &l->Widths[n], NULL, 1);
+        pos.Index += l->Chars[n];
+    }
+    return l;
+}
+
+/* Get measured lines of text run for drawing rectangle, measure them when rectangle is new */
+static
+const GUI_DRAW_TEXTLAYOUT_t* __TextLayoutGet(GUI_DRAW_TEXTRUN_t* run, const GUI_DRAW_FONT_t* draw) {
+    GUI_DRAW_TEXTLAYOUT_t* l;
+    GUI_Byte flags = draw->Flags & __TEXT_LAYOUT_FLAGS;
+    uint8_t i;
+    
+    for (i = 0; i < GUI_TEXT_RUN_LAYOUTS; i++) {    /* Search for rectangle measured before */
+        l = run->Layouts[i];
+        if (l && l->Width == draw->Width && l->LineHeight == draw->LineHeight && l->Flags == flags) {
+            return l->Count ? l : 0;
+        }
+    }
+    
+    i = run->LayoutNext;                            /* Replace oldest layout */
+    run->LayoutNext = (i + 1) % GUI_TEXT_RUN_LAYOUTS;
+    l = run->Layouts[i] = __TextLayoutMeasure(run, run->Layouts[i], draw->Width, draw->LineHeight, flags);
+    return (l && l->Count) ? l : 0;
+}
+
+/* Get number of characters and width of next line to draw */
+static
+uint16_t __StringGetLine(const GUI_FONT_t* font, const __GUI_TextPos_t* pos, const GUI_DRAW_FONT_t* draw, const GUI_DRAW_TEXTLAYOUT_t* layout, uint16_t line, GUI_iDim_t* width) {
+    if (layout) {                                   /* Lines are already measured */
+        if (line >= layout->Count) {
+            return 0;
+        }
+        *width = layout->Widths[line];
+        return layout->Chars[line];
+    }
+    return __StringRectangle(font, pos, draw, width, NULL, 1);
+}
+
+/* Divide and round result towards negative infinity, divider must be positive */
+static
+int32_t __DivFloor(int32_t a, int32_t b) {
+    return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+
+/* Set half-planes of sector from start angle to end angle without end, sector must not be wider than 180 degrees */
+static
+void __ArcSector(__GUI_ArcHalfPlane_t* hp, int32_t start, int32_t end) {
+    hp[0].Nx = -GUI_MATH_SinDeg(start);             /* Points clockwise from start direction */
+    hp[0].Ny = GUI_MATH_CosDeg(start);
+    hp[0].Min = 0;
+    hp[1].Nx = GUI_MATH_SinDeg(end);                /* Points counter-clockwise from end direction */
+    hp[1].Ny = -GUI_MATH_CosDeg(end);
+    hp[1].Min = 1;
+}
+
+/* Limit span on scanline to pixels inside half-plane */
+/* Pixels are tested at quarter of pixel from their top left corner, so center pixel is in exactly one of adjacent sectors */
+static
+void __ArcClipSpan(const __GUI_ArcHalfPlane_t* hp, GUI_iDim_t dy, GUI_iDim_t* x1, GUI_iDim_t* x2) {
+    int32_t c = hp->Min - hp->Nx - hp->Ny * (4 * dy + 1), lim;
+    
+    if (hp->Nx > 0) {                               /* Left end of half-plane on scanline */
+        lim = -__DivFloor(-c, 4 * hp->Nx);
+        if (*x1 < lim) {
+            *x1 = lim;
+        }
+    } else if (hp->Nx < 0) {                        /* Right end of half-plane on scanline */
+        lim = __DivFloor(-c, -4 * hp->Nx);
+        if (*x2 > lim) {
+            *x2 = lim;
+        }
+    } else if (c > 0) {                             /* Scanline is outside horizontal half-plane */
+        *x2 = *x1 - 1;
+    }
+}
+
+/* Draw span of arc on single scanline, clipped to angular sectors */
+static
+void __ArcSpan(const GUI_Display_t* disp, GUI_iDim_t x, GUI_iDim_t y, GUI_iDim_t dy, GUI_iDim_t x1, GUI_iDim_t x2, const __GUI_ArcHalfPlane_t* hp, uint8_t sectors, GUI_Color_t color) {
+    GUI_iDim_t sx1, sx2;
+    uint8_t i;
+    
+    if (!sectors) {                                 /* Full circle */
+        GUI_DRAW_HLine(disp, x + x1, y + dy, x2 - x1 + 1, color);
+        return;
+    }
+    for (i = 0; i < sectors; i++, hp += 2) {        /* Sectors do not overlap, each pixel is drawn once */
+        sx1 = x1;
+        sx2 = x2;
+        __ArcClipSpan(&hp[0], dy, &sx1, &sx2);
+        __ArcClipSpan(&hp[1], dy, &sx1, &sx2);
+        if (sx1 <= sx2) {
+            GUI_DRAW_HLine(disp, x + sx1, y + dy, sx2 - sx1 + 1, color);
+        }
+    }
+}
+
+/* Draw part of ring between radius r and inner radius rIn with horizontal spans, rIn < 0 draws pie */
+static
+void __DrawArc(const GUI_Display_t* disp, GUI_iDim_t x, GUI_iDim_t y, GUI_iDim_t r, GUI_iDim_t rIn, int16_t startAngle, int16_t endAngle, GUI_Color_t color) {
+    __GUI_ArcHalfPlane_t hp[4];
+    uint8_t sectors = 0, k;
+    int32_t sweep = (int32_t)endAngle - (int32_t)startAngle;
+    int32_t lim = r * r + r, limIn = rIn * rIn + rIn;  /* Pixel is inside circle when x^2 + y^2 <= r^2 + r */
+    GUI_iDim_t dy, row, xo = r, xi = rIn;
+    
+    if (r < 0 || !sweep) {
+        return;
+    }
+    if (sweep > -360 && sweep < 360) {              /* Angular limits are needed */
+        sweep %= 360;
+        if (sweep < 0) {
+            sweep += 360;
+        }
+        if (sweep <= 180) {
+            __ArcSector(&hp[0], startAngle, startAngle + sweep);
+            sectors = 1;
+        } else {                                    /* Split to 2 sectors, each up to 180 degrees */
+            __ArcSector(&hp[0], startAngle, startAngle + 180);
+            __ArcSector(&hp[2], startAngle + 180, startAngle + sweep);
+            sectors = 2;
+        }
+    }
+    
+    /**
+     * Go from center to top and bottom and
+     * get outer and inner span edges for each scanline
+     */
+    for (dy = 0; dy <= r; dy++) {
+        while (xo >= 0 && (xo * xo + dy * dy) > lim) {
+            xo--;
+        }
+        if (rIn >= 0 && dy <= rIn) {
+            while (xi >= 0 && (xi * xi + dy * dy) > limIn) {
+                xi--;
+            }
+        } else {
+            xi = -1;
+        }
+        for (k = 0; k < (dy ? 2 : 1); k++) {        /* Scanline below and above center */
+            row = k ? -dy : dy;
+            if ((y + row) < disp->Y1 || (y + row) >= disp->Y2) {
+                continue;
+            }
+            if (xi >= 0) {                          /* Left and right part of ring */
+                __ArcSpan(disp, x, y, row, -xo, -xi - 1, hp, sectors, color);
+                __ArcSpan(disp, x, y, row, xi + 1, xo, hp, sectors, color);
+            } else {
+                __ArcSpan(disp, x, y, row, -xo, xo, hp, sectors, color);
+            }
+        }
+    }
+}
+
+/* Prepare pixel blending of anti-aliased primitive with color */
+static
+void __AAInit(__GUI_AA_t* aa, GUI_Color_t color) {
+    aa->LCD = &GUI.LCD;
+    aa->LL = &GUI.LL;
+    aa->Blend = GUI.LL.BlendPixel;
+    aa->Layer = GUI.LCD.DrawingLayer;
+    aa->Alpha = color >> 24;
+    aa->Color = color & 0x00FFFFFFUL;
+}
+
+/* Blend color with 8-bit coverage to pixel, pixel must be inside clipping region */
+static
+void __BlendPixel(const __GUI_AA_t* aa, GUI_iDim_t x, GUI_iDim_t y, uint32_t coverage) {
+    if (aa->Alpha != 0xFF) {                        /* Multiply with color alpha */
+        coverage = coverage * aa->Alpha + 0x80;
+        coverage = (coverage + (coverage >> 8)) >> 8;
+    }
+    if (coverage == 0xFF) {                         /* Fully covered pixel needs no background */
+        aa->LL->SetPixel(aa->LCD, aa->Layer, x, y, aa->Color | 0xFF000000UL);
+    } else if (coverage) {
+        if (aa->Blend) {                            /* Call driver directly, most of pixels are blended */
+            aa->Blend(aa->LCD, aa->Layer, x, y, aa->Color | (coverage << 24));
+        } else {
+            __GUI_DRAW_BlendPixel(aa->LCD, aa->LL, aa->Layer, x, y, aa->Color | (coverage << 24));
+        }
+    }
+}
+
+/* Blend pixel in all 4 corners of rectangle, clipping region is NULL when all pixels are known to be visible */
+static
+void __BlendCorners(const __GUI_AA_t* aa, const GUI_Display_t* clip, GUI_iDim_t x1, GUI_iDim_t y1, GUI_iDim_t x2, GUI_iDim_t y2, GUI_iDim_t dx, GUI_iDim_t dy, uint32_t coverage) {
+    if (!clip) {                                    /* Fully visible, no test for each pixel */
+        __BlendPixel(aa, x1 - dx, y1 - dy, coverage);
+        __BlendPixel(aa, x2 + dx, y1 - dy, coverage);
+        __BlendPixel(aa, x1 - dx, y2 + dy, coverage);
+        __BlendPixel(aa, x2 + dx, y2 + dy, coverage);
+        return;
+    }
+    if ((y1 - dy) >= clip->Y1 && (y1 - dy) < clip->Y2) {
+        if ((x1 - dx) >= clip->X1 && (x1 - dx) < clip->X2) {
+            __BlendPixel(aa, x1 - dx, y1 - dy, coverage);
+        }
+        if ((x2 + dx) >= clip->X1 && (x2 + dx) < clip->X2) {
+            __BlendPixel(aa, x2 + dx, y1 - dy, coverage);
+        }
+    }
+    if ((y2 + dy) >= clip->Y1 && (y2 + dy) < clip->Y2) {
+        if ((x1 - dx) >= clip->X1 && (x1 - dx) < clip->X2) {
+            __BlendPixel(aa, x1 - dx, y2 + dy, coverage);
+        }
+        if ((x2 + dx) >= clip->X1 && (x2 + dx) < clip->X2) {
+            __BlendPixel(aa, x2 + dx, y2 + dy, coverage);
+        }
+    }
+}
+
+/**
+ * Draw anti-aliased edges of 4 circle corners with centers in corners of rectangle x1, y1, x2, y2.
+ * Edge is at exact distance r from center, coverage of pixels is interpolated between squares of their distances.
+ * Pixels on axes of corners are not drawn, they are part of straight rectangle edges.
+ * When filled, only pixels outside radius are drawn, inner part is filled with lines by caller
+ */
+static
+void __CornersAA(const GUI_Display_t* disp, GUI_iDim_t x1, GUI_iDim_t y1, GUI_iDim_t x2, GUI_iDim_t y2, GUI_iDim_t r, GUI_Color_t color, uint8_t filled) {
+    const GUI_Display_t* clip = disp;
+    __GUI_AA_t aa;
+    int32_t x, y = r, t, f;
+    
+    if (!__GUI_RECT_MATCH(
+        disp->X1, disp->Y1, disp->X2, disp->Y2,
+        x1 - r, y1 - r, x2 + r, y2 + r
+    )) {
+        return;
+    }
+    if ((x1 - r) >= disp->X1 && (x2 + r) < disp->X2 && (y1 - r) >= disp->Y1 && (y2 + r) < disp->Y2) {
+        clip = NULL;                                /* Shape is fully visible, no need to clip each pixel */
+    }
+    __AAInit(&aa, color);
+    
+    /**
+     * Go through first octant where edge is more horizontal than vertical,
+     * second octant is drawn with swapped coordinates
+     */
+    for (x = 1; ; x++) {
+        t = (int32_t)r * r - x * x;                 /* Square of exact edge height */
+        while (y * y > t) {
+            y--;
+        }
+        if (x > y) {
+            break;
+        }
+        f = ((t - y * y) * 255 + y) / (2 * y + 1);  /* Coverage of outer pixel */
+        if (!filled) {                              /* Inner pixel of 1 pixel wide edge */
+            __BlendCorners(&aa, clip, x1, y1, x2, y2, x, y, 255 - f);
+            if (x != y) {
+                __BlendCorners(&aa, clip, x1, y1, x2, y2, y, x, 255 - f);
+            }
+        }
+        if (f) {                                    /* Outer pixel */
+            __BlendCorners(&aa, clip, x1, y1, x2, y2, x, y + 1, f);
+            __BlendCorners(&aa, clip, x1, y1, x2, y2, y + 1, x, f);
+        }
+    }
+}
+
+/* Add span of pixels to scanline of band, spans are kept sorted and touching spans are merged */
+static
+void __StrokeSpan(__GUI_StrokeBand_t* b, GUI_iDim_t row, int32_t x1, int32_t x2) {
+    GUI_iDim_t (*s)[2] = b->Span[row];
+    uint8_t i, k, n = b->Count[row];
+    
+    x1 = __GUI_MAX(x1, b->Disp->X1);                /* Clip span to display region */
+    x2 = __GUI_MIN(x2, b->Disp->X2);
+    if (x1 >= x2) {
+        return;
+    }
+    for (i = 0; i < n && s[i][1] < x1; i++);       /* Find first span which is not left of new span */
+    for (k = i; k < n && s[k][0] <= x2; k++) {      /* Merge all spans touching new span */
+        x1 = __GUI_MIN(x1, s[k][0]);
+        x2 = __GUI_MAX(x2, s[k][1]);
+    }
+    if (k == i) {                                   /* Nothing to merge, insert new span */
+        if (n == __STROKE_BAND_SPANS) {             /* No more space on scanline, draw span directly */
+            GUI_DRAW_HLine(b->Disp, x1, b->Y + row, x2 - x1, b->Color);
+            return;
+        }
+        memmove(&s[i + 1], &s[i], (n - i) * sizeof(s[0]));
+        n++;
+    } else if (k > i + 1) {                         /* Remove spans merged to first one */
+        memmove(&s[i + 1], &s[k], (n - k) * sizeof(s[0]));
+        n -= k - i - 1;
+    }
+    s[i][0] = x1;
+    s[i][1] = x2;
+    b->Count[row] = n;
+}
+
+/**
+ * Add convex polygon with coordinates in 24.8 fixed point to band.
+ * Pixel is covered when its center is inside, centers on left and top edges are inside, on right and bottom edges outside
+ */
+static
+void __StrokePoly(__GUI_StrokeBand_t* b, const int32_t* px, const int32_t* py, uint8_t count) {
+    int32_t yMin = py[0], yMax = py[0], y, x, xl, xr, r1, r2;
+    uint8_t i, k;
+    
+    for (i = 1; i < count; i++) {
+        yMin = __GUI_MIN(yMin, py[i]);
+        yMax = __GUI_MAX(yMax, py[i]);
+    }
+    r1 = __GUI_MAX(__DivFloor(yMin + 255, 256), b->Y) - b->Y;  /* First and last scanline of band inside polygon */
+    r2 = __GUI_MIN(__DivFloor(yMax + 255, 256), b->Y + b->Rows) - b->Y;
+    for (; r1 < r2; r1++) {
+        y = (int32_t)(b->Y + r1) << 8;              /* Center of pixels on scanline */
+        xl = INT32_MAX;
+        xr = INT32_MIN;
+        for (i = 0; i < count; i++) {               /* Find left and right edge on scanline */
+            k = i + 1 < count ? i + 1 : 0;
+            if ((py[i] <= y && y < py[k]) || (py[k] <= y && y < py[i])) {
+                x = px[i] + (int32_t)((int64_t)(y - py[i]) * (px[k] - px[i]) / (py[k] - py[i]));
+                xl = __GUI_MIN(xl, x);
+                xr = __GUI_MAX(xr, x);
+            }
+        }
+        if (xl < xr) {
+            __StrokeSpan(b, r1, __DivFloor(xl + 255, 256), __DivFloor(xr + 255, 256));
+        }
+    }
+}
+
+/* Add disc with center and radius in 24.8 fixed point to band */
+static
+void __StrokeDisc(__GUI_StrokeBand_t* b, int32_t cx, int32_t cy, int32_t r) {
+    int32_t y, w, r1, r2;
+    
+    r1 = __GUI_MAX(__DivFloor(cy - r + 255, 256), b->Y) - b->Y;
+    r2 = __GUI_MIN(__DivFloor(cy + r + 255, 256), b->Y + b->Rows) - b->Y;
+    for (; r1 < r2; r1++) {
+        y = ((int32_t)(b->Y + r1) << 8) - cy;
+        w = GUI_MATH_SqrtInt((uint32_t)(r * r - y * y));    /* Half width of disc on scanline */
+        __StrokeSpan(b, r1, __DivFloor(cx - w + 255, 256), __DivFloor(cx + w + 255, 256));
+    }
+}
+
+/* Get normal of segment from a to b with length h, all in 24.8 fixed point */
+static
+void __StrokeNormal(const GUI_DRAW_Poly_t* a, const GUI_DRAW_Poly_t* b, int32_t h, int32_t* nx, int32_t* ny) {
+    int32_t dx = (int32_t)b->X - a->X, dy = (int32_t)b->Y - a->Y;
+    uint64_t q = ((uint64_t)((int64_t)dx * dx + (int64_t)dy * dy)) << 16;  /* Square of length in 48.16 */
+    uint32_t len;
+    uint8_t s = 0;
+    
+    while (q >> 32) {                               /* Scale down to fit square root input */
+        q >>= 2;
+        s++;
+    }
+    len = GUI_MATH_SqrtInt((uint32_t)q) << s;       /* Length of segment in 24.8 */
+    *nx = (int32_t)(-(int64_t)dy * h * 256 / len);
+    *ny = (int32_t)((int64_t)dx * h * 256 / len);
+}
+
+/* Add join at point p between segments with normals n1 and n2 with length h, normals and h are in 24.8 fixed point */
+static
+void __StrokeJoin(__GUI_StrokeBand_t* b, const GUI_DRAW_Poly_t* p, int32_t n1x, int32_t n1y, int32_t n2x, int32_t n2y, int32_t h, GUI_DRAW_JOIN_t join) {
+    int32_t px[4], py[4];
+    int64_t cross, hh, d;
+    
+    px[0] = (int32_t)p->X << 8;
+    py[0] = (int32_t)p->Y << 8;
+    if (join == GUI_DRAW_JOIN_ROUND) {
+        __StrokeDisc(b, px[0], py[0], h);
+        return;
+    }
+    cross = (int64_t)n1x * n2y - (int64_t)n1y * n2x;
+    if (!cross) {                                   /* Segments on the same line, no gap to fill */
+        return;
+    }
+    if (cross > 0) {                                /* Gap is on the side opposite to normals */
+        n1x = -n1x;
+        n1y = -n1y;
+        n2x = -n2x;
+        n2y = -n2y;
+    }
+    px[1] = px[0] + n1x;
+    py[1] = py[0] + n1y;
+    hh = (int64_t)h * h;
+    d = hh + (int64_t)n1x * n2x + (int64_t)n1y * n2y;
+    if (join == GUI_DRAW_JOIN_MITER && 8 * d >= hh) {   /* Miter tip is at most 4 half widths from point, longer become bevel */
+        px[2] = px[0] + (int32_t)((n1x + n2x) * hh / d);
+        py[2] = py[0] + (int32_t)((n1y + n2y) * hh / d);
+        px[3] = px[0] + n2x;
+        py[3] = py[0] + n2y;
+        __StrokePoly(b, px, py, 4);
+    } else {
+        px[2] = px[0] + n2x;
+        py[2] = py[0] + n2y;
+        __StrokePoly(b, px, py, 3);
+    }
+}
+
+/* Get number of bytes for single image line */
+static
+uint32_t __ImageGetLineSize(const GUI_IMAGE_DESC_t* img) {
+    switch (img->Format) {
+        case GUI_IMAGE_FORMAT_ARGB8888: return (uint32_t)img->Width * 4;
+        case GUI_IMAGE_FORMAT_RGB565:   return (uint32_t)img->Width * 2;
+        case GUI_IMAGE_FORMAT_A4:       return ((uint32_t)img->Width + 1) / 2;
+        default:                        return (uint32_t)img->Width;
+    }
+}
+
+/* Get ARGB8888 color of image pixel at X position in line */
+static
+GUI_Color_t __ImageGetPixel(const GUI_IMAGE_DESC_t* img, const GUI_Byte* line, GUI_iDim_t x, GUI_Color_t color) {
+    uint32_t a, p;
+    switch (img->Format) {
+        case GUI_IMAGE_FORMAT_ARGB8888:
+            return ((const uint32_t *)line)[x];
+        case GUI_IMAGE_FORMAT_RGB565:
+            p = (uint32_t)line[2 * x] | ((uint32_t)line[2 * x + 1] << 8);
+            return 0xFF000000UL | 
+                ((((p >> 11) & 0x1F) * 527 + 23) >> 6) << 16 |  /* Expand 5-bit red to 8-bit */
+                ((((p >>  5) & 0x3F) * 259 + 33) >> 6) <<  8 |  /* Expand 6-bit green to 8-bit */
+                ((((p >>  0) & 0x1F) * 527 + 23) >> 6);         /* Expand 5-bit blue to 8-bit */
+        case GUI_IMAGE_FORMAT_L8:
+            return line[x] < img->CLUTSize ? img->CLUT[line[x]] : 0;
+        case GUI_IMAGE_FORMAT_A8:
+            a = line[x];
+            break;
+        case GUI_IMAGE_FORMAT_A4:
+            a = (x & 1) ? (line[x >> 1] >> 4) : (line[x >> 1] & 0x0F);  /* First pixel is in low nibble */
+            a *= 0x11;                              /* Expand 4-bit alpha to 8-bit */
+            break;
+        default:
+            return 0;
+    }
+    a = (a * (color >> 24) + 0x80);                 /* Multiply with color alpha */
+    a = (a + (a >> 8)) >> 8;
+    return (color & 0x00FFFFFFUL) | (a << 24);
+}
+
+/* Blend foreground color with alpha over background color */
+static
+GUI_Color_t __BlendColor(GUI_Color_t fg, GUI_Color_t bg) {
+    uint32_t a = fg >> 24, ia = 255 - a, rb, g, oa;
+    
+    rb = (fg & 0x00FF00FFUL) * a + (bg & 0x00FF00FFUL) * ia + 0x00800080UL; /* Red and blue channel at the same time */
+    rb = ((rb + ((rb >> 8) & 0x00FF00FFUL)) >> 8) & 0x00FF00FFUL;
+    g = (fg & 0x0000FF00UL) * a + (bg & 0x0000FF00UL) * ia + 0x00008000UL;  /* Green channel */
+    g = ((g + ((g >> 8) & 0x0000FF00UL)) >> 8) & 0x0000FF00UL;
+    oa = a + (((bg >> 24) * ia + 0x80) * 257 >> 16);    /* Output alpha */
+    return (oa << 24) | rb | g;
+}
+
+/* Blend single color with A8 or A4 alpha mask, used for images and anti-aliased glyphs */
+static
+void __ImageAlphaSoftware(GUI_LCD_t* LCD, GUI_LL_t* LL, uint8_t layer, const GUI_IMAGE_DESC_t* img, const GUI_Byte* line, GUI_iDim_t x, GUI_iDim_t y, GUI_iDim_t xOff, GUI_iDim_t width, GUI_iDim_t height, GUI_Color_t color) {
+    uint32_t lineSize = __ImageGetLineSize(img), ca = color >> 24, a;
+    uint8_t a4 = img->Format == GUI_IMAGE_FORMAT_A4;
+    GUI_iDim_t i, k, px;
+    
+    for (i = 0; i < height; i++, line += lineSize) {
+        for (k = 0, px = xOff; k < width; k++, px++) {
+            if (a4) {
+                a = (px & 0x01) ? (line[px >> 1] >> 4) : (line[px >> 1] & 0x0F);  /* First pixel is in low nibble */
+                a *= 0x11;                          /* Expand 4-bit alpha to 8-bit */
+            } else {
+                a = line[px];
+            }
+            if (!a) {                               /* Most of glyph pixels are empty */
+                continue;
+            }
+            if (ca != 0xFF) {                       /* Multiply with color alpha */
+                a = a * ca + 0x80;
+                a = (a + (a >> 8)) >> 8;
+            }
+            if (a == 0xFF) {                        /* Opaque pixel needs no background */
+                LL->SetPixel(LCD, layer, x + k, y + i, color);
+            } else if (a) {
+                LL->SetPixel(LCD, layer, x + k, y + i, __BlendColor((color & 0x00FFFFFFUL) | (a << 24), LL->GetPixel(LCD, layer, x + k, y + i)));
+            }
+        }
+    }
+}
+
+/* Decode compressed image and draw it in chunks */
+static
+void __ImageDrawStream(const GUI_IMAGE_DESC_t* img, GUI_iDim_t x, GUI_iDim_t y, GUI_iDim_t xOff, GUI_iDim_t yOff, GUI_iDim_t width, GUI_iDim_t height, GUI_Color_t color) {
+    GUI_IMGDEC_t dec;
+    GUI_Color_t buff[__IMAGE_CHUNK_SIZE];
+    GUI_IMAGE_DESC_t chunk = {0};
+    GUI_iDim_t i, k, n;
+    
+    if (!GUI_IMGDEC_Init(&dec, img) ||
+        !GUI_IMGDEC_Skip(&dec, (uint32_t)img->Width * yOff)) {  /* Skip lines above clipping region */
+        return;
+    }
+    chunk.Height = 1;
+    chunk.Format = GUI_IMAGE_FORMAT_ARGB8888;
+    chunk.Data = (const GUI_Byte *)buff;
+    for (i = 0; i < height; i++) {                  /* Lines below clipping region are never decoded */
+        if (!GUI_IMGDEC_Skip(&dec, xOff)) {         /* Skip left part of line */
+            return;
+        }
+        for (k = 0; k < width; k += n) {
+            n = __GUI_MIN(width - k, __IMAGE_CHUNK_SIZE);
+            if (!GUI_IMGDEC_Read(&dec, buff, n)) {
+                return;
+            }
+            chunk.Width = n;
+            if (!GUI.LL.DrawImage || !GUI.LL.DrawImage(&GUI.LCD, GUI.LCD.DrawingLayer, &chunk, x + k, y + i, 0, 0, n, 1, color)) {
+                __GUI_DRAW_ImageSoftware(&GUI.LCD, &GUI.LL, GUI.LCD.DrawingLayer, &chunk, x + k, y + i, 0, 0, n, 1, color);
+            }
+        }
+        if (!GUI_IMGDEC_Skip(&dec, img->Width - xOff - width)) {    /* Skip right part of line */
+            return;
+        }
+    }
+}
+
+#if GUI_USE_IMAGE_CACHE
+/* Get image converted to ARGB8888 format from cache or convert it */
+static
+const GUI_IMAGE_DESC_t* __ImageCacheGet(const GUI_IMAGE_DESC_t* img) {
+    __GUI_IMAGE_CacheEntry_t* e = 0;
+    uint32_t size = (uint32_t)img->Width * (uint32_t)img->Height * 4, lineSize;
+    GUI_Color_t* data;
+    GUI_iDim_t i, k;
+    uint8_t n;
+    
+    for (n = 0; n < GUI_IMAGE_CACHE_ENTRIES; n++) { /* Search in cache */
+        if (ImageCache[n].Src == img) {
+            ImageCache[n].Used = ++ImageCacheCounter;
+            return &ImageCache[n].Img;
+        }
+    }
+    if (size > GUI_IMAGE_CACHE_SIZE) {              /* Image too big for cache */
+        return 0;
+    }
+    
+    /**
+     * Remove least recently used images until there is enough memory and free entry
+     */
+    while (1) {
+        e = 0;
+        for (n = 0; n < GUI_IMAGE_CACHE_ENTRIES; n++) {
+            if (!ImageCache[n].Src) {               /* Free entry */
+                e = &ImageCache[n];
+                break;
+            }
+        }
+        if (e && (ImageCacheSize + size) <= GUI_IMAGE_CACHE_SIZE) {
+            break;
+        }
+        e = &ImageCache[0];
+        for (n = 1; n < GUI_IMAGE_CACHE_ENTRIES; n++) { /* Find least recently used entry */
+            if (ImageCache[n].Src && (!e->Src || ImageCache[n].Used < e->Used)) {
+                e = &ImageCache[n];
+            }
+        }
+        ImageCacheSize -= e->Size;
+        __GUI_MEMFREE(e->Data);
+        e->Src = 0;
+    }
+    
+    data = (GUI_Color_t *)__GUI_MEMALLOC(size, GUI_MEM_TYPE_IMAGE);     /* Allocate memory for converted image */
+    if (!data) {
+        return 0;
+    }
+    lineSize = __ImageGetLineSize(img);
+    for (i = 0; i < img->Height; i++) {             /* Convert image to ARGB8888 */
+        for (k = 0; k < img->Width; k++) {
+            data[i * img->Width + k] = __ImageGetPixel(img, img->Data + i * lineSize, k, 0);
+        }
+    }
+    
+    e->Src = img;
+    e->Img.Width = img->Width;
+    e->Img.Height = img->Height;
+    e->Img.Format = GUI_IMAGE_FORMAT_ARGB8888;
+    e->Img.Data = (GUI_Byte *)data;
+    e->Data = data;
+    e->Size = size;
+    e->Used = ++ImageCacheCounter;
+    ImageCacheSize += size;
+    return &e->Img;
 }
+#endif /* GUI_USE_IMAGE_CACHE */
 
 /******************************************************************************/
 /******************************************************************************/
@@ -668,6 +1434,249 @@ void GUI_DRAW_FilledCircleCorner(const GUI_Display_t* disp, GUI_iDim_t x0, GUI_i
     }
 }
 
+void GUI_DRAW_Arc(const GUI_Display_t* disp, GUI_iDim_t x, GUI_iDim_t y, GUI_iDim_t r, int16_t startAngle, int16_t endAngle, GUI_Color_t color) {
+    __DrawArc(disp, x, y, r, r - 1, startAngle, endAngle, color);
+}
+
+void GUI_DRAW_FilledArc(const GUI_Display_t* disp, GUI_iDim_t x, GUI_iDim_t y, GUI_iDim_t r, GUI_iDim_t width, int16_t startAngle, int16_t endAngle, GUI_Color_t color) {
+    if (width > 0) {
+        __DrawArc(disp, x, y, r, r - width, startAngle, endAngle, color);
+    }
+}
+
+void GUI_DRAW_Pie(const GUI_Display_t* disp, GUI_iDim_t x, GUI_iDim_t y, GUI_iDim_t r, int16_t startAngle, int16_t endAngle, GUI_Color_t color) {
+    __DrawArc(disp, x, y, r, -1, startAngle, endAngle, color);
+}
+
+void GUI_DRAW_LineAA(const GUI_Display_t* disp, GUI_iDim_t x1, GUI_iDim_t y1, GUI_iDim_t x2, GUI_iDim_t y2, GUI_Color_t color) {
+    GUI_iDim_t dx, dy, n, end, tmp, x, y, mx, my, ox, oy;
+    uint32_t adj, acc, w, i;
+    uint8_t clip;
+    __GUI_AA_t aa;
+    
+    if (__GUI_MAX(x1, x2) < disp->X1 || __GUI_MIN(x1, x2) >= disp->X2 ||
+        __GUI_MAX(y1, y2) < disp->Y1 || __GUI_MIN(y1, y2) >= disp->Y2) {
+        return;
+    }
+    dx = __GUI_ABS(x2 - x1);
+    dy = __GUI_ABS(y2 - y1);
+    if (dy == 0) {                                  /* Straight lines have no partially covered pixels */
+        GUI_DRAW_HLine(disp, __GUI_MIN(x1, x2), y1, dx + 1, color);
+        return;
+    }
+    if (dx == 0) {
+        GUI_DRAW_VLine(disp, x1, __GUI_MIN(y1, y2), dy + 1, color);
+        return;
+    }
+    __AAInit(&aa, color);
+    
+    /* Pixels on minor axis are 1 pixel outside of end points at most, test each pixel only when not fully visible */
+    clip = __GUI_MIN(x1, x2) <= disp->X1 || __GUI_MAX(x1, x2) >= (disp->X2 - 1) ||
+        __GUI_MIN(y1, y2) <= disp->Y1 || __GUI_MAX(y1, y2) >= (disp->Y2 - 1);
+    
+    /**
+     * Go along major axis and split each pixel between 2 pixels on minor axis.
+     * Position on minor axis is 16.16 fixed point, upper 8 bits of fraction are coverage of second pixel.
+     * Step is rounded up so last pixel ends exactly in end point.
+     * Pixels move by mx, my on each step, second pixel is at ox, oy from first one
+     */
+    if (dx >= dy) {                                 /* Line is more horizontal */
+        if (x2 < x1) {                              /* Always draw from left to right */
+            tmp = x1;
+            x1 = x2;
+            x2 = tmp;
+            tmp = y1;
+            y1 = y2;
+            y2 = tmp;
+        }
+        mx = 1;
+        my = 0;
+        ox = 0;
+        oy = y2 > y1 ? 1 : -1;
+        adj = (((uint32_t)dy << 16) + dx - 1) / dx;
+        n = __GUI_MAX(0, disp->X1 - x1);            /* Clip major axis before drawing */
+        end = __GUI_MIN(dx, disp->X2 - 1 - x1);
+    } else {                                        /* Line is more vertical */
+        if (y2 < y1) {                              /* Always draw from top to bottom */
+            tmp = x1;
+            x1 = x2;
+            x2 = tmp;
+            tmp = y1;
+            y1 = y2;
+            y2 = tmp;
+        }
+        mx = 0;
+        my = 1;
+        ox = x2 > x1 ? 1 : -1;
+        oy = 0;
+        adj = (((uint32_t)dx << 16) + dy - 1) / dy;
+        n = __GUI_MAX(0, disp->Y1 - y1);            /* Clip major axis before drawing */
+        end = __GUI_MIN(dy, disp->Y2 - 1 - y1);
+    }
+    acc = adj * n;
+    i = acc >> 16;
+    x = x1 + mx * n + ox * (GUI_iDim_t)i;
+    y = y1 + my * n + oy * (GUI_iDim_t)i;
+    for (; n <= end; n++, x += mx, y += my) {
+        w = (acc >> 8) & 0xFF;
+        if (!clip && aa.Blend && aa.Alpha == 0xFF) {    /* Opaque and fully visible line, call driver directly */
+            if (!w) {                               /* Only first pixel is covered */
+                aa.LL->SetPixel(aa.LCD, aa.Layer, x, y, color);
+            } else if (w == 0xFF) {                 /* Only second pixel is covered */
+                aa.LL->SetPixel(aa.LCD, aa.Layer, x + ox, y + oy, color);
+            } else {
+                aa.Blend(aa.LCD, aa.Layer, x, y, aa.Color | ((0xFF - w) << 24));
+                aa.Blend(aa.LCD, aa.Layer, x + ox, y + oy, aa.Color | (w << 24));
+            }
+        } else {
+            if (!clip || (x >= disp->X1 && x < disp->X2 && y >= disp->Y1 && y < disp->Y2)) {
+                __BlendPixel(&aa, x, y, 0xFF - w);
+            }
+            if (w && (!clip || ((x + ox) >= disp->X1 && (x + ox) < disp->X2 && (y + oy) >= disp->Y1 && (y + oy) < disp->Y2))) {
+                __BlendPixel(&aa, x + ox, y + oy, w);
+            }
+        }
+        acc += adj;
+        if ((acc >> 16) != i) {                     /* Step on minor axis, adj is never more than 1 pixel */
+            i++;
+            x += ox;
+            y += oy;
+        }
+    }
+}
+
+void GUI_DRAW_RoundedRectangleAA(const GUI_Display_t* disp, GUI_iDim_t x, GUI_iDim_t y, GUI_iDim_t width, GUI_iDim_t height, GUI_iDim_t r, GUI_Color_t color) {
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+    r = __GUI_MIN(r, (__GUI_MIN(width, height) - 1) / 2);
+    if (r <= 0) {
+        GUI_DRAW_Rectangle(disp, x, y, width, height, color);
+        return;
+    }
+    GUI_DRAW_HLine(disp, x + r,         y,              width - 2 * r,  color);
+    GUI_DRAW_VLine(disp, x + width - 1, y + r,          height - 2 * r, color);
+    GUI_DRAW_HLine(disp, x + r,         y + height - 1, width - 2 * r,  color);
+    GUI_DRAW_VLine(disp, x,             y + r,          height - 2 * r, color);
+    
+    __CornersAA(disp, x + r, y + r, x + width - r - 1, y + height - r - 1, r, color, 0);
+}
+
+void GUI_DRAW_FilledRoundedRectangleAA(const GUI_Display_t* disp, GUI_iDim_t x, GUI_iDim_t y, GUI_iDim_t width, GUI_iDim_t height, GUI_iDim_t r, GUI_Color_t color) {
+    GUI_iDim_t dx = 0, dy;
+    
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+    r = __GUI_MIN(r, (__GUI_MIN(width, height) - 1) / 2);
+    if (r <= 0) {
+        GUI_DRAW_FilledRectangle(disp, x, y, width, height, color);
+        return;
+    }
+    for (dy = r; dy > 0; dy--) {                    /* Lines of top and bottom corners with pixels inside radius */
+        while (((int32_t)(dx + 1) * (dx + 1) + (int32_t)dy * dy) <= (int32_t)r * r) {
+            dx++;
+        }
+        GUI_DRAW_HLine(disp, x + r - dx, y + r - dy,              width - 2 * r + 2 * dx, color);
+        GUI_DRAW_HLine(disp, x + r - dx, y + height - r - 1 + dy, width - 2 * r + 2 * dx, color);
+    }
+    GUI_DRAW_FilledRectangle(disp, x, y + r, width, height - 2 * r, color);
+    
+    __CornersAA(disp, x + r, y + r, x + width - r - 1, y + height - r - 1, r, color, 1);
+}
+
+void GUI_DRAW_CircleAA(const GUI_Display_t* disp, GUI_iDim_t x, GUI_iDim_t y, GUI_iDim_t r, GUI_Color_t color) {
+    GUI_DRAW_RoundedRectangleAA(disp, x - r, y - r, 2 * r + 1, 2 * r + 1, r, color);
+}
+
+void GUI_DRAW_FilledCircleAA(const GUI_Display_t* disp, GUI_iDim_t x, GUI_iDim_t y, GUI_iDim_t r, GUI_Color_t color) {
+    GUI_DRAW_FilledRoundedRectangleAA(disp, x - r, y - r, 2 * r + 1, 2 * r + 1, r, color);
+}
+
+void GUI_DRAW_PolyLine(const GUI_Display_t* disp, const GUI_DRAW_Poly_t* points, uint32_t len, GUI_Dim_t width, GUI_DRAW_JOIN_t join, GUI_Color_t color) {
+    __GUI_StrokeBand_t* b = &StrokeBand;
+    const GUI_DRAW_Poly_t *a, *c, *pa;
+    int32_t h, ext, y1, y2, nx = 0, ny = 0, pnx = 0, pny = 0, px[4], py[4];
+    uint32_t i;
+    uint8_t valid, pvalid;
+    GUI_iDim_t r, k;
+    
+    if (len < 2 || width < 1) {
+        return;
+    }
+    width = __GUI_MIN(width, 255);
+    h = (int32_t)width << 7;                        /* Half of width in 24.8 fixed point */
+    ext = (join == GUI_DRAW_JOIN_MITER ? 2 * width : (width + 1) / 2) + 1;  /* Maximal distance of drawn pixel from nearest point */
+    
+    y1 = y2 = points[0].Y;                          /* Find vertical range of line on display */
+    for (i = 1; i < len; i++) {
+        y1 = __GUI_MIN(y1, points[i].Y);
+        y2 = __GUI_MAX(y2, points[i].Y);
+    }
+    y1 = __GUI_MAX(y1 - ext, disp->Y1);
+    y2 = __GUI_MIN(y2 + ext + 1, disp->Y2);
+    if (y1 >= y2 || disp->X1 >= disp->X2) {
+        return;
+    }
+    
+    b->Disp = disp;
+    b->Color = color;
+    
+    /**
+     * Line is rasterized in bands of scanlines.
+     * Each segment and join is converted to convex polygon and its spans are merged on scanlines,
+     * merged spans are drawn when band is completed
+     */
+    for (b->Y = y1; b->Y < y2; b->Y += __STROKE_BAND_ROWS) {
+        b->Rows = __GUI_MIN(__STROKE_BAND_ROWS, y2 - b->Y);
+        memset(b->Count, 0x00, sizeof(b->Count));
+        
+        pa = NULL;                                  /* Start point of previous segment */
+        pvalid = 0;
+        for (i = 1; i < len; i++) {
+            a = &points[i - 1];
+            c = &points[i];
+            if (a->X == c->X && a->Y == c->Y) {     /* Ignore segments without length */
+                continue;
+            }
+            valid = 0;
+            if (__GUI_MIN(a->Y, c->Y) - ext < b->Y + b->Rows && __GUI_MAX(a->Y, c->Y) + ext >= b->Y) {
+                __StrokeNormal(a, c, h, &nx, &ny);
+                valid = 1;
+                px[0] = ((int32_t)a->X << 8) + nx;  /* Rectangle around segment */
+                py[0] = ((int32_t)a->Y << 8) + ny;
+                px[1] = ((int32_t)c->X << 8) + nx;
+                py[1] = ((int32_t)c->Y << 8) + ny;
+                px[2] = ((int32_t)c->X << 8) - nx;
+                py[2] = ((int32_t)c->Y << 8) - ny;
+                px[3] = ((int32_t)a->X << 8) - nx;
+                py[3] = ((int32_t)a->Y << 8) - ny;
+                __StrokePoly(b, px, py, 4);
+            }
+            if (pa != NULL && a->Y - ext < b->Y + b->Rows && a->Y + ext >= b->Y) {
+                if (!valid) {
+                    __StrokeNormal(a, c, h, &nx, &ny);
+                    valid = 1;
+                }
+                if (!pvalid) {
+                    __StrokeNormal(pa, a, h, &pnx, &pny);
+                }
+                __StrokeJoin(b, a, pnx, pny, nx, ny, h, join);
+            }
+            pa = a;
+            pnx = nx;
+            pny = ny;
+            pvalid = valid;
+        }
+        
+        for (r = 0; r < b->Rows; r++) {             /* Draw merged spans of band */
+            for (k = 0; k < b->Count[r]; k++) {
+                GUI_DRAW_HLine(disp, b->Span[r][k][0], b->Y + r, b->Span[r][k][1] - b->Span[r][k][0], color);
+            }
+        }
+    }
+}
+
 void GUI_DRAW_Poly(const GUI_Display_t* disp, const GUI_DRAW_Poly_t* points, GUI_Byte len, GUI_Color_t color) {
     GUI_iDim_t x = 0, y = 0;
 
@@ -688,21 +1697,35 @@ void GUI_DRAW_Poly(const GUI_Display_t* disp, const GUI_DRAW_Poly_t* points, GUI
 void GUI_DRAW_WriteText(const GUI_Display_t* disp, const GUI_FONT_t* font, const GUI_Char* str, GUI_DRAW_FONT_t* draw) {
     GUI_iDim_t w, h, x, y;
     uint32_t ch;
-    uint8_t i;
     uint16_t cnt;
     GUI_iDim_t startX;
     const GUI_FONT_CharInfo_t* c;
+    const GUI_DRAW_TEXTLAYOUT_t* layout = 0;
+    uint16_t line = 0;
+    __GUI_TextPos_t pos;
     
     if (!draw->LineHeight) {                        /* When line height is not set */
         draw->LineHeight = font->Size;              /* Set font size */
     }
     
-    __StringRectangle(font, str, draw, &w, &h, 0);  /* Get string width for this box */
-    if (w > draw->Width) {                          /* If string is wider than available rectangle */
-        if (draw->Flags & GUI_FLAG_FONT_RIGHTALIGN) {   /* Check right align text */
-            str = __StringGetPointerForWidth(font, str, draw);
-        } else {
-            w = draw->Width;                        /* Strip text width to available */
+    pos.Str = str;
+    pos.Index = 0;
+    pos.Run = 0;
+    if (draw->Run && draw->Run->Text == str && draw->Run->Font == font) {   /* Use pre-decoded string */
+        pos.Run = draw->Run;
+        layout = __TextLayoutGet(draw->Run, draw);  /* Get lines measured before */
+    }
+    
+    if (layout) {
+        h = layout->TextHeight;
+    } else {
+        __StringRectangle(font, &pos, draw, &w, &h, 0); /* Get string width for this box */
+        if (w > draw->Width) {                      /* If string is wider than available rectangle */
+            if (draw->Flags & GUI_FLAG_FONT_RIGHTALIGN) {   /* Check right align text */
+                __StringGetPointerForWidth(font, &pos, draw);
+            } else {
+                w = draw->Width;                    /* Strip text width to available */
+            }
         }
     }
     
@@ -721,7 +1744,7 @@ void GUI_DRAW_WriteText(const GUI_Display_t* disp, const GUI_FONT_t* font, const
     
     y -= draw->ScrollY;                             /* Go scroll top */
     
-    while ((cnt = __StringRectangle(font, str, draw, &w, NULL, 1)) > 0) {
+    while ((cnt = __StringGetLine(font, &pos, draw, layout, line++, &w)) > 0) {
         x = draw->X;;                                       
         if (draw->Align & GUI_HALIGN_CENTER) {      /* Check for horizontal align center */
             x += (draw->Width - w) / 2;             /* Align center of drawing area */
@@ -729,7 +1752,7 @@ void GUI_DRAW_WriteText(const GUI_Display_t* disp, const GUI_FONT_t* font, const
             x += draw->Width - w;                   /* Align right of drawing area */
         }
         startX = x;                                 /* save start X position */
-        while (cnt-- && GUI_STRING_GetCh(&str, &ch, &i)) {            
+        while (cnt-- && __StringGetCh(font, &pos, &ch, &c)) {
             if ((uint8_t)'\r' == (uint8_t)ch || (uint8_t)'\n' == (uint8_t)ch) { /* Check CR & LF characters */
                 if (draw->Flags & GUI_FLAG_FONT_MULTILINE) {
                     x = startX;                     /* Go to beginning of line */
@@ -743,10 +1766,14 @@ void GUI_DRAW_WriteText(const GUI_Display_t* disp, const GUI_FONT_t* font, const
                 continue;
             }
             
-            if ((c = __StringGetCharPtr(font, ch)) == 0) {  /* Get character pointer */
+            if (!c) {                               /* Check character pointer */
                 continue;                           /* Character is not known */
             }
+#if GUI_USE_FONT_FALLBACK
+            __DRAW_Char(disp, __StringGetGlyphFont(font, c), draw, x, y, c);   /* Draw with flags and storage of font glyph belongs to */
+#else
             __DRAW_Char(disp, font, draw, x, y, c); /* Draw actual char */
+#endif /* GUI_USE_FONT_FALLBACK */
             
             x += c->xSize + c->xMargin;             /* Increase X position */
         }
@@ -757,6 +1784,73 @@ void GUI_DRAW_WriteText(const GUI_Display_t* disp, const GUI_FONT_t* font, const
     }
 }
 
+GUI_DRAW_TEXTRUN_t* __GUI_DRAW_TextRunGet(GUI_DRAW_TEXTRUN_t** run, const GUI_FONT_t* font, const GUI_Char* str) {
+    GUI_DRAW_TEXTRUN_t* r = *run;
+    const GUI_Char* s = str;
+    uint32_t count = 0, ch;
+    
+    if (r && r->Text == str && r->Font == font) {   /* Run is still valid */
+        return r;
+    }
+    
+    while (GUI_STRING_GetCh(&s, &ch, NULL)) {       /* Get number of characters */
+        count++;
+    }
+    if (!r || r->Size < count) {                    /* Allocate memory for new size */
+        r = (GUI_DRAW_TEXTRUN_t *)__GUI_MEMALLOC(sizeof(*r) + count * (sizeof(*r->Ch) + sizeof(*r->Glyph)), GUI_MEM_TYPE_TEXT);
+        if (!r) {
+            __GUI_DRAW_TextRunFree(run);
+            return 0;
+        }
+        r->Size = count;
+        r->Glyph = (const GUI_FONT_CharInfo_t **)(r + 1);   /* Glyphs are after structure */
+        r->Ch = (uint32_t *)(r->Glyph + count);     /* Characters are after glyphs */
+        if (*run) {                                 /* Keep rectangles measured with previous run */
+            memcpy(r->Layouts, (*run)->Layouts, sizeof(r->Layouts));
+            r->LayoutNext = (*run)->LayoutNext;
+            __GUI_MEMFREE(*run);
+        } else {
+            memset(r->Layouts, 0x00, sizeof(r->Layouts));
+            r->LayoutNext = 0;
+        }
+        *run = r;
+    }
+    
+    r->Count = 0;
+    for (s = str; r->Count < count && GUI_STRING_GetCh(&s, &ch, NULL); r->Count++) {
+        r->Ch[r->Count] = ch;
+        r->Glyph[r->Count] = __StringGetCharPtr(font, ch);  /* Find glyph only once */
+    }
+    r->Text = str;
+    r->Font = font;
+    
+    for (count = 0; count < GUI_TEXT_RUN_LAYOUTS; count++) {    /* Measure new text for rectangles used before */
+        if (r->Layouts[count]) {
+            r->Layouts[count] = __TextLayoutMeasure(r, r->Layouts[count], r->Layouts[count]->Width, r->Layouts[count]->LineHeight, r->Layouts[count]->Flags);
+        }
+    }
+    return r;
+}
+
+void __GUI_DRAW_TextRunFree(GUI_DRAW_TEXTRUN_t** run) {
+    uint8_t i;
+    
+    if (*run) {
+        for (i = 0; i < GUI_TEXT_RUN_LAYOUTS; i++) {
+            if ((*run)->Layouts[i]) {
+                __GUI_MEMFREE((*run)->Layouts[i]);
+            }
+        }
+        __GUI_MEMFREE(*run);
+    }
+}
+
+#if GUI_USE_FONT_FALLBACK
+void __GUI_DRAW_FontFallbackFlush(void) {
+    memset(FallbackCache, 0x00, sizeof(FallbackCache));
+}
+#endif /* GUI_USE_FONT_FALLBACK */
+
 void GUI_DRAW_ScrollBar_init(GUI_DRAW_SB_t* sb) {
     memset(sb, 0x00, sizeof(*sb));                  /* Reset structure */
 }
@@ -791,3 +1885,174 @@ void GUI_DRAW_ScrollBar(const GUI_Display_t* disp, GUI_DRAW_SB_t* sb) {
     }
     GUI_DRAW_Rectangle3D(disp, sb->X, sb->Y + btnH + midOffset, sb->Width, rectHeight, GUI_DRAW_3D_State_Raised); 
 }
+
+/******************************************************************************/
+/******************************************************************************/
+/***                          Functions for images                           **/
+/******************************************************************************/
+/******************************************************************************/
+void GUI_DRAW_Image(const GUI_Display_t* disp, GUI_iDim_t x, GUI_iDim_t y, const GUI_IMAGE_DESC_t* img, GUI_Color_t color) {
+    GUI_iDim_t xOff = 0, yOff = 0, width, height;
+    
+    if (!img || !img->Data) {                       /* Check input parameters */
+        return;
+    }
+    width = img->Width;
+    height = img->Height;
+    if (                                            /* Check if image is inside area */
+        x >= disp->X2 ||                            /* Too right */
+        y >= disp->Y2 ||                            /* Too bottom */
+        (x + width) <= disp->X1 ||                  /* Too left */
+        (y + height) <= disp->Y1                    /* Too top */
+        ) {
+        return;
+    }
+    
+    /* Clip image to display region */
+    if (x < disp->X1) {
+        xOff = disp->X1 - x;
+        width -= xOff;
+        x = disp->X1;
+    }
+    if (y < disp->Y1) {
+        yOff = disp->Y1 - y;
+        height -= yOff;
+        y = disp->Y1;
+    }
+    if ((x + width) > disp->X2) {
+        width = disp->X2 - x;
+    }
+    if ((y + height) > disp->Y2) {
+        height = disp->Y2 - y;
+    }
+    
+    if (GUI_IMGDEC_IsCompressed(img->Format)) {    /* Compressed images are decoded while drawing */
+        __ImageDrawStream(img, x, y, xOff, yOff, width, height, color);
+        return;
+    }
+    
+    /* Try with low-level driver first */
+    if (GUI.LL.DrawImage && GUI.LL.DrawImage(&GUI.LCD, GUI.LCD.DrawingLayer, img, x, y, xOff, yOff, width, height, color)) {
+        return;
+    }
+    
+#if GUI_USE_IMAGE_CACHE
+    if (img->Format == GUI_IMAGE_FORMAT_RGB565 || img->Format == GUI_IMAGE_FORMAT_L8) { /* Color formats can be converted once */
+        const GUI_IMAGE_DESC_t* conv = __ImageCacheGet(img);
+        if (conv) {
+            if (GUI.LL.DrawImage && GUI.LL.DrawImage(&GUI.LCD, GUI.LCD.DrawingLayer, conv, x, y, xOff, yOff, width, height, color)) {
+                return;
+            }
+            img = conv;                             /* Use converted image for software drawing */
+        }
+    }
+#endif /* GUI_USE_IMAGE_CACHE */
+    
+    __GUI_DRAW_ImageSoftware(&GUI.LCD, &GUI.LL, GUI.LCD.DrawingLayer, img, x, y, xOff, yOff, width, height, color);   /* Draw with software */
+}
+
+GUI_Color_t __GUI_DRAW_AAColor(GUI_Color_t color, GUI_Color_t fg, uint8_t weight) {
+    GUI_Byte r1, g1, b1;
+#if GUI_USE_FIXED_POINT
+    /* Calculate new values for pixel with integer weights, t = weight / 3 */
+    r1 = (weight * ((color >> 16) & 0xFF) + (3 - weight) * ((fg >> 16) & 0xFF)) / 3;
+    g1 = (weight * ((color >>  8) & 0xFF) + (3 - weight) * ((fg >>  8) & 0xFF)) / 3;
+    b1 = (weight * ((color >>  0) & 0xFF) + (3 - weight) * ((fg >>  0) & 0xFF)) / 3;
+#else
+    float t = (float)weight / 3.0f;
+    
+    /* Calculate new values for pixel */
+    r1 = (float)t * (float)((color >> 16) & 0xFF) + (float)(1.0f - (float)t) * (float)((fg >> 16) & 0xFF);
+    g1 = (float)t * (float)((color >>  8) & 0xFF) + (float)(1.0f - (float)t) * (float)((fg >>  8) & 0xFF);
+    b1 = (float)t * (float)((color >>  0) & 0xFF) + (float)(1.0f - (float)t) * (float)((fg >>  0) & 0xFF);
+#endif /* GUI_USE_FIXED_POINT */
+    return (color & 0xFF000000UL) | r1 << 16 | g1 << 8 | b1;
+}
+
+void __GUI_DRAW_BlendPixel(GUI_LCD_t* LCD, GUI_LL_t* LL, uint8_t layer, GUI_iDim_t x, GUI_iDim_t y, GUI_Color_t color) {
+    if (LL->BlendPixel) {                           /* Driver blends directly in frame buffer */
+        LL->BlendPixel(LCD, layer, x, y, color);
+    } else {
+        LL->SetPixel(LCD, layer, x, y, __BlendColor(color, LL->GetPixel(LCD, layer, x, y)));
+    }
+}
+
+void __GUI_DRAW_ImageSoftware(GUI_LCD_t* LCD, GUI_LL_t* LL, uint8_t layer, const GUI_IMAGE_DESC_t* img, GUI_iDim_t x, GUI_iDim_t y, GUI_iDim_t xOff, GUI_iDim_t yOff, GUI_iDim_t width, GUI_iDim_t height, GUI_Color_t color) {
+    const GUI_Byte* line;
+    uint32_t lineSize = __ImageGetLineSize(img);
+    GUI_iDim_t i, k;
+    GUI_Color_t c;
+    
+    line = img->Data + lineSize * yOff;
+    if (img->Format == GUI_IMAGE_FORMAT_A8 || img->Format == GUI_IMAGE_FORMAT_A4) {
+        __ImageAlphaSoftware(LCD, LL, layer, img, line, x, y, xOff, width, height, color);
+        return;
+    }
+    for (i = 0; i < height; i++, line += lineSize) {
+        for (k = 0; k < width; k++) {
+            c = __ImageGetPixel(img, line, xOff + k, color);
+            if ((c >> 24) == 0xFF) {                /* Opaque pixel */
+                LL->SetPixel(LCD, layer, x + k, y + i, c);
+            } else if (c >> 24) {                   /* Transparent pixel */
+                c = __BlendColor(c, LL->GetPixel(LCD, layer, x + k, y + i));
+                LL->SetPixel(LCD, layer, x + k, y + i, c);
+            }
+        }
+    }
+}
+
+uint8_t GUI_DRAW_ImageDecode(const GUI_IMAGE_DESC_t* img, GUI_Color_t* buff, GUI_Dim_t buffWidth, GUI_Color_t color) {
+    GUI_IMGDEC_t dec;
+    const GUI_Byte* line;
+    uint32_t lineSize;
+    GUI_iDim_t i, k;
+    
+    if (!img || !img->Data || !buff || buffWidth < img->Width) {    /* Check input parameters */
+        return 0;
+    }
+    if (GUI_IMGDEC_IsCompressed(img->Format)) {    /* Decode compressed image line by line */
+        if (!GUI_IMGDEC_Init(&dec, img)) {
+            return 0;
+        }
+        for (i = 0; i < img->Height; i++, buff += buffWidth) {
+            if (!GUI_IMGDEC_Read(&dec, buff, img->Width)) {
+                return 0;
+            }
+        }
+    } else {
+        lineSize = __ImageGetLineSize(img);
+        line = img->Data;
+        for (i = 0; i < img->Height; i++, buff += buffWidth, line += lineSize) {
+            for (k = 0; k < img->Width; k++) {
+                buff[k] = __ImageGetPixel(img, line, k, color);
+            }
+        }
+    }
+    return 1;
+}
+
+#if GUI_USE_IMAGE_CACHE || defined(DOXYGEN)
+void GUI_DRAW_ImageCacheClear(void) {
+    uint8_t n;
+    
+    for (n = 0; n < GUI_IMAGE_CACHE_ENTRIES; n++) {
+        if (ImageCache[n].Src) {
+            __GUI_MEMFREE(ImageCache[n].Data);  /* Free converted image */
+            ImageCache[n].Src = 0;
+        }
+    }
+    ImageCacheSize = 0;
+}
+
+void GUI_DRAW_ImageCacheRemove(const GUI_IMAGE_DESC_t* img) {
+    uint8_t n;
+    
+    for (n = 0; n < GUI_IMAGE_CACHE_ENTRIES; n++) {
+        if (ImageCache[n].Src == img) {
+            ImageCacheSize -= ImageCache[n].Size;
+            __GUI_MEMFREE(ImageCache[n].Data);  /* Free converted image */
+            ImageCache[n].Src = 0;
+        }
+    }
+}
+#endif /* GUI_USE_IMAGE_CACHE || defined(DOXYGEN) */
@@ -141,6 +141,39 @@ extern "C" {
 #define GUI_VALIGN_CENTER               0x10/*!< Vertical align is center */
 #define GUI_VALIGN_BOTTOM               0x20/*!< Vertical align is bottom */         
 
+/**
+ * \brief           Text lines measured for single text rectangle
+ *
+ *                  Layout is valid for rectangle width, line height and flags it was measured with
+ */
+typedef struct GUI_DRAW_TEXTLAYOUT_t {
+    GUI_iDim_t Width;                       /*!< Rectangle width used for measurement */
+    GUI_Dim_t LineHeight;                   /*!< Line height used for measurement */
+    GUI_Byte Flags;                         /*!< Drawing flags used for measurement */
+    GUI_iDim_t TextHeight;                  /*!< Height of all lines */
+    uint16_t Count;                         /*!< Number of lines, 0 when text must be measured while drawing */
+    uint16_t* Chars;                        /*!< Number of characters in each line */
+    GUI_iDim_t* Widths;                     /*!< Width of each line */
+} GUI_DRAW_TEXTLAYOUT_t;
+
+/**
+ * \brief           Text decoded to characters and font glyphs
+ *
+ *                  Text layout measures and draws string in several passes.
+ *                  With text run, string is decoded only once when text or font changes
+ *                  and lines are measured only once for each of recently used text rectangles
+ */
+typedef struct GUI_DRAW_TEXTRUN_t {
+    const GUI_Char* Text;                   /*!< Decoded text, NULL when run is not valid */
+    const GUI_FONT_t* Font;                 /*!< Font used for glyph lookup */
+    uint32_t Count;                         /*!< Number of decoded characters */
+    uint32_t Size;                          /*!< Maximal number of characters in allocated memory */
+    uint32_t* Ch;                           /*!< Decoded characters */
+    const GUI_FONT_CharInfo_t** Glyph;      /*!< Font glyph for each character, NULL when character is not in font */
+    GUI_DRAW_TEXTLAYOUT_t* Layouts[GUI_TEXT_RUN_LAYOUTS];   /*!< Measured lines for recently used text rectangles */
+    uint8_t LayoutNext;                     /*!< Index of layout to replace when new rectangle is used */
+} GUI_DRAW_TEXTRUN_t;
+
 /**
  * \brief           Structure for drawing strings on widgets
  * \sa              GUI_DRAW_FONT_Init
@@ -157,6 +190,7 @@ typedef struct GUI_DRAW_FONT_t {
     GUI_Color_t Color1;                     /*!< Color 1 */
     GUI_Color_t Color2;                     /*!< Color 2 */
     uint32_t ScrollY;                       /*!< Scroll in vertical direction */
+    GUI_DRAW_TEXTRUN_t* Run;                /*!< Optional pre-decoded string, used instead of decoding string when it matches. Measured lines are saved to it */
 } GUI_DRAW_FONT_t;
 
 /**
@@ -199,6 +233,16 @@ typedef struct GUI_DRAW_Poly_t {
     GUI_iDim_t Y;                           /*!< Poly point Y location */
 } GUI_DRAW_Poly_t;
 
+/**
+ * \brief           Join style between segments of thick poly line
+ * \sa              GUI_DRAW_PolyLine
+ */
+typedef enum GUI_DRAW_JOIN_t {
+    GUI_DRAW_JOIN_MITER = 0x00,             /*!< Outer edges are extended to sharp corner, very sharp corners are beveled */
+    GUI_DRAW_JOIN_ROUND,                    /*!< Corner is rounded with circle of line width diameter */
+    GUI_DRAW_JOIN_BEVEL,                    /*!< Outer edges are connected with straight line */
+} GUI_DRAW_JOIN_t;
+
 /**
  * \brief           Initialize \ref GUI_DRAW_FONT_t structure for further usage
  * \param[in,out]   *f: Pointer to empty \ref GUI_DRAW_FONT_t structure
@@ -403,6 +447,148 @@ void GUI_DRAW_CircleCorner(const GUI_Display_t* disp, GUI_iDim_t x0, GUI_iDim_t
  */
 void GUI_DRAW_FilledCircleCorner(const GUI_Display_t* disp, GUI_iDim_t x0, GUI_iDim_t y0, GUI_iDim_t r, GUI_Byte_t c, uint32_t color);
 
+/**
+ * \brief           Draw arc of circle, 1 pixel wide
+ *
+ *                  Angles are in units of degrees, 0 degrees points to the right
+ *                  and angles increase clockwise on screen. Arc is drawn clockwise from start angle up to end angle,
+ *                  end angle is not included, therefore arcs with common angle do not overlap.
+ *                  Difference of 360 degrees or more draws full circle
+ *
+ * \note            Arc is drawn with horizontal lines, each pixel is drawn once
+ * \param[in,out]   *disp: Pointer to \ref GUI_Display_t structure for display operations
+ * \param[in]       x: X position of circle center
+ * \param[in]       y: Y position of circle center
+ * \param[in]       r: Circle radius
+ * \param[in]       startAngle: Start angle in units of degrees
+ * \param[in]       endAngle: End angle in units of degrees
+ * \param[in]       color: Color used for drawing operation
+ * \retval          None
+ * \sa              GUI_DRAW_FilledArc
+ * \sa              GUI_DRAW_Pie
+ */
+void GUI_DRAW_Arc(const GUI_Display_t* disp, GUI_iDim_t x, GUI_iDim_t y, GUI_iDim_t r, int16_t startAngle, int16_t endAngle, GUI_Color_t color);
+
+/**
+ * \brief           Draw part of ring, for example progress ring or gauge
+ * \note            Angles are the same as for \ref GUI_DRAW_Arc
+ * \param[in,out]   *disp: Pointer to \ref GUI_Display_t structure for display operations
+ * \param[in]       x: X position of circle center
+ * \param[in]       y: Y position of circle center
+ * \param[in]       r: Outer radius of ring
+ * \param[in]       width: Ring width in units of pixels, ring is drawn inside outer radius
+ * \param[in]       startAngle: Start angle in units of degrees
+ * \param[in]       endAngle: End angle in units of degrees
+ * \param[in]       color: Color used for drawing operation
+ * \retval          None
+ * \sa              GUI_DRAW_Arc
+ * \sa              GUI_DRAW_Pie
+ */
+void GUI_DRAW_FilledArc(const GUI_Display_t* disp, GUI_iDim_t x, GUI_iDim_t y, GUI_iDim_t r, GUI_iDim_t width, int16_t startAngle, int16_t endAngle, GUI_Color_t color);
+
+/**
+ * \brief           Draw pie sector of filled circle
+ * \note            Angles are the same as for \ref GUI_DRAW_Arc
+ * \param[in,out]   *disp: Pointer to \ref GUI_Display_t structure for display operations
+ * \param[in]       x: X position of circle center
+ * \param[in]       y: Y position of circle center
+ * \param[in]       r: Circle radius
+ * \param[in]       startAngle: Start angle in units of degrees
+ * \param[in]       endAngle: End angle in units of degrees
+ * \param[in]       color: Color used for drawing operation
+ * \retval          None
+ * \sa              GUI_DRAW_Arc
+ * \sa              GUI_DRAW_FilledArc
+ */
+void GUI_DRAW_Pie(const GUI_Display_t* disp, GUI_iDim_t x, GUI_iDim_t y, GUI_iDim_t r, int16_t startAngle, int16_t endAngle, GUI_Color_t color);
+
+/**
+ * \brief           Draw anti-aliased line between 2 points
+ *
+ *                  Each pixel on major axis is split between 2 pixels on minor axis,
+ *                  proportionally to distance from exact line position
+ *
+ * \note            Both end points are drawn, horizontal and vertical lines are drawn with \ref GUI_DRAW_HLine and \ref GUI_DRAW_VLine
+ * \param[in,out]   *disp: Pointer to \ref GUI_Display_t structure for display operations
+ * \param[in]       x1: Line start X position
+ * \param[in]       y1: Line start Y position
+ * \param[in]       x2: Line end X position
+ * \param[in]       y2: Line end Y position
+ * \param[in]       color: Color used for drawing operation, alpha value is used for transparency
+ * \retval          None
+ * \sa              GUI_DRAW_Line
+ */
+void GUI_DRAW_LineAA(const GUI_Display_t* disp, GUI_iDim_t x1, GUI_iDim_t y1, GUI_iDim_t x2, GUI_iDim_t y2, GUI_Color_t color);
+
+/**
+ * \brief           Draw rectangle with anti-aliased rounded corners
+ * \note            Rectangle size is the same as with \ref GUI_DRAW_RoundedRectangle, partially covered pixels stay inside
+ * \param[in,out]   *disp: Pointer to \ref GUI_Display_t structure for display operations
+ * \param[in]       x: Top left X position
+ * \param[in]       y: Top left Y position
+ * \param[in]       width: Rectangle width
+ * \param[in]       height: Rectangle height
+ * \param[in]       r: Corner radius, limited to half of shorter side
+ * \param[in]       color: Color used for drawing operation
+ * \retval          None
+ * \sa              GUI_DRAW_FilledRoundedRectangleAA
+ */
+void GUI_DRAW_RoundedRectangleAA(const GUI_Display_t* disp, GUI_iDim_t x, GUI_iDim_t y, GUI_iDim_t width, GUI_iDim_t height, GUI_iDim_t r, GUI_Color_t color);
+
+/**
+ * \brief           Draw filled rectangle with anti-aliased rounded corners
+ * \param[in,out]   *disp: Pointer to \ref GUI_Display_t structure for display operations
+ * \param[in]       x: Top left X position
+ * \param[in]       y: Top left Y position
+ * \param[in]       width: Rectangle width
+ * \param[in]       height: Rectangle height
+ * \param[in]       r: Corner radius, limited to half of shorter side
+ * \param[in]       color: Color used for drawing operation
+ * \retval          None
+ * \sa              GUI_DRAW_RoundedRectangleAA
+ */
+void GUI_DRAW_FilledRoundedRectangleAA(const GUI_Display_t* disp, GUI_iDim_t x, GUI_iDim_t y, GUI_iDim_t width, GUI_iDim_t height, GUI_iDim_t r, GUI_Color_t color);
+
+/**
+ * \brief           Draw anti-aliased circle
+ * \note            Circle is centered to pixel and is 2 * r + 1 pixels wide
+ * \param[in,out]   *disp: Pointer to \ref GUI_Display_t structure for display operations
+ * \param[in]       x: X position of circle center
+ * \param[in]       y: Y position of circle center
+ * \param[in]       r: Circle radius
+ * \param[in]       color: Color used for drawing operation
+ * \retval          None
+ * \sa              GUI_DRAW_FilledCircleAA
+ */
+void GUI_DRAW_CircleAA(const GUI_Display_t* disp, GUI_iDim_t x, GUI_iDim_t y, GUI_iDim_t r, GUI_Color_t color);
+
+/**
+ * \brief           Draw filled anti-aliased circle
+ * \note            Circle is centered to pixel and is 2 * r + 1 pixels wide
+ * \param[in,out]   *disp: Pointer to \ref GUI_Display_t structure for display operations
+ * \param[in]       x: X position of circle center
+ * \param[in]       y: Y position of circle center
+ * \param[in]       r: Circle radius
+ * \param[in]       color: Color used for drawing operation
+ * \retval          None
+ * \sa              GUI_DRAW_CircleAA
+ */
+void GUI_DRAW_FilledCircleAA(const GUI_Display_t* disp, GUI_iDim_t x, GUI_iDim_t y, GUI_iDim_t r, GUI_Color_t color);
+
+/**
+ * \brief           Draw thick poly line through points
+ * \note            Line is centered on points and has flat ends.
+ *                  Every pixel is drawn only once, unless line crosses single scanline more than 16 times
+ * \param[in,out]   *disp: Pointer to \ref GUI_Display_t structure for display operations
+ * \param[in]       *points: Pointer to array of \ref GUI_DRAW_Poly_t points
+ * \param[in]       len: Number of points in array
+ * \param[in]       width: Line width in units of pixels, maximal width is 255
+ * \param[in]       join: Join style between segments. This parameter can be a value of \ref GUI_DRAW_JOIN_t enumeration
+ * \param[in]       color: Color used for drawing operation
+ * \retval          None
+ */
+void GUI_DRAW_PolyLine(const GUI_Display_t* disp, const GUI_DRAW_Poly_t* points, uint32_t len, GUI_Dim_t width, GUI_DRAW_JOIN_t join, GUI_Color_t color);
+
 /**
  * \brief           Draw triangle
  * \param[in,out]   *disp: Pointer to \ref GUI_Display_t structure for display operations
@@ -465,6 +651,127 @@ void GUI_DRAW_ScrollBar_init(GUI_DRAW_SB_t* sb);
  */
 void GUI_DRAW_ScrollBar(const GUI_Display_t* disp, GUI_DRAW_SB_t* sb);
 
+/**
+ * \brief           Draw image to screen
+ *
+ *                  Image is drawn with low-level driver if supported, otherwise software is used.
+ *                  Pixels with alpha channel are blended with existing content on screen.
+ *                  Compressed images are decoded in small chunks while drawing, only up to last visible line
+ *
+ * \param[in,out]   *disp: Pointer to \ref GUI_Display_t structure for display operations
+ * \param[in]       x: Top left X position of image
+ * \param[in]       y: Top left Y position of image
+ * \param[in]       *img: Pointer to \ref GUI_IMAGE_DESC_t image descriptor
+ * \param[in]       color: Color used for \ref GUI_IMAGE_FORMAT_A8 and \ref GUI_IMAGE_FORMAT_A4 formats, ignored for other formats
+ * \retval          None
+ */
+void GUI_DRAW_Image(const GUI_Display_t* disp, GUI_iDim_t x, GUI_iDim_t y, const GUI_IMAGE_DESC_t* img, GUI_Color_t color);
+
+/**
+ * \brief           Decode image to memory in ARGB8888 format
+ * \note            Pixels in memory are replaced, no blending is performed
+ * \param[in]       *img: Pointer to \ref GUI_IMAGE_DESC_t image descriptor
+ * \param[out]      *buff: Pointer to top left pixel of output area
+ * \param[in]       buffWidth: Width of output memory in units of pixels, at least image width
+ * \param[in]       color: Color used for \ref GUI_IMAGE_FORMAT_A8 and \ref GUI_IMAGE_FORMAT_A4 formats, ignored for other formats
+ * \retval          1: Image was decoded ok
+ * \retval          0: Image was not decoded
+ */
+uint8_t GUI_DRAW_ImageDecode(const GUI_IMAGE_DESC_t* img, GUI_Color_t* buff, GUI_Dim_t buffWidth, GUI_Color_t color);
+
+#if defined(GUI_INTERNAL) || defined(DOXYGEN)
+/**
+ * \brief           Mix 2-bit anti-aliased font pixel with screen color
+ * \note            Since this function is private, it can only be used by user inside GUI library
+ * \param[in]       color: Current screen color
+ * \param[in]       fg: Font color
+ * \param[in]       weight: Weight of screen color, from 1 to 2 in units of thirds
+ * \retval          Mixed color with alpha of screen color
+ */
+GUI_Color_t __GUI_DRAW_AAColor(GUI_Color_t color, GUI_Color_t fg, uint8_t weight);
+
+/**
+ * \brief           Blend color over pixel on screen
+ * \note            Since this function is private, it can only be used by user inside GUI library
+ * \note            Low-level blend function is used when set, otherwise pixel is read, blended and written back
+ * \param[in,out]   *LCD: Pointer to LCD settings
+ * \param[in]       *LL: Pointer to low-level functions used for drawing
+ * \param[in]       layer: Layer number to draw on
+ * \param[in]       x: X position on screen
+ * \param[in]       y: Y position on screen
+ * \param[in]       color: Color with alpha value as pixel coverage
+ * \retval          None
+ */
+void __GUI_DRAW_BlendPixel(GUI_LCD_t* LCD, GUI_LL_t* LL, uint8_t layer, GUI_iDim_t x, GUI_iDim_t y, GUI_Color_t color);
+
+/**
+ * \brief           Draw part of uncompressed image with software using specific low-level driver
+ * \note            Since this function is private, it can only be used by user inside GUI library
+ * \param[in,out]   *LCD: Pointer to LCD settings
+ * \param[in]       *LL: Pointer to low-level functions used for drawing
+ * \param[in]       layer: Layer number to draw on
+ * \param[in]       *img: Pointer to \ref GUI_IMAGE_DESC_t image descriptor
+ * \param[in]       x: X position on screen
+ * \param[in]       y: Y position on screen
+ * \param[in]       xOff: X offset in image
+ * \param[in]       yOff: Y offset in image
+ * \param[in]       width: Width of image part in units of pixels
+ * \param[in]       height: Height of image part in units of pixels
+ * \param[in]       color: Color used for alpha-only formats
+ * \retval          None
+ */
+void __GUI_DRAW_ImageSoftware(GUI_LCD_t* LCD, GUI_LL_t* LL, uint8_t layer, const GUI_IMAGE_DESC_t* img, GUI_iDim_t x, GUI_iDim_t y, GUI_iDim_t xOff, GUI_iDim_t yOff, GUI_iDim_t width, GUI_iDim_t height, GUI_Color_t color);
+
+/**
+ * \brief           Get text run for string and font, decode string again when run does not match
+ * \note            Since this function is private, it can only be used by user inside GUI library
+ * \note            Run memory is reused when string fits, otherwise it is allocated again.
+ *                  Set \ref GUI_DRAW_TEXTRUN_t.Text to NULL to force decoding of modified string.
+ *                  Lines of new string are measured again for all rectangles measured with previous string
+ * \param[in,out]   **run: Pointer to pointer to \ref GUI_DRAW_TEXTRUN_t structure, NULL when not yet allocated
+ * \param[in]       *font: Font used for glyph lookup
+ * \param[in]       *str: String to decode
+ * \retval          > 0: Pointer to valid run
+ * \retval          0: Memory is not available, string must be decoded while drawing
+ */
+GUI_DRAW_TEXTRUN_t* __GUI_DRAW_TextRunGet(GUI_DRAW_TEXTRUN_t** run, const GUI_FONT_t* font, const GUI_Char* str);
+
+/**
+ * \brief           Free text run and its measured layouts
+ * \note            Since this function is private, it can only be used by user inside GUI library
+ * \param[in,out]   **run: Pointer to pointer to \ref GUI_DRAW_TEXTRUN_t structure, set to NULL after free
+ * \retval          None
+ */
+void __GUI_DRAW_TextRunFree(GUI_DRAW_TEXTRUN_t** run);
+
+#if GUI_USE_FONT_FALLBACK || defined(DOXYGEN)
+/**
+ * \brief           Remove all characters resolved in font fallback chains
+ * \note            Since this function is private, it can only be used by user inside GUI library
+ * \note            Use when font memory is released
+ * \retval          None
+ */
+void __GUI_DRAW_FontFallbackFlush(void);
+#endif /* GUI_USE_FONT_FALLBACK || defined(DOXYGEN) */
+#endif /* defined(GUI_INTERNAL) || defined(DOXYGEN) */
+
+#if GUI_USE_IMAGE_CACHE || defined(DOXYGEN)
+/**
+ * \brief           Remove all converted images from cache
+ * \note            Use when source image is modified or its memory is released
+ * \retval          None
+ */
+void GUI_DRAW_ImageCacheClear(void);
+
+/**
+ * \brief           Remove converted image from cache
+ * \note            Use when source image is modified or its memory is released
+ * \param[in]       *img: Pointer to \ref GUI_IMAGE_DESC_t source image descriptor
+ * \retval          None
+ */
+void GUI_DRAW_ImageCacheRemove(const GUI_IMAGE_DESC_t* img);
+#endif /* GUI_USE_IMAGE_CACHE || defined(DOXYGEN) */
+
 /**
  * \} GUI_DRAW
  */
@@ -0,0 +1,369 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2017 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#define GUI_INTERNAL
+#include "gui_hud.h"
+#include "gui_draw.h"
+#include "widgets/gui_window.h"
+
+#if GUI_USE_HUD
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private structures                            **/
+/******************************************************************************/
+/******************************************************************************/
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private definitions                           **/
+/******************************************************************************/
+/******************************************************************************/
+#define __GLYPH_W                   3       /* Glyph width in font pixels */
+#define __GLYPH_H                   5       /* Glyph height in font pixels */
+#define __SCALE                     2       /* Size of font pixel on screen */
+#define __CHAR_W                    ((__GLYPH_W + 1) * __SCALE) /* Character advance */
+#define __LINE_H                    ((__GLYPH_H + 1) * __SCALE) /* Line advance */
+#define __LINES                     4       /* Number of statistics lines */
+#define __LINE_CHARS                9       /* Maximal number of characters in line */
+#define __PANEL_W                   (__LINE_CHARS * __CHAR_W + 2 * __SCALE)
+#define __PANEL_H                   (__LINES * __LINE_H + __SCALE)
+
+#define __COLOR_DIRTY               GUI_COLOR_RED
+#define __COLOR_SKIPPED             GUI_COLOR_BLUE
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private variables                            **/
+/******************************************************************************/
+/******************************************************************************/
+/* 3x5 glyphs, rows from top to bottom, MSB is left pixel */
+static const char __Chars[] = "0123456789FPSTWHusk.";
+static const uint16_t __Glyphs[] = {
+    0x7B6F, 0x2C97, 0x73E7, 0x73CF, 0x5BC9, 0x79CF, 0x79EF, 0x7249, 0x7BEF, 0x7BCF,
+    0x79E4, 0x7BE4, 0x79CF, 0x7492, 0x5B7D, 0x5BED, 0x016F, 0x070E, 0x4BAD, 0x0002
+};
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private functions                            **/
+/******************************************************************************/
+/******************************************************************************/
+/* Extend region with area */
+static
+void __AddRegion(GUI_Display_t* d, const GUI_HUD_Area_t* a) {
+    if (d->X1 > a->X)                   { d->X1 = a->X; }
+    if (d->Y1 > a->Y)                   { d->Y1 = a->Y; }
+    if (d->X2 < a->X + a->Width)        { d->X2 = a->X + a->Width; }
+    if (d->Y2 < a->Y + a->Height)       { d->Y2 = a->Y + a->Height; }
+}
+
+/* Save pixels below area, area is clipped to screen */
+static
+uint8_t __Save(GUI_HUD_t* hud, uint8_t layer, GUI_HUD_Area_t* a, uint32_t reserved) {
+    GUI_iDim_t x, y;
+    GUI_Color_t* p;
+    
+    if (a->X < 0)                       { a->Width += a->X; a->X = 0; }
+    if (a->Y < 0)                       { a->Height += a->Y; a->Y = 0; }
+    if (a->X + a->Width > GUI.LCD.Width)    { a->Width = GUI.LCD.Width - a->X; }
+    if (a->Y + a->Height > GUI.LCD.Height)  { a->Height = GUI.LCD.Height - a->Y; }
+    if (a->Width <= 0 || a->Height <= 0) {
+        return 0;
+    }
+    if (hud->SavedCount >= GUI_COUNT_OF(hud->Saved) ||
+        hud->PixelsUsed + reserved + (uint32_t)a->Width * (uint32_t)a->Height > GUI_COUNT_OF(hud->Pixels)) {
+        return 0;                               /* Not enough memory, do not draw area */
+    }
+    p = &hud->Pixels[hud->PixelsUsed];
+    for (y = a->Y; y < a->Y + a->Height; y++) {
+        for (x = a->X; x < a->X + a->Width; x++) {
+            *p++ = GUI.LL.GetPixel(&GUI.LCD, layer, x, y);
+        }
+    }
+    hud->PixelsUsed += a->Width * a->Height;
+    memcpy(&hud->Saved[hud->SavedCount++], a, sizeof(*a));
+    return 1;
+}
+
+/* Fill area with color after saving pixels below */
+static
+void __Fill(GUI_HUD_t* hud, uint8_t layer, GUI_iDim_t x, GUI_iDim_t y, GUI_iDim_t width, GUI_iDim_t height, GUI_Color_t color, uint32_t reserved) {
+    GUI_HUD_Area_t a;
+    GUI_iDim_t i, j;
+    
+    a.X = x;
+    a.Y = y;
+    a.Width = width;
+    a.Height = height;
+    if (__Save(hud, layer, &a, reserved)) {
+        for (j = a.Y; j < a.Y + a.Height; j++) {
+            for (i = a.X; i < a.X + a.Width; i++) {
+                GUI.LL.SetPixel(&GUI.LCD, layer, i, j, color);
+            }
+        }
+    }
+}
+
+/* Draw string with built-in font, pixels must already be saved */
+static
+void __DrawString(uint8_t layer, GUI_iDim_t x, GUI_iDim_t y, const char* str, GUI_Color_t color) {
+    const char* c;
+    GUI_iDim_t px, py;
+    uint16_t g;
+    uint8_t i, j, s, t;
+    
+    for (; *str; str++, x += __CHAR_W) {
+        if (!(c = strchr(__Chars, *str))) {
+            continue;                           /* Unknown characters are drawn as space */
+        }
+        g = __Glyphs[c - __Chars];
+        for (j = 0; j < __GLYPH_H; j++) {
+            for (i = 0; i < __GLYPH_W; i++) {
+                if (g & (1 << (__GLYPH_W * __GLYPH_H - 1 - (j * __GLYPH_W + i)))) {
+                    for (t = 0; t < __SCALE; t++) {
+                        for (s = 0; s < __SCALE; s++) {
+                            px = x + i * __SCALE + s;
+                            py = y + j * __SCALE + t;
+                            if (px < GUI.LCD.Width && py < GUI.LCD.Height) {    /* Panel may be clipped by screen */
+                                GUI.LL.SetPixel(&GUI.LCD, layer, px, py, color);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+/* Format line with label, number and unit */
+static
+void __FormatLine(char* str, const char* label, uint32_t num, const char* unit) {
+    char tmp[11];
+    uint8_t i = 0;
+    
+    do {
+        tmp[i++] = '0' + num % 10;
+        num /= 10;
+    } while (num);
+    while (*label) {
+        *str++ = *label++;
+    }
+    *str++ = ' ';
+    while (i) {
+        *str++ = tmp[--i];
+    }
+    while (*unit) {
+        *str++ = *unit++;
+    }
+    *str = 0;
+}
+
+/* Add outlined area */
+static
+void __AddFlash(GUI_HUD_t* hud, GUI_iDim_t x, GUI_iDim_t y, GUI_iDim_t width, GUI_iDim_t height, GUI_Color_t color) {
+    GUI_HUD_Flash_t* f = &hud->Flash[hud->FlashPos];
+    
+    f->Area.X = x;
+    f->Area.Y = y;
+    f->Area.Width = width;
+    f->Area.Height = height;
+    f->Color = color;
+    f->Frames = GUI_HUD_FLASH_FRAMES;
+    if (++hud->FlashPos >= GUI_COUNT_OF(hud->Flash)) {
+        hud->FlashPos = 0;                      /* Overwrite oldest area */
+    }
+}
+
+/* Draw overlay on frame */
+static
+void __Draw(GUI_HUD_t* hud, uint8_t layer) {
+    GUI_HUD_Flash_t* f;
+    GUI_HUD_Area_t* a;
+    uint32_t reserved;
+    uint8_t i;
+    char str[__LINES][__LINE_CHARS + 1 + 2];
+    
+    reserved = (hud->Flags & GUI_HUD_FLAG_STATS) ? (__PANEL_W * __PANEL_H) : 0;   /* Keep memory for statistics */
+    for (i = 0; i < GUI_COUNT_OF(hud->Flash); i++) {
+        f = &hud->Flash[i];
+        if (!f->Frames) {
+            continue;
+        }
+        a = &f->Area;
+        f->Frames--;
+        __Fill(hud, layer, a->X, a->Y, a->Width, 1, f->Color, reserved);
+        __Fill(hud, layer, a->X, a->Y + a->Height - 1, a->Width, 1, f->Color, reserved);
+        __Fill(hud, layer, a->X, a->Y + 1, 1, a->Height - 2, f->Color, reserved);
+        __Fill(hud, layer, a->X + a->Width - 1, a->Y + 1, 1, a->Height - 2, f->Color, reserved);
+    }
+    
+    if (hud->Flags & GUI_HUD_FLAG_STATS) {
+        __FormatLine(str[0], "FPS", hud->Stats.FPS, "");
+        __FormatLine(str[1], "T", hud->Stats.FrameTime, "us");
+        __FormatLine(str[2], "W", hud->Stats.Widgets, "");
+        __FormatLine(str[3], "H", hud->Stats.HeapUsed, "");
+        if (strlen(str[3]) > __LINE_CHARS) {    /* Show heap in kilobytes */
+            __FormatLine(str[3], "H", hud->Stats.HeapUsed / 1024, "k");
+        }
+        
+        i = hud->SavedCount;
+        __Fill(hud, layer, 0, 0, __PANEL_W, __PANEL_H, GUI_COLOR_BLACK, 0);
+        if (i != hud->SavedCount) {             /* Panel was drawn */
+            for (i = 0; i < __LINES; i++) {
+                __DrawString(layer, __SCALE, __SCALE + i * __LINE_H, str[i], GUI_COLOR_WHITE);
+            }
+        }
+    }
+}
+
+/******************************************************************************/
+/******************************************************************************/
+/***                                Public API                               **/
+/******************************************************************************/
+/******************************************************************************/
+void __GUI_HUD_Restore(uint8_t layer) {
+    GUI_HUD_t* hud = GUI.Hud;
+    GUI_HUD_Area_t* a;
+    GUI_Color_t* p;
+    GUI_iDim_t x, y;
+    
+    hud->Restored.X1 = 0x7FFF;
+    hud->Restored.Y1 = 0x7FFF;
+    hud->Restored.X2 = 0x8000;
+    hud->Restored.Y2 = 0x8000;
+    
+    p = &hud->Pixels[hud->PixelsUsed];
+    while (hud->SavedCount) {                   /* Restore in reverse order for overlapped areas */
+        a = &hud->Saved[--hud->SavedCount];
+        p -= a->Width * a->Height;
+        for (y = a->Y; y < a->Y + a->Height; y++) {
+            for (x = a->X; x < a->X + a->Width; x++) {
+                GUI.LL.SetPixel(&GUI.LCD, layer, x, y, *p++);
+            }
+        }
+        p -= a->Width * a->Height;
+        __AddRegion(&hud->Restored, a);
+    }
+    hud->PixelsUsed = 0;
+}
+
+void __GUI_HUD_Skipped(GUI_HANDLE_p h) {
+    GUI_HUD_t* hud = GUI.Hud;
+    
+    hud->Skipped++;
+    if (hud->Flags & GUI_HUD_FLAG_SKIPPED) {
+        __AddFlash(hud, __GUI_WIDGET_GetAbsoluteX(h), __GUI_WIDGET_GetAbsoluteY(h), __GUI_WIDGET_GetWidth(h), __GUI_WIDGET_GetHeight(h), __COLOR_SKIPPED);
+    }
+}
+
+void __GUI_HUD_Frame(uint8_t layer, GUI_Display_t* dirty, uint32_t widgets, uint32_t time) {
+    GUI_HUD_t* hud = GUI.Hud;
+#if GUI_USE_MEM_STATS
+    GUI_MEM_Stats_t mem;
+#endif /* GUI_USE_MEM_STATS */
+    uint8_t i;
+    
+    hud->Stats.FrameTime = time;
+    hud->Stats.Widgets = widgets;
+    hud->Stats.Skipped = hud->Skipped;
+#if GUI_USE_MEM_STATS
+    GUI_MEM_GetStats(&mem);                         /* Memory allocated by GUI including headers */
+    hud->Stats.HeapUsed = mem.Total.Bytes + mem.Overhead;
+#else
+    hud->Stats.HeapUsed = GUI_HUD_HEAP_USED();
+#endif /* GUI_USE_MEM_STATS */
+    hud->Skipped = 0;
+    hud->FPSFrames++;
+    if ((uint32_t)(GUI.Time - hud->FPSTime) >= 1000) {  /* Calculate frames in last second */
+        hud->Stats.FPS = hud->FPSFrames * 1000 / (uint32_t)(GUI.Time - hud->FPSTime);
+        hud->FPSFrames = 0;
+        hud->FPSTime = GUI.Time;
+    }
+    
+    if ((hud->Flags & GUI_HUD_FLAG_DIRTY) && dirty->X2 > dirty->X1 && dirty->Y2 > dirty->Y1) {
+        __AddFlash(hud, dirty->X1, dirty->Y1, dirty->X2 - dirty->X1, dirty->Y2 - dirty->Y1, __COLOR_DIRTY);
+    }
+    
+    /* Notify about changed pixels, for example for remote display */
+    if (hud->Restored.X2 > hud->Restored.X1) {
+        if (dirty->X1 > hud->Restored.X1)   { dirty->X1 = hud->Restored.X1; }
+        if (dirty->Y1 > hud->Restored.Y1)   { dirty->Y1 = hud->Restored.Y1; }
+        if (dirty->X2 < hud->Restored.X2)   { dirty->X2 = hud->Restored.X2; }
+        if (dirty->Y2 < hud->Restored.Y2)   { dirty->Y2 = hud->Restored.Y2; }
+    }
+    
+#if GUI_USE_PIPELINE
+    if (GUI.Pipeline) {                         /* Reading pixels would stall rasterization task */
+        return;
+    }
+#endif /* GUI_USE_PIPELINE */
+    
+    __Draw(hud, layer);                         /* Draw overlay */
+    for (i = 0; i < hud->SavedCount; i++) {
+        __AddRegion(dirty, &hud->Saved[i]);
+    }
+}
+
+GUI_Result_t GUI_HUD_SetFlags(uint8_t flags) {
+    GUI_HUD_t* hud;
+    
+    __GUI_ENTER();                              /* Enter GUI */
+    
+    hud = GUI.Hud;
+    if (!hud && flags) {
+        hud = (GUI_HUD_t *)__GUI_MEMALLOC(sizeof(*hud), GUI_MEM_TYPE_OTHER);
+        if (!hud) {
+            __GUI_LEAVE();
+            return guiERROR;
+        }
+        memset(hud, 0x00, sizeof(*hud));
+        hud->FPSTime = GUI.Time;
+        GUI.Hud = hud;
+    }
+    if (hud) {
+        hud->Flags = flags;
+        if (!flags) {                           /* Remove overlay from screen */
+            memset(hud->Flash, 0x00, sizeof(hud->Flash));
+            __GUI_WIDGET_Invalidate(GUI_WINDOW_GetDesktop());
+        }
+    }
+    
+    __GUI_LEAVE();                              /* Leave GUI */
+    return guiOK;
+}
+
+uint8_t GUI_HUD_GetFlags(void) {
+    return GUI.Hud ? GUI.Hud->Flags : 0;
+}
+
+GUI_Result_t GUI_HUD_GetStats(GUI_HUD_Stats_t* stats) {
+    __GUI_ASSERTPARAMS(stats && GUI.Hud);       /* Check input parameters */
+    
+    memcpy(stats, &GUI.Hud->Stats, sizeof(*stats));
+    return guiOK;
+}
+
+#endif /* GUI_USE_HUD */
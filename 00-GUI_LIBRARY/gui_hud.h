@@ -0,0 +1,183 @@
+/**
+ * \author  Tilen Majerle <tilen@majerle.eu>
+ * \brief   GUI debug overlay
+ *	
+\verbatim
+   ----------------------------------------------------------------------
+    Copyright (c) 2017 Tilen Majerle
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge,
+    publish, distribute, sublicense, and/or sell copies of the Software, 
+    and to permit persons to whom the Software is furnished to do so, 
+    subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+    AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+   ----------------------------------------------------------------------
+\endverbatim
+ */
+#ifndef GUI_HUD_H
+#define GUI_HUD_H
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \defgroup        GUI_HUD Debug overlay
+ * \brief           Frame statistics and dirty region visualization
+ * \{
+ *
+ * Overlay shows number of frames per second, time to draw last frame,
+ * number of widgets redrawn and heap usage in top left corner of screen.
+ * Optionally, dirty region of each frame and widgets which were skipped because
+ * they are outside of dirty region are outlined for \ref GUI_HUD_FLASH_FRAMES frames.
+ *
+ * Overlay is drawn after frame is measured, directly before layer is shown.
+ * Pixels below overlay are saved and restored on next frame before widgets are redrawn,
+ * therefore overlay does not force any widget redraw and does not change measurements.
+ *
+ * \note            Frame time is measured with DWT cycle counter which must be enabled by user
+ * \note            When pipelined rendering is active, overlay is not drawn, statistics are available with \ref GUI_HUD_GetStats
+ */
+
+#include "gui.h"
+
+#if GUI_USE_HUD || defined(DOXYGEN)
+
+#define GUI_HUD_FLAG_STATS          0x01    /*!< Show frame statistics */
+#define GUI_HUD_FLAG_DIRTY          0x02    /*!< Outline dirty region of each frame */
+#define GUI_HUD_FLAG_SKIPPED        0x04    /*!< Outline widgets skipped because they are outside of dirty region */
+
+/**
+ * \brief           Number of outlined regions remembered at a time
+ */
+#define GUI_HUD_FLASH_COUNT         16
+
+/**
+ * \brief           Frame statistics
+ */
+typedef struct GUI_HUD_Stats_t {
+    uint32_t FPS;                           /*!< Number of frames drawn in last second */
+    uint32_t FrameTime;                     /*!< Time to redraw widgets in last frame in units of microseconds */
+    uint32_t Widgets;                       /*!< Number of widgets redrawn in last frame, as returned by \ref GUI_Process */
+    uint32_t Skipped;                       /*!< Number of widgets marked for redraw but outside of dirty region in last frame */
+    uint32_t HeapUsed;                      /*!< Number of bytes allocated by GUI with \ref GUI_USE_MEM_STATS, otherwise \ref GUI_HUD_HEAP_USED */
+} GUI_HUD_Stats_t;
+
+/**
+ * \brief           Rectangle area on screen
+ */
+typedef struct GUI_HUD_Area_t {
+    GUI_iDim_t X;                           /*!< Start X position */
+    GUI_iDim_t Y;                           /*!< Start Y position */
+    GUI_iDim_t Width;                       /*!< Area width */
+    GUI_iDim_t Height;                      /*!< Area height */
+} GUI_HUD_Area_t;
+
+/**
+ * \brief           Outlined region
+ */
+typedef struct GUI_HUD_Flash_t {
+    GUI_HUD_Area_t Area;                    /*!< Outlined area */
+    GUI_Color_t Color;                      /*!< Outline color */
+    uint8_t Frames;                         /*!< Number of frames left to show outline */
+} GUI_HUD_Flash_t;
+
+/**
+ * \brief           Debug overlay object
+ */
+typedef struct GUI_HUD_t {
+    uint8_t Flags;                          /*!< Enabled parts of overlay */
+    GUI_HUD_Stats_t Stats;                  /*!< Statistics of last frame */
+    uint32_t FPSTime;                       /*!< Start time of current second */
+    uint32_t FPSFrames;                     /*!< Number of frames in current second */
+    uint32_t Skipped;                       /*!< Number of widgets skipped in current frame */
+    GUI_Display_t Restored;                 /*!< Region restored at start of current frame */
+    
+    GUI_HUD_Flash_t Flash[GUI_HUD_FLASH_COUNT]; /*!< Outlined regions */
+    uint8_t FlashPos;                       /*!< Position for next outlined region */
+    
+    GUI_HUD_Area_t Saved[4 * GUI_HUD_FLASH_COUNT + 1];  /*!< Areas below overlay */
+    uint8_t SavedCount;                     /*!< Number of saved areas */
+    GUI_Color_t Pixels[GUI_HUD_SAVE_PIXELS];    /*!< Pixels below overlay */
+    uint32_t PixelsUsed;                    /*!< Number of saved pixels */
+} GUI_HUD_t;
+
+/**
+ * \brief           Set visible parts of debug overlay for current GUI context
+ * \note            Memory for overlay is allocated on first call with non-zero flags
+ * \param[in]       flags: Bitwise OR of \ref GUI_HUD_FLAG_STATS, \ref GUI_HUD_FLAG_DIRTY and \ref GUI_HUD_FLAG_SKIPPED, 0 to hide overlay
+ * \retval          Member of \ref GUI_Result_t enumeration
+ */
+GUI_Result_t GUI_HUD_SetFlags(uint8_t flags);
+
+/**
+ * \brief           Get visible parts of debug overlay for current GUI context
+ * \retval          Bitwise OR of enabled flags
+ */
+uint8_t GUI_HUD_GetFlags(void);
+
+/**
+ * \brief           Get statistics of last frame for current GUI context
+ * \param[out]      *stats: Pointer to \ref GUI_HUD_Stats_t structure to fill
+ * \retval          Member of \ref GUI_Result_t enumeration
+ */
+GUI_Result_t GUI_HUD_GetStats(GUI_HUD_Stats_t* stats);
+
+#if defined(GUI_INTERNAL) || defined(DOXYGEN)
+
+/**
+ * \brief           Restore pixels below overlay of previous frame
+ * \note            Since this function is private, it can only be used by user inside GUI library
+ * \param[in]       layer: Layer to restore pixels to
+ * \retval          None
+ */
+void __GUI_HUD_Restore(uint8_t layer);
+
+/**
+ * \brief           Notify overlay about widget not drawn because it is outside of dirty region
+ * \note            Since this function is private, it can only be used by user inside GUI library
+ * \param[in,out]   h: Widget handle
+ * \retval          None
+ */
+void __GUI_HUD_Skipped(GUI_HANDLE_p h);
+
+/**
+ * \brief           Update statistics and draw overlay on finished frame
+ * \note            Since this function is private, it can only be used by user inside GUI library
+ * \param[in]       layer: Layer with drawn frame
+ * \param[in,out]   *dirty: Dirty region of frame, extended with restored and overlay areas
+ * \param[in]       widgets: Number of widgets redrawn in frame
+ * \param[in]       time: Time to redraw widgets in units of microseconds
+ * \retval          None
+ */
+void __GUI_HUD_Frame(uint8_t layer, GUI_Display_t* dirty, uint32_t widgets, uint32_t time);
+
+#endif /* defined(GUI_INTERNAL) || defined(DOXYGEN) */
+
+#endif /* GUI_USE_HUD || defined(DOXYGEN) */
+
+/**
+ * \}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
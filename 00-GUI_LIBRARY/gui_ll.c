@@ -211,6 +211,18 @@ GUI_Color_t LCD_GetPixel(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y
     return *(volatile GUI_Color_t *)(LCD_FRAME_BUFFER + (layer * LCD_FRAME_BUFFER_SIZE) + LCD_PIXEL_SIZE * (LCD_WIDTH * y + x));
 }
 
+void LCD_BlendPixel(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y, GUI_Color_t color) {
+    volatile uint32_t* addr = (volatile uint32_t *)(Layers[layer].StartAddress + LCD_PIXEL_SIZE * (LCD_WIDTH * y + x));
+    uint32_t bg = *addr, a = color >> 24, rb, ag;
+    
+    /* Move each channel towards color, 2 channels in single multiplication */
+    rb = bg & 0x00FF00FFUL;                         /* Red and blue channel */
+    rb += (((color & 0x00FF00FFUL) - rb) * a) >> 8;
+    ag = (bg >> 8) & 0x00FF00FFUL;                  /* Alpha and green channel, alpha moves towards opaque */
+    ag += (((((color >> 8) & 0xFFUL) | 0x00FF0000UL) - ag) * a) >> 8;
+    *addr = ((ag & 0x00FF00FFUL) << 8) | (rb & 0x00FF00FFUL);
+}
+
 void LCD_Fill(GUI_LCD_t* LCD, uint8_t layer, void* dst, GUI_Dim_t xSize, GUI_Dim_t ySize, GUI_Dim_t OffLine, GUI_Color_t color) {
     DMA2D->CR = 0x00030000UL;                       /* Register to memory and TCIE */
     DMA2D->OCOLR = color;                           /* Color to be used */
@@ -262,6 +274,78 @@ void LCD_FillRect(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y, GUI_D
     LCD_Fill(LCD, layer, (void *)addr, xSize, ySize, LCD->Width - xSize, color);
 }
 
+uint8_t LCD_DrawImage(GUI_LCD_t* LCD, uint8_t layer, const GUI_IMAGE_DESC_t* img, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t xOff, GUI_Dim_t yOff, GUI_Dim_t width, GUI_Dim_t height, GUI_Color_t color) {
+    uint32_t addr = Layers[layer].StartAddress + (LCD_PIXEL_SIZE * (LCD->Width * y + x));
+    uint32_t src, fgpfccr;
+    
+    switch (img->Format) {
+        case GUI_IMAGE_FORMAT_ARGB8888:
+            src = (uint32_t)img->Data + 4 * ((uint32_t)img->Width * yOff + xOff);
+            fgpfccr = DMA2D_INPUT_ARGB8888;
+            break;
+        case GUI_IMAGE_FORMAT_RGB565:
+            src = (uint32_t)img->Data + 2 * ((uint32_t)img->Width * yOff + xOff);
+            fgpfccr = DMA2D_INPUT_RGB565;
+            break;
+        case GUI_IMAGE_FORMAT_L8:
+            if (!img->CLUT || !img->CLUTSize) {
+                return 0;
+            }
+            src = (uint32_t)img->Data + (uint32_t)img->Width * yOff + xOff;
+            fgpfccr = DMA2D_INPUT_L8;
+            break;
+        case GUI_IMAGE_FORMAT_A8:
+            src = (uint32_t)img->Data + (uint32_t)img->Width * yOff + xOff;
+            fgpfccr = DMA2D_INPUT_A8 | (0x02UL << 16) | (color & 0xFF000000UL);   /* Multiply alpha with color alpha */
+            break;
+        case GUI_IMAGE_FORMAT_A4:
+            if ((xOff | width | img->Width) & 0x01) {   /* DMA2D needs byte aligned lines in A4 mode, it reads first pixel from low nibble */
+                return 0;
+            }
+            src = (uint32_t)img->Data + ((uint32_t)img->Width * yOff + xOff) / 2;
+            fgpfccr = DMA2D_INPUT_A4 | (0x02UL << 16) | (color & 0xFF000000UL);   /* Multiply alpha with color alpha */
+            break;
+        default:
+            return 0;
+    }
+    
+    if (img->Format == GUI_IMAGE_FORMAT_L8) {       /* Load color lookup table first */
+        DMA2D->FGCMAR = (uint32_t)img->CLUT;
+        DMA2D->FGPFCCR = fgpfccr | ((uint32_t)(img->CLUTSize - 1) << 8);
+        DMA2D->FGPFCCR |= DMA2D_FGPFCCR_START;
+        
+        while (DMA2D->FGPFCCR & DMA2D_FGPFCCR_START);
+        fgpfccr |= (uint32_t)(img->CLUTSize - 1) << 8;
+    }
+    
+    if (img->Format == GUI_IMAGE_FORMAT_RGB565) {
+        DMA2D->CR = 0x00010000UL;                   /* Memory to memory with pixel format conversion */
+    } else {
+        DMA2D->CR = 0x00020000UL;                   /* Memory to memory with blending */
+        DMA2D->BGMAR = addr;                        /* Background is current screen content */
+        DMA2D->BGOR = LCD->Width - width;
+        DMA2D->BGPFCCR = LTDC_PIXEL_FORMAT_ARGB8888;
+    }
+    
+    /* Set up pointers */
+    DMA2D->FGMAR = src;
+    DMA2D->FGOR = img->Width - width;
+    DMA2D->FGCOLR = color & 0x00FFFFFFUL;           /* Used in A8 and A4 modes */
+    DMA2D->FGPFCCR = fgpfccr;
+    DMA2D->OMAR = addr;
+    DMA2D->OOR = LCD->Width - width;
+    DMA2D->OPFCCR = LTDC_PIXEL_FORMAT_ARGB8888;
+    
+    /* Set up size */
+    DMA2D->NLR = (uint32_t)(width << 16) | (uint16_t)height;
+    
+    /* Start DMA2D */
+    DMA2D->CR |= DMA2D_CR_START;
+    
+    while (DMA2D->CR & DMA2D_CR_START);
+    return 1;
+}
+
 /* IRQ function for LTDC */
 void LTDC_IRQHandler(void) {
     HAL_LTDC_IRQHandler(&LTDCHandle);
@@ -318,6 +402,8 @@ uint8_t GUI_LL_Init(GUI_LCD_t* LCD, GUI_LL_t* LL) {
     LL->DrawVLine = &LCD_DrawVLine;             /* Set drawing horizontal line routine */
     LL->Fill = &LCD_Fill;                       /* Set fill screen routine */
     LL->FillRect = &LCD_FillRect;               /* Set fill rectangle routine */
+    LL->DrawImage = &LCD_DrawImage;             /* Set image drawing routine */
+    LL->BlendPixel = &LCD_BlendPixel;           /* Set pixel blending routine for anti-aliasing */
     
     return 0;                                   /* Initialization successful */
 }
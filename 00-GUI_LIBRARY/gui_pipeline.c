@@ -0,0 +1,542 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2017 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#define GUI_INTERNAL
+#include "gui_pipeline.h"
+#include "gui_draw.h"
+#include "gui_remote.h"
+
+#if GUI_USE_PIPELINE
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private structures                            **/
+/******************************************************************************/
+/******************************************************************************/
+typedef enum __GUI_PIPELINE_CmdType_t {
+    __CMD_SetPixel = 0x00,                  /* Set single pixel */
+    __CMD_MixPixel,                         /* Mix pixel with screen content */
+    __CMD_BlendPixel,                       /* Blend color with alpha over screen content */
+    __CMD_Fill,                             /* Fill memory area */
+    __CMD_Copy,                             /* Copy memory area */
+    __CMD_HLine,                            /* Horizontal line */
+    __CMD_VLine,                            /* Vertical line */
+    __CMD_FillRect,                         /* Filled rectangle */
+    __CMD_Image,                            /* Image with pixels stored after command */
+    __CMD_Present,                          /* End of frame, show layer */
+} __GUI_PIPELINE_CmdType_t;
+
+typedef struct __GUI_PIPELINE_Cmd_t {
+    uint8_t Type;                           /* Command type */
+    uint8_t Layer;                          /* Layer number to draw on */
+    uint16_t Size;                          /* Command size including data after it */
+} __GUI_PIPELINE_Cmd_t;
+
+typedef struct __GUI_PIPELINE_CmdPixel_t {
+    __GUI_PIPELINE_Cmd_t C;
+    GUI_Dim_t X, Y;                         /* Pixel position */
+    GUI_Color_t Color;                      /* Pixel color */
+    uint8_t Weight;                         /* Anti-alias weight for mixed pixel */
+} __GUI_PIPELINE_CmdPixel_t;
+
+typedef struct __GUI_PIPELINE_CmdRect_t {
+    __GUI_PIPELINE_Cmd_t C;
+    GUI_Dim_t X, Y;                         /* Top left position */
+    GUI_Dim_t Width, Height;                /* Size of rectangle, width is length of line */
+    GUI_Color_t Color;                      /* Fill color */
+} __GUI_PIPELINE_CmdRect_t;
+
+typedef struct __GUI_PIPELINE_CmdMem_t {
+    __GUI_PIPELINE_Cmd_t C;
+    void* Src;                              /* Source memory for copy */
+    void* Dst;                              /* Destination memory */
+    GUI_Dim_t Width, Height;                /* Size of area */
+    GUI_Dim_t OffLineSrc, OffLineDst;       /* Line offsets */
+    GUI_Color_t Color;                      /* Fill color */
+} __GUI_PIPELINE_CmdMem_t;
+
+typedef struct __GUI_PIPELINE_CmdPresent_t {
+    __GUI_PIPELINE_Cmd_t C;
+    uint8_t Prev;                           /* Layer with previous frame */
+    GUI_Display_t Dirty;                    /* Region changed in frame */
+} __GUI_PIPELINE_CmdPresent_t;
+
+typedef struct __GUI_PIPELINE_CmdImage_t {
+    __GUI_PIPELINE_Cmd_t C;
+    GUI_IMAGE_DESC_t Img;                   /* Image with data pointing after command */
+    GUI_Dim_t X, Y;                         /* Position on screen */
+    GUI_Dim_t XOff;                         /* X offset in copied image */
+    GUI_Dim_t Width, Height;                /* Size of drawn part */
+    GUI_Color_t Color;                      /* Color for alpha-only formats */
+} __GUI_PIPELINE_CmdImage_t;
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private definitions                           **/
+/******************************************************************************/
+/******************************************************************************/
+#define __ALIGN(x)                  (((x) + (sizeof(void *) - 1)) & ~(sizeof(void *) - 1))
+#define __BLOCK_SIZE                __ALIGN(GUI_PIPELINE_BLOCK_SIZE)
+#define __BLOCK(p, n)               (&(p)->Blocks[((n) % GUI_PIPELINE_BLOCKS) * __BLOCK_SIZE])
+
+#ifndef GUI_PIPELINE_YIELD
+#error "GUI_PIPELINE_YIELD() must be defined in gui_config.h to let other task run while waiting"
+#endif /* GUI_PIPELINE_YIELD */
+
+#ifndef GUI_PIPELINE_STOP_TIMEOUT
+#define GUI_PIPELINE_STOP_TIMEOUT   100
+#endif /* GUI_PIPELINE_STOP_TIMEOUT */
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private variables                            **/
+/******************************************************************************/
+/******************************************************************************/
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private functions                            **/
+/******************************************************************************/
+/******************************************************************************/
+/* Send recorded block to rasterization */
+static
+void __Submit(GUI_PIPELINE_t* p) {
+    if (p->Recording) {
+        p->Used[p->Submitted % GUI_PIPELINE_BLOCKS] = p->Pos;
+        GUI_PIPELINE_BARRIER();                     /* Block must be written before it is visible */
+        p->Submitted++;
+        p->Recording = 0;
+    }
+}
+
+/* Submit recorded commands and wait until they are rasterized */
+static
+void __Flush(GUI_PIPELINE_t* p) {
+    __Submit(p);
+    if (p->Consumed != p->Submitted) {
+        p->Flushes++;
+        while (p->Consumed != p->Submitted) {
+            GUI_PIPELINE_YIELD();
+            GUI_PIPELINE_BARRIER();
+        }
+    }
+}
+
+/* Get free block space in units of bytes */
+static
+uint32_t __GetFree(GUI_PIPELINE_t* p) {
+    return p->Recording ? (__BLOCK_SIZE - p->Pos) : __BLOCK_SIZE;
+}
+
+/* Reserve memory for new command */
+static
+void* __Alloc(GUI_PIPELINE_t* p, uint8_t type, uint8_t layer, uint32_t size) {
+    __GUI_PIPELINE_Cmd_t* cmd;
+    
+    size = __ALIGN(size);
+    if (p->Recording && (p->Pos + size) > __BLOCK_SIZE) {   /* Command does not fit to current block */
+        __Submit(p);
+    }
+    if (!p->Recording) {                            /* Acquire new block */
+        while ((p->Submitted - p->Consumed) >= GUI_PIPELINE_BLOCKS) {
+            GUI_PIPELINE_YIELD();                   /* Wait for rasterization to release block */
+            GUI_PIPELINE_BARRIER();
+        }
+        p->Recording = 1;
+        p->Pos = 0;
+    }
+    cmd = (__GUI_PIPELINE_Cmd_t *)(__BLOCK(p, p->Submitted) + p->Pos);
+    cmd->Type = type;
+    cmd->Layer = layer;
+    cmd->Size = (uint16_t)size;
+    p->Pos += size;
+    return cmd;
+}
+
+/* Get line size of uncompressed image in units of bytes */
+static
+uint32_t __ImageGetLineSize(const GUI_IMAGE_DESC_t* img) {
+    switch (img->Format) {
+        case GUI_IMAGE_FORMAT_ARGB8888: return (uint32_t)img->Width * 4;
+        case GUI_IMAGE_FORMAT_RGB565:   return (uint32_t)img->Width * 2;
+        case GUI_IMAGE_FORMAT_A4:       return ((uint32_t)img->Width + 1) / 2;
+        default:                        return (uint32_t)img->Width;
+    }
+}
+
+/* Recording low-level functions */
+static
+void __SetPixel(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y, GUI_Color_t color) {
+    __GUI_PIPELINE_CmdPixel_t* cmd = __Alloc(GUI.Pipeline, __CMD_SetPixel, layer, sizeof(*cmd));
+    __GUI_UNUSED(LCD);                              /* Low-level driver gets LCD when rasterizing */
+    cmd->X = x;
+    cmd->Y = y;
+    cmd->Color = color;
+}
+
+static
+void __BlendPixel(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y, GUI_Color_t color) {
+    __GUI_PIPELINE_CmdPixel_t* cmd = __Alloc(GUI.Pipeline, __CMD_BlendPixel, layer, sizeof(*cmd));
+    __GUI_UNUSED(LCD);                              /* Low-level driver gets LCD when rasterizing */
+    cmd->X = x;
+    cmd->Y = y;
+    cmd->Color = color;
+}
+
+static
+GUI_Color_t __GetPixel(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y) {
+    __Flush(GUI.Pipeline);                          /* Screen must be up to date first */
+    return GUI.Pipeline->LL.GetPixel(LCD, layer, x, y);
+}
+
+static
+void __Fill(GUI_LCD_t* LCD, uint8_t layer, void* dst, GUI_Dim_t xSize, GUI_Dim_t ySize, GUI_Dim_t offLine, GUI_Color_t color) {
+    __GUI_PIPELINE_CmdMem_t* cmd = __Alloc(GUI.Pipeline, __CMD_Fill, layer, sizeof(*cmd));
+    __GUI_UNUSED(LCD);                              /* Low-level driver gets LCD when rasterizing */
+    cmd->Dst = dst;
+    cmd->Width = xSize;
+    cmd->Height = ySize;
+    cmd->OffLineDst = offLine;
+    cmd->Color = color;
+}
+
+static
+void __Copy(GUI_LCD_t* LCD, uint8_t layer, void* src, void* dst, GUI_Dim_t xSize, GUI_Dim_t ySize, GUI_Dim_t offLineSrc, GUI_Dim_t offLineDst) {
+    __GUI_PIPELINE_CmdMem_t* cmd = __Alloc(GUI.Pipeline, __CMD_Copy, layer, sizeof(*cmd));
+    __GUI_UNUSED(LCD);                              /* Low-level driver gets LCD when rasterizing */
+    cmd->Src = src;
+    cmd->Dst = dst;
+    cmd->Width = xSize;
+    cmd->Height = ySize;
+    cmd->OffLineSrc = offLineSrc;
+    cmd->OffLineDst = offLineDst;
+}
+
+static
+void __DrawLine(uint8_t type, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t width, GUI_Dim_t height, GUI_Color_t color) {
+    __GUI_PIPELINE_CmdRect_t* cmd = __Alloc(GUI.Pipeline, type, layer, sizeof(*cmd));
+    cmd->X = x;
+    cmd->Y = y;
+    cmd->Width = width;
+    cmd->Height = height;
+    cmd->Color = color;
+}
+
+static
+void __DrawHLine(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t length, GUI_Color_t color) {
+    __GUI_UNUSED(LCD);                              /* Low-level driver gets LCD when rasterizing */
+    __DrawLine(__CMD_HLine, layer, x, y, length, 1, color);
+}
+
+static
+void __DrawVLine(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t length, GUI_Color_t color) {
+    __GUI_UNUSED(LCD);                              /* Low-level driver gets LCD when rasterizing */
+    __DrawLine(__CMD_VLine, layer, x, y, length, 1, color);
+}
+
+static
+void __FillRect(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t xSize, GUI_Dim_t ySize, GUI_Color_t color) {
+    __GUI_UNUSED(LCD);                              /* Low-level driver gets LCD when rasterizing */
+    __DrawLine(__CMD_FillRect, layer, x, y, xSize, ySize, color);
+}
+
+static
+uint8_t __DrawImage(GUI_LCD_t* LCD, uint8_t layer, const GUI_IMAGE_DESC_t* img, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t xOff, GUI_Dim_t yOff, GUI_Dim_t width, GUI_Dim_t height, GUI_Color_t color) {
+    GUI_PIPELINE_t* p = GUI.Pipeline;
+    __GUI_PIPELINE_CmdImage_t* cmd;
+    const GUI_Byte* src;
+    GUI_Byte* data;
+    uint32_t lineSize, bytes, start, clut, head, n, i, k;
+    GUI_Dim_t imgWidth, xStart;
+    
+    if (GUI_IMGDEC_IsCompressed(img->Format)) {    /* Compressed images are decoded to chunks by caller */
+        return 0;
+    }
+    
+    /* Get part of each line to copy */
+    lineSize = __ImageGetLineSize(img);
+    switch (img->Format) {
+        case GUI_IMAGE_FORMAT_ARGB8888: start = (uint32_t)xOff * 4; bytes = (uint32_t)width * 4; break;
+        case GUI_IMAGE_FORMAT_RGB565:   start = (uint32_t)xOff * 2; bytes = (uint32_t)width * 2; break;
+        case GUI_IMAGE_FORMAT_A4:       start = (uint32_t)xOff / 2; bytes = ((uint32_t)xOff + width + 1) / 2 - start; break;
+        default:                        start = (uint32_t)xOff;     bytes = (uint32_t)width;     break;
+    }
+    imgWidth = img->Format == GUI_IMAGE_FORMAT_A4 ? (GUI_Dim_t)(2 * bytes) : width;
+    xStart = img->Format == GUI_IMAGE_FORMAT_A4 ? (xOff & 0x01) : 0;
+    clut = (img->Format == GUI_IMAGE_FORMAT_L8 && img->CLUT) ? __ALIGN(img->CLUTSize * sizeof(GUI_Color_t)) : 0;
+    head = __ALIGN(sizeof(*cmd)) + clut;
+    
+    if ((head + bytes) > __BLOCK_SIZE) {            /* Single line does not fit to block, draw directly */
+        __Flush(p);
+        if (!p->LL.DrawImage || !p->LL.DrawImage(LCD, layer, img, x, y, xOff, yOff, width, height, color)) {
+            __GUI_DRAW_ImageSoftware(LCD, &p->LL, layer, img, x, y, xOff, yOff, width, height, color);
+        }
+        return 1;
+    }
+    
+    src = img->Data + lineSize * yOff + start;
+    for (i = 0; i < (uint32_t)height; i += n) {
+        n = (__GetFree(p) >= (head + bytes) ? __GetFree(p) : __BLOCK_SIZE) - head;
+        n = __GUI_MIN(n / bytes, (uint32_t)height - i); /* Number of lines in this command */
+        
+        cmd = __Alloc(p, __CMD_Image, layer, head + n * bytes);
+        data = (GUI_Byte *)cmd + __ALIGN(sizeof(*cmd));
+        memset(&cmd->Img, 0x00, sizeof(cmd->Img));
+        cmd->Img.Format = img->Format;
+        cmd->Img.Width = imgWidth;
+        cmd->Img.Height = (GUI_Dim_t)n;
+        cmd->Img.Size = n * bytes;
+        if (clut) {                                 /* Copy color lookup table */
+            memcpy(data, img->CLUT, img->CLUTSize * sizeof(GUI_Color_t));
+            cmd->Img.CLUT = (const GUI_Color_t *)data;
+            cmd->Img.CLUTSize = img->CLUTSize;
+            data += clut;
+        }
+        cmd->Img.Data = data;
+        for (k = 0; k < n; k++, src += lineSize, data += bytes) {
+            memcpy(data, src, bytes);               /* Copy visible part of line */
+        }
+        cmd->X = x;
+        cmd->Y = y + (GUI_Dim_t)i;
+        cmd->XOff = xStart;
+        cmd->Width = width;
+        cmd->Height = (GUI_Dim_t)n;
+        cmd->Color = color;
+    }
+    return 1;
+}
+
+/* Execute single command with low-level driver */
+static
+void __Execute(GUI_t* ctx, GUI_PIPELINE_t* p, const __GUI_PIPELINE_Cmd_t* c) {
+    GUI_LCD_t* LCD = &ctx->LCD;
+    GUI_LL_t* LL = &p->LL;
+    uint8_t layer = c->Layer;
+    
+    switch (c->Type) {
+        case __CMD_SetPixel: {
+            const __GUI_PIPELINE_CmdPixel_t* cmd = (const __GUI_PIPELINE_CmdPixel_t *)c;
+            LL->SetPixel(LCD, layer, cmd->X, cmd->Y, cmd->Color);
+            break;
+        }
+        case __CMD_MixPixel: {
+            const __GUI_PIPELINE_CmdPixel_t* cmd = (const __GUI_PIPELINE_CmdPixel_t *)c;
+            LL->SetPixel(LCD, layer, cmd->X, cmd->Y, __GUI_DRAW_AAColor(LL->GetPixel(LCD, layer, cmd->X, cmd->Y), cmd->Color, cmd->Weight));
+            break;
+        }
+        case __CMD_BlendPixel: {
+            const __GUI_PIPELINE_CmdPixel_t* cmd = (const __GUI_PIPELINE_CmdPixel_t *)c;
+            __GUI_DRAW_BlendPixel(LCD, LL, layer, cmd->X, cmd->Y, cmd->Color);
+            break;
+        }
+        case __CMD_Fill: {
+            const __GUI_PIPELINE_CmdMem_t* cmd = (const __GUI_PIPELINE_CmdMem_t *)c;
+            LL->Fill(LCD, layer, cmd->Dst, cmd->Width, cmd->Height, cmd->OffLineDst, cmd->Color);
+            break;
+        }
+        case __CMD_Copy: {
+            const __GUI_PIPELINE_CmdMem_t* cmd = (const __GUI_PIPELINE_CmdMem_t *)c;
+            LL->Copy(LCD, layer, cmd->Src, cmd->Dst, cmd->Width, cmd->Height, cmd->OffLineSrc, cmd->OffLineDst);
+            break;
+        }
+        case __CMD_HLine: {
+            const __GUI_PIPELINE_CmdRect_t* cmd = (const __GUI_PIPELINE_CmdRect_t *)c;
+            LL->DrawHLine(LCD, layer, cmd->X, cmd->Y, cmd->Width, cmd->Color);
+            break;
+        }
+        case __CMD_VLine: {
+            const __GUI_PIPELINE_CmdRect_t* cmd = (const __GUI_PIPELINE_CmdRect_t *)c;
+            LL->DrawVLine(LCD, layer, cmd->X, cmd->Y, cmd->Width, cmd->Color);
+            break;
+        }
+        case __CMD_FillRect: {
+            const __GUI_PIPELINE_CmdRect_t* cmd = (const __GUI_PIPELINE_CmdRect_t *)c;
+            LL->FillRect(LCD, layer, cmd->X, cmd->Y, cmd->Width, cmd->Height, cmd->Color);
+            break;
+        }
+        case __CMD_Image: {
+            const __GUI_PIPELINE_CmdImage_t* cmd = (const __GUI_PIPELINE_CmdImage_t *)c;
+            if (!LL->DrawImage || !LL->DrawImage(LCD, layer, &cmd->Img, cmd->X, cmd->Y, cmd->XOff, 0, cmd->Width, cmd->Height, cmd->Color)) {
+                __GUI_DRAW_ImageSoftware(LCD, LL, layer, &cmd->Img, cmd->X, cmd->Y, cmd->XOff, 0, cmd->Width, cmd->Height, cmd->Color);
+            }
+            break;
+        }
+        case __CMD_Present: {
+#if GUI_USE_REMOTE
+            const __GUI_PIPELINE_CmdPresent_t* cmd = (const __GUI_PIPELINE_CmdPresent_t *)c;
+            if (ctx->Remote) {                      /* Send changes to remote viewer */
+                __GUI_REMOTE_Frame(ctx, LL, layer, cmd->Prev, &cmd->Dirty);
+            }
+#endif /* GUI_USE_REMOTE */
+            LCD->Layers[layer].Pending = 1;         /* Set drawing layer as pending */
+            LCD->Flags |= GUI_FLAG_LCD_WAIT_LAYER_CONFIRM;  /* Next frame waits for confirmation */
+            GUI_LL_Control(LCD, GUI_LL_Command_SetActiveLayer, &layer); /* Set new active layer to low-level driver */
+            p->FramesDone++;
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+/******************************************************************************/
+/******************************************************************************/
+/***                                Public API                               **/
+/******************************************************************************/
+/******************************************************************************/
+uint8_t __GUI_PIPELINE_IsBusy(void) {
+    GUI_PIPELINE_t* p = GUI.Pipeline;
+    return (p->FramesRecorded - p->FramesDone) >= GUI_PIPELINE_FRAMES;
+}
+
+void __GUI_PIPELINE_Present(uint8_t layer, uint8_t prev, const GUI_Display_t* dirty) {
+    GUI_PIPELINE_t* p = GUI.Pipeline;
+    __GUI_PIPELINE_CmdPresent_t* cmd;
+    
+    cmd = __Alloc(p, __CMD_Present, layer, sizeof(*cmd));
+    cmd->Prev = prev;
+    memcpy(&cmd->Dirty, dirty, sizeof(cmd->Dirty));
+    p->FramesRecorded++;
+    __Submit(p);                                    /* Frame always ends block */
+}
+
+void __GUI_PIPELINE_MixPixel(GUI_Dim_t x, GUI_Dim_t y, GUI_Color_t color, uint8_t weight) {
+    __GUI_PIPELINE_CmdPixel_t* cmd = __Alloc(GUI.Pipeline, __CMD_MixPixel, GUI.LCD.DrawingLayer, sizeof(*cmd));
+    cmd->X = x;
+    cmd->Y = y;
+    cmd->Color = color;
+    cmd->Weight = weight;
+}
+
+GUI_Result_t GUI_PIPELINE_Enable(void) {
+    GUI_PIPELINE_t* p;
+    
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    if (GUI.Pipeline) {                             /* Already enabled */
+        __GUI_LEAVE();
+        return guiOK;
+    }
+    p = (GUI_PIPELINE_t *)__GUI_MEMALLOC(sizeof(*p), GUI_MEM_TYPE_OTHER);
+    if (!p) {
+        __GUI_LEAVE();
+        return guiERROR;
+    }
+    memset(p, 0x00, sizeof(*p));
+    p->Blocks = (GUI_Byte *)__GUI_MEMALLOC(GUI_PIPELINE_BLOCKS * __BLOCK_SIZE, GUI_MEM_TYPE_OTHER);
+    if (!p->Blocks) {
+        __GUI_MEMFREE(p);
+        __GUI_LEAVE();
+        return guiERROR;
+    }
+    
+    memcpy(&p->LL, &GUI.LL, sizeof(p->LL));         /* Save low-level driver for rasterization */
+    GUI.LL.SetPixel = __SetPixel;                   /* Record all drawing operations */
+    GUI.LL.GetPixel = __GetPixel;
+    GUI.LL.Fill = __Fill;
+    GUI.LL.Copy = __Copy;
+    GUI.LL.DrawHLine = __DrawHLine;
+    GUI.LL.DrawVLine = __DrawVLine;
+    GUI.LL.FillRect = __FillRect;
+    GUI.LL.DrawImage = __DrawImage;
+    GUI.LL.BlendPixel = __BlendPixel;
+    GUI_PIPELINE_BARRIER();
+    GUI.Pipeline = p;
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return guiOK;
+}
+
+GUI_Result_t GUI_PIPELINE_Disable(void) {
+    GUI_PIPELINE_t* p;
+    uint32_t polls, wait = 0;
+    
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    p = GUI.Pipeline;
+    if (p) {
+        __Submit(p);                                /* Remaining commands are rasterized by rasterization task */
+        GUI_PIPELINE_BARRIER();
+        p->Stop = 1;                                /* Request stop from rasterization task */
+        polls = p->Polls;
+        while (!p->Stopped) {                       /* Wait until task does not use pipeline anymore */
+            if (wait >= GUI_PIPELINE_STOP_TIMEOUT) {    /* No rasterization task, rasterize remaining commands here */
+                GUI_PIPELINE_Process(&GUI);
+                if (p->Stopped) {
+                    break;
+                }
+            }
+            GUI_PIPELINE_YIELD();
+            GUI_PIPELINE_BARRIER();
+            if (wait < GUI_PIPELINE_STOP_TIMEOUT) {
+                if (p->Polls != polls) {            /* Rasterization task is still running */
+                    polls = p->Polls;
+                    wait = 0;
+                } else {
+                    wait++;
+                }
+            }
+        }
+        memcpy(&GUI.LL, &p->LL, sizeof(GUI.LL));    /* Restore low-level driver */
+        __GUI_MEMFREE(p->Blocks);
+        __GUI_MEMFREE(p);
+    }
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return guiOK;
+}
+
+int32_t GUI_PIPELINE_Process(GUI_t* ctx) {
+    GUI_PIPELINE_t* p;
+    const GUI_Byte *pos, *end;
+    int32_t cnt = 0;
+    
+    if (!ctx || !(p = ctx->Pipeline)) {
+        return 0;
+    }
+    p->Polls++;                                     /* Rasterization task is alive */
+    while (p->Consumed != p->Submitted) {
+        if (*(volatile uint32_t *)&ctx->LCD.Flags & GUI_FLAG_LCD_WAIT_LAYER_CONFIRM) {
+            break;                                  /* Previous frame is not shown yet */
+        }
+        GUI_PIPELINE_BARRIER();                     /* Read block after it is submitted */
+        pos = __BLOCK(p, p->Consumed);
+        end = pos + p->Used[p->Consumed % GUI_PIPELINE_BLOCKS];
+        for (; pos < end; pos += ((const __GUI_PIPELINE_Cmd_t *)pos)->Size) {
+            __Execute(ctx, p, (const __GUI_PIPELINE_Cmd_t *)pos);
+            cnt++;
+        }
+        GUI_PIPELINE_BARRIER();                     /* Finish block before it is released */
+        p->Consumed++;
+    }
+    if (p->Stop && p->Consumed == p->Submitted) {   /* Everything is rasterized, acknowledge stop */
+        ctx->Pipeline = 0;                          /* Pipeline is not used by this task after acknowledge */
+        GUI_PIPELINE_BARRIER();
+        p->Stopped = 1;
+    }
+    return cnt;
+}
+
+#endif /* GUI_USE_PIPELINE */
@@ -0,0 +1,168 @@
+/**
+ * \author  Tilen Majerle <tilen@majerle.eu>
+ * \brief   GUI pipelined rendering
+ *	
+\verbatim
+   ----------------------------------------------------------------------
+    Copyright (c) 2017 Tilen Majerle
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge,
+    publish, distribute, sublicense, and/or sell copies of the Software, 
+    and to permit persons to whom the Software is furnished to do so, 
+    subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+    AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+   ----------------------------------------------------------------------
+\endverbatim
+ */
+#ifndef GUI_PIPELINE_H
+#define GUI_PIPELINE_H
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \defgroup        GUI_PIPELINE Pipelined rendering
+ * \brief           Split GUI processing between recording and rasterization task
+ * \{
+ *
+ * With pipeline enabled, \ref GUI_Process still handles input, timers and widget draw callbacks,
+ * but drawing operations are only recorded to list of commands instead of sent to low-level driver.
+ * Second task rasterizes recorded commands with \ref GUI_PIPELINE_Process through low-level driver.
+ * While second task waits for DMA2D to draw frame N, first task already processes logic for frame N + 1.
+ *
+ * Commands are stored in \ref GUI_PIPELINE_BLOCKS blocks of \ref GUI_PIPELINE_BLOCK_SIZE bytes.
+ * Up to \ref GUI_PIPELINE_FRAMES frames may wait for rasterization, after that \ref GUI_Process does not draw until one is finished.
+ * Next frame is rasterized only after previous one is confirmed with \ref GUI_LCD_ConfirmActiveLayer.
+ *
+ * Typical usage with 2 tasks:
+ *
+\code{c}
+//Task A, UI logic
+GUI_Init();
+GUI_PIPELINE_Enable();
+while (1) {
+    GUI_Process();
+}
+
+//Task B, rasterization
+while (1) {
+    if (!GUI_PIPELINE_Process(GUI_CTX_GetDefault())) {
+        osDelay(1);
+    }
+}
+\endcode
+ *
+ * \note            Image pixels are copied to command blocks, source images may be modified or released after drawing.
+ *                  Reading screen content while recording (\ref GUI_DRAW_GetPixel) waits for all recorded commands to be rasterized
+ */
+
+#include "gui.h"
+
+#if GUI_USE_PIPELINE || defined(DOXYGEN)
+
+/**
+ * \brief           Pipeline object
+ */
+typedef struct GUI_PIPELINE_t {
+    GUI_LL_t LL;                            /*!< Low-level driver used for rasterization */
+    GUI_Byte* Blocks;                       /*!< Pointer to memory for command blocks */
+    uint32_t Used[GUI_PIPELINE_BLOCKS];     /*!< Number of bytes used in each submitted block */
+    uint32_t Pos;                           /*!< Write position in block currently being recorded */
+    uint8_t Recording;                      /*!< Status whether block for recording is acquired */
+    volatile uint32_t Submitted;            /*!< Number of blocks submitted by recording task */
+    volatile uint32_t Consumed;             /*!< Number of blocks rasterized by rasterization task */
+    volatile uint32_t FramesRecorded;       /*!< Number of recorded frames */
+    volatile uint32_t FramesDone;           /*!< Number of rasterized frames */
+    uint32_t Flushes;                       /*!< Number of times recording task had to wait for rasterization to finish */
+    volatile uint8_t Stop;                  /*!< Set by \ref GUI_PIPELINE_Disable to request stop of rasterization task */
+    volatile uint8_t Stopped;               /*!< Set by rasterization task when it does not use pipeline anymore */
+    volatile uint32_t Polls;                /*!< Number of \ref GUI_PIPELINE_Process calls, used to detect rasterization task */
+} GUI_PIPELINE_t;
+
+/**
+ * \brief           Enable pipelined rendering for current GUI context
+ * \note            Call after GUI is initialized
+ * \retval          Member of \ref GUI_Result_t enumeration
+ */
+GUI_Result_t GUI_PIPELINE_Enable(void);
+
+/**
+ * \brief           Disable pipelined rendering for current GUI context
+ * \note            Rasterization task must keep calling \ref GUI_PIPELINE_Process until function returns.
+ *                  It rasterizes remaining commands and acknowledges stop, after that pipeline memory is released.
+ *                  When rasterization task does not call it for \ref GUI_PIPELINE_STOP_TIMEOUT yields,
+ *                  remaining commands are rasterized by this function and task must not call it anymore.
+ *                  Call it before GUI is initialized again, \ref GUI_Init fails while pipeline is enabled
+ * \retval          Member of \ref GUI_Result_t enumeration
+ */
+GUI_Result_t GUI_PIPELINE_Disable(void);
+
+/**
+ * \brief           Rasterize recorded commands of GUI context
+ * \note            Call from task other than the one calling \ref GUI_Process
+ * \param[in,out]   *ctx: Pointer to GUI context with enabled pipeline
+ * \retval          Number of commands executed, 0 if nothing to rasterize
+ */
+int32_t GUI_PIPELINE_Process(GUI_t* ctx);
+
+#if defined(GUI_INTERNAL) || defined(DOXYGEN)
+
+/**
+ * \brief           Check if pipeline can accept new frame
+ * \note            Since this function is private, it can only be used by user inside GUI library
+ * \retval          1: Maximal number of frames is waiting for rasterization
+ * \retval          0: New frame can be recorded
+ */
+uint8_t __GUI_PIPELINE_IsBusy(void);
+
+/**
+ * \brief           Finish recorded frame and show it on specific layer after rasterization
+ * \note            Since this function is private, it can only be used by user inside GUI library
+ * \param[in]       layer: Layer number to set as active once frame is rasterized
+ * \param[in]       prev: Layer number with previous frame, used for remote display
+ * \param[in]       *dirty: Region changed in this frame
+ * \retval          None
+ */
+void __GUI_PIPELINE_Present(uint8_t layer, uint8_t prev, const GUI_Display_t* dirty);
+
+/**
+ * \brief           Record pixel mixed with current screen content when rasterized
+ * \note            Since this function is private, it can only be used by user inside GUI library
+ * \param[in]       x: X position on screen
+ * \param[in]       y: Y position on screen
+ * \param[in]       color: Foreground color
+ * \param[in]       weight: Anti-alias weight of background. See \ref __GUI_DRAW_AAColor
+ * \retval          None
+ */
+void __GUI_PIPELINE_MixPixel(GUI_Dim_t x, GUI_Dim_t y, GUI_Color_t color, uint8_t weight);
+
+#endif /* defined(GUI_INTERNAL) || defined(DOXYGEN) */
+
+#endif /* GUI_USE_PIPELINE || defined(DOXYGEN) */
+
+/**
+ * \}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,391 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2017 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#define GUI_INTERNAL
+#include "gui_remote.h"
+#include "input/gui_input.h"
+#include "widgets/gui_window.h"
+
+#if GUI_USE_REMOTE
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private structures                            **/
+/******************************************************************************/
+/******************************************************************************/
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private definitions                           **/
+/******************************************************************************/
+/******************************************************************************/
+#define __PKT_RECT                  0x01
+#define __PKT_FRAME_END             0x02
+#define __PKT_SCREEN                0x03
+#define __PKT_TOUCH                 0x10
+#define __PKT_KEY                   0x11
+#define __PKT_REFRESH               0x12
+
+#define __OP_SKIP                   0x00
+#define __OP_RUN                    0x40
+#define __OP_LITERAL                0x80
+#define __OP_MAX                    64
+
+#ifndef GUI_REMOTE_LOCK
+#error "GUI_REMOTE_LOCK(), GUI_REMOTE_UNLOCK() and GUI_REMOTE_YIELD() must be defined in gui_config.h"
+#endif /* GUI_REMOTE_LOCK */
+
+/* Convert ARGB8888 color to RGB565 */
+#define __TO_RGB565(c)              ((uint16_t)((((c) >> 8) & 0xF800) | (((c) >> 5) & 0x07E0) | (((c) >> 3) & 0x001F)))
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private variables                            **/
+/******************************************************************************/
+/******************************************************************************/
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private functions                            **/
+/******************************************************************************/
+/******************************************************************************/
+/* Send buffered data to transport */
+static
+void __Flush(GUI_REMOTE_t* r) {
+    if (r->BuffLen) {
+        if (!r->Error && !r->Send(r->Buff, r->BuffLen, r->Param)) {
+            r->Error = 1;                           /* Viewer is out of sync now */
+        }
+        r->BytesSent += r->BuffLen;
+        r->BuffLen = 0;
+    }
+}
+
+/* Write byte to output buffer */
+static
+void __Put(GUI_REMOTE_t* r, uint8_t b) {
+    if (r->BuffLen >= sizeof(r->Buff)) {
+        __Flush(r);
+    }
+    r->Buff[r->BuffLen++] = b;
+}
+
+/* Write 16-bit value in little-endian format */
+static
+void __Put16(GUI_REMOTE_t* r, uint16_t v) {
+    __Put(r, (uint8_t)v);
+    __Put(r, (uint8_t)(v >> 8));
+}
+
+/* Write pending literal pixels */
+static
+void __FlushLiteral(GUI_REMOTE_t* r) {
+    uint8_t i;
+    if (r->LiteralCount) {
+        __Put(r, __OP_LITERAL | (r->LiteralCount - 1));
+        for (i = 0; i < r->LiteralCount; i++) {
+            __Put16(r, r->Literal[i]);
+        }
+        r->LiteralCount = 0;
+    }
+}
+
+/* Add pixel to literal pixels */
+static
+void __AddLiteral(GUI_REMOTE_t* r, uint16_t c) {
+    r->Literal[r->LiteralCount++] = c;
+    if (r->LiteralCount == __OP_MAX) {
+        __FlushLiteral(r);
+    }
+}
+
+/* Write pending run, single pixel is literal */
+static
+void __FlushRun(GUI_REMOTE_t* r) {
+    if (r->RunCount == 1) {
+        __AddLiteral(r, r->RunColor);
+    } else if (r->RunCount) {
+        __FlushLiteral(r);                          /* Keep pixels order */
+        __Put(r, __OP_RUN | (r->RunCount - 1));
+        __Put16(r, r->RunColor);
+    }
+    r->RunCount = 0;
+}
+
+/* Write pending skipped pixels */
+static
+void __FlushSkip(GUI_REMOTE_t* r) {
+    if (r->SkipCount) {
+        __Put(r, __OP_SKIP | (r->SkipCount - 1));
+        r->SkipCount = 0;
+    }
+}
+
+/* Encode single pixel */
+static
+void __Encode(GUI_REMOTE_t* r, uint16_t c, uint8_t same) {
+    if (same) {                                     /* Pixel did not change since previous frame */
+        __FlushRun(r);
+        __FlushLiteral(r);
+        if (++r->SkipCount == __OP_MAX) {
+            __FlushSkip(r);
+        }
+        return;
+    }
+    __FlushSkip(r);
+    if (r->RunCount && r->RunColor == c) {          /* Continue with run */
+        if (++r->RunCount == __OP_MAX) {
+            __FlushRun(r);
+        }
+        return;
+    }
+    __FlushRun(r);                                  /* Start new run */
+    r->RunColor = c;
+    r->RunCount = 1;
+}
+
+/* Write packet header */
+static
+void __PutHeader(GUI_REMOTE_t* r, uint8_t type) {
+    __Put(r, GUI_REMOTE_SYNC);
+    __Put(r, type);
+}
+
+/* Process complete received packet */
+static
+void __ProcessPacket(GUI_t* ctx, GUI_REMOTE_t* r) {
+    switch (r->RxType) {
+#if GUI_USE_TOUCH
+        case __PKT_TOUCH: {
+            GUI_TouchData_t ts = {0};
+            ts.Status = r->Rx[0] ? GUI_TouchState_PRESSED : GUI_TouchState_RELEASED;
+            ts.Count = 1;
+            ts.X[0] = (GUI_iDim_t)(r->Rx[1] | (r->Rx[2] << 8));
+            ts.Y[0] = (GUI_iDim_t)(r->Rx[3] | (r->Rx[4] << 8));
+            GUI_INPUT_CTX_TouchAdd(ctx, &ts);
+            break;
+        }
+#endif /* GUI_USE_TOUCH */
+#if GUI_USE_KEYBOARD
+        case __PKT_KEY: {
+            GUI_KeyboardData_t kb = {0};
+            memcpy(kb.Keys, r->Rx, __GUI_MIN(sizeof(kb.Keys), 4));
+            kb.Flags = r->Rx[4];
+            GUI_INPUT_CTX_KeyAdd(ctx, &kb);
+            break;
+        }
+#endif /* GUI_USE_KEYBOARD */
+        case __PKT_REFRESH:
+            r->Refresh = 1;                         /* Processed in GUI thread */
+            break;
+        default:
+            break;
+    }
+}
+
+/* Get remote display of context and mark it as used, NULL if not enabled */
+static
+GUI_REMOTE_t* __Acquire(GUI_t* ctx) {
+    GUI_REMOTE_t* r;
+    
+    GUI_REMOTE_LOCK();
+    r = ctx->Remote;
+    if (r) {
+        r->Users++;                                 /* Disable waits until it is released */
+    }
+    GUI_REMOTE_UNLOCK();
+    return r;
+}
+
+/* Release remote display after use */
+static
+void __Release(GUI_REMOTE_t* r) {
+    GUI_REMOTE_LOCK();
+    r->Users--;
+    GUI_REMOTE_UNLOCK();
+}
+
+/* Get length of packet data for packet type */
+static
+int8_t __GetPacketLen(uint8_t type) {
+    switch (type) {
+        case __PKT_TOUCH:   return 5;
+        case __PKT_KEY:     return 5;
+        case __PKT_REFRESH: return 0;
+        default:            return -1;
+    }
+}
+
+/******************************************************************************/
+/******************************************************************************/
+/***                                Public API                               **/
+/******************************************************************************/
+/******************************************************************************/
+void __GUI_REMOTE_Process(void) {
+    GUI_REMOTE_t* r = GUI.Remote;
+    
+    if (r && r->Refresh) {                          /* Viewer needs complete screen */
+        r->Refresh = 0;
+        r->Full = 1;
+        __GUI_WIDGET_Invalidate(GUI_WINDOW_GetDesktop());   /* Redraw everything */
+    }
+}
+
+uint8_t __GUI_REMOTE_IsFullFrame(void) {
+    uint8_t full = GUI.Remote->Full;
+    GUI.Remote->Full = 0;
+    return full;
+}
+
+void __GUI_REMOTE_Frame(GUI_t* ctx, GUI_LL_t* LL, uint8_t layer, uint8_t prev, const GUI_Display_t* dirty) {
+    GUI_REMOTE_t* r;
+    GUI_iDim_t x1, y1, x2, y2, x, y;
+    GUI_Color_t c;
+    
+    if (!(r = __Acquire(ctx))) {                    /* Remote display may be disabled from other task */
+        return;
+    }
+    x1 = __GUI_MAX(dirty->X1, 0);                   /* Clip dirty region to screen */
+    y1 = __GUI_MAX(dirty->Y1, 0);
+    x2 = __GUI_MIN(dirty->X2, ctx->LCD.Width);
+    y2 = __GUI_MIN(dirty->Y2, ctx->LCD.Height);
+    
+    r->Error = 0;
+    if (layer == prev) {                            /* Complete screen is sent */
+        __PutHeader(r, __PKT_SCREEN);
+        __Put16(r, (uint16_t)ctx->LCD.Width);
+        __Put16(r, (uint16_t)ctx->LCD.Height);
+    }
+    if (x2 > x1 && y2 > y1) {
+        __PutHeader(r, __PKT_RECT);
+        __Put16(r, (uint16_t)x1);
+        __Put16(r, (uint16_t)y1);
+        __Put16(r, (uint16_t)(x2 - x1));
+        __Put16(r, (uint16_t)(y2 - y1));
+        for (y = y1; y < y2; y++) {
+            for (x = x1; x < x2; x++) {
+                c = LL->GetPixel(&ctx->LCD, layer, x, y);
+                __Encode(r, __TO_RGB565(c), layer != prev && __TO_RGB565(LL->GetPixel(&ctx->LCD, prev, x, y)) == __TO_RGB565(c));
+            }
+        }
+        __FlushSkip(r);
+        __FlushRun(r);
+        __FlushLiteral(r);
+    }
+    __PutHeader(r, __PKT_FRAME_END);
+    __Flush(r);
+    if (r->Error) {                                 /* Viewer missed data, send everything again */
+        r->Refresh = 1;
+    }
+    __Release(r);
+}
+
+GUI_Result_t GUI_REMOTE_Enable(GUI_REMOTE_Send_t send, void* param) {
+    GUI_REMOTE_t* r;
+    
+    __GUI_ASSERTPARAMS(send);                       /* Check input parameters */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    r = GUI.Remote;
+    if (!r) {
+        r = (GUI_REMOTE_t *)__GUI_MEMALLOC(sizeof(*r), GUI_MEM_TYPE_OTHER);
+        if (!r) {
+            __GUI_LEAVE();
+            return guiERROR;
+        }
+        memset(r, 0x00, sizeof(*r));
+    }
+    r->Send = send;
+    r->Param = param;
+    r->Refresh = 1;                                 /* Start with complete screen */
+    GUI.Remote = r;
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return guiOK;
+}
+
+GUI_Result_t GUI_REMOTE_Disable(void) {
+    GUI_REMOTE_t* r;
+    
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    GUI_REMOTE_LOCK();
+    r = GUI.Remote;                                 /* Detach remote display, new users do not get it anymore */
+    GUI.Remote = 0;
+    GUI_REMOTE_UNLOCK();
+    if (r) {
+        while (r->Users) {                          /* Wait for receiving interrupt or rasterization task to finish */
+            GUI_REMOTE_YIELD();
+        }
+        __GUI_MEMFREE(r);
+    }
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return guiOK;
+}
+
+GUI_Result_t GUI_REMOTE_Refresh(void) {
+    __GUI_ASSERTPARAMS(GUI.Remote);                 /* Check input parameters */
+    
+    GUI.Remote->Refresh = 1;
+    return guiOK;
+}
+
+uint32_t GUI_REMOTE_Receive(GUI_t* ctx, const void* data, uint32_t len) {
+    const GUI_Byte* d = (const GUI_Byte *)data;
+    GUI_REMOTE_t* r;
+    uint32_t cnt = 0;
+    int8_t plen;
+    
+    if (!ctx || !d || !(r = __Acquire(ctx))) {
+        return 0;
+    }
+    for (; len; len--, d++) {
+        if (!r->RxType) {                           /* Waiting for sync and type */
+            if (!r->RxSync) {
+                r->RxSync = *d == GUI_REMOTE_SYNC;
+                continue;
+            }
+            r->RxSync = 0;
+            if (__GetPacketLen(*d) < 0) {           /* Unknown packet, search for next sync */
+                continue;
+            }
+            r->RxType = *d;
+            r->RxLen = 0;
+        } else {
+            r->Rx[r->RxLen++] = *d;                 /* Save packet data */
+        }
+        plen = __GetPacketLen(r->RxType);
+        if (r->RxLen >= plen) {                     /* Packet is complete */
+            __ProcessPacket(ctx, r);
+            r->RxType = 0;
+            cnt++;
+        }
+    }
+    __Release(r);
+    return cnt;
+}
+
+#endif /* GUI_USE_REMOTE */
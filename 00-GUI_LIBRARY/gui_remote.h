@@ -0,0 +1,194 @@
+/**
+ * \author  Tilen Majerle <tilen@majerle.eu>
+ * \brief   GUI remote display streaming
+ *	
+\verbatim
+   ----------------------------------------------------------------------
+    Copyright (c) 2017 Tilen Majerle
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge,
+    publish, distribute, sublicense, and/or sell copies of the Software, 
+    and to permit persons to whom the Software is furnished to do so, 
+    subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+    AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+   ----------------------------------------------------------------------
+\endverbatim
+ */
+#ifndef GUI_REMOTE_H
+#define GUI_REMOTE_H
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \defgroup        GUI_REMOTE Remote display
+ * \brief           Stream screen changes to remote viewer and receive its input
+ * \{
+ *
+ * After each frame, only dirty region of frame is encoded and sent over byte transport,
+ * for example UART with DMA on target or socket or pipe on host.
+ * Bandwidth therefore depends on amount of changes and not on display size.
+ *
+ * Pixels are sent in RGB565 format with simple codec. Pixels not changed since previous frame
+ * are skipped, which costs no additional memory as previous frame is still in other layer.
+ *
+ * \par Device to viewer packets
+ *
+ * All values are little-endian, each packet starts with \ref GUI_REMOTE_SYNC byte
+ *
+\verbatim
+SYNC 0x01 X[2] Y[2] W[2] H[2] OPS...    Rectangle, followed by operations until W * H pixels are covered, left to right, top to bottom
+SYNC 0x02                               End of frame, viewer can show the frame
+SYNC 0x03 W[2] H[2]                     Screen size, sent before complete screen
+
+Operation byte: bits 7:6 are operation, bits 5:0 are count N - 1
+    00: Skip N pixels, they are the same as in previous frame
+    01: Repeat next 2-byte color N times
+    10: Next N 2-byte colors are literal pixels
+\endverbatim
+ *
+ * \par Viewer to device packets
+ *
+\verbatim
+SYNC 0x10 Status X[2] Y[2]              Touch, Status is 1 when pressed and 0 when released
+SYNC 0x11 Keys[4] Flags                 Key press, see \ref GUI_KeyboardData_t
+SYNC 0x12                               Request complete screen, send when viewer connects
+\endverbatim
+ */
+
+#include "gui.h"
+
+#if GUI_USE_REMOTE || defined(DOXYGEN)
+
+#define GUI_REMOTE_SYNC             0xA5    /*!< Start byte of each packet */
+
+/**
+ * \brief           Callback function to send data to remote viewer
+ * \note            Data are valid only during function call
+ * \param[in]       *data: Pointer to data to send
+ * \param[in]       len: Number of bytes to send
+ * \param[in]       param: User parameter from \ref GUI_REMOTE_Enable
+ * \retval          1: Data were sent
+ * \retval          0: Data were not sent, complete screen is sent on next frame
+ */
+typedef uint8_t (*GUI_REMOTE_Send_t)(const void* data, uint32_t len, void* param);
+
+/**
+ * \brief           Remote display object
+ */
+typedef struct GUI_REMOTE_t {
+    GUI_REMOTE_Send_t Send;                 /*!< Transport function */
+    void* Param;                            /*!< User parameter for transport function */
+    GUI_Byte Buff[GUI_REMOTE_BUFFER_SIZE];  /*!< Output buffer */
+    uint32_t BuffLen;                       /*!< Number of bytes in output buffer */
+    uint8_t Error;                          /*!< Sending failed during current frame */
+    uint8_t Full;                           /*!< Next frame is sent as complete screen */
+    volatile uint8_t Refresh;               /*!< Complete screen was requested by viewer */
+    
+    uint16_t Literal[64];                   /*!< Literal pixels waiting for output */
+    uint8_t LiteralCount;                   /*!< Number of literal pixels */
+    uint16_t RunColor;                      /*!< Color of current run */
+    uint8_t RunCount;                       /*!< Number of pixels in current run */
+    uint8_t SkipCount;                      /*!< Number of skipped pixels */
+    
+    uint8_t RxType;                         /*!< Type of packet being received, 0 when waiting for type */
+    uint8_t RxSync;                         /*!< Sync byte was received */
+    uint8_t RxLen;                          /*!< Number of received packet bytes */
+    GUI_Byte Rx[8];                         /*!< Received packet data */
+    
+    uint32_t BytesSent;                     /*!< Total number of bytes sent */
+    volatile uint8_t Users;                 /*!< Number of interrupts or tasks currently using remote display */
+} GUI_REMOTE_t;
+
+/**
+ * \brief           Enable remote display for current GUI context
+ * \note            Complete screen is sent on next frame
+ * \param[in]       send: Transport function for outgoing data
+ * \param[in]       param: User parameter for transport function
+ * \retval          Member of \ref GUI_Result_t enumeration
+ */
+GUI_Result_t GUI_REMOTE_Enable(GUI_REMOTE_Send_t send, void* param);
+
+/**
+ * \brief           Disable remote display for current GUI context
+ * \note            Waits until \ref GUI_REMOTE_Receive and rasterization task of pipeline stop using it
+ * \retval          Member of \ref GUI_Result_t enumeration
+ */
+GUI_Result_t GUI_REMOTE_Disable(void);
+
+/**
+ * \brief           Send complete screen on next frame
+ * \retval          Member of \ref GUI_Result_t enumeration
+ */
+GUI_Result_t GUI_REMOTE_Refresh(void);
+
+/**
+ * \brief           Process data received from remote viewer
+ * \note            Function is safe to be called from interrupt or thread not processing GUI context,
+ *                  touch and key events are added with \ref GUI_INPUT_CTX_TouchAdd and \ref GUI_INPUT_CTX_KeyAdd
+ * \param[in,out]   *ctx: Pointer to GUI context with enabled remote display
+ * \param[in]       *data: Received data
+ * \param[in]       len: Number of received bytes
+ * \retval          Number of complete packets processed
+ */
+uint32_t GUI_REMOTE_Receive(GUI_t* ctx, const void* data, uint32_t len);
+
+#if defined(GUI_INTERNAL) || defined(DOXYGEN)
+
+/**
+ * \brief           Process requests from viewer in GUI thread
+ * \note            Since this function is private, it can only be used by user inside GUI library
+ * \retval          None
+ */
+void __GUI_REMOTE_Process(void);
+
+/**
+ * \brief           Check if frame must be sent as complete screen and clear the request
+ * \note            Since this function is private, it can only be used by user inside GUI library
+ * \retval          1: Send complete frame without delta to previous frame
+ * \retval          0: Send only changes
+ */
+uint8_t __GUI_REMOTE_IsFullFrame(void);
+
+/**
+ * \brief           Encode and send dirty region of drawn frame
+ * \note            Since this function is private, it can only be used by user inside GUI library
+ * \param[in,out]   *ctx: GUI context of frame
+ * \param[in]       *LL: Low-level driver to read pixels with
+ * \param[in]       layer: Layer with drawn frame
+ * \param[in]       prev: Layer with previous frame or the same as layer to send all pixels
+ * \param[in]       *dirty: Dirty region of frame
+ * \retval          None
+ */
+void __GUI_REMOTE_Frame(GUI_t* ctx, GUI_LL_t* LL, uint8_t layer, uint8_t prev, const GUI_Display_t* dirty);
+
+#endif /* defined(GUI_INTERNAL) || defined(DOXYGEN) */
+
+#endif /* GUI_USE_REMOTE || defined(DOXYGEN) */
+
+/**
+ * \}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,401 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2017 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#define GUI_INTERNAL
+#include "gui_snapshot.h"
+#include "widgets/gui_window.h"
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private structures                            **/
+/******************************************************************************/
+/******************************************************************************/
+typedef struct __GUI_SNAPSHOT_Header_t {
+    uint32_t Magic;                         /* Snapshot identification */
+    uint16_t Version;                       /* Snapshot format version */
+    uint16_t Flags;                         /* Snapshot flags */
+    uint32_t Size;                          /* Total snapshot size in units of bytes */
+    uint32_t Signature;                     /* Firmware signature */
+    uint32_t Checksum;                      /* Checksum of all data after header */
+    uint32_t FrameOffset;                   /* Offset of saved frame */
+    uint16_t Count;                         /* Number of widgets */
+    uint16_t Focused;                       /* Index of focused widget */
+    uint16_t FocusedPrev;                   /* Index of previously focused widget */
+    uint16_t WindowActive;                  /* Index of active window */
+    uint16_t FrameWidth;                    /* Width of saved frame */
+    uint16_t FrameHeight;                   /* Height of saved frame */
+    GUI_Display_t Display;                  /* Clipping region of pending redraw */
+} __GUI_SNAPSHOT_Header_t;
+
+typedef struct __GUI_SNAPSHOT_Widget_t {
+    const GUI_WIDGET_t* Widget;             /* Widget type */
+    uint16_t Parent;                        /* Index of parent widget */
+    uint16_t Size;                          /* Size of widget memory */
+    uint32_t TextSize;                      /* Size of saved dynamic text memory */
+    uint32_t DataSize;                      /* Size of widget private data from GUI_WC_Save */
+    uint8_t ColorsCount;                    /* Number of saved colors */
+    uint8_t Timer;                          /* Set to 1 when widget timer is saved */
+} __GUI_SNAPSHOT_Widget_t;
+
+typedef struct __GUI_SNAPSHOT_Ctx_t {
+    GUI_Byte* Buff;                         /* Output memory */
+    uint32_t Size;                          /* Output memory size */
+    uint32_t Pos;                           /* Current write position */
+    __GUI_SNAPSHOT_Header_t* Header;        /* Snapshot header */
+    uint16_t Count;                         /* Number of widgets saved */
+} __GUI_SNAPSHOT_Ctx_t;
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private definitions                           **/
+/******************************************************************************/
+/******************************************************************************/
+#define SNAPSHOT_MAGIC              0x53495547UL    /* "GUIS" */
+#define SNAPSHOT_VERSION            2
+#define SNAPSHOT_NONE               0xFFFF
+
+#define __Align(x)                  (((x) + 3) & ~3UL)
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private variables                            **/
+/******************************************************************************/
+/******************************************************************************/
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private functions                            **/
+/******************************************************************************/
+/******************************************************************************/
+/* Get signature of firmware, snapshot is not valid with different firmware */
+static
+uint32_t __Signature(void) {
+    return (uint32_t)(uintptr_t)&GUI_SNAPSHOT_Save ^ ((uint32_t)sizeof(GUI_HANDLE_ROOT_t) << 16) ^ (uint32_t)sizeof(GUI_t);
+}
+
+/* Calculate FNV-1a checksum of memory */
+static
+uint32_t __Checksum(const GUI_Byte* data, uint32_t len) {
+    uint32_t hash = 0x811C9DC5UL;
+    while (len--) {
+        hash = (hash ^ *data++) * 0x01000193UL;
+    }
+    return hash;
+}
+
+/* Write data to snapshot, only calculate size when there is no memory */
+static
+void __Write(__GUI_SNAPSHOT_Ctx_t* ctx, const void* data, uint32_t len) {
+    if (ctx->Buff && (ctx->Pos + len) <= ctx->Size) {
+        memcpy(&ctx->Buff[ctx->Pos], data, len);
+    }
+    ctx->Pos = __Align(ctx->Pos + len);
+}
+
+/* Save widget and all its children */
+static
+void __SaveWidgets(__GUI_SNAPSHOT_Ctx_t* ctx, GUI_HANDLE_p parent, uint16_t parentIndex) {
+    __GUI_SNAPSHOT_Widget_t w;
+    GUI_WIDGET_SnapshotData_t d;
+    GUI_HANDLE_p h;
+    uint16_t index;
+    
+    for (h = __GUI_LINKEDLIST_WidgetGetNext((GUI_HANDLE_ROOT_t *)parent, 0); h; h = __GUI_LINKEDLIST_WidgetGetNext(NULL, h)) {
+        if (__GH(h)->Flags & GUI_FLAG_REMOVE) {     /* Ignore widgets waiting for delete */
+            continue;
+        }
+        index = ctx->Count++;
+        if (ctx->Buff && ctx->Header) {             /* Save references to widget */
+            if (h == GUI.FocusedWidget)     { ctx->Header->Focused = index; }
+            if (h == GUI.FocusedWidgetPrev) { ctx->Header->FocusedPrev = index; }
+            if (h == GUI.WindowActive)      { ctx->Header->WindowActive = index; }
+        }
+        
+        memset(&w, 0x00, sizeof(w));
+        w.Widget = __GH(h)->Widget;
+        w.Parent = parentIndex;
+        w.Size = __GH(h)->Widget->Size;
+        if ((__GH(h)->Flags & GUI_FLAG_DYNAMICTEXTALLOC) && __GH(h)->Text) {
+            w.TextSize = __GH(h)->TextMemSize;
+        }
+        if (__GH(h)->Colors) {
+            w.ColorsCount = __GH(h)->Widget->ColorsCount;
+        }
+        w.Timer = __GH(h)->Timer != 0;
+        memset(&d, 0x00, sizeof(d));
+        __GUI_WIDGET_Callback(h, GUI_WC_Save, &d, NULL);    /* Get size of widget private data */
+        w.DataSize = d.Size;
+        __Write(ctx, &w, sizeof(w));                /* Widget description */
+        __Write(ctx, h, w.Size);                    /* Widget memory */
+        if (w.TextSize) {
+            __Write(ctx, __GH(h)->Text, w.TextSize);    /* Dynamic text */
+        }
+        if (w.ColorsCount) {
+            __Write(ctx, __GH(h)->Colors, w.ColorsCount * sizeof(GUI_Color_t));
+        }
+        if (w.Timer) {
+            __Write(ctx, __GH(h)->Timer, sizeof(GUI_TIMER_t));
+        }
+        if (w.DataSize) {                           /* Let widget write its data directly to snapshot */
+            if (ctx->Buff && (ctx->Pos + w.DataSize) <= ctx->Size) {
+                d.Data = &ctx->Buff[ctx->Pos];
+                d.Size = w.DataSize;
+                __GUI_WIDGET_Callback(h, GUI_WC_Save, &d, NULL);
+            }
+            ctx->Pos = __Align(ctx->Pos + w.DataSize);
+        }
+        
+        if (__GUI_WIDGET_AllowChildren(h)) {        /* Save children widgets */
+            __SaveWidgets(ctx, h, index);
+        }
+    }
+}
+
+/* Free widget restored from snapshot */
+static
+void __FreeWidget(GUI_HANDLE_p h) {
+    if (__GH(h)->Flags & GUI_FLAG_DYNAMICTEXTALLOC) {
+        __GUI_MEMFREE(__GH(h)->Text);
+    }
+    if (__GH(h)->Colors) {
+        __GUI_MEMFREE(__GH(h)->Colors);
+    }
+    if (__GH(h)->TextRun) {
+        __GUI_DRAW_TextRunFree(&__GH(h)->TextRun);
+    }
+    if (__GH(h)->Timer) {
+        __GUI_TIMER_Remove(&__GH(h)->Timer);
+    }
+    __GUI_MEMFREE(h);
+}
+
+/* Create widgets from snapshot */
+static
+uint8_t __RestoreWidgets(const __GUI_SNAPSHOT_Header_t* hdr, GUI_HANDLE_p* widgets, GUI_WIDGET_SnapshotData_t* data) {
+    const GUI_Byte* snap = (const GUI_Byte *)hdr;
+    const __GUI_SNAPSHOT_Widget_t* w;
+    GUI_TIMER_t t;
+    uint32_t pos = __Align(sizeof(*hdr)), end = hdr->FrameOffset ? hdr->FrameOffset : hdr->Size;
+    GUI_HANDLE_p h, parent;
+    uint16_t i;
+    
+    for (i = 0; i < hdr->Count; i++) {
+        if ((pos + sizeof(*w)) > end) {
+            return 0;
+        }
+        w = (const __GUI_SNAPSHOT_Widget_t *)&snap[pos];
+        pos = __Align(pos + sizeof(*w));
+        if (!w->Widget || w->Widget->Size != w->Size || w->Size < sizeof(GUI_HANDLE) || w->TextSize > end || w->DataSize > end ||
+            (w->Parent != SNAPSHOT_NONE && w->Parent >= i) ||
+            (pos + __Align(w->Size) + __Align(w->TextSize) + __Align(w->ColorsCount * sizeof(GUI_Color_t)) +
+                (w->Timer ? __Align(sizeof(GUI_TIMER_t)) : 0) + __Align(w->DataSize)) > end) {
+            return 0;
+        }
+        parent = w->Parent == SNAPSHOT_NONE ? NULL : widgets[w->Parent];
+        if (parent && !__GUI_WIDGET_AllowChildren(parent)) {
+            return 0;
+        }
+        
+        h = (GUI_HANDLE_p)__GUI_MEMWIDALLOC(w->Widget);  /* Allocate widget memory */
+        if (!h) {
+            return 0;
+        }
+        memcpy(h, &snap[pos], w->Size);
+        pos = __Align(pos + w->Size);
+        
+        /* Reset all pointers to memory */
+        memset(&__GH(h)->List, 0x00, sizeof(__GH(h)->List));
+        __GH(h)->Parent = parent;
+        __GH(h)->Timer = 0;
+        __GH(h)->Colors = 0;
+        __GH(h)->TextRun = 0;
+        __GH(h)->Flags &= ~GUI_FLAG_ACTIVE;         /* Touch is not active after restore */
+        if (__GUI_WIDGET_AllowChildren(h)) {
+            memset(&((GUI_HANDLE_ROOT_t *)h)->RootList, 0x00, sizeof(((GUI_HANDLE_ROOT_t *)h)->RootList));
+        }
+        if (__GH(h)->Flags & GUI_FLAG_DYNAMICTEXTALLOC) {
+            __GH(h)->Text = 0;
+            if (w->TextSize) {
+                __GH(h)->Text = (GUI_Char *)__GUI_MEMALLOC(w->TextSize, GUI_MEM_TYPE_TEXT);
+            }
+            if (!__GH(h)->Text) {                   /* Text memory was not saved or allocated */
+                __GH(h)->Flags &= ~GUI_FLAG_DYNAMICTEXTALLOC;
+                __GH(h)->TextMemSize = 0;
+            } else {
+                memcpy(__GH(h)->Text, &snap[pos], w->TextSize);
+            }
+        }
+        pos = __Align(pos + w->TextSize);
+        if (w->ColorsCount) {
+            __GH(h)->Colors = (GUI_Color_t *)__GUI_MEMALLOC(w->ColorsCount * sizeof(GUI_Color_t), GUI_MEM_TYPE_COLORS);
+            if (__GH(h)->Colors) {
+                memcpy(__GH(h)->Colors, &snap[pos], w->ColorsCount * sizeof(GUI_Color_t));
+            }
+            pos = __Align(pos + w->ColorsCount * sizeof(GUI_Color_t));
+        }
+        if (w->Timer) {                             /* Create timer again with the same callback and state */
+            memcpy(&t, &snap[pos], sizeof(t));     /* Snapshot memory may not be aligned for pointers */
+            __GH(h)->Timer = __GUI_TIMER_Create(t.Period, t.Callback, t.Params, t.Flags);
+            if (__GH(h)->Timer) {
+                __GH(h)->Timer->Counter = t.Counter;
+            }
+            pos = __Align(pos + sizeof(GUI_TIMER_t));
+        }
+        data[i].Data = (void *)&snap[pos];         /* Widget private data is restored with callback */
+        data[i].Size = w->DataSize;
+        pos = __Align(pos + w->DataSize);
+        
+        __GUI_LINKEDLIST_WidgetAdd((GUI_HANDLE_ROOT_t *)parent, h); /* Add to the end of parent's list to keep order */
+        widgets[i] = h;
+    }
+    return 1;
+}
+
+/******************************************************************************/
+/******************************************************************************/
+/***                                Public API                               **/
+/******************************************************************************/
+/******************************************************************************/
+uint32_t GUI_SNAPSHOT_Save(void* buff, uint32_t size, uint8_t flags) {
+    __GUI_SNAPSHOT_Ctx_t ctx = {0};
+    __GUI_SNAPSHOT_Header_t hdr = {0};
+    const GUI_Layer_t* layer;
+    uint32_t frameSize = 0;
+    
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    ctx.Buff = (GUI_Byte *)buff;
+    ctx.Size = size;
+    if (buff && size >= sizeof(hdr)) {
+        ctx.Header = (__GUI_SNAPSHOT_Header_t *)buff;
+        memset(ctx.Header, 0x00, sizeof(hdr));
+        ctx.Header->Focused = ctx.Header->FocusedPrev = ctx.Header->WindowActive = SNAPSHOT_NONE;
+    }
+    ctx.Pos = __Align(sizeof(hdr));                 /* Header is written at the end */
+    __SaveWidgets(&ctx, NULL, SNAPSHOT_NONE);       /* Save complete widget tree */
+    
+    if (flags & GUI_SNAPSHOT_FLAG_FRAME) {          /* Save currently shown frame */
+        layer = &GUI.LCD.Layers[GUI.LCD.ActiveLayer];
+        frameSize = (uint32_t)GUI.LCD.Width * (uint32_t)GUI.LCD.Height * sizeof(GUI_Color_t);
+        hdr.FrameOffset = ctx.Pos;
+        hdr.FrameWidth = GUI.LCD.Width;
+        hdr.FrameHeight = GUI.LCD.Height;
+        __Write(&ctx, (const void *)(uintptr_t)layer->StartAddress, frameSize);
+    }
+    
+    if (!buff) {                                    /* Size request only */
+        __GUI_LEAVE();                              /* Leave GUI */
+        return ctx.Pos;
+    }
+    if (ctx.Pos > size) {                           /* Memory too small */
+        __GUI_LEAVE();                              /* Leave GUI */
+        return 0;
+    }
+    
+    hdr.Magic = SNAPSHOT_MAGIC;
+    hdr.Version = SNAPSHOT_VERSION;
+    hdr.Flags = flags;
+    hdr.Size = ctx.Pos;
+    hdr.Signature = __Signature();
+    hdr.Count = ctx.Count;
+    hdr.Focused = ctx.Header->Focused;
+    hdr.FocusedPrev = ctx.Header->FocusedPrev;
+    hdr.WindowActive = ctx.Header->WindowActive;
+    hdr.Display = GUI.Display;
+    hdr.Checksum = __Checksum(&ctx.Buff[sizeof(hdr)], ctx.Pos - sizeof(hdr));
+    memcpy(buff, &hdr, sizeof(hdr));
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return ctx.Pos;
+}
+
+GUI_Result_t GUI_SNAPSHOT_Restore(const void* data, uint32_t size) {
+    const __GUI_SNAPSHOT_Header_t* hdr = (const __GUI_SNAPSHOT_Header_t *)data;
+    GUI_HANDLE_p* widgets = 0;
+    GUI_WIDGET_SnapshotData_t* ext = 0;
+    const GUI_Byte* frame = 0;
+    uint16_t i;
+    
+    /* Check snapshot before anything is touched */
+    if (!data || size < sizeof(*hdr) || hdr->Magic != SNAPSHOT_MAGIC || hdr->Version != SNAPSHOT_VERSION ||
+        hdr->Size > size || hdr->Size < sizeof(*hdr) || hdr->FrameOffset > hdr->Size || !hdr->Count ||
+        hdr->Signature != __Signature() ||
+        hdr->Checksum != __Checksum((const GUI_Byte *)data + sizeof(*hdr), hdr->Size - sizeof(*hdr))) {
+        GUI_Init();                                 /* Normal initialization */
+        return guiERROR;
+    }
+    
+    /**
+     * Frame is used only when snapshot contains all its pixels.
+     * Low-level init shows it only when its size matches LCD,
+     * otherwise screen is cleared and redrawn
+     */
+    if (hdr->FrameOffset && (hdr->Size - hdr->FrameOffset) >= (uint32_t)hdr->FrameWidth * (uint32_t)hdr->FrameHeight * sizeof(GUI_Color_t)) {
+        frame = (const GUI_Byte *)data + hdr->FrameOffset;
+    }
+    if (__GUI_InitCore(frame, hdr->FrameWidth, hdr->FrameHeight) != guiOK) {   /* Init low-level and show saved frame */
+        return guiERROR;
+    }
+    if (GUI.LCD.Width != hdr->FrameWidth || GUI.LCD.Height != hdr->FrameHeight) {
+        frame = 0;                                  /* Frame was not shown */
+    }
+    
+    widgets = (GUI_HANDLE_p *)__GUI_MEMALLOC(hdr->Count * sizeof(*widgets), GUI_MEM_TYPE_OTHER);
+    ext = (GUI_WIDGET_SnapshotData_t *)__GUI_MEMALLOC(hdr->Count * sizeof(*ext), GUI_MEM_TYPE_OTHER);
+    if (widgets) {
+        memset(widgets, 0x00, hdr->Count * sizeof(*widgets));
+    }
+    if (!widgets || !ext || !__RestoreWidgets(hdr, widgets, ext)) { /* Restore widget tree */
+        if (widgets) {
+            for (i = 0; i < hdr->Count && widgets[i]; i++) {
+                __FreeWidget(widgets[i]);
+            }
+            __GUI_MEMFREE(widgets);
+        }
+        if (ext) {
+            __GUI_MEMFREE(ext);
+        }
+        GUI_Init();                                 /* Start from scratch */
+        return guiERROR;
+    }
+    
+    /* Restore references */
+    GUI.FocusedWidget = hdr->Focused < hdr->Count ? widgets[hdr->Focused] : 0;
+    GUI.FocusedWidgetPrev = hdr->FocusedPrev < hdr->Count ? widgets[hdr->FocusedPrev] : 0;
+    GUI.WindowActive = hdr->WindowActive < hdr->Count ? widgets[hdr->WindowActive] : 0;
+    
+    for (i = 0; i < hdr->Count; i++) {              /* Let widgets fix private memory and restore their data */
+        __GUI_WIDGET_Callback(widgets[i], GUI_WC_Restore, &ext[i], NULL);
+    }
+    __GUI_MEMFREE(widgets);
+    __GUI_MEMFREE(ext);
+    
+    if (frame) {                                    /* Screen is already up to date */
+        GUI.Display = hdr->Display;                 /* Continue with pending redraw */
+    } else {
+        __GUI_WIDGET_Invalidate(GUI_WINDOW_GetDesktop());   /* Redraw everything */
+    }
+    return guiOK;
+}
@@ -0,0 +1,101 @@
+/**
+ * \author  Tilen Majerle <tilen@majerle.eu>
+ * \brief   GUI state snapshot for suspend and resume
+ *	
+\verbatim
+   ----------------------------------------------------------------------
+    Copyright (c) 2017 Tilen Majerle
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge,
+    publish, distribute, sublicense, and/or sell copies of the Software, 
+    and to permit persons to whom the Software is furnished to do so, 
+    subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+    AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+   ----------------------------------------------------------------------
+\endverbatim
+ */
+#ifndef GUI_SNAPSHOT_H
+#define GUI_SNAPSHOT_H
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \defgroup        GUI_SNAPSHOT Snapshot
+ * \brief           Save and restore complete GUI state
+ * \{
+ *
+ * Snapshot is compact binary image of live widget tree: widget types, geometry, flags,
+ * colors, dynamically allocated texts, widget values and focus. Optionally it contains
+ * currently displayed frame, which is shown immediately on restore without any redraw.
+ *
+ * Typical usage on devices with standby mode:
+ *
+ *  - Before standby, call \ref GUI_SNAPSHOT_Save to write snapshot to backup RAM or RAM buffer written to flash
+ *  - On wake, call \ref GUI_SNAPSHOT_Restore instead of \ref GUI_Init
+ *  - If restore fails, GUI is initialized as with \ref GUI_Init and application builds windows as usual
+ *
+ * Widgets are restored without \ref GUI_WC_Init callback, \ref GUI_WC_Restore is called instead.
+ *
+ * Widget timers are created again with the same callback and counter.
+ * Widgets save their own allocated memory with \ref GUI_WC_Save command,
+ * listbox and dropdown save their entries this way, selection is kept.
+ *
+ * \note            Snapshot contains pointers to widget types, fonts, callbacks and user texts.
+ *                  It is valid only for the same firmware image and user texts, including texts of list entries,
+ *                  must be in static memory.
+ *                  Graph data objects are owned by application and are not part of snapshot,
+ *                  application must create and attach them again after restore.
+ *                  Saved frame is shown only when LCD has the same size as when snapshot was saved
+ */
+
+#include "gui.h"
+
+#define GUI_SNAPSHOT_FLAG_FRAME     0x01    /*!< Save currently displayed frame to snapshot */
+
+/**
+ * \brief           Save snapshot of current GUI state
+ * \param[out]      *buff: Pointer to memory to save snapshot to or NULL to get required size only
+ * \param[in]       size: Size of memory in units of bytes
+ * \param[in]       flags: Snapshot flags. This parameter can be 0 or \ref GUI_SNAPSHOT_FLAG_FRAME
+ * \retval          > 0: Number of bytes required or written to memory
+ * \retval          0: Memory is too small
+ */
+uint32_t GUI_SNAPSHOT_Save(void* buff, uint32_t size, uint8_t flags);
+
+/**
+ * \brief           Initialize GUI from snapshot
+ * \note            Use this function instead of \ref GUI_Init
+ * \param[in]       *data: Pointer to snapshot, aligned to 4 bytes
+ * \param[in]       size: Size of memory with snapshot in units of bytes
+ * \retval          guiOK: GUI was restored from snapshot
+ * \retval          guiERROR: Snapshot is not valid, GUI was initialized as with \ref GUI_Init
+ */
+GUI_Result_t GUI_SNAPSHOT_Restore(const void* data, uint32_t size);
+
+/**
+ * \}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
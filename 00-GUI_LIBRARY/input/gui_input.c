@@ -37,14 +37,6 @@
 /***                           Private definitions                           **/
 /******************************************************************************/
 /******************************************************************************/    
-#if GUI_USE_TOUCH
-static GUI_BUFFER_t TSBuffer;
-static GUI_Byte_t TSBufferData[GUI_TOUCH_BUFFER_SIZE * sizeof(GUI_TouchData_t) + 1];
-#endif /* GUI_USE_TOUCH */
-#if GUI_USE_KEYBOARD
-static GUI_BUFFER_t KBBuffer;
-static GUI_Byte_t KBBufferData[GUI_TOUCH_BUFFER_SIZE * sizeof(GUI_KeyboardData_t) + 1];
-#endif /* GUI_USE_KEYBOARD */
 
 /******************************************************************************/
 /******************************************************************************/
@@ -64,33 +56,41 @@ static GUI_Byte_t KBBufferData[GUI_TOUCH_BUFFER_SIZE * sizeof(GUI_KeyboardData_t
 /******************************************************************************/
 /******************************************************************************/
 #if GUI_USE_TOUCH
+uint8_t GUI_INPUT_CTX_TouchAdd(GUI_t* ctx, GUI_TouchData_t* ts) {
+    ts->Time = ctx->Time;                           /* Set event time */
+    return GUI_BUFFER_Write(&ctx->TouchBuffer, ts, sizeof(*ts)) ? 1 : 0;    /* Write data to buffer */
+}
+
 uint8_t GUI_INPUT_TouchAdd(GUI_TouchData_t* ts) {
-    ts->Time = GUI.Time;                            /* Set event time */
-    return GUI_BUFFER_Write(&TSBuffer, ts, sizeof(*ts)) ? 1 : 0;    /* Write data to buffer */
+    return GUI_INPUT_CTX_TouchAdd(GUI_CONTEXT_GET(), ts);   /* Add to current context */
 }
 
 uint8_t __GUI_INPUT_TouchRead(GUI_TouchData_t* ts) {
-    if (GUI_BUFFER_GetFull(&TSBuffer) >= sizeof(*ts)) {
-        return (uint8_t)GUI_BUFFER_Read(&TSBuffer, ts, sizeof(*ts)); /* Read data fro mbuffer */
+    if (GUI_BUFFER_GetFull(&GUI.TouchBuffer) >= sizeof(*ts)) {
+        return (uint8_t)GUI_BUFFER_Read(&GUI.TouchBuffer, ts, sizeof(*ts)); /* Read data fro mbuffer */
     }
     return 0;
 }
 
 uint8_t __GUI_INPUT_TouchAvailable(void) {
-    return GUI_BUFFER_GetFull(&TSBuffer) > 0;       /* Check if any available touch */
+    return GUI_BUFFER_GetFull(&GUI.TouchBuffer) > 0;   /* Check if any available touch */
 }
 #endif /* GUI_USE_TOUCH */
 
 
 #if GUI_USE_KEYBOARD
+uint8_t GUI_INPUT_CTX_KeyAdd(GUI_t* ctx, GUI_KeyboardData_t* kb) {
+    kb->Time = ctx->Time;                           /* Set event time */
+    return GUI_BUFFER_Write(&ctx->KeyBuffer, kb, sizeof(*kb)) ? 1 : 0;  /* Write data to buffer */
+}
+
 uint8_t GUI_INPUT_KeyAdd(GUI_KeyboardData_t* kb) {
-    kb->Time = GUI.Time;                            /* Set event time */
-    return GUI_BUFFER_Write(&KBBuffer, kb, sizeof(*kb)) ? 1 : 0;    /* Write data to buffer */
+    return GUI_INPUT_CTX_KeyAdd(GUI_CONTEXT_GET(), kb); /* Add to current context */
 }
 
 uint8_t __GUI_INPUT_KeyRead(GUI_KeyboardData_t* kb) {
-    if (GUI_BUFFER_GetFull(&KBBuffer) >= sizeof(*kb)) {
-        return (uint8_t)GUI_BUFFER_Read(&KBBuffer, kb, sizeof(*kb)); /* Read data fro mbuffer */
+    if (GUI_BUFFER_GetFull(&GUI.KeyBuffer) >= sizeof(*kb)) {
+        return (uint8_t)GUI_BUFFER_Read(&GUI.KeyBuffer, kb, sizeof(*kb)); /* Read data fro mbuffer */
     }
     return 0;
 }
@@ -98,9 +98,9 @@ uint8_t __GUI_INPUT_KeyRead(GUI_KeyboardData_t* kb) {
 
 void __GUI_INPUT_Init(void) {
 #if GUI_USE_TOUCH
-    GUI_BUFFER_Init(&TSBuffer, sizeof(TSBufferData), TSBufferData);
+    GUI_BUFFER_Init(&GUI.TouchBuffer, sizeof(GUI.TouchBufferData), GUI.TouchBufferData);
 #endif /* GUI_USE_TOUCH */
 #if GUI_USE_KEYBOARD
-    GUI_BUFFER_Init(&KBBuffer, sizeof(KBBufferData), KBBufferData);
+    GUI_BUFFER_Init(&GUI.KeyBuffer, sizeof(GUI.KeyBufferData), GUI.KeyBufferData);
 #endif /* GUI_USE_KEYBOARD */
 }
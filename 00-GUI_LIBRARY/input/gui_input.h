@@ -60,6 +60,26 @@ uint8_t GUI_INPUT_TouchAdd(GUI_TouchData_t* ts);
  */
 uint8_t GUI_INPUT_KeyAdd(GUI_KeyboardData_t* kb);
 
+/**
+ * \brief           Add new touch data to input buffer of specific GUI context
+ * \note            Function is safe to be called from interrupt or thread not processing this context
+ * \param[in,out]   *ctx: Pointer to \ref GUI_t context
+ * \param[in]       *ts: Pointer to \ref GUI_TouchData_t touch data with valid input
+ * \retval          1: Success
+ * \retval          0: Failure
+ */
+uint8_t GUI_INPUT_CTX_TouchAdd(GUI_t* ctx, GUI_TouchData_t* ts);
+
+/**
+ * \brief           Add new key data to input buffer of specific GUI context
+ * \note            Function is safe to be called from interrupt or thread not processing this context
+ * \param[in,out]   *ctx: Pointer to \ref GUI_t context
+ * \param[in]       *kb: Pointer to \ref GUI_KeyboardData_t key data
+ * \retval          1: Success
+ * \retval          0: Failure
+ */
+uint8_t GUI_INPUT_CTX_KeyAdd(GUI_t* ctx, GUI_KeyboardData_t* kb);
+
 #if !defined(DOXYGEN) && defined(GUI_INTERNAL)
 void __GUI_INPUT_Init(void);
 uint8_t __GUI_INPUT_TouchAvailable(void);
@@ -67,7 +67,6 @@ extern "C" {
 \endverbatim
  *
  */
-#include "gui_utils.h"
 #include "stdlib.h"
 #include "string.h"
 #include "stdint.h"
@@ -100,6 +99,9 @@ typedef struct _GUI_BUFFER_t {
 	void* UserParameters;           /*!< Pointer to user value if needed */
 } GUI_BUFFER_t;
 
+/* Buffer structure is part of GUI context, include GUI after it is defined */
+#include "gui_utils.h"
+
 /**
  * \brief  Initializes buffer structure for work
  * \param  *Buffer: Pointer to \ref GUI_BUFFER_t structure to initialize
@@ -0,0 +1,211 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#define GUI_INTERNAL
+#include "gui_fontcache.h"
+
+#if GUI_USE_FONT_CACHE
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private structures                            **/
+/******************************************************************************/
+/******************************************************************************/
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private definitions                           **/
+/******************************************************************************/
+/******************************************************************************/
+#define __NONE                      0xFFFF
+#define __Bucket(c)                 (((uint32_t)(uintptr_t)(c) >> 2) % GUI_FONT_CACHE_ENTRIES)
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private variables                            **/
+/******************************************************************************/
+/******************************************************************************/
+/* Cache is part of GUI context, contexts may be drawn in parallel */
+#define Entries                     (GUI.FontCache.Entries)
+#define Buckets                     (GUI.FontCache.Buckets)
+#define Head                        (GUI.FontCache.Head)
+#define Tail                        (GUI.FontCache.Tail)
+#define Stats                       (GUI.FontCache.Stats)
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private functions                            **/
+/******************************************************************************/
+/******************************************************************************/
+/* Remove entry from LRU list */
+static
+void __LRU_Unlink(uint16_t i) {
+    if (Entries[i].Prev != __NONE) {
+        Entries[Entries[i].Prev].Next = Entries[i].Next;
+    } else {
+        Head = Entries[i].Next;
+    }
+    if (Entries[i].Next != __NONE) {
+        Entries[Entries[i].Next].Prev = Entries[i].Prev;
+    } else {
+        Tail = Entries[i].Prev;
+    }
+}
+
+/* Add entry to the beginning of LRU list */
+static
+void __LRU_PushFront(uint16_t i) {
+    Entries[i].Prev = __NONE;
+    Entries[i].Next = Head;
+    if (Head != __NONE) {
+        Entries[Head].Prev = i;
+    }
+    Head = i;
+    if (Tail == __NONE) {
+        Tail = i;
+    }
+}
+
+/* Remove entry from its hash bucket */
+static
+void __Bucket_Remove(uint16_t i) {
+    uint16_t* p = &Buckets[__Bucket(Entries[i].Key)];
+    while (*p != __NONE) {
+        if (*p == i) {
+            *p = Entries[i].HashNext;               /* Skip entry in chain */
+            break;
+        }
+        p = &Entries[*p].HashNext;
+    }
+    Entries[i].Key = 0;
+}
+
+/* Get number of bytes for character bitmap */
+static
+uint32_t __GetDataSize(const GUI_FONT_t* font, const GUI_FONT_CharInfo_t* c) {
+    uint8_t ppb = 8;                                /* Pixels per byte */
+    if (font->Flags & GUI_FLAG_FONT_AA8) {
+        ppb = 1;
+    } else if (font->Flags & GUI_FLAG_FONT_AA4) {
+        ppb = 2;
+    } else if (font->Flags & GUI_FLAG_FONT_AA) {
+        ppb = 4;
+    }
+    return (uint32_t)((c->xSize + ppb - 1) / ppb) * c->ySize;
+}
+
+/******************************************************************************/
+/******************************************************************************/
+/***                                Public API                               **/
+/******************************************************************************/
+/******************************************************************************/
+void __GUI_FONTCACHE_Init(void) {
+    uint16_t i;
+    
+    Head = Tail = __NONE;
+    for (i = 0; i < GUI_FONT_CACHE_ENTRIES; i++) {
+        Buckets[i] = __NONE;
+        Entries[i].Key = 0;
+        Entries[i].HashNext = __NONE;
+        __LRU_PushFront(i);                         /* All entries are free at the beginning */
+    }
+}
+
+const GUI_Byte* __GUI_FONTCACHE_GetData(const GUI_FONT_t* font, const GUI_FONT_CharInfo_t* c) {
+    uint16_t i;
+    uint32_t size, time;
+    
+    /**
+     * Search for entry in hash bucket
+     */
+    for (i = Buckets[__Bucket(c)]; i != __NONE; i = Entries[i].HashNext) {
+        if (Entries[i].Key == c) {
+            Stats.Hits++;
+            if (Head != i) {                        /* Mark entry as most recently used */
+                __LRU_Unlink(i);
+                __LRU_PushFront(i);
+            }
+            return Entries[i].Data;
+        }
+    }
+    
+    Stats.Misses++;
+    size = __GetDataSize(font, c);
+    if (size > GUI_FONT_CACHE_GLYPH_SIZE || !font->Ext || !font->Ext->Read) {
+        Stats.Errors++;
+        return 0;
+    }
+    
+    /**
+     * Reuse least recently used entry
+     */
+    i = Tail;
+    if (Entries[i].Key) {
+        __Bucket_Remove(i);
+    }
+    
+    time = GUI_FONT_CACHE_TIMESTAMP();
+    if (!font->Ext->Read(font->Ext->Param, (uint32_t)(uintptr_t)c->Data, Entries[i].Data, size)) {
+        Stats.Errors++;
+        return 0;                                   /* Entry stays free at the end of LRU list */
+    }
+    time = GUI_FONT_CACHE_TIMESTAMP() - time;
+    Stats.Fetches++;
+    Stats.FetchTime += time;
+    if (time > Stats.FetchTimeMax) {
+        Stats.FetchTimeMax = time;
+    }
+    
+    Entries[i].Key = c;                             /* Add entry to hash bucket */
+    Entries[i].HashNext = Buckets[__Bucket(c)];
+    Buckets[__Bucket(c)] = i;
+    __LRU_Unlink(i);                                /* Set as most recently used */
+    __LRU_PushFront(i);
+    return Entries[i].Data;
+}
+
+uint8_t GUI_FONTCACHE_GetStats(GUI_FONTCACHE_Stats_t* stats, uint8_t reset) {
+    __GUI_ASSERTPARAMS(stats);                      /* Check input parameters */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    memcpy(stats, &Stats, sizeof(Stats));           /* Copy statistics */
+    if (reset) {
+        memset(&Stats, 0x00, sizeof(Stats));
+    }
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return 1;
+}
+
+uint8_t GUI_FONTCACHE_Flush(void) {
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    __GUI_FONTCACHE_Init();                         /* Reset all entries */
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return 1;
+}
+
+#endif /* GUI_USE_FONT_CACHE */
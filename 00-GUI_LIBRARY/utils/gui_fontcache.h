@@ -0,0 +1,115 @@
+/**
+ * \author  Tilen Majerle <tilen@majerle.eu>
+ * \brief   GUI font glyph cache
+ *  
+\verbatim
+   ----------------------------------------------------------------------
+    Copyright (c) 2016 Tilen Majerle
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge,
+    publish, distribute, sublicense, and/or sell copies of the Software, 
+    and to permit persons to whom the Software is furnished to do so, 
+    subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+    AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+   ----------------------------------------------------------------------
+\endverbatim
+ */
+#ifndef GUI_FONTCACHE_H
+#define GUI_FONTCACHE_H
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup      GUI_UTILS
+ * \{
+ */
+#include "gui_utils.h"
+
+/**
+ * \defgroup        GUI_FONTCACHE Font cache
+ * \brief           RAM cache for glyph bitmaps of fonts in external storage
+ * \{
+ *
+ * Fonts with \ref GUI_FONT_t.Ext member set keep only character table in memory,
+ * \ref GUI_FONT_CharInfo_t.Data member holds address of bitmap in external storage.
+ *
+ * When character is drawn, bitmap is searched in cache first.
+ * On miss, bitmap is read with \ref GUI_FONT_Ext_t.Read callback to least recently used cache entry.
+ *
+ * \note            Module is available when \ref GUI_USE_FONT_CACHE is enabled
+ */
+
+#if GUI_USE_FONT_CACHE || defined(DOXYGEN)
+
+#if defined(GUI_INTERNAL) || defined(DOXYGEN)
+
+/**
+ * \brief           Initialize font cache
+ * \note            Since this function is private, it can only be used by user inside GUI library
+ * \retval          None
+ */
+void __GUI_FONTCACHE_Init(void);
+
+/**
+ * \brief           Get bitmap data for character of font in external storage
+ * \note            Since this function is private, it can only be used by user inside GUI library
+ * \note            Returned pointer is valid until next call of this function
+ * \param[in]       *font: Font with \ref GUI_FONT_t.Ext member set
+ * \param[in]       *c: Character from font character table
+ * \retval          > 0: Pointer to bitmap data in RAM
+ * \retval          0: Bitmap is not available
+ */
+const GUI_Byte* __GUI_FONTCACHE_GetData(const GUI_FONT_t* font, const GUI_FONT_CharInfo_t* c);
+
+#endif /* defined(GUI_INTERNAL) || defined(DOXYGEN) */
+
+/**
+ * \brief           Get font cache statistics
+ * \param[out]      *stats: Pointer to \ref GUI_FONTCACHE_Stats_t structure to fill
+ * \param[in]       reset: Set to 1 to reset statistics after read
+ * \retval          1: Statistics were read ok
+ * \retval          0: Statistics were not read
+ */
+uint8_t GUI_FONTCACHE_GetStats(GUI_FONTCACHE_Stats_t* stats, uint8_t reset);
+
+/**
+ * \brief           Remove all glyphs from font cache
+ * \note            Use when content of external storage changes
+ * \retval          1: Cache was flushed ok
+ * \retval          0: Cache was not flushed
+ */
+uint8_t GUI_FONTCACHE_Flush(void);
+
+#endif /* GUI_USE_FONT_CACHE || defined(DOXYGEN) */
+
+/**
+ * \}
+ */
+
+/**
+ * \}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,240 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#define GUI_INTERNAL
+#include "gui_imgdec.h"
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private structures                            **/
+/******************************************************************************/
+/******************************************************************************/
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private definitions                           **/
+/******************************************************************************/
+/******************************************************************************/
+#define QOI_HEADER_SIZE             14
+#define QOI_END_SIZE                8
+
+#define QOI_OP_INDEX                0x00
+#define QOI_OP_DIFF                 0x40
+#define QOI_OP_LUMA                 0x80
+#define QOI_OP_RUN                  0xC0
+#define QOI_OP_RGB                  0xFE
+#define QOI_OP_RGBA                 0xFF
+#define QOI_MASK                    0xC0
+
+/* Color channels in ARGB8888 */
+#define __A(c)                      (((c) >> 24) & 0xFF)
+#define __R(c)                      (((c) >> 16) & 0xFF)
+#define __G(c)                      (((c) >>  8) & 0xFF)
+#define __B(c)                      (((c) >>  0) & 0xFF)
+#define __ARGB(a, r, g, b)          (((uint32_t)((a) & 0xFF) << 24) | ((uint32_t)((r) & 0xFF) << 16) | ((uint32_t)((g) & 0xFF) << 8) | ((uint32_t)((b) & 0xFF)))
+
+#define __QOI_Hash(c)               ((__R(c) * 3 + __G(c) * 5 + __B(c) * 7 + __A(c) * 11) & 0x3F)
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private variables                            **/
+/******************************************************************************/
+/******************************************************************************/
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private functions                            **/
+/******************************************************************************/
+/******************************************************************************/
+/* Read 32-bit big-endian value */
+static
+uint32_t __ReadBE32(const GUI_Byte* p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+/* Read 32-bit little-endian value */
+static
+uint32_t __ReadLE32(const GUI_Byte* p) {
+    return ((uint32_t)p[3] << 24) | ((uint32_t)p[2] << 16) | ((uint32_t)p[1] << 8) | (uint32_t)p[0];
+}
+
+/* Decode next QOI chunk to last pixel and run counter */
+static
+uint8_t __QOI_Chunk(GUI_IMGDEC_t* dec) {
+    GUI_Color_t c = dec->Last;
+    uint8_t b, b2;
+    int32_t vg;
+    
+    if (dec->Ptr >= dec->End) {
+        return 0;
+    }
+    b = *dec->Ptr++;
+    if (b == QOI_OP_RGB) {
+        if ((dec->End - dec->Ptr) < 3) {
+            return 0;
+        }
+        c = __ARGB(__A(c), dec->Ptr[0], dec->Ptr[1], dec->Ptr[2]);
+        dec->Ptr += 3;
+    } else if (b == QOI_OP_RGBA) {
+        if ((dec->End - dec->Ptr) < 4) {
+            return 0;
+        }
+        c = __ARGB(dec->Ptr[3], dec->Ptr[0], dec->Ptr[1], dec->Ptr[2]);
+        dec->Ptr += 4;
+    } else if ((b & QOI_MASK) == QOI_OP_INDEX) {
+        c = dec->Index[b];
+    } else if ((b & QOI_MASK) == QOI_OP_DIFF) {
+        c = __ARGB(__A(c),
+            __R(c) + ((b >> 4) & 0x03) - 2,
+            __G(c) + ((b >> 2) & 0x03) - 2,
+            __B(c) + ((b >> 0) & 0x03) - 2);
+    } else if ((b & QOI_MASK) == QOI_OP_LUMA) {
+        if (dec->Ptr >= dec->End) {
+            return 0;
+        }
+        b2 = *dec->Ptr++;
+        vg = (int32_t)(b & 0x3F) - 32;
+        c = __ARGB(__A(c),
+            __R(c) + vg - 8 + ((b2 >> 4) & 0x0F),
+            __G(c) + vg,
+            __B(c) + vg - 8 + (b2 & 0x0F));
+    } else {                                        /* QOI_OP_RUN */
+        dec->Run = b & 0x3F;                        /* Current pixel is first of run */
+    }
+    dec->Index[__QOI_Hash(c)] = c;
+    dec->Last = c;
+    return 1;
+}
+
+/* Decode next RLE packet header */
+static
+uint8_t __RLE_Chunk(GUI_IMGDEC_t* dec) {
+    uint8_t b;
+    
+    if ((dec->End - dec->Ptr) < 5) {                /* Header and at least one pixel */
+        return 0;
+    }
+    b = *dec->Ptr++;
+    if (b & 0x80) {                                 /* Repeated pixel */
+        dec->Last = __ReadLE32(dec->Ptr);
+        dec->Ptr += 4;
+        dec->Run = (b & 0x7F) + 1;
+    } else {                                        /* Literal pixels */
+        if ((uint32_t)(dec->End - dec->Ptr) < 4 * ((uint32_t)b + 1)) {
+            return 0;
+        }
+        dec->Literal = (uint32_t)b + 1;
+    }
+    return 1;
+}
+
+/* Decode or skip pixels, buff is NULL when skipping */
+static
+uint8_t __Process(GUI_IMGDEC_t* dec, GUI_Color_t* buff, uint32_t count) {
+    uint32_t n;
+    
+    if (count > dec->Remaining) {
+        return 0;
+    }
+    dec->Remaining -= count;
+    while (count) {
+        if (dec->Run) {                             /* Repeat last pixel */
+            n = __GUI_MIN(dec->Run, count);
+            dec->Run -= n;
+            count -= n;
+            if (buff) {
+                while (n--) {
+                    *buff++ = dec->Last;
+                }
+            }
+        } else if (dec->Literal) {                  /* Copy literal RLE pixels */
+            n = __GUI_MIN(dec->Literal, count);
+            dec->Literal -= n;
+            count -= n;
+            if (buff) {
+                while (n--) {
+                    *buff++ = __ReadLE32(dec->Ptr);
+                    dec->Ptr += 4;
+                }
+            } else {
+                dec->Ptr += 4 * n;
+            }
+        } else if (dec->Format == GUI_IMAGE_FORMAT_QOI) {
+            if (!__QOI_Chunk(dec)) {
+                return 0;
+            }
+            dec->Run++;                             /* Output decoded pixel with next iteration */
+        } else if (!__RLE_Chunk(dec)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/******************************************************************************/
+/******************************************************************************/
+/***                                Public API                               **/
+/******************************************************************************/
+/******************************************************************************/
+uint8_t GUI_IMGDEC_Init(GUI_IMGDEC_t* dec, const GUI_IMAGE_DESC_t* img) {
+    __GUI_ASSERTPARAMS(dec && img);                 /* Check input parameters */
+    
+    memset(dec, 0x00, sizeof(*dec));
+    if (!img->Data || !GUI_IMGDEC_IsCompressed(img->Format)) {
+        return 0;
+    }
+    dec->Format = img->Format;
+    dec->Ptr = img->Data;
+    dec->End = img->Data + img->Size;
+    dec->Remaining = (uint32_t)img->Width * (uint32_t)img->Height;
+    
+    if (img->Format == GUI_IMAGE_FORMAT_QOI) {
+        if (img->Size < (QOI_HEADER_SIZE + QOI_END_SIZE) ||
+            memcmp(img->Data, "qoif", 4) ||         /* Check magic and dimensions */
+            __ReadBE32(&img->Data[4]) != (uint32_t)img->Width ||
+            __ReadBE32(&img->Data[8]) != (uint32_t)img->Height) {
+            return 0;
+        }
+        dec->Ptr += QOI_HEADER_SIZE;
+        dec->End -= QOI_END_SIZE;
+        dec->Last = 0xFF000000UL;                   /* Initial pixel is opaque black */
+    }
+    return 1;
+}
+
+uint8_t GUI_IMGDEC_Read(GUI_IMGDEC_t* dec, GUI_Color_t* buff, uint32_t count) {
+    __GUI_ASSERTPARAMS(dec && buff);                /* Check input parameters */
+    return __Process(dec, buff, count);
+}
+
+uint8_t GUI_IMGDEC_Skip(GUI_IMGDEC_t* dec, uint32_t count) {
+    __GUI_ASSERTPARAMS(dec);                        /* Check input parameters */
+    return __Process(dec, NULL, count);
+}
+
+void GUI_IMGDEC_SetInput(GUI_IMGDEC_t* dec, const GUI_Byte* data, uint32_t len) {
+    dec->Ptr = data;
+    dec->End = data + len;
+}
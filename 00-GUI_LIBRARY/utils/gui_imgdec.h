@@ -0,0 +1,159 @@
+/**
+ * \author  Tilen Majerle <tilen@majerle.eu>
+ * \brief   Streaming decoder for compressed images
+ *  
+\verbatim
+   ----------------------------------------------------------------------
+    Copyright (c) 2016 Tilen Majerle
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge,
+    publish, distribute, sublicense, and/or sell copies of the Software, 
+    and to permit persons to whom the Software is furnished to do so, 
+    subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+    AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+   ----------------------------------------------------------------------
+\endverbatim
+ */
+#ifndef GUI_IMGDEC_H
+#define GUI_IMGDEC_H
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup      GUI_UTILS
+ * \{
+ */
+#include "gui_utils.h"
+
+/**
+ * \defgroup        GUI_IMGDEC Image decoder
+ * \brief           Streaming decoder for compressed images
+ * \{
+ *
+ * Decoder produces pixels in ARGB8888 format sequentially, from top left to bottom right corner.
+ * No memory for full image is required, caller reads pixels in chunks of any size.
+ *
+ * Supported formats:
+ *
+ *  - \ref GUI_IMAGE_FORMAT_QOI: "Quite OK Image" file, including 14-byte header and end marker
+ *  - \ref GUI_IMAGE_FORMAT_RLE: Sequence of packets. Each packet starts with header byte <b>H</b>.
+ *      When bit 7 of <b>H</b> is set, single ARGB8888 little-endian pixel follows and is repeated <b>(H & 0x7F) + 1</b> times.
+ *      When bit 7 of <b>H</b> is cleared, <b>H + 1</b> ARGB8888 little-endian pixels follow.
+ *      Packets may continue over line boundaries
+ *
+ * Repeated pixels are skipped without decoding each of them, which makes skipping clipped lines cheap.
+ */
+
+/**
+ * \brief           Image decoder state
+ */
+typedef struct GUI_IMGDEC_t {
+    GUI_IMAGE_Format_t Format;              /*!< Image format */
+    const GUI_Byte* Ptr;                    /*!< Pointer to next byte to decode */
+    const GUI_Byte* End;                    /*!< Pointer to first byte after image data */
+    uint32_t Remaining;                     /*!< Number of pixels left to decode */
+    GUI_Color_t Last;                       /*!< Last decoded pixel */
+    uint32_t Run;                           /*!< Number of repeats of last pixel left */
+    uint32_t Literal;                       /*!< Number of literal pixels left in current \ref GUI_IMAGE_FORMAT_RLE packet */
+    GUI_Color_t Index[64];                  /*!< Array of previously seen pixels for \ref GUI_IMAGE_FORMAT_QOI format */
+} GUI_IMGDEC_t;
+
+/**
+ * \brief           Check if image format is decoded with this module
+ * \param[in]       fmt: Image format. This parameter can be a value of \ref GUI_IMAGE_Format_t enumeration
+ * \retval          1: Format is compressed
+ * \retval          0: Format is not compressed
+ * \hideinitializer
+ */
+#define GUI_IMGDEC_IsCompressed(fmt)    ((fmt) == GUI_IMAGE_FORMAT_QOI || (fmt) == GUI_IMAGE_FORMAT_RLE)
+
+/**
+ * \brief           Prepare decoder for image
+ * \param[out]      *dec: Pointer to \ref GUI_IMGDEC_t structure for decoder state
+ * \param[in]       *img: Pointer to compressed image. For \ref GUI_IMAGE_FORMAT_QOI format,
+ *                      dimensions in file header must match dimensions of image descriptor
+ * \retval          1: Decoder is ready
+ * \retval          0: Image format is not supported or image is not valid
+ */
+uint8_t GUI_IMGDEC_Init(GUI_IMGDEC_t* dec, const GUI_IMAGE_DESC_t* img);
+
+/**
+ * \brief           Decode next pixels
+ * \param[in,out]   *dec: Pointer to \ref GUI_IMGDEC_t structure for decoder state
+ * \param[out]      *buff: Pointer to output buffer for ARGB8888 pixels
+ * \param[in]       count: Number of pixels to decode
+ * \retval          1: All pixels were decoded
+ * \retval          0: Image data is corrupted or there are not enough pixels
+ */
+uint8_t GUI_IMGDEC_Read(GUI_IMGDEC_t* dec, GUI_Color_t* buff, uint32_t count);
+
+/**
+ * \brief           Skip next pixels
+ * \param[in,out]   *dec: Pointer to \ref GUI_IMGDEC_t structure for decoder state
+ * \param[in]       count: Number of pixels to skip
+ * \retval          1: All pixels were skipped
+ * \retval          0: Image data is corrupted or there are not enough pixels
+ */
+uint8_t GUI_IMGDEC_Skip(GUI_IMGDEC_t* dec, uint32_t count);
+
+/**
+ * \brief           Set next part of compressed data for image streamed from storage
+ * \note            Decoder must be first initialized with \ref GUI_IMGDEC_Init using part of data with image header.
+ *                  New part must start with first byte not yet consumed by decoder, see \ref GUI_IMGDEC_GetConsumed
+ * \note            Before each \ref GUI_IMGDEC_Read, part must contain enough data for requested pixels,
+ *                  at most \ref GUI_IMGDEC_MAX_BYTES bytes are needed
+ * \param[in,out]   *dec: Pointer to \ref GUI_IMGDEC_t structure for decoder state
+ * \param[in]       *data: Pointer to compressed data
+ * \param[in]       len: Number of bytes in data
+ * \retval          None
+ */
+void GUI_IMGDEC_SetInput(GUI_IMGDEC_t* dec, const GUI_Byte* data, uint32_t len);
+
+/**
+ * \brief           Get number of bytes consumed from data set with \ref GUI_IMGDEC_SetInput
+ * \param[in]       dec: Pointer to \ref GUI_IMGDEC_t structure for decoder state
+ * \param[in]       data: Pointer to data set as input
+ * \retval          Number of consumed bytes
+ * \hideinitializer
+ */
+#define GUI_IMGDEC_GetConsumed(dec, data)   ((uint32_t)((dec)->Ptr - (const GUI_Byte *)(data)))
+
+/**
+ * \brief           Maximal number of compressed bytes needed to decode pixels
+ * \param[in]       count: Number of pixels
+ * \retval          Number of bytes, including largest \ref GUI_IMAGE_FORMAT_RLE literal packet
+ * \hideinitializer
+ */
+#define GUI_IMGDEC_MAX_BYTES(count)     ((uint32_t)(count) * 5 + 4 * 128 + 1)
+
+/**
+ * \}
+ */
+
+/**
+ * \}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,144 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#define GUI_INTERNAL
+#include "gui_job.h"
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private structures                            **/
+/******************************************************************************/
+/******************************************************************************/
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private definitions                           **/
+/******************************************************************************/
+/******************************************************************************/
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private variables                            **/
+/******************************************************************************/
+/******************************************************************************/
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private functions                            **/
+/******************************************************************************/
+/******************************************************************************/
+
+/******************************************************************************/
+/******************************************************************************/
+/***                                Public API                               **/
+/******************************************************************************/
+/******************************************************************************/
+GUI_JOB_t* __GUI_JOB_Create(GUI_JOB_Thread_t thread, void* params, GUI_JOB_t** handle) {
+    GUI_JOB_t* ptr;
+    
+    __GUI_ASSERTPARAMS(thread);                     /* Check input parameters */
+    ptr = (GUI_JOB_t *)__GUI_MEMALLOC(sizeof(GUI_JOB_t), GUI_MEM_TYPE_OTHER);  /* Allocate memory for job */
+    if (ptr) {
+        memset(ptr, 0x00, sizeof(GUI_JOB_t));       /* Reset memory */
+        
+        PT_INIT(&ptr->pt);                          /* Start thread from beginning */
+        ptr->Thread = thread;                       /* Set job function */
+        ptr->Params = params;                       /* Job custom parameters */
+        ptr->Handle = handle;                       /* Owner pointer, cleared when job is released */
+        if (handle) {
+            *handle = ptr;
+        }
+        
+        __GUI_LINKEDLIST_ADD_GEN(&GUI.Jobs.List, &ptr->List);   /* Add job to linked list */
+        GUI.Jobs.Count++;
+    }
+    return ptr;
+}
+
+uint8_t __GUI_JOB_Remove(GUI_JOB_t** j) {
+    __GUI_ASSERTPARAMS(j && *j);                    /* Check input parameters */
+    (*j)->Flags |= GUI_FLAG_JOB_REMOVE;             /* Job may be running now, release memory later */
+    (*j)->Handle = 0;                               /* Owner does not use job anymore */
+    *j = 0;                                         /* Restore pointer */
+    return 1;
+}
+
+uint32_t __GUI_JOB_Process(void) {
+    GUI_JOB_t* j;
+    volatile uint32_t time = GUI.Time;
+    uint32_t steps = 0, idle = 0;
+    
+    while ((j = (GUI_JOB_t *)GUI.Jobs.List.First) != NULL) {
+        __GUI_LINKEDLIST_REMOVE_GEN(&GUI.Jobs.List, &j->List);  /* Take first job */
+        if (!(j->Flags & GUI_FLAG_JOB_REMOVE)) {
+            steps++;
+            switch (j->Thread(j)) {                 /* Execute single step of job */
+                case PT_YIELDED:                    /* Job did part of work */
+                    idle = 0;
+                    break;
+                case PT_WAITING:                    /* Job waits for condition */
+                    idle++;
+                    break;
+                default:                            /* Job ended or exited */
+                    j->Flags |= GUI_FLAG_JOB_REMOVE;
+                    break;
+            }
+        }
+        if (j->Flags & GUI_FLAG_JOB_REMOVE) {       /* Release job memory */
+            if (j->Handle) {
+                *j->Handle = 0;                     /* Owner pointer does not point to released job */
+            }
+            __GUI_MEMFREE(j);
+            GUI.Jobs.Count--;
+        } else {
+            __GUI_LINKEDLIST_ADD_GEN(&GUI.Jobs.List, &j->List); /* Put job to the end for round-robin order */
+        }
+        
+        if (idle >= GUI.Jobs.Count ||               /* All jobs are waiting */
+            steps >= GUI_JOB_MAX_STEPS ||           /* Protection when time is not updated */
+            (GUI.Time - time) >= GUI_JOB_SLICE) {   /* Time slice is used */
+            break;
+        }
+    }
+    return steps;
+}
+
+GUI_JOB_t* GUI_JOB_Create(GUI_JOB_Thread_t thread, void* params, GUI_JOB_t** handle) {
+    GUI_JOB_t* ptr;
+    
+    __GUI_ENTER();                                  /* Enter GUI */
+    ptr = __GUI_JOB_Create(thread, params, handle); /* Create job */
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return ptr;
+}
+
+GUI_Result_t GUI_JOB_Remove(GUI_JOB_t** j) {
+    uint8_t ret;
+    
+    __GUI_ENTER();                                  /* Enter GUI */
+    ret = __GUI_JOB_Remove(j);                      /* Remove job */
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return ret ? guiOK : guiERROR;
+}
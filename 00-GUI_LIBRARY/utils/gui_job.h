@@ -0,0 +1,153 @@
+/**
+ * \author  Tilen Majerle <tilen@majerle.eu>
+ * \brief   GUI cooperative background jobs
+ *  
+\verbatim
+   ----------------------------------------------------------------------
+    Copyright (c) 2016 Tilen Majerle
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge,
+    publish, distribute, sublicense, and/or sell copies of the Software, 
+    and to permit persons to whom the Software is furnished to do so, 
+    subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+    AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+   ----------------------------------------------------------------------
+\endverbatim
+ */
+#ifndef GUI_JOB_H
+#define GUI_JOB_H
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup      GUI_UTILS
+ * \brief       
+ * \{
+ */
+#include "gui_utils.h"
+
+/**
+ * \defgroup        GUI_JOB Background jobs
+ * \brief           Cooperative jobs processed after redraw
+ * \{
+ *
+ * Job is protothread which splits long work into small steps,
+ * for example image decoding or sorting of large list.
+ * Jobs are processed in round-robin order inside \ref GUI_Process after redraw
+ * until \ref GUI_JOB_SLICE milliseconds are used or all jobs are waiting,
+ * therefore input and redraw are never blocked for longer than one step.
+ *
+ * \par             Example job
+ *
+\code{c}
+PT_THREAD(sort_job(GUI_JOB_t* job)) {
+    my_sort_t* s = GUI_JOB_GetParams(job);
+    
+    PT_BEGIN(&job->pt);
+    for (s->i = 0; s->i < s->count; s->i++) {
+        sort_step(s);               //Do small part of work
+        PT_YIELD(&job->pt);         //Give time to GUI and other jobs
+    }
+    PT_END(&job->pt);               //Job is removed when thread ends
+}
+
+GUI_JOB_Create(sort_job, &my_sort, &my_sort.job);   //my_sort.job is set to NULL when job is removed
+\endcode
+ */
+
+#if defined(GUI_INTERNAL) || defined(DOXYGEN)
+
+#define GUI_FLAG_JOB_REMOVE             ((uint8_t)(1 << 0UL))   /*!< Job is removed on next processing */
+
+/**
+ * \brief           Create new job and start it on next processing
+ * \note            Since this function is private, it can only be used by user inside GUI library
+ * \param[in]       thread: Job protothread function
+ * \param[in]       *params: Pointer to user parameters used in job
+ * \param[out]      **handle: Pointer to owner variable, set to job on creation and to NULL when job memory is released.
+ *                      Set to NULL when job pointer is not kept
+ * \retval          > 0: Job created
+ * \retval          0: Job creation failed
+ */
+GUI_JOB_t* __GUI_JOB_Create(GUI_JOB_Thread_t thread, void* params, GUI_JOB_t** handle);
+
+/**
+ * \brief           Remove job
+ * \note            Since this function is private, it can only be used by user inside GUI library
+ * \note            Job is not called anymore, memory is released on next processing
+ * \param[in]       **j: Pointer to pointer to \ref GUI_JOB_t structure.
+ *                      After job remove, pointer value where it points to will be changed
+ * \retval          1: Job was removed ok
+ * \retval          0: Job was not removed
+ */
+uint8_t __GUI_JOB_Remove(GUI_JOB_t** j);
+
+/**
+ * \brief           Internal processing called by GUI library
+ * \note            Since this function is private, it can only be used by user inside GUI library
+ * \note            Runs job steps until time slice is used or all jobs are waiting
+ * \retval          Number of executed job steps
+ */
+uint32_t __GUI_JOB_Process(void);
+
+#endif /* defined(GUI_INTERNAL) || defined(DOXYGEN) */
+
+/**
+ * \brief           Create new job and start it on next processing
+ * \param[in]       thread: Job protothread function, job is removed when it ends or exits
+ * \param[in]       *params: Pointer to user parameters used in job
+ * \param[out]      **handle: Pointer to owner variable, set to job on creation and to NULL when job memory is released.
+ *                      Set to NULL when job pointer is not kept
+ * \retval          > 0: Job created
+ * \retval          0: Job creation failed
+ */
+GUI_JOB_t* GUI_JOB_Create(GUI_JOB_Thread_t thread, void* params, GUI_JOB_t** handle);
+
+/**
+ * \brief           Remove job before it ends
+ * \param[in]       **j: Pointer to pointer to \ref GUI_JOB_t structure.
+ *                      After job remove, pointer value where it points to will be changed.
+ *                      When it is handle given on creation and job already ended, it is NULL and function fails
+ * \retval          Member of \ref GUI_Result_t enumeration
+ */
+GUI_Result_t GUI_JOB_Remove(GUI_JOB_t** j);
+
+/**
+ * \brief           Get parameters from job
+ * \param[in]       j: Job structure
+ * \retval          Job parameters
+ * \hideinitializer
+ */
+#define GUI_JOB_GetParams(j)            (j)->Params
+
+/**
+ * \}
+ */
+
+/**
+ * \}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
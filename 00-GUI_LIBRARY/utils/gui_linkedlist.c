@@ -197,7 +197,7 @@ uint8_t __GUI_LINKEDLIST_MOVEUP_GEN(GUI_LinkedListRoot_t* root, GUI_LinkedList_t
 
 GUI_LinkedListMulti_t* __GUI_LINKEDLIST_MULTI_ADD_GEN(GUI_LinkedListRoot_t* root, void* element) {
     GUI_LinkedListMulti_t* ptr;
-    ptr = (GUI_LinkedListMulti_t *)__GUI_MEMALLOC(sizeof(GUI_LinkedListMulti_t));   /* Create memory for linked list */
+    ptr = (GUI_LinkedListMulti_t *)__GUI_MEMALLOC(sizeof(GUI_LinkedListMulti_t), GUI_MEM_TYPE_OTHER);   /* Create memory for linked list */
     if (!ptr) {
         return 0;
     }
@@ -245,12 +245,13 @@ uint8_t __GUI_LINKEDLIST_MULTI_MOVEUP_GEN(GUI_LinkedListRoot_t* root, GUI_Linked
 }
 
 uint8_t __GUI_LINKEDLIST_MULTI_FIND_REMOVE(GUI_LinkedListRoot_t* root, void* element) {
-    GUI_LinkedListMulti_t* link;
+    GUI_LinkedListMulti_t* link, *next;
     uint8_t ret = 0;
     
     __GUI_ASSERTPARAMS(root);                       /* Check input parameters */
     
-    for (link = __GUI_LINKEDLIST_MULTI_GETNEXT_GEN(root, NULL); link; link = __GUI_LINKEDLIST_MULTI_GETNEXT_GEN(NULL, link)) {
+    for (link = __GUI_LINKEDLIST_MULTI_GETNEXT_GEN(root, NULL); link; link = next) {
+        next = __GUI_LINKEDLIST_MULTI_GETNEXT_GEN(NULL, link);  /* Get next before link memory is released */
         if ((void *)__GUI_LINKEDLIST_MULTI_GetData(link) == element) {  /* Check match */
             __GUI_LINKEDLIST_MULTI_REMOVE_GEN(root, link);  /* Remove element from linked list */
             ret = 1;
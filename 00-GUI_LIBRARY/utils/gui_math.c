@@ -43,12 +43,44 @@
 /***                            Private variables                            **/
 /******************************************************************************/
 /******************************************************************************/
+/* Sine of angles from 0 to 90 degrees in units of GUI_MATH_TRIG_ONE */
+static const int16_t SinTable[91] = {
+        0,   286,   572,   857,  1143,  1428,  1713,  1997,  2280,  2563,
+     2845,  3126,  3406,  3686,  3964,  4240,  4516,  4790,  5063,  5334,
+     5604,  5872,  6138,  6402,  6664,  6924,  7182,  7438,  7692,  7943,
+     8192,  8438,  8682,  8923,  9162,  9397,  9630,  9860, 10087, 10311,
+    10531, 10749, 10963, 11174, 11381, 11585, 11786, 11982, 12176, 12365,
+    12551, 12733, 12911, 13085, 13255, 13421, 13583, 13741, 13894, 14044,
+    14189, 14330, 14466, 14598, 14726, 14849, 14968, 15082, 15191, 15296,
+    15396, 15491, 15582, 15668, 15749, 15826, 15897, 15964, 16026, 16083,
+    16135, 16182, 16225, 16262, 16294, 16322, 16344, 16362, 16374, 16382,
+    16384
+};
 
 /******************************************************************************/
 /******************************************************************************/
 /***                            Private functions                            **/
 /******************************************************************************/
 /******************************************************************************/
+/* Calculate square root of 64-bit number with digit-by-digit method */
+static
+uint32_t __SqrtU64(uint64_t x) {
+    uint64_t res = 0, bit = (uint64_t)1 << 62;      /* Start with highest power of 4 */
+    
+    while (bit > x) {                               /* Find highest power of 4 lower or equal to input */
+        bit >>= 2;
+    }
+    while (bit) {
+        if (x >= res + bit) {
+            x -= res + bit;
+            res = (res >> 1) + bit;
+        } else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)res;
+}
 
 /******************************************************************************/
 /******************************************************************************/
@@ -91,3 +123,60 @@ uint8_t GUI_MATH_CenterOfXY(float x1, float y1, float x2, float y2, float* resul
     
     return 1;
 }
+
+uint32_t GUI_MATH_SqrtInt(uint32_t x) {
+    uint32_t res = 0, bit = (uint32_t)1 << 30;      /* Start with highest power of 4 */
+    
+    while (bit > x) {                               /* Find highest power of 4 lower or equal to input */
+        bit >>= 2;
+    }
+    while (bit) {
+        if (x >= res + bit) {
+            x -= res + bit;
+            res = (res >> 1) + bit;
+        } else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    return res;
+}
+
+uint8_t GUI_MATH_SqrtFixed(GUI_Fixed_t x, GUI_Fixed_t* result) {
+    if (x > 0) {                                    /* Check valid input */
+        *result = (GUI_Fixed_t)__SqrtU64((uint64_t)x << GUI_FIXED_SHIFT);  /* Square root of Q32.32 number is Q16.16 number */
+        return 1;
+    }
+    return 0;
+}
+
+uint8_t GUI_MATH_DistanceBetweenXYFixed(GUI_Fixed_t x1, GUI_Fixed_t y1, GUI_Fixed_t x2, GUI_Fixed_t y2, GUI_Fixed_t* result) {
+    int64_t dx = (int64_t)x1 - (int64_t)x2;
+    int64_t dy = (int64_t)y1 - (int64_t)y2;
+    uint64_t sum = (uint64_t)(dx * dx) + (uint64_t)(dy * dy);   /* Sum of squares in Q32.32 format */
+    
+    if (sum) {                                      /* Check valid input */
+        *result = (GUI_Fixed_t)__SqrtU64(sum);      /* Square root of Q32.32 number is Q16.16 number */
+        return 1;
+    }
+    return 0;
+}
+
+int16_t GUI_MATH_SinDeg(int32_t angle) {
+    angle %= 360;                                   /* Normalize angle to 0 - 359 degrees */
+    if (angle < 0) {
+        angle += 360;
+    }
+    if (angle <= 90) {                              /* Use symmetry of quadrants */
+        return SinTable[angle];
+    } else if (angle <= 180) {
+        return SinTable[180 - angle];
+    } else if (angle <= 270) {
+        return -SinTable[angle - 180];
+    }
+    return -SinTable[360 - angle];
+}
+
+int16_t GUI_MATH_CosDeg(int32_t angle) {
+    return GUI_MATH_SinDeg(angle + 90);
+}
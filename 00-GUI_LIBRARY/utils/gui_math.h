@@ -49,6 +49,59 @@ extern "C" {
  * \{
  */
 
+/**
+ * \name            GUI_MATH_FIXED Fixed-point
+ * \brief           Q16.16 fixed-point number operations
+ * \note            Valid range of integer part is from -32768 to 32767
+ * \{
+ */
+
+#define GUI_FIXED_SHIFT             16  /*!< Number of fractional bits in fixed-point number */
+#define GUI_FIXED_ONE               ((GUI_Fixed_t)1 << GUI_FIXED_SHIFT) /*!< Fixed-point representation of 1 */
+#define GUI_FIXED_FROM_INT(x)       ((GUI_Fixed_t)(x) * GUI_FIXED_ONE)  /*!< Convert integer to fixed-point number */
+#define GUI_FIXED_TO_INT(x)         ((int32_t)(x) >> GUI_FIXED_SHIFT)   /*!< Convert fixed-point number to integer, rounded down */
+#define GUI_FIXED_FROM_FLOAT(x)     ((GUI_Fixed_t)((x) * 65536.0f))     /*!< Convert float to fixed-point number. Use with constant numbers only to prevent float calculation */
+#define GUI_FIXED_TO_FLOAT(x)       ((float)(x) / 65536.0f)             /*!< Convert fixed-point number to float */
+#define GUI_FIXED_MUL(a, b)         ((GUI_Fixed_t)(((int64_t)(a) * (int64_t)(b)) >> GUI_FIXED_SHIFT))   /*!< Multiply 2 fixed-point numbers */
+#define GUI_FIXED_DIV(a, b)         ((GUI_Fixed_t)(((int64_t)(a) * GUI_FIXED_ONE) / (int64_t)(b)))      /*!< Divide 2 fixed-point numbers */
+
+/**
+ * \}
+ */
+
+/**
+ * \name            GUI_MATH_REAL Real numbers
+ * \brief           Operations on \ref GUI_Real_t numbers
+ *
+ *                  Depending on \ref GUI_USE_FIXED_POINT configuration,
+ *                  macros are mapped to float or to Q16.16 fixed-point operations
+ * \{
+ */
+
+#if GUI_USE_FIXED_POINT || defined(DOXYGEN)
+#define GUI_REAL(x)                 GUI_FIXED_FROM_FLOAT(x)     /*!< Create real number constant from float constant */
+#define GUI_REAL_FROM_INT(x)        GUI_FIXED_FROM_INT(x)       /*!< Convert integer to real number */
+#define GUI_REAL_TO_INT(x)          GUI_FIXED_TO_INT(x)         /*!< Convert real number to integer */
+#define GUI_REAL_FROM_FLOAT(x)      GUI_FIXED_FROM_FLOAT(x)     /*!< Convert float to real number */
+#define GUI_REAL_TO_FLOAT(x)        GUI_FIXED_TO_FLOAT(x)       /*!< Convert real number to float */
+#define GUI_REAL_MUL(a, b)          GUI_FIXED_MUL(a, b)         /*!< Multiply 2 real numbers */
+#define GUI_REAL_DIV(a, b)          GUI_FIXED_DIV(a, b)         /*!< Divide 2 real numbers */
+#define GUI_REAL_MUL_INT(a, i)      ((GUI_Real_t)((a) * (int32_t)(i)))  /*!< Multiply real number with integer */
+#else
+#define GUI_REAL(x)                 ((float)(x))
+#define GUI_REAL_FROM_INT(x)        ((float)(x))
+#define GUI_REAL_TO_INT(x)          ((int32_t)(x))
+#define GUI_REAL_FROM_FLOAT(x)      ((float)(x))
+#define GUI_REAL_TO_FLOAT(x)        ((float)(x))
+#define GUI_REAL_MUL(a, b)          ((a) * (b))
+#define GUI_REAL_DIV(a, b)          ((a) / (b))
+#define GUI_REAL_MUL_INT(a, i)      ((a) * (float)(i))
+#endif /* GUI_USE_FIXED_POINT || defined(DOXYGEN) */
+
+/**
+ * \}
+ */
+
 /**
  * \brief           Calculate square of input value
  *
@@ -105,6 +158,66 @@ uint8_t GUI_MATH_DistanceBetweenXY(float x1, float y1, float x2, float y2, float
  * \retval          0: Function failed, results are not valid
  */
 uint8_t GUI_MATH_CenterOfXY(float x1, float y1, float x2, float y2, float* resultX, float* resultY);
+
+/**
+ * \brief           Calculate integer square root of input value
+ *
+ *                  \f$\ y=\lfloor sqrt{(x)} \rfloor\f$
+ *
+ * \note            Function uses only integer operations and is suitable for targets without FPU
+ * \param[in]       x: Number to calculate square root from
+ * \retval          Square root rounded down
+ */
+uint32_t GUI_MATH_SqrtInt(uint32_t x);
+
+/**
+ * \brief           Calculate square root of fixed-point input value
+ *
+ *                  \f$\ y=sqrt{(x)}\f$
+ *
+ * \param[in]       x: Q16.16 fixed-point number to calculate square root from
+ * \param[out]      *result: Pointer to \ref GUI_Fixed_t variable to store result to
+ * \retval          1: Function succedded, result is valid
+ * \retval          0: Function failed, result is not valid
+ * \sa              GUI_MATH_Sqrt
+ */
+uint8_t GUI_MATH_SqrtFixed(GUI_Fixed_t x, GUI_Fixed_t* result);
+
+/**
+ * \brief           Calculate distance between 2 XY fixed-point points
+ *
+ *                  \f$\ y=sqrt{((x_1-x_2)^2+(y_1-y_2)^2)}\f$
+ *
+ * \param[in]       x1: X position of point 1 in Q16.16 format
+ * \param[in]       y1: Y position of point 1 in Q16.16 format
+ * \param[in]       x2: X position of point 2 in Q16.16 format
+ * \param[in]       y2: Y position of point 2 in Q16.16 format
+ * \param[out]      *result: Pointer to \ref GUI_Fixed_t variable to store result to
+ * \retval          1: Function succedded, result is valid
+ * \retval          0: Function failed, result is not valid
+ * \sa              GUI_MATH_DistanceBetweenXY
+ */
+uint8_t GUI_MATH_DistanceBetweenXYFixed(GUI_Fixed_t x1, GUI_Fixed_t y1, GUI_Fixed_t x2, GUI_Fixed_t y2, GUI_Fixed_t* result);
+
+#define GUI_MATH_TRIG_ONE           16384   /*!< Value of 1 in results of \ref GUI_MATH_SinDeg and \ref GUI_MATH_CosDeg */
+
+/**
+ * \brief           Calculate sine of angle from lookup table
+ * \note            Function uses only integer operations and is suitable for targets without FPU
+ * \param[in]       angle: Angle in units of degrees, any positive or negative value
+ * \retval          Sine of angle in units of \ref GUI_MATH_TRIG_ONE
+ * \sa              GUI_MATH_CosDeg
+ */
+int16_t GUI_MATH_SinDeg(int32_t angle);
+
+/**
+ * \brief           Calculate cosine of angle from lookup table
+ * \note            Function uses only integer operations and is suitable for targets without FPU
+ * \param[in]       angle: Angle in units of degrees, any positive or negative value
+ * \retval          Cosine of angle in units of \ref GUI_MATH_TRIG_ONE
+ * \sa              GUI_MATH_SinDeg
+ */
+int16_t GUI_MATH_CosDeg(int32_t angle);
     
 /**
  * \}
@@ -0,0 +1,210 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#define GUI_INTERNAL
+#include "gui_mem.h"
+
+#if GUI_USE_MEM_STATS
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private structures                            **/
+/******************************************************************************/
+/******************************************************************************/
+/* Header in front of each allocated block, size keeps user memory aligned to 8 bytes */
+typedef struct __GUI_MEM_Header_t {
+    uint32_t Size;                          /* Number of bytes requested by user */
+    uint8_t Type;                           /* Allocation category */
+    uint8_t Widget;                         /* Index of widget type or 0xFF when not widget */
+    uint16_t Reserved;
+} __GUI_MEM_Header_t;
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private definitions                           **/
+/******************************************************************************/
+/******************************************************************************/
+#define __NO_WIDGET         0xFF
+
+#ifndef GUI_MEM_LOCK
+#define GUI_MEM_LOCK()
+#define GUI_MEM_UNLOCK()
+#endif /* GUI_MEM_LOCK */
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private variables                            **/
+/******************************************************************************/
+/******************************************************************************/
+static GUI_MEM_Stats_t Stats;               /* Allocator is shared, statistics are global and protected with GUI_MEM_LOCK */
+static const GUI_WIDGET_t* Widgets[GUI_MEM_WIDGET_TYPES];   /* Widget types for statistics entries */
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private functions                            **/
+/******************************************************************************/
+/******************************************************************************/
+/* Add object to usage and update high-water marks */
+static
+void __UsageAdd(GUI_MEM_Usage_t* u, uint32_t size) {
+    u->Count++;
+    u->Bytes += size;
+    if (u->Count > u->MaxCount) {
+        u->MaxCount = u->Count;
+    }
+    if (u->Bytes > u->MaxBytes) {
+        u->MaxBytes = u->Bytes;
+    }
+}
+
+/* Remove object from usage */
+static
+void __UsageRemove(GUI_MEM_Usage_t* u, uint32_t size) {
+    u->Count--;
+    u->Bytes -= size;
+}
+
+/* Get statistics entry for widget type, add new one if not yet used */
+static
+uint8_t __GetWidgetIndex(const GUI_WIDGET_t* widget) {
+    uint8_t i;
+    
+    for (i = 0; i < GUI_MEM_WIDGET_TYPES; i++) {
+        if (Widgets[i] == widget) {
+            return i;
+        }
+        if (!Widgets[i]) {                          /* Free entry, widget type is used first time */
+            Widgets[i] = widget;
+            Stats.Widgets[i].Name = widget->Name;
+            return i;
+        }
+    }
+    return __NO_WIDGET;                             /* Counted only in widget category */
+}
+
+/* Allocate memory with header and update statistics */
+static
+void* __Alloc(uint32_t size, GUI_MEM_Type_t type, uint8_t widget) {
+    __GUI_MEM_Header_t* hdr;
+    
+    hdr = (__GUI_MEM_Header_t *)malloc(sizeof(*hdr) + size);
+    if (!hdr) {
+        return 0;
+    }
+    hdr->Size = size;
+    hdr->Type = (uint8_t)type;
+    hdr->Widget = widget;
+    
+    GUI_MEM_LOCK();                                 /* Statistics are shared between contexts */
+    __UsageAdd(&Stats.Total, size);
+    __UsageAdd(&Stats.Types[type], size);
+    if (widget != __NO_WIDGET) {
+        __UsageAdd(&Stats.Widgets[widget].Usage, size);
+    }
+    Stats.Overhead += sizeof(*hdr);
+    GUI_MEM_UNLOCK();
+    return hdr + 1;
+}
+
+/******************************************************************************/
+/******************************************************************************/
+/***                                Public API                               **/
+/******************************************************************************/
+/******************************************************************************/
+void* __GUI_MEM_Alloc(uint32_t size, GUI_MEM_Type_t type) {
+    if (type >= GUI_MEM_TYPE_COUNT) {
+        type = GUI_MEM_TYPE_OTHER;
+    }
+    return __Alloc(size, type, __NO_WIDGET);
+}
+
+void* __GUI_MEM_AllocWidget(const GUI_WIDGET_t* widget) {
+    uint8_t index;
+    
+    GUI_MEM_LOCK();                                 /* Widget table is shared between contexts */
+    index = __GetWidgetIndex(widget);
+    GUI_MEM_UNLOCK();
+    return __Alloc(widget->Size, GUI_MEM_TYPE_WIDGET, index);
+}
+
+void __GUI_MEM_Free(void* ptr) {
+    __GUI_MEM_Header_t* hdr;
+    
+    if (!ptr) {
+        return;
+    }
+    hdr = (__GUI_MEM_Header_t *)ptr - 1;            /* Get block header */
+    GUI_MEM_LOCK();
+    __UsageRemove(&Stats.Total, hdr->Size);
+    __UsageRemove(&Stats.Types[hdr->Type], hdr->Size);
+    if (hdr->Widget != __NO_WIDGET) {
+        __UsageRemove(&Stats.Widgets[hdr->Widget].Usage, hdr->Size);
+    }
+    Stats.Overhead -= sizeof(*hdr);
+    GUI_MEM_UNLOCK();
+    free(hdr);
+}
+
+GUI_Result_t GUI_MEM_GetStats(GUI_MEM_Stats_t* stats) {
+    __GUI_ASSERTPARAMS(stats);                      /* Check input parameters */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    GUI_MEM_LOCK();
+    memcpy(stats, &Stats, sizeof(*stats));
+    GUI_MEM_UNLOCK();
+    stats->HeapFree = GUI_MEM_HEAP_FREE();          /* Read heap state from allocator */
+    stats->HeapLargest = GUI_MEM_HEAP_LARGEST();
+    if (stats->HeapFree && stats->HeapLargest <= stats->HeapFree) {
+        stats->Fragmentation = 100 - (uint8_t)(((uint64_t)stats->HeapLargest * 100) / stats->HeapFree);
+    } else {
+        stats->Fragmentation = 0;
+    }
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return guiOK;
+}
+
+void GUI_MEM_ResetMax(void) {
+    uint8_t i;
+    
+    __GUI_ENTER();                                  /* Enter GUI */
+    GUI_MEM_LOCK();
+    
+    Stats.Total.MaxCount = Stats.Total.Count;
+    Stats.Total.MaxBytes = Stats.Total.Bytes;
+    for (i = 0; i < GUI_MEM_TYPE_COUNT; i++) {
+        Stats.Types[i].MaxCount = Stats.Types[i].Count;
+        Stats.Types[i].MaxBytes = Stats.Types[i].Bytes;
+    }
+    for (i = 0; i < GUI_MEM_WIDGET_TYPES; i++) {
+        Stats.Widgets[i].Usage.MaxCount = Stats.Widgets[i].Usage.Count;
+        Stats.Widgets[i].Usage.MaxBytes = Stats.Widgets[i].Usage.Bytes;
+    }
+    
+    GUI_MEM_UNLOCK();
+    __GUI_LEAVE();                                  /* Leave GUI */
+}
+
+#endif /* GUI_USE_MEM_STATS */
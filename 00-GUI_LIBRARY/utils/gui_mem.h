@@ -0,0 +1,167 @@
+/**
+ * \author  Tilen Majerle <tilen@majerle.eu>
+ * \brief   GUI memory allocation and accounting
+ *  
+\verbatim
+   ----------------------------------------------------------------------
+    Copyright (c) 2016 Tilen Majerle
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge,
+    publish, distribute, sublicense, and/or sell copies of the Software, 
+    and to permit persons to whom the Software is furnished to do so, 
+    subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+    AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+   ----------------------------------------------------------------------
+\endverbatim
+ */
+#ifndef GUI_MEM_H
+#define GUI_MEM_H
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup      GUI_UTILS
+ * \brief       
+ * \{
+ */
+#include "gui_utils.h"
+
+/**
+ * \defgroup        GUI_MEM Memory accounting
+ * \brief           Statistics of memory allocated by GUI library
+ * \{
+ *
+ * Every allocation inside library is assigned to one of \ref GUI_MEM_Type_t categories
+ * and widget handles are additionally counted per widget type.
+ * For each category, number of live objects, used bytes and their high-water marks are available
+ * with \ref GUI_MEM_GetStats, which allows to check memory trends of long running application.
+ *
+ * Free memory and largest free block are read from allocator
+ * with \ref GUI_MEM_HEAP_FREE and \ref GUI_MEM_HEAP_LARGEST functions in configuration.
+ */
+
+/**
+ * \brief           Memory allocation category
+ */
+typedef enum GUI_MEM_Type_t {
+    GUI_MEM_TYPE_WIDGET = 0x00,             /*!< Widget handles */
+    GUI_MEM_TYPE_TEXT,                      /*!< Text buffers from \ref GUI_WIDGET_AllocTextMemory */
+    GUI_MEM_TYPE_COLORS,                    /*!< Custom widget color arrays */
+    GUI_MEM_TYPE_TIMER,                     /*!< Software timers */
+    GUI_MEM_TYPE_ITEM,                      /*!< Listbox and dropdown items */
+    GUI_MEM_TYPE_GRAPH,                     /*!< Graph data objects and their values */
+    GUI_MEM_TYPE_IMAGE,                     /*!< Image, sprite and image cache buffers */
+    GUI_MEM_TYPE_OTHER,                     /*!< Linked list entries, jobs and other internal objects */
+    GUI_MEM_TYPE_COUNT,                     /*!< Number of categories, not valid type */
+} GUI_MEM_Type_t;
+
+/**
+ * \brief           Memory usage of one category
+ */
+typedef struct GUI_MEM_Usage_t {
+    uint32_t Count;                         /*!< Number of live objects */
+    uint32_t Bytes;                         /*!< Number of bytes used by live objects */
+    uint32_t MaxCount;                      /*!< Maximal number of live objects at the same time */
+    uint32_t MaxBytes;                      /*!< Maximal number of bytes used at the same time */
+} GUI_MEM_Usage_t;
+
+/**
+ * \brief           Memory usage of widget type
+ */
+typedef struct GUI_MEM_WidgetUsage_t {
+    const GUI_Char* Name;                   /*!< Widget name from \ref GUI_WIDGET_t structure, NULL when entry is not used */
+    GUI_MEM_Usage_t Usage;                  /*!< Memory usage of widget handles of this type */
+} GUI_MEM_WidgetUsage_t;
+
+/**
+ * \brief           Memory statistics
+ */
+typedef struct GUI_MEM_Stats_t {
+    GUI_MEM_Usage_t Total;                  /*!< Memory usage of all categories together */
+    GUI_MEM_Usage_t Types[GUI_MEM_TYPE_COUNT];  /*!< Memory usage per category, indexed with \ref GUI_MEM_Type_t */
+    GUI_MEM_WidgetUsage_t Widgets[GUI_MEM_WIDGET_TYPES];    /*!< Memory usage per widget type, in order of first allocation */
+    uint32_t Overhead;                      /*!< Bytes used for accounting headers of live objects */
+    uint32_t HeapFree;                      /*!< Free bytes in heap reported by allocator */
+    uint32_t HeapLargest;                   /*!< Largest free block in heap reported by allocator */
+    uint8_t Fragmentation;                  /*!< Fragmentation estimate in units of percent, part of free memory not in largest block */
+} GUI_MEM_Stats_t;
+
+#if GUI_USE_MEM_STATS || defined(DOXYGEN)
+
+#if defined(GUI_INTERNAL) || defined(DOXYGEN)
+
+/**
+ * \brief           Allocate memory and count it to category
+ * \note            Since this function is private, it can only be used by user inside GUI library
+ * \param[in]       size: Number of bytes to allocate
+ * \param[in]       type: Allocation category, member of \ref GUI_MEM_Type_t enumeration
+ * \retval          > 0: Pointer to allocated memory
+ * \retval          0: Allocation failed
+ */
+void* __GUI_MEM_Alloc(uint32_t size, GUI_MEM_Type_t type);
+
+/**
+ * \brief           Allocate memory for widget handle and count it to widget type
+ * \note            Since this function is private, it can only be used by user inside GUI library
+ * \param[in]       *widget: Pointer to \ref GUI_WIDGET_t widget description
+ * \retval          > 0: Pointer to allocated memory of widget size
+ * \retval          0: Allocation failed
+ */
+void* __GUI_MEM_AllocWidget(const GUI_WIDGET_t* widget);
+
+/**
+ * \brief           Free memory allocated with \ref __GUI_MEM_Alloc or \ref __GUI_MEM_AllocWidget
+ * \note            Since this function is private, it can only be used by user inside GUI library
+ * \param[in]       *ptr: Pointer to memory to free, NULL is allowed
+ * \retval          None
+ */
+void __GUI_MEM_Free(void* ptr);
+
+#endif /* defined(GUI_INTERNAL) || defined(DOXYGEN) */
+
+/**
+ * \brief           Get memory statistics of GUI library
+ * \param[out]      *stats: Pointer to \ref GUI_MEM_Stats_t structure to fill
+ * \retval          Member of \ref GUI_Result_t enumeration
+ */
+GUI_Result_t GUI_MEM_GetStats(GUI_MEM_Stats_t* stats);
+
+/**
+ * \brief           Reset high-water marks to current usage
+ * \retval          None
+ */
+void GUI_MEM_ResetMax(void);
+
+#endif /* GUI_USE_MEM_STATS || defined(DOXYGEN) */
+
+/**
+ * \}
+ */
+
+/**
+ * \}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,356 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#define GUI_INTERNAL
+#include "gui_outline.h"
+#include "../gui_draw.h"
+
+#if GUI_USE_OUTLINE_FONT && GUI_USE_FONT_CACHE
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private structures                            **/
+/******************************************************************************/
+/******************************************************************************/
+/* Font created from outline, character table follows structure in the same memory block */
+typedef struct __GUI_OUTLINE_Font_t {
+    GUI_FONT_t Font;                        /* Font used for drawing, must be first member */
+    GUI_FONT_Ext_t Ext;                     /* Glyphs are rasterized in read callback of external storage */
+    const GUI_OUTLINE_FONT_t* Outline;      /* Outline font */
+} __GUI_OUTLINE_Font_t;
+
+/* Coverage accumulation buffer for band of glyph rows */
+typedef struct __GUI_OUTLINE_Raster_t {
+    int16_t* Cover;                         /* Coverage changes, 16 sampled scanlines for (Width + 1) pixels per row */
+    int32_t Width;                          /* Bitmap width in units of pixels */
+    int32_t Height;                         /* Band height in units of pixels */
+    int32_t Top;                            /* Y position of band in bitmap in 1/256 of pixel */
+} __GUI_OUTLINE_Raster_t;
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private definitions                           **/
+/******************************************************************************/
+/******************************************************************************/
+#define __SUBSAMPLES                16      /* Number of scanlines sampled per pixel row */
+#define __SUBSTEP                   (256 / __SUBSAMPLES)    /* Distance between sampled scanlines in 1/256 of pixel */
+#define __FULL                      (256 * __SUBSAMPLES)    /* Accumulated value for fully covered pixel */
+#define __MAX_CURVE_LINES           16      /* Maximal number of lines quadratic curve is split to */
+#define __BAND_COVER                1024    /* Number of coverage values for band of rows rasterized at a time */
+
+#define __CeilDiv(a, b)             (-__FloorDiv(-(a), (b)))
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private functions                            **/
+/******************************************************************************/
+/******************************************************************************/
+/* Divide and round result towards negative infinity, divider must be positive */
+static
+int32_t __FloorDiv(int32_t a, int32_t b) {
+    return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+
+/* Get baseline position in pixels from top of line */
+static
+int32_t __Baseline(const __GUI_OUTLINE_Font_t* f) {
+    int32_t height = f->Outline->Ascender - f->Outline->Descender;
+    
+    return (f->Outline->Ascender * f->Font.Size + height / 2) / height;
+}
+
+/**
+ * Get glyph bitmap position in pixels, relative to pen position on baseline.
+ * Character has no X offset and only positive Y offset from top of line,
+ * box is clipped to line and right of pen position and glyph is rasterized to the same box
+ */
+static
+void __GlyphBox(const __GUI_OUTLINE_Font_t* f, const GUI_OUTLINE_Glyph_t* g, int32_t* left, int32_t* top, int32_t* right, int32_t* bottom) {
+    int32_t size = f->Font.Size, height = f->Outline->Ascender - f->Outline->Descender, baseline = __Baseline(f);
+    
+    *left = 0;                                      /* Bitmap starts at pen position and includes left side bearing */
+    *right = __GUI_MAX(__CeilDiv(g->XMax * size, height), 0);
+    *top = __GUI_MIN(__CeilDiv(g->YMax * size, height), baseline);
+    *bottom = __GUI_MAX(__FloorDiv(g->YMin * size, height), baseline - size);
+    if (*bottom > *top) {                           /* Glyph is completely outside line */
+        *bottom = *top;
+    }
+}
+
+/* Add line in 1/256 pixel units to coverage buffer, one crossing per sampled scanline */
+static
+void __RasterLine(__GUI_OUTLINE_Raster_t* r, int32_t x0, int32_t y0, int32_t x1, int32_t y1) {
+    int32_t dir = 1, j, jEnd, x, y, f;
+    int16_t* row;
+    
+    if (y0 == y1) {                                 /* Horizontal line does not change coverage */
+        return;
+    }
+    y0 -= r->Top;                                   /* Move line to band */
+    y1 -= r->Top;
+    if (y0 > y1) {                                  /* Always go from top to bottom */
+        x = x0; x0 = x1; x1 = x;
+        y = y0; y0 = y1; y1 = y;
+        dir = -1;
+    }
+    j = __CeilDiv(y0 - __SUBSTEP / 2, __SUBSTEP);   /* First and last sampled scanline crossed by line */
+    jEnd = __CeilDiv(y1 - __SUBSTEP / 2, __SUBSTEP);
+    if (j < 0) {
+        j = 0;
+    }
+    if (jEnd > r->Height * __SUBSAMPLES) {
+        jEnd = r->Height * __SUBSAMPLES;
+    }
+    for (; j < jEnd; j++) {
+        y = j * __SUBSTEP + __SUBSTEP / 2;
+        x = x0 + (int32_t)((int64_t)(x1 - x0) * (y - y0) / (y1 - y0));
+        if (x < 0) {
+            x = 0;
+        } else if (x > r->Width * 256) {
+            x = r->Width * 256;
+        }
+        row = &r->Cover[((j / __SUBSAMPLES) * (r->Width + 1) + (x >> 8)) * __SUBSAMPLES + j % __SUBSAMPLES];
+        f = x & 0xFF;                               /* Split crossing between 2 pixels */
+        row[0] += dir * (256 - f);
+        if (f) {
+            row[__SUBSAMPLES] += dir * f;           /* Same scanline of next pixel */
+        }
+    }
+}
+
+/* Add quadratic curve in 1/256 pixel units to coverage buffer */
+static
+void __RasterCurve(__GUI_OUTLINE_Raster_t* r, int32_t x0, int32_t y0, int32_t cx, int32_t cy, int32_t x1, int32_t y1) {
+    int32_t dev, n, i, px = x0, py = y0, x, y;
+    
+    dev = x0 - 2 * cx + x1;                         /* Deviation of curve from straight line */
+    dev = (dev < 0 ? -dev : dev) + (y0 - 2 * cy + y1 < 0 ? -(y0 - 2 * cy + y1) : (y0 - 2 * cy + y1));
+    n = 1 + GUI_MATH_SqrtInt(dev / 128);            /* Number of lines keeps error below quarter of pixel */
+    if (n > __MAX_CURVE_LINES) {
+        n = __MAX_CURVE_LINES;
+    }
+    for (i = 1; i <= n; i++) {
+        x = (x0 * (n - i) * (n - i) + 2 * cx * i * (n - i) + x1 * i * i) / (n * n);
+        y = (y0 * (n - i) * (n - i) + 2 * cy * i * (n - i) + y1 * i * i) / (n * n);
+        __RasterLine(r, px, py, x, y);
+        px = x;
+        py = y;
+    }
+}
+
+/**
+ * Add lines and curves of all glyph contours to coverage buffer,
+ * on-curve point is implied between 2 consecutive control points
+ */
+static
+void __RasterGlyph(const __GUI_OUTLINE_Font_t* f, const GUI_OUTLINE_Glyph_t* g, __GUI_OUTLINE_Raster_t* r, int32_t left, int32_t top) {
+    const GUI_OUTLINE_Point_t* p = g->Points;
+    int32_t size = f->Font.Size, height = f->Outline->Ascender - f->Outline->Descender;
+    int32_t sx, sy, x, y, cx = 0, cy = 0, mx, my;
+    uint16_t c, first, last, i, k0, cnt;
+    uint8_t curve;
+    
+#define __PX(pt)    (__FloorDiv((pt)->X * size * 256, height) - left * 256) /* Point position in 1/256 of pixel in bitmap */
+#define __PY(pt)    (top * 256 - __FloorDiv((pt)->Y * size * 256, height))
+    
+    for (c = 0, first = 0; c < g->Contours; c++, first = last + 1) {
+        last = g->EndPoints[c];
+        if (p[first].OnCurve) {                     /* Start with on-curve point */
+            sx = __PX(&p[first]);
+            sy = __PY(&p[first]);
+            k0 = first + 1;
+            cnt = last - first;
+        } else if (p[last].OnCurve) {
+            sx = __PX(&p[last]);
+            sy = __PY(&p[last]);
+            k0 = first;
+            cnt = last - first;
+        } else {                                    /* Start in the middle of 2 control points */
+            sx = (__PX(&p[first]) + __PX(&p[last])) / 2;
+            sy = (__PY(&p[first]) + __PY(&p[last])) / 2;
+            k0 = first;
+            cnt = last - first + 1;
+        }
+        x = sx;
+        y = sy;
+        curve = 0;
+        for (i = k0; i < k0 + cnt; i++) {
+            if (p[i].OnCurve) {
+                if (curve) {
+                    __RasterCurve(r, x, y, cx, cy, __PX(&p[i]), __PY(&p[i]));
+                } else {
+                    __RasterLine(r, x, y, __PX(&p[i]), __PY(&p[i]));
+                }
+                x = __PX(&p[i]);
+                y = __PY(&p[i]);
+                curve = 0;
+            } else {
+                if (curve) {                        /* Implied on-curve point between control points */
+                    mx = (cx + __PX(&p[i])) / 2;
+                    my = (cy + __PY(&p[i])) / 2;
+                    __RasterCurve(r, x, y, cx, cy, mx, my);
+                    x = mx;
+                    y = my;
+                }
+                cx = __PX(&p[i]);
+                cy = __PY(&p[i]);
+                curve = 1;
+            }
+        }
+        if (curve) {                                /* Close contour */
+            __RasterCurve(r, x, y, cx, cy, sx, sy);
+        } else {
+            __RasterLine(r, x, y, sx, sy);
+        }
+    }
+#undef __PX
+#undef __PY
+}
+
+/* Rasterize glyph to font cache entry, called by font cache on first use of glyph */
+static
+uint8_t __ReadGlyph(void* param, uint32_t addr, GUI_Byte* data, uint32_t len) {
+    const __GUI_OUTLINE_Font_t* f = (const __GUI_OUTLINE_Font_t *)param;
+    const GUI_OUTLINE_Glyph_t* g = &f->Outline->Glyphs[addr];
+    const int16_t* cell;
+    __GUI_OUTLINE_Raster_t r;
+    int32_t left, top, right, bottom, height, rows, band, x, y, s, v, cover;
+    int32_t sum[__SUBSAMPLES];
+    
+    memset(data, 0x00, len);
+    if (!len || !g->Contours) {                     /* Nothing to draw */
+        return 1;
+    }
+    
+    __GlyphBox(f, g, &left, &top, &right, &bottom);
+    r.Width = f->Font.Data[addr].xSize;
+    height = f->Font.Data[addr].ySize;
+    rows = __GUI_MIN(__GUI_MAX(__BAND_COVER / ((r.Width + 1) * __SUBSAMPLES), 1), height);
+    r.Cover = (int16_t *)__GUI_MEMALLOC(sizeof(*r.Cover) * (r.Width + 1) * rows * __SUBSAMPLES, GUI_MEM_TYPE_OTHER);
+    if (!r.Cover) {
+        return 0;
+    }
+    
+    /**
+     * Rasterize glyph in bands of rows, fill rule is applied on each sampled scanline
+     * and coverage of sampled scanlines is summed to 4-bit alpha
+     */
+    for (band = 0; band < height; band += rows) {
+        r.Height = __GUI_MIN(rows, height - band);
+        r.Top = band * 256;
+        memset(r.Cover, 0x00, sizeof(*r.Cover) * (r.Width + 1) * r.Height * __SUBSAMPLES);
+        __RasterGlyph(f, g, &r, left, top);
+        for (y = 0; y < r.Height; y++) {
+            cell = &r.Cover[y * (r.Width + 1) * __SUBSAMPLES];
+            memset(sum, 0x00, sizeof(sum));
+            for (x = 0; x < r.Width; x++, cell += __SUBSAMPLES) {
+                for (cover = 0, s = 0; s < __SUBSAMPLES; s++) {
+                    sum[s] += cell[s];
+                    v = sum[s] < 0 ? -sum[s] : sum[s];  /* Non-zero winding rule */
+                    cover += v > 256 ? 256 : v;
+                }
+                v = (cover * 15 + __FULL / 2) / __FULL;
+                data[(band + y) * ((r.Width + 1) / 2) + x / 2] |= v << ((x & 1) ? 4 : 0);   /* First pixel in low nibble */
+            }
+        }
+    }
+    __GUI_MEMFREE(r.Cover);
+    return 1;
+}
+
+/******************************************************************************/
+/******************************************************************************/
+/***                                Public API                               **/
+/******************************************************************************/
+/******************************************************************************/
+const GUI_FONT_t* GUI_OUTLINE_CreateFont(const GUI_OUTLINE_FONT_t* outline, GUI_Byte size) {
+    __GUI_OUTLINE_Font_t* f;
+    GUI_FONT_CharInfo_t* chars;
+    const GUI_OUTLINE_Glyph_t* g;
+    int32_t left, top, right, bottom, height, adv;
+    uint16_t i, count;
+    
+    __GUI_ASSERTPARAMS(outline && size && outline->Ascender > outline->Descender && outline->EndChar >= outline->StartChar); /* Check input parameters */
+    
+    count = outline->EndChar - outline->StartChar + 1;
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    f = (__GUI_OUTLINE_Font_t *)__GUI_MEMALLOC(sizeof(*f) + count * sizeof(*chars), GUI_MEM_TYPE_OTHER);
+    if (f) {
+        chars = (GUI_FONT_CharInfo_t *)(f + 1);     /* Character table is after structure */
+        height = outline->Ascender - outline->Descender;
+        
+        memset(f, 0x00, sizeof(*f));
+        f->Outline = outline;
+        f->Ext.Read = __ReadGlyph;
+        f->Ext.Param = f;
+        f->Font.Name = outline->Name;
+        f->Font.Size = size;
+        f->Font.StartChar = outline->StartChar;
+        f->Font.EndChar = outline->EndChar;
+        f->Font.Flags = GUI_FLAG_FONT_AA4;
+        f->Font.Data = chars;
+        f->Font.Ext = &f->Ext;
+        
+        /**
+         * Calculate bitmap size and position for each glyph,
+         * character bitmap address is glyph index in outline font
+         */
+        for (i = 0; i < count; i++) {
+            g = &outline->Glyphs[i];
+            memset(&chars[i], 0x00, sizeof(chars[i]));
+            if (g->Contours) {
+                __GlyphBox(f, g, &left, &top, &right, &bottom);
+                chars[i].xSize = __GUI_MIN(right - left, 0xFF);
+                chars[i].ySize = __GUI_MIN(top - bottom, 0xFF);
+                chars[i].yPos = __Baseline(f) - top;
+            }
+            adv = (g->Advance * size + height / 2) / height;
+            chars[i].xMargin = __GUI_MIN(__GUI_MAX(adv - chars[i].xSize, 0), 0xFF);
+            chars[i].Data = (const GUI_Byte *)(uintptr_t)i;
+        }
+    }
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return f ? &f->Font : 0;
+}
+
+uint8_t GUI_OUTLINE_DeleteFont(const GUI_FONT_t* font) {
+    __GUI_OUTLINE_Font_t* f = (__GUI_OUTLINE_Font_t *)font;
+    
+    __GUI_ASSERTPARAMS(font && font->Ext && font->Ext->Read == __ReadGlyph);    /* Check input parameters */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    __GUI_FONTCACHE_Init();                         /* Cached glyphs point to character table of font */
+#if GUI_USE_FONT_FALLBACK
+    __GUI_DRAW_FontFallbackFlush();
+#endif /* GUI_USE_FONT_FALLBACK */
+    __GUI_MEMFREE(f);
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return 1;
+}
+
+#endif /* GUI_USE_OUTLINE_FONT && GUI_USE_FONT_CACHE */
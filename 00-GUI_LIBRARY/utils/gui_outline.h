@@ -0,0 +1,147 @@
+/**
+ * \author  Tilen Majerle <tilen@majerle.eu>
+ * \brief   GUI scalable outline fonts
+ *  
+\verbatim
+   ----------------------------------------------------------------------
+    Copyright (c) 2016 Tilen Majerle
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge,
+    publish, distribute, sublicense, and/or sell copies of the Software, 
+    and to permit persons to whom the Software is furnished to do so, 
+    subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+    AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+   ----------------------------------------------------------------------
+\endverbatim
+ */
+#ifndef GUI_OUTLINE_H
+#define GUI_OUTLINE_H
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup      GUI_UTILS
+ * \{
+ */
+#include "gui_utils.h"
+
+/**
+ * \defgroup        GUI_OUTLINE Outline fonts
+ * \brief           Scalable fonts rendered from quadratic outlines
+ * \{
+ *
+ * Outline font holds glyph contours in font units, in the same form as TrueType glyph table:
+ * contours of on-curve and off-curve points, connected with lines and quadratic Bezier curves,
+ * with on-curve point implied in the middle of 2 consecutive off-curve points.
+ *
+ * \ref GUI_OUTLINE_CreateFont creates regular \ref GUI_FONT_t at any pixel size from single outline font.
+ * Only character table with glyph sizes is calculated on creation.
+ * Glyph is rasterized with 4-bit anti-aliasing to \ref GUI_FONTCACHE when drawn first time,
+ * next draws use cached bitmap in the same way as fonts in external storage.
+ * Parts of glyph left of pen position, above ascender or below descender are clipped.
+ *
+ * \note            Module is available when \ref GUI_USE_OUTLINE_FONT and \ref GUI_USE_FONT_CACHE are enabled.
+ *                  \ref GUI_FONT_CACHE_GLYPH_SIZE must be at least half of pixel width times pixel height of largest glyph
+ *
+ * \par             Example
+ *
+\code{c}
+extern const GUI_OUTLINE_FONT_t Font_Outline_Arial;
+
+const GUI_FONT_t* arial14 = GUI_OUTLINE_CreateFont(&Font_Outline_Arial, 14);
+const GUI_FONT_t* arial22 = GUI_OUTLINE_CreateFont(&Font_Outline_Arial, 22);
+
+GUI_WIDGET_SetFontDefault(arial14);
+\endcode
+ */
+
+/**
+ * \brief           Single point of glyph outline
+ */
+typedef struct GUI_OUTLINE_Point_t {
+    int16_t X;                              /*!< X position in font units */
+    int16_t Y;                              /*!< Y position in font units, positive direction is up from baseline */
+    uint8_t OnCurve;                        /*!< Set to 1 when point is on curve, 0 for control point of quadratic curve */
+} GUI_OUTLINE_Point_t;
+
+/**
+ * \brief           Outline of single glyph
+ */
+typedef struct GUI_OUTLINE_Glyph_t {
+    int16_t XMin;                           /*!< Left side of bounding box in font units */
+    int16_t YMin;                           /*!< Bottom side of bounding box in font units */
+    int16_t XMax;                           /*!< Right side of bounding box in font units */
+    int16_t YMax;                           /*!< Top side of bounding box in font units */
+    uint16_t Advance;                       /*!< Horizontal advance to next character in font units */
+    uint16_t Contours;                      /*!< Number of closed contours. Set to 0 for glyph without drawing (space) */
+    GUI_Const uint16_t* EndPoints;          /*!< Index of last point for each contour */
+    GUI_Const GUI_OUTLINE_Point_t* Points;  /*!< Points of all contours */
+} GUI_OUTLINE_Glyph_t;
+
+/**
+ * \brief           Scalable outline font
+ */
+typedef struct GUI_OUTLINE_FONT_t {
+    GUI_Const GUI_Char* Name;               /*!< Pointer to font name */
+    int16_t Ascender;                       /*!< Top of line above baseline in font units */
+    int16_t Descender;                      /*!< Bottom of line below baseline in font units, negative number */
+    uint16_t StartChar;                     /*!< Start character number in list */
+    uint16_t EndChar;                       /*!< End character number in list */
+    GUI_Const GUI_OUTLINE_Glyph_t* Glyphs;  /*!< Pointer to first glyph */
+} GUI_OUTLINE_FONT_t;
+
+#if (GUI_USE_OUTLINE_FONT && GUI_USE_FONT_CACHE) || defined(DOXYGEN)
+
+/**
+ * \brief           Create font with specific pixel size from outline font
+ * \note            Glyphs are rasterized on first use, creation only calculates glyph sizes
+ * \param[in]       *outline: Pointer to \ref GUI_OUTLINE_FONT_t outline font. Structure must stay valid while font is used.
+ * \param[in]       size: Font size (line height) in units of pixels
+ * \retval          > 0: Pointer to created font
+ * \retval          0: Font was not created
+ * \sa              GUI_OUTLINE_DeleteFont
+ */
+const GUI_FONT_t* GUI_OUTLINE_CreateFont(const GUI_OUTLINE_FONT_t* outline, GUI_Byte size);
+
+/**
+ * \brief           Delete font created from outline font
+ * \note            Font must not be used by widgets or string tables anymore. Font cache is flushed
+ * \param[in]       *font: Pointer to font created with \ref GUI_OUTLINE_CreateFont
+ * \retval          1: Font was deleted ok
+ * \retval          0: Font was not deleted
+ */
+uint8_t GUI_OUTLINE_DeleteFont(const GUI_FONT_t* font);
+
+#endif /* (GUI_USE_OUTLINE_FONT && GUI_USE_FONT_CACHE) || defined(DOXYGEN) */
+
+/**
+ * \}
+ */
+
+/**
+ * \}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
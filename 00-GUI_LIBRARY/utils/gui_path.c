@@ -0,0 +1,544 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#define GUI_INTERNAL
+#include "gui_path.h"
+#include "../gui_draw.h"
+
+#if GUI_USE_PATH
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private structures                            **/
+/******************************************************************************/
+/******************************************************************************/
+/* Block of pixels rasterized at a time */
+typedef struct __GUI_PATH_Raster_t {
+    const GUI_PATH_t* Path;                 /* Path to rasterize */
+    int32_t Size;                           /* Size in pixels for path units */
+    GUI_PATH_FILL_t Rule;                   /* Fill rule */
+    int32_t OrigX;                          /* X position of path origin relative to block in 1/256 of pixel */
+    int32_t OrigY;                          /* Y position of path origin relative to block in 1/256 of pixel */
+    int32_t Width;                          /* Block width in units of pixels */
+    int32_t Height;                         /* Block height in units of pixels */
+    const GUI_Display_t* Disp;              /* Clipping region when path is filled on screen */
+    GUI_Color_t Color;                      /* Fill color */
+    GUI_IMAGE_DESC_t* Img;                  /* Output image when path is rendered to image */
+} __GUI_PATH_Raster_t;
+
+/* Output function for single row of alpha values */
+typedef void (*__GUI_PATH_Out_t)(__GUI_PATH_Raster_t* r, int32_t x, int32_t y, const uint8_t* a, int32_t len);
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private definitions                           **/
+/******************************************************************************/
+/******************************************************************************/
+#define __SUBSAMPLES                16      /* Number of scanlines sampled per pixel row */
+#define __SUBSTEP                   (256 / __SUBSAMPLES)    /* Distance between sampled scanlines in 1/256 of pixel */
+#define __FULL                      (256 * __SUBSAMPLES)    /* Accumulated value for fully covered pixel */
+#define __MAX_CURVE_LINES           32      /* Maximal number of lines curve is split to */
+#define __MAX_COORD                 (1L << 28)  /* Limit for scaled coordinates to prevent overflows */
+
+#define __CeilDiv(a, b)             (-__FloorDiv(-(a), (b)))
+
+#if GUI_PATH_CELLS < 2 * __SUBSAMPLES
+#error "GUI_PATH_CELLS must be at least 32 to hold one pixel with crossings on right edge"
+#endif /* GUI_PATH_CELLS < 2 * __SUBSAMPLES */
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private variables                            **/
+/******************************************************************************/
+/******************************************************************************/
+#define Cells                       (GUI.Path.Cells)    /* Cells are part of GUI context, contexts may be drawn in parallel */
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private functions                            **/
+/******************************************************************************/
+/******************************************************************************/
+/* Divide and round result towards negative infinity, divider must be positive */
+static
+int32_t __FloorDiv(int32_t a, int32_t b) {
+    return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+
+/* Scale path coordinate to 1/256 of pixel */
+static
+int32_t __Scale(const __GUI_PATH_Raster_t* r, int16_t v) {
+    int64_t a = (int64_t)v * r->Size * 256;
+    
+    a = a >= 0 ? a / r->Path->Units : -((-a + r->Path->Units - 1) / r->Path->Units);
+    return (int32_t)__GUI_MAX(__GUI_MIN(a, __MAX_COORD), -__MAX_COORD);
+}
+
+/* Get number of lines for curve with deviation from straight line, error is kept below 1/16 of pixel */
+static
+int32_t __CurveLines(int64_t dev) {
+    dev /= 64;
+    if (dev >= (__MAX_CURVE_LINES - 1) * (__MAX_CURVE_LINES - 1)) {
+        return __MAX_CURVE_LINES;
+    }
+    return 1 + GUI_MATH_SqrtInt((uint32_t)dev);
+}
+
+/* Check if curve with control points in Y range and X minimum can change coverage of block, curves left of block still count for winding */
+static
+uint8_t __CurveVisible(const __GUI_PATH_Raster_t* r, int32_t yMin, int32_t yMax, int32_t xMin) {
+    return r->OrigY + yMax > 0 && r->OrigY + yMin < r->Height * 256 && r->OrigX + xMin < r->Width * 256;
+}
+
+/**
+ * Add line in 1/256 pixel units relative to path origin to coverage cells, one crossing per sampled scanline.
+ * Curves are split to lines relative to path origin, so result does not depend on block position
+ */
+static
+void __RasterLine(__GUI_PATH_Raster_t* r, int32_t x0, int32_t y0, int32_t x1, int32_t y1) {
+    int32_t dir = 1, j, jEnd, x, y, f;
+    int32_t* cell;
+    
+    if (y0 == y1) {                                 /* Horizontal line does not change coverage */
+        return;
+    }
+    x0 += r->OrigX;                                 /* Move line to block */
+    y0 += r->OrigY;
+    x1 += r->OrigX;
+    y1 += r->OrigY;
+    if (y0 > y1) {                                  /* Always go from top to bottom */
+        x = x0; x0 = x1; x1 = x;
+        y = y0; y0 = y1; y1 = y;
+        dir = -1;
+    }
+    j = __CeilDiv(y0 - __SUBSTEP / 2, __SUBSTEP);   /* First and last sampled scanline crossed by line */
+    jEnd = __CeilDiv(y1 - __SUBSTEP / 2, __SUBSTEP);
+    if (j < 0) {
+        j = 0;
+    }
+    if (jEnd > r->Height * __SUBSAMPLES) {
+        jEnd = r->Height * __SUBSAMPLES;
+    }
+    for (; j < jEnd; j++) {
+        y = j * __SUBSTEP + __SUBSTEP / 2;
+        x = x0 + (int32_t)((int64_t)(x1 - x0) * (y - y0) / (y1 - y0));
+        if (x < 0) {                                /* Crossings left of block still count for winding */
+            x = 0;
+        } else if (x > r->Width * 256) {            /* Crossings right of block go to unused last cell */
+            x = r->Width * 256;
+        }
+        cell = &Cells[((j / __SUBSAMPLES) * (r->Width + 1) + (x >> 8)) * __SUBSAMPLES + j % __SUBSAMPLES];
+        f = x & 0xFF;                               /* Split crossing between 2 pixels */
+        cell[0] += dir * (256 - f);
+        if (f) {
+            cell[__SUBSAMPLES] += dir * f;          /* Same scanline of next pixel */
+        }
+    }
+}
+
+/* Add quadratic curve in 1/256 pixel units to coverage cells */
+static
+void __RasterQuad(__GUI_PATH_Raster_t* r, int32_t x0, int32_t y0, int32_t cx, int32_t cy, int32_t x1, int32_t y1) {
+    int64_t dx = (int64_t)x0 - 2 * cx + x1, dy = (int64_t)y0 - 2 * cy + y1, nn;
+    int32_t n, i, s, px = x0, py = y0, x, y;
+    
+    if (!__CurveVisible(r, __GUI_MIN(__GUI_MIN(y0, cy), y1), __GUI_MAX(__GUI_MAX(y0, cy), y1), __GUI_MIN(__GUI_MIN(x0, cx), x1))) {
+        return;
+    }
+    n = __CurveLines((dx < 0 ? -dx : dx) + (dy < 0 ? -dy : dy));
+    nn = (int64_t)n * n;
+    for (i = 1; i <= n; i++) {
+        s = n - i;
+        x = (int32_t)(((int64_t)x0 * s * s + 2 * (int64_t)cx * i * s + (int64_t)x1 * i * i) / nn);
+        y = (int32_t)(((int64_t)y0 * s * s + 2 * (int64_t)cy * i * s + (int64_t)y1 * i * i) / nn);
+        __RasterLine(r, px, py, x, y);
+        px = x;
+        py = y;
+    }
+}
+
+/* Add cubic curve in 1/256 pixel units to coverage cells */
+static
+void __RasterCubic(__GUI_PATH_Raster_t* r, int32_t x0, int32_t y0, int32_t cx1, int32_t cy1, int32_t cx2, int32_t cy2, int32_t x1, int32_t y1) {
+    int64_t d1, d2, t, nnn;
+    int32_t n, i, s, px = x0, py = y0, x, y;
+    
+    if (!__CurveVisible(r,
+            __GUI_MIN(__GUI_MIN(y0, cy1), __GUI_MIN(cy2, y1)),
+            __GUI_MAX(__GUI_MAX(y0, cy1), __GUI_MAX(cy2, y1)),
+            __GUI_MIN(__GUI_MIN(x0, cx1), __GUI_MIN(cx2, x1)))) {
+        return;
+    }
+    d1 = (int64_t)x0 - 2 * cx1 + cx2;               /* Deviation of curve from straight line */
+    d2 = (int64_t)y0 - 2 * cy1 + cy2;
+    d1 = (d1 < 0 ? -d1 : d1) + (d2 < 0 ? -d2 : d2);
+    d2 = (int64_t)cx1 - 2 * cx2 + x1;
+    t = (int64_t)cy1 - 2 * cy2 + y1;
+    d2 = (d2 < 0 ? -d2 : d2) + (t < 0 ? -t : t);
+    n = __CurveLines(3 * __GUI_MAX(d1, d2));
+    nnn = (int64_t)n * n * n;
+    for (i = 1; i <= n; i++) {
+        s = n - i;
+        x = (int32_t)(((int64_t)x0 * s * s * s + 3 * (int64_t)cx1 * s * s * i + 3 * (int64_t)cx2 * s * i * i + (int64_t)x1 * i * i * i) / nnn);
+        y = (int32_t)(((int64_t)y0 * s * s * s + 3 * (int64_t)cy1 * s * s * i + 3 * (int64_t)cy2 * s * i * i + (int64_t)y1 * i * i * i) / nnn);
+        __RasterLine(r, px, py, x, y);
+        px = x;
+        py = y;
+    }
+}
+
+/* Add all sub-paths to coverage cells, every sub-path is closed */
+static
+void __RasterPath(__GUI_PATH_Raster_t* r) {
+    const GUI_PATH_Elem_t* e = r->Path->Elems;
+    uint16_t i, count = r->Path->Count;
+    int32_t sx = 0, sy = 0, x = 0, y = 0, px, py;
+    
+#define __PX(el)    __Scale(r, (el)->X)             /* Element position in 1/256 of pixel relative to origin */
+#define __PY(el)    __Scale(r, (el)->Y)
+    
+    for (i = 0; i < count; i++, e++) {
+        px = __PX(e);
+        py = __PY(e);
+        switch (e->Cmd) {
+            case GUI_PATH_CMD_MOVE:
+                __RasterLine(r, x, y, sx, sy);      /* Close previous sub-path */
+                sx = x = px;
+                sy = y = py;
+                break;
+            case GUI_PATH_CMD_LINE:
+                __RasterLine(r, x, y, px, py);
+                x = px;
+                y = py;
+                break;
+            case GUI_PATH_CMD_QUAD:
+                if (i + 1 < count) {                /* Incomplete curve is ignored */
+                    __RasterQuad(r, x, y, px, py, __PX(&e[1]), __PY(&e[1]));
+                    x = __PX(&e[1]);
+                    y = __PY(&e[1]);
+                }
+                i++;
+                e++;
+                break;
+            case GUI_PATH_CMD_CUBIC:
+                if (i + 2 < count) {
+                    __RasterCubic(r, x, y, px, py, __PX(&e[1]), __PY(&e[1]), __PX(&e[2]), __PY(&e[2]));
+                    x = __PX(&e[2]);
+                    y = __PY(&e[2]);
+                }
+                i += 2;
+                e += 2;
+                break;
+            case GUI_PATH_CMD_CLOSE:
+                __RasterLine(r, x, y, sx, sy);
+                x = sx;
+                y = sy;
+                break;
+            default:
+                break;
+        }
+    }
+    __RasterLine(r, x, y, sx, sy);                  /* Close last sub-path */
+#undef __PX
+#undef __PY
+}
+
+/* Get coverage of pixel on single sampled scanline from winding sum and fill rule */
+static
+int32_t __Coverage(GUI_PATH_FILL_t rule, int32_t sum) {
+    int32_t v = sum < 0 ? -sum : sum;
+    
+    if (rule == GUI_PATH_FILL_EVENODD) {            /* Every second winding is outside */
+        v &= 2 * 256 - 1;
+        if (v > 256) {
+            v = 2 * 256 - v;
+        }
+    } else if (v > 256) {                           /* Non-zero winding is inside */
+        v = 256;
+    }
+    return v;
+}
+
+/**
+ * Convert coverage changes of block row to 8-bit alpha, alpha is written over cells of the same row.
+ * Fill rule is applied on each sampled scanline before coverage of pixel is accumulated
+ */
+static
+const uint8_t* __RasterRow(__GUI_PATH_Raster_t* r, int32_t row) {
+    const int32_t* cell = &Cells[row * (r->Width + 1) * __SUBSAMPLES];
+    uint8_t* a = (uint8_t *)cell;
+    int32_t sum[__SUBSAMPLES] = {0}, cover = 0, k, s;
+    uint8_t changed;
+    
+    for (k = 0; k < r->Width; k++, cell += __SUBSAMPLES) {
+        changed = 0;
+        for (s = 0; s < __SUBSAMPLES; s++) {        /* Cells of pixel are read before their memory is overwritten */
+            if (cell[s]) {
+                sum[s] += cell[s];
+                changed = 1;
+            }
+        }
+        if (changed) {                              /* Coverage is the same as on the left without crossings */
+            for (cover = 0, s = 0; s < __SUBSAMPLES; s++) {
+                cover += __Coverage(r->Rule, sum[s]);
+            }
+        }
+        a[k] = (cover * 255 + __FULL / 2) / __FULL;
+    }
+    return a;
+}
+
+/* Get bounding box of path and its control points in pixels relative to path origin */
+static
+uint8_t __PathBox(__GUI_PATH_Raster_t* r, int32_t* x1, int32_t* y1, int32_t* x2, int32_t* y2) {
+    const GUI_PATH_Elem_t* e = r->Path->Elems;
+    int32_t xMin = 0, yMin = 0, xMax = 0, yMax = 0, x, y;
+    uint16_t i;
+    
+    if (!r->Path->Count) {
+        return 0;
+    }
+    if (e[0].Cmd == GUI_PATH_CMD_MOVE) {            /* Path starts at origin only without move command */
+        xMin = xMax = __Scale(r, e[0].X);
+        yMin = yMax = __Scale(r, e[0].Y);
+    }
+    for (i = 0; i < r->Path->Count; i++, e++) {
+        if (e->Cmd == GUI_PATH_CMD_CLOSE) {         /* Point of close command is not used */
+            continue;
+        }
+        x = __Scale(r, e->X);
+        y = __Scale(r, e->Y);
+        xMin = __GUI_MIN(xMin, x);
+        yMin = __GUI_MIN(yMin, y);
+        xMax = __GUI_MAX(xMax, x);
+        yMax = __GUI_MAX(yMax, y);
+    }
+    *x1 = __FloorDiv(xMin, 256);
+    *y1 = __FloorDiv(yMin, 256);
+    *x2 = __CeilDiv(xMax, 256);
+    *y2 = __CeilDiv(yMax, 256);
+    return *x1 < *x2 && *y1 < *y2;
+}
+
+/* Rasterize path with origin at ox and oy in blocks covering area and pass each row of alpha values to output */
+static
+void __Rasterize(__GUI_PATH_Raster_t* r, int32_t ox, int32_t oy, int32_t x1, int32_t y1, int32_t x2, int32_t y2, __GUI_PATH_Out_t out) {
+    int32_t cols, rows, bx, by, i;
+    
+    cols = __GUI_MIN(x2 - x1, GUI_PATH_CELLS / __SUBSAMPLES - 1);   /* Each row needs one more pixel for crossings on right edge */
+    rows = GUI_PATH_CELLS / ((cols + 1) * __SUBSAMPLES);
+    for (by = y1; by < y2; by += rows) {
+        r->Height = __GUI_MIN(rows, y2 - by);
+        r->OrigY = (oy - by) * 256;
+        for (bx = x1; bx < x2; bx += cols) {
+            r->Width = __GUI_MIN(cols, x2 - bx);
+            r->OrigX = (ox - bx) * 256;
+            memset(Cells, 0x00, sizeof(Cells[0]) * (r->Width + 1) * r->Height * __SUBSAMPLES);
+            __RasterPath(r);
+            for (i = 0; i < r->Height; i++) {
+                out(r, bx, by + i, __RasterRow(r, i), r->Width);
+            }
+        }
+    }
+}
+
+/* Draw row of alpha values on screen, fully covered spans are drawn as lines when color is opaque */
+static
+void __FillRow(__GUI_PATH_Raster_t* r, int32_t x, int32_t y, const uint8_t* a, int32_t len) {
+    GUI_IMAGE_DESC_t span = {0};
+    uint8_t opaque = (r->Color >> 24) == 0xFF;
+    int32_t k = 0, s;
+    
+    span.Height = 1;
+    span.Format = GUI_IMAGE_FORMAT_A8;
+    while (k < len) {
+        if (!a[k]) {                                /* Skip pixels outside path */
+            k++;
+            continue;
+        }
+        s = k;
+        if (opaque && a[k] == 0xFF) {
+            while (k < len && a[k] == 0xFF) {
+                k++;
+            }
+            GUI_DRAW_HLine(r->Disp, x + s, y, k - s, r->Color);
+        } else {                                    /* Blend span of partially covered pixels */
+            while (k < len && a[k] && (!opaque || a[k] != 0xFF)) {
+                k++;
+            }
+            span.Width = k - s;
+            span.Data = &a[s];
+            GUI_DRAW_Image(r->Disp, x + s, y, &span, r->Color);
+        }
+    }
+}
+
+/* Copy row of alpha values to image */
+static
+void __ImageRow(__GUI_PATH_Raster_t* r, int32_t x, int32_t y, const uint8_t* a, int32_t len) {
+    memcpy((GUI_Byte *)r->Img->Data + (uint32_t)y * r->Img->Width + x, a, len);
+}
+
+/* Add elements with the same command to path */
+static
+uint8_t __PathAdd(GUI_PATH_t* path, GUI_PATH_CMD_t cmd, const int16_t* xy, uint8_t count) {
+    GUI_PATH_Elem_t* e;
+    uint8_t i;
+    
+    if ((uint32_t)path->Count + count > path->Size) {   /* Path is full or constant */
+        return 0;
+    }
+    e = (GUI_PATH_Elem_t *)&path->Elems[path->Count];   /* Path with size was initialized with writable memory */
+    for (i = 0; i < count; i++) {
+        e[i].Cmd = cmd;
+        e[i].X = xy[2 * i + 0];
+        e[i].Y = xy[2 * i + 1];
+    }
+    path->Count += count;
+    return 1;
+}
+
+/******************************************************************************/
+/******************************************************************************/
+/***                                Public API                               **/
+/******************************************************************************/
+/******************************************************************************/
+uint8_t GUI_PATH_Init(GUI_PATH_t* path, GUI_PATH_Elem_t* elems, uint16_t size, uint16_t units) {
+    __GUI_ASSERTPARAMS(path && elems && size && units); /* Check input parameters */
+    
+    path->Elems = elems;
+    path->Count = 0;
+    path->Size = size;
+    path->Units = units;
+    return 1;
+}
+
+uint8_t GUI_PATH_MoveTo(GUI_PATH_t* path, int16_t x, int16_t y) {
+    int16_t xy[2] = {x, y};
+    
+    __GUI_ASSERTPARAMS(path);                       /* Check input parameters */
+    return __PathAdd(path, GUI_PATH_CMD_MOVE, xy, 1);
+}
+
+uint8_t GUI_PATH_LineTo(GUI_PATH_t* path, int16_t x, int16_t y) {
+    int16_t xy[2] = {x, y};
+    
+    __GUI_ASSERTPARAMS(path);                       /* Check input parameters */
+    return __PathAdd(path, GUI_PATH_CMD_LINE, xy, 1);
+}
+
+uint8_t GUI_PATH_QuadTo(GUI_PATH_t* path, int16_t cx, int16_t cy, int16_t x, int16_t y) {
+    int16_t xy[4] = {cx, cy, x, y};
+    
+    __GUI_ASSERTPARAMS(path);                       /* Check input parameters */
+    return __PathAdd(path, GUI_PATH_CMD_QUAD, xy, 2);
+}
+
+uint8_t GUI_PATH_CubicTo(GUI_PATH_t* path, int16_t cx1, int16_t cy1, int16_t cx2, int16_t cy2, int16_t x, int16_t y) {
+    int16_t xy[6] = {cx1, cy1, cx2, cy2, x, y};
+    
+    __GUI_ASSERTPARAMS(path);                       /* Check input parameters */
+    return __PathAdd(path, GUI_PATH_CMD_CUBIC, xy, 3);
+}
+
+uint8_t GUI_PATH_Close(GUI_PATH_t* path) {
+    int16_t xy[2] = {0, 0};
+    
+    __GUI_ASSERTPARAMS(path);                       /* Check input parameters */
+    return __PathAdd(path, GUI_PATH_CMD_CLOSE, xy, 1);
+}
+
+void GUI_PATH_Fill(const GUI_Display_t* disp, const GUI_PATH_t* path, GUI_iDim_t x, GUI_iDim_t y, GUI_Dim_t size, GUI_PATH_FILL_t rule, GUI_Color_t color) {
+    __GUI_PATH_Raster_t r;
+    int32_t x1, y1, x2, y2;
+    
+    if (!path || !path->Elems || !path->Units || size <= 0) {   /* Check input parameters */
+        return;
+    }
+    memset(&r, 0x00, sizeof(r));
+    r.Path = path;
+    r.Size = size;
+    r.Rule = rule;
+    r.Disp = disp;
+    r.Color = color;
+    if (!__PathBox(&r, &x1, &y1, &x2, &y2)) {
+        return;
+    }
+    
+    x1 = __GUI_MAX(x1 + x, disp->X1);               /* Rasterize only visible part of path */
+    y1 = __GUI_MAX(y1 + y, disp->Y1);
+    x2 = __GUI_MIN(x2 + x, disp->X2);
+    y2 = __GUI_MIN(y2 + y, disp->Y2);
+    if (x1 < x2 && y1 < y2) {
+        __Rasterize(&r, x, y, x1, y1, x2, y2, __FillRow);
+    }
+}
+
+uint8_t GUI_PATH_RenderImage(const GUI_PATH_t* path, GUI_Dim_t size, GUI_PATH_FILL_t rule, GUI_IMAGE_DESC_t* img) {
+    __GUI_PATH_Raster_t r;
+    int32_t x1, y1, x2, y2;
+    GUI_Byte* data = NULL;
+    
+    __GUI_ASSERTPARAMS(path && path->Elems && path->Units && size > 0 && img); /* Check input parameters */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    memset(img, 0x00, sizeof(*img));
+    memset(&r, 0x00, sizeof(r));
+    r.Path = path;
+    r.Size = size;
+    r.Rule = rule;
+    r.Img = img;
+    if (__PathBox(&r, &x1, &y1, &x2, &y2) && x2 > 0 && y2 > 0) {
+        x2 = __GUI_MIN(x2, 0x7FFF);                 /* Image starts at path origin */
+        y2 = __GUI_MIN(y2, 0x7FFF);
+        data = (GUI_Byte *)__GUI_MEMALLOC((uint32_t)x2 * y2, GUI_MEM_TYPE_IMAGE);
+        if (data) {
+            img->Width = x2;
+            img->Height = y2;
+            img->Format = GUI_IMAGE_FORMAT_A8;
+            img->Data = data;
+            img->Size = (uint32_t)x2 * y2;
+            __Rasterize(&r, 0, 0, 0, 0, x2, y2, __ImageRow);    /* Every pixel of image is written */
+        }
+    }
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return data != NULL;
+}
+
+uint8_t GUI_PATH_FreeImage(GUI_IMAGE_DESC_t* img) {
+    void* data;
+    
+    __GUI_ASSERTPARAMS(img && img->Data);           /* Check input parameters */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    data = (void *)img->Data;
+    __GUI_MEMFREE(data);
+    memset(img, 0x00, sizeof(*img));
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return 1;
+}
+
+#endif /* GUI_USE_PATH */
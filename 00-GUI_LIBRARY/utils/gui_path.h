@@ -0,0 +1,241 @@
+/**
+ * \author  Tilen Majerle <tilen@majerle.eu>
+ * \brief   GUI vector paths
+ *  
+\verbatim
+   ----------------------------------------------------------------------
+    Copyright (c) 2016 Tilen Majerle
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge,
+    publish, distribute, sublicense, and/or sell copies of the Software, 
+    and to permit persons to whom the Software is furnished to do so, 
+    subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+    AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+   ----------------------------------------------------------------------
+\endverbatim
+ */
+#ifndef GUI_PATH_H
+#define GUI_PATH_H
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup      GUI_UTILS
+ * \{
+ */
+#include "gui_utils.h"
+
+/**
+ * \defgroup        GUI_PATH Vector paths
+ * \brief           Anti-aliased shapes of lines and curves, filled at any size
+ * \{
+ *
+ * Path is list of elements with commands in the same way as SVG path:
+ * sub-paths start with move command and continue with lines, quadratic and cubic Bezier curves.
+ * Every sub-path is closed when filled.
+ *
+ * Path is rasterized in blocks of pixels, coverage of each pixel is accumulated in cell buffer
+ * of \ref GUI_PATH_CELLS entries, shared by all paths.
+ * Fill rule is applied on each of 16 sampled scanlines of pixel, overlapping sub-paths are correct also on partially covered pixels.
+ * Partially covered pixels are blended as spans of 8-bit alpha, fully covered pixels are drawn as lines.
+ *
+ * Path coordinates are in path units, \ref GUI_PATH_t.Units path units are drawn as requested size in pixels.
+ * For icons drawn many times, \ref GUI_PATH_RenderImage renders path once to alpha image
+ * which is then drawn with \ref GUI_DRAW_Image in any color.
+ *
+ * \note            Module is available when \ref GUI_USE_PATH is enabled
+ *
+ * \par             Example
+ *
+ * Arrow icon designed on 16x16 grid, drawn 32x32 pixels big
+ *
+\code{c}
+const GUI_PATH_Elem_t arrow_elems[] = {
+    {GUI_PATH_CMD_MOVE, 2, 8},
+    {GUI_PATH_CMD_LINE, 8, 2},
+    {GUI_PATH_CMD_LINE, 14, 8},
+    {GUI_PATH_CMD_LINE, 10, 8},
+    {GUI_PATH_CMD_QUAD, 10, 14},
+    {GUI_PATH_CMD_QUAD, 6, 14},
+    {GUI_PATH_CMD_LINE, 6, 8},
+    {GUI_PATH_CMD_CLOSE},
+};
+const GUI_PATH_t arrow = {arrow_elems, GUI_COUNT_OF(arrow_elems), 0, 16};
+
+GUI_PATH_Fill(disp, &arrow, x, y, 32, GUI_PATH_FILL_NONZERO, GUI_COLOR_WHITE);
+\endcode
+ */
+
+/**
+ * \brief           Path command enumeration
+ */
+typedef enum GUI_PATH_CMD_t {
+    GUI_PATH_CMD_MOVE = 0x00,               /*!< Start new sub-path at point */
+    GUI_PATH_CMD_LINE,                      /*!< Straight line to point */
+    GUI_PATH_CMD_QUAD,                      /*!< Quadratic curve, uses 2 elements: control point and end point */
+    GUI_PATH_CMD_CUBIC,                     /*!< Cubic curve, uses 3 elements: 2 control points and end point */
+    GUI_PATH_CMD_CLOSE,                     /*!< Line back to start of sub-path, point is not used */
+} GUI_PATH_CMD_t;
+
+/**
+ * \brief           Fill rule enumeration
+ */
+typedef enum GUI_PATH_FILL_t {
+    GUI_PATH_FILL_NONZERO = 0x00,           /*!< Point is inside when sub-paths around it do not cancel their directions */
+    GUI_PATH_FILL_EVENODD,                  /*!< Point is inside when odd number of sub-paths is around it */
+} GUI_PATH_FILL_t;
+
+/**
+ * \brief           Single element of path
+ * \note            All elements of curve have the same command
+ */
+typedef struct GUI_PATH_Elem_t {
+    uint8_t Cmd;                            /*!< Command, member of \ref GUI_PATH_CMD_t enumeration */
+    int16_t X;                              /*!< X position in path units */
+    int16_t Y;                              /*!< Y position in path units, positive direction is down */
+} GUI_PATH_Elem_t;
+
+/**
+ * \brief           Vector path
+ */
+typedef struct GUI_PATH_t {
+    GUI_Const GUI_PATH_Elem_t* Elems;       /*!< Pointer to path elements */
+    uint16_t Count;                         /*!< Number of used elements */
+    uint16_t Size;                          /*!< Size of elements array for building path, set to 0 for constant path */
+    uint16_t Units;                         /*!< Number of path units drawn as requested size in pixels */
+} GUI_PATH_t;
+
+#if GUI_USE_PATH || defined(DOXYGEN)
+
+/**
+ * \brief           Initialize path to be built in memory
+ * \param[out]      *path: Pointer to \ref GUI_PATH_t structure to initialize
+ * \param[in]       *elems: Pointer to array of elements for path
+ * \param[in]       size: Number of elements in array
+ * \param[in]       units: Number of path units drawn as requested size in pixels
+ * \retval          1: Path was initialized ok
+ * \retval          0: Path was not initialized
+ */
+uint8_t GUI_PATH_Init(GUI_PATH_t* path, GUI_PATH_Elem_t* elems, uint16_t size, uint16_t units);
+
+/**
+ * \brief           Start new sub-path
+ * \param[in,out]   *path: Pointer to \ref GUI_PATH_t structure
+ * \param[in]       x: X position of sub-path start
+ * \param[in]       y: Y position of sub-path start
+ * \retval          1: Element was added ok
+ * \retval          0: Element was not added, path is full
+ */
+uint8_t GUI_PATH_MoveTo(GUI_PATH_t* path, int16_t x, int16_t y);
+
+/**
+ * \brief           Add straight line to path
+ * \param[in,out]   *path: Pointer to \ref GUI_PATH_t structure
+ * \param[in]       x: X position of line end
+ * \param[in]       y: Y position of line end
+ * \retval          1: Element was added ok
+ * \retval          0: Element was not added, path is full
+ */
+uint8_t GUI_PATH_LineTo(GUI_PATH_t* path, int16_t x, int16_t y);
+
+/**
+ * \brief           Add quadratic Bezier curve to path
+ * \param[in,out]   *path: Pointer to \ref GUI_PATH_t structure
+ * \param[in]       cx: X position of control point
+ * \param[in]       cy: Y position of control point
+ * \param[in]       x: X position of curve end
+ * \param[in]       y: Y position of curve end
+ * \retval          1: Elements were added ok
+ * \retval          0: Elements were not added, path is full
+ */
+uint8_t GUI_PATH_QuadTo(GUI_PATH_t* path, int16_t cx, int16_t cy, int16_t x, int16_t y);
+
+/**
+ * \brief           Add cubic Bezier curve to path
+ * \param[in,out]   *path: Pointer to \ref GUI_PATH_t structure
+ * \param[in]       cx1: X position of first control point
+ * \param[in]       cy1: Y position of first control point
+ * \param[in]       cx2: X position of second control point
+ * \param[in]       cy2: Y position of second control point
+ * \param[in]       x: X position of curve end
+ * \param[in]       y: Y position of curve end
+ * \retval          1: Elements were added ok
+ * \retval          0: Elements were not added, path is full
+ */
+uint8_t GUI_PATH_CubicTo(GUI_PATH_t* path, int16_t cx1, int16_t cy1, int16_t cx2, int16_t cy2, int16_t x, int16_t y);
+
+/**
+ * \brief           Close current sub-path with line to its start
+ * \param[in,out]   *path: Pointer to \ref GUI_PATH_t structure
+ * \retval          1: Element was added ok
+ * \retval          0: Element was not added, path is full
+ */
+uint8_t GUI_PATH_Close(GUI_PATH_t* path);
+
+/**
+ * \brief           Fill path with anti-aliasing
+ * \param[in,out]   *disp: Pointer to \ref GUI_Display_t structure for display operations
+ * \param[in]       *path: Pointer to \ref GUI_PATH_t path to fill
+ * \param[in]       x: X position of path origin on screen
+ * \param[in]       y: Y position of path origin on screen
+ * \param[in]       size: Size in units of pixels for \ref GUI_PATH_t.Units path units
+ * \param[in]       rule: Fill rule. This parameter can be a value of \ref GUI_PATH_FILL_t enumeration
+ * \param[in]       color: Color used for drawing operation
+ * \retval          None
+ */
+void GUI_PATH_Fill(const GUI_Display_t* disp, const GUI_PATH_t* path, GUI_iDim_t x, GUI_iDim_t y, GUI_Dim_t size, GUI_PATH_FILL_t rule, GUI_Color_t color);
+
+/**
+ * \brief           Render path to new image in \ref GUI_IMAGE_FORMAT_A8 format
+ * \note            Image starts at path origin, parts of path with negative coordinates are not rendered
+ * \param[in]       *path: Pointer to \ref GUI_PATH_t path to render
+ * \param[in]       size: Size in units of pixels for \ref GUI_PATH_t.Units path units
+ * \param[in]       rule: Fill rule. This parameter can be a value of \ref GUI_PATH_FILL_t enumeration
+ * \param[out]      *img: Pointer to \ref GUI_IMAGE_DESC_t structure to fill with rendered image
+ * \retval          1: Image was rendered ok
+ * \retval          0: Image was not rendered
+ * \sa              GUI_PATH_FreeImage
+ */
+uint8_t GUI_PATH_RenderImage(const GUI_PATH_t* path, GUI_Dim_t size, GUI_PATH_FILL_t rule, GUI_IMAGE_DESC_t* img);
+
+/**
+ * \brief           Free memory of image rendered from path
+ * \param[in,out]   *img: Pointer to \ref GUI_IMAGE_DESC_t structure filled with \ref GUI_PATH_RenderImage
+ * \retval          1: Image was freed ok
+ * \retval          0: Image was not freed
+ */
+uint8_t GUI_PATH_FreeImage(GUI_IMAGE_DESC_t* img);
+
+#endif /* GUI_USE_PATH || defined(DOXYGEN) */
+
+/**
+ * \}
+ */
+
+/**
+ * \}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
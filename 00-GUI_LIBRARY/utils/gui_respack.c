@@ -0,0 +1,409 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#define GUI_INTERNAL
+#include "gui_respack.h"
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private structures                            **/
+/******************************************************************************/
+/******************************************************************************/
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private definitions                           **/
+/******************************************************************************/
+/******************************************************************************/
+#define __IsAligned(x)              (!((uintptr_t)(x) & (GUI_RESPACK_ALIGN - 1)))
+
+/**
+ * \brief           Check if character table in pack can be used directly as \ref GUI_FONT_CharInfo_t array
+ *
+ *                  It is true when pointers are 32-bit, bitmap offset is then read
+ *                  as \ref GUI_FONT_CharInfo_t.Data relative to \ref GUI_FONT_t.Base
+ */
+#define __CharsInPlace()            (sizeof(GUI_FONT_CharInfo_t) == sizeof(GUI_RESPACK_FontChar_t) && \
+                                        offsetof(GUI_FONT_CharInfo_t, Data) == offsetof(GUI_RESPACK_FontChar_t, DataOffset) && \
+                                        sizeof(((GUI_FONT_CharInfo_t *)0)->Data) == sizeof(uint32_t))
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private variables                            **/
+/******************************************************************************/
+/******************************************************************************/
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private functions                            **/
+/******************************************************************************/
+/******************************************************************************/
+/* Check if table of count elements of esize bytes is inside pack */
+static
+uint8_t __InPack(const GUI_RESPACK_t* pack, uint32_t offset, uint32_t count, uint32_t esize) {
+    uint32_t size = pack->Header->Size;
+    return offset <= size && count <= ((size - offset) / esize);
+}
+
+/* Check if 0-terminated string starts inside pack and ends before end of pack */
+static
+uint8_t __IsString(const GUI_RESPACK_t* pack, uint32_t offset) {
+    return offset < pack->Header->Size && memchr(pack->Base + offset, 0x00, pack->Header->Size - offset) != NULL;
+}
+
+/* Check if entry is valid inside pack */
+static
+uint8_t __CheckEntry(const GUI_RESPACK_t* pack, const GUI_RESPACK_Entry_t* e) {
+    if (!__IsString(pack, e->NameOffset) || !__InPack(pack, e->Offset, e->Size, 1)) {   /* Check boundaries */
+        return 0;
+    }
+    if (!__IsAligned(e->Offset)) {                  /* Data must be aligned */
+        return 0;
+    }
+    if ((e->Type == GUI_RESPACK_TYPE_FONT && e->Size < sizeof(GUI_RESPACK_Font_t)) ||
+        (e->Type == GUI_RESPACK_TYPE_IMAGE && e->Size < sizeof(GUI_RESPACK_Image_t)) ||
+        (e->Type == GUI_RESPACK_TYPE_SPRITE && e->Size < sizeof(GUI_RESPACK_Sprite_t))) {   /* Entry must have at least its record */
+        return 0;
+    }
+    return 1;
+}
+
+/* Get number of bytes for character bitmap */
+static
+uint32_t __GetCharSize(uint8_t flags, const GUI_RESPACK_FontChar_t* c) {
+    uint8_t ppb = 8;                                /* Pixels per byte */
+    if (flags & GUI_FLAG_FONT_AA8) {
+        ppb = 1;
+    } else if (flags & GUI_FLAG_FONT_AA4) {
+        ppb = 2;
+    } else if (flags & GUI_FLAG_FONT_AA) {
+        ppb = 4;
+    }
+    return (uint32_t)((c->xSize + ppb - 1) / ppb) * c->ySize;
+}
+
+/* Check if image record and its data are inside pack */
+static
+uint8_t __CheckImage(const GUI_RESPACK_t* pack, const GUI_RESPACK_Image_t* r) {
+    uint32_t need = (uint32_t)r->Width * r->Height;   /* Minimal size of uncompressed data */
+    
+    if (r->Format > GUI_IMAGE_FORMAT_RLE || r->Width < 0 || r->Height < 0) {
+        return 0;
+    }
+    switch (r->Format) {
+        case GUI_IMAGE_FORMAT_ARGB8888: need *= 4; break;
+        case GUI_IMAGE_FORMAT_RGB565: need *= 2; break;
+        case GUI_IMAGE_FORMAT_A4: need = (uint32_t)((r->Width + 1) / 2) * r->Height; break;
+        case GUI_IMAGE_FORMAT_QOI:
+        case GUI_IMAGE_FORMAT_RLE: need = 0; break; /* Decoders check their input */
+        default: break;
+    }
+    if (r->Size < need) {                           /* Raw data must cover whole image */
+        return 0;
+    }
+    if (!__IsAligned(r->DataOffset) || !__InPack(pack, r->DataOffset, r->Size, 1)) {
+        return 0;
+    }
+    if (r->Format == GUI_IMAGE_FORMAT_L8 &&
+        (!__IsAligned(r->CLUTOffset) || r->CLUTSize > 256 || !__InPack(pack, r->CLUTOffset, r->CLUTSize, sizeof(GUI_Color_t)))) {
+        return 0;
+    }
+    return 1;
+}
+
+/* Fill image descriptor from checked image record, data stays in pack */
+static
+void __SetImage(const GUI_RESPACK_t* pack, const GUI_RESPACK_Image_t* r, GUI_IMAGE_DESC_t* img) {
+    memset(img, 0x00, sizeof(*img));
+    img->Width = r->Width;
+    img->Height = r->Height;
+    img->Format = (GUI_IMAGE_Format_t)r->Format;
+    img->Data = pack->Base + r->DataOffset;
+    img->Size = r->Size;
+    if (r->Format == GUI_IMAGE_FORMAT_L8) {
+        img->CLUT = (const GUI_Color_t *)(pack->Base + r->CLUTOffset);
+        img->CLUTSize = r->CLUTSize;
+    }
+}
+
+/******************************************************************************/
+/******************************************************************************/
+/***                                Public API                               **/
+/******************************************************************************/
+/******************************************************************************/
+uint32_t GUI_RESPACK_Hash(const GUI_Char* name) {
+    uint32_t hash = 0x811C9DC5UL;                   /* FNV-1a offset basis */
+    while (*name) {
+        hash ^= (uint32_t)*name++;
+        hash *= 0x01000193UL;                       /* FNV-1a prime */
+    }
+    return hash;
+}
+
+GUI_Result_t GUI_RESPACK_Open(GUI_RESPACK_t* pack, const void* addr, uint32_t size) {
+    const GUI_RESPACK_Header_t* hdr = (const GUI_RESPACK_Header_t *)addr;
+    uint32_t i;
+    
+    memset(pack, 0x00, sizeof(*pack));              /* Reset structure */
+    if (!addr || !__IsAligned(addr) || size < sizeof(GUI_RESPACK_Header_t)) {   /* Check input parameters */
+        return guiERROR;
+    }
+    if (hdr->Magic != GUI_RESPACK_MAGIC || hdr->Version != GUI_RESPACK_VERSION) {   /* Check pack identification */
+        return guiERROR;
+    }
+    if (hdr->HeaderSize < sizeof(GUI_RESPACK_Header_t) || hdr->Size > size || hdr->Size < hdr->HeaderSize) {
+        return guiERROR;
+    }
+    if (!__IsAligned(hdr->IndexOffset) || hdr->IndexOffset > hdr->Size ||
+        hdr->Count > ((hdr->Size - hdr->IndexOffset) / sizeof(GUI_RESPACK_Entry_t))) { /* Check index table */
+        return guiERROR;
+    }
+    
+    pack->Base = (const uint8_t *)addr;
+    pack->Header = hdr;
+    pack->Entries = (const GUI_RESPACK_Entry_t *)(pack->Base + hdr->IndexOffset);
+    
+    /**
+     * Verify all entries once, lookups do not need to check them later
+     */
+    for (i = 0; i < hdr->Count; i++) {
+        if (!__CheckEntry(pack, &pack->Entries[i]) ||
+            (i && pack->Entries[i - 1].Hash > pack->Entries[i].Hash)) { /* Index must be sorted by hash */
+            memset(pack, 0x00, sizeof(*pack));
+            return guiERROR;
+        }
+    }
+    return guiOK;
+}
+
+const GUI_RESPACK_Entry_t* GUI_RESPACK_Find(const GUI_RESPACK_t* pack, const GUI_Char* name) {
+    uint32_t hash, low, high, mid;
+    
+    if (!pack || !pack->Header || !name) {          /* Check input parameters */
+        return 0;
+    }
+    
+    hash = GUI_RESPACK_Hash(name);                  /* Get hash of input name */
+    low = 0;
+    high = pack->Header->Count;
+    while (low < high) {                            /* Find first entry with matching hash */
+        mid = low + (high - low) / 2;
+        if (pack->Entries[mid].Hash < hash) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    
+    /**
+     * Check all entries with the same hash,
+     * compare names to handle hash collisions
+     */
+    for (; low < pack->Header->Count && pack->Entries[low].Hash == hash; low++) {
+        if (!GUI_STRING_Compare((const GUI_Char *)(pack->Base + pack->Entries[low].NameOffset), name)) {
+            return &pack->Entries[low];
+        }
+    }
+    return 0;
+}
+
+const void* GUI_RESPACK_GetData(const GUI_RESPACK_t* pack, const GUI_Char* name, uint32_t* size) {
+    const GUI_RESPACK_Entry_t* e;
+    
+    if ((e = GUI_RESPACK_Find(pack, name)) == 0) {  /* Find entry */
+        return 0;
+    }
+    if (size) {
+        *size = e->Size;
+    }
+    return pack->Base + e->Offset;                  /* Return pointer directly to pack memory */
+}
+
+const GUI_FONT_t* GUI_RESPACK_GetFont(const GUI_RESPACK_t* pack, const GUI_Char* name) {
+    const GUI_RESPACK_Entry_t* e;
+    const GUI_RESPACK_Font_t* rec;
+    const GUI_RESPACK_FontChar_t* chars;
+    GUI_FONT_t* font = 0;
+    GUI_FONT_CharInfo_t* info;
+    uint32_t i, count, size;
+    
+    if ((e = GUI_RESPACK_Find(pack, name)) == 0 || e->Type != GUI_RESPACK_TYPE_FONT) {
+        return 0;
+    }
+    
+    /**
+     * Verify record before allocation,
+     * all offsets must point inside pack
+     */
+    rec = (const GUI_RESPACK_Font_t *)(pack->Base + e->Offset);
+    if (rec->EndChar < rec->StartChar || !__IsAligned(rec->CharsOffset) || (rec->NameOffset && !__IsString(pack, rec->NameOffset))) {
+        return 0;
+    }
+    count = (uint32_t)(rec->EndChar - rec->StartChar) + 1;
+    if (!__InPack(pack, rec->CharsOffset, count, sizeof(GUI_RESPACK_FontChar_t))) {
+        return 0;
+    }
+    chars = (const GUI_RESPACK_FontChar_t *)(pack->Base + rec->CharsOffset);
+    for (i = 0; i < count; i++) {
+        if (!__InPack(pack, chars[i].DataOffset, __GetCharSize(rec->Flags, &chars[i]), 1)) {
+            return 0;
+        }
+    }
+    
+    /**
+     * Character table is used directly from pack when layout matches,
+     * otherwise it is relocated to memory after font structure
+     */
+    size = sizeof(*font);
+    if (!__CharsInPlace()) {
+        size += count * sizeof(*info);
+    }
+    
+    __GUI_ENTER();                                  /* Enter GUI */
+    font = __GUI_MEMALLOC(size, GUI_MEM_TYPE_OTHER);    /* Allocate font and optionally characters in one block */
+    if (font) {
+        memset(font, 0x00, sizeof(*font));
+        font->Name = rec->NameOffset ? (const GUI_Char *)(pack->Base + rec->NameOffset) : 0;
+        font->Size = rec->Size;
+        font->StartChar = rec->StartChar;
+        font->EndChar = rec->EndChar;
+        font->Flags = rec->Flags;
+        if (__CharsInPlace()) {
+            font->Data = (const GUI_FONT_CharInfo_t *)chars;
+            font->Base = pack->Base;                /* Bitmap offsets are relative to start of pack */
+        } else {
+            info = (GUI_FONT_CharInfo_t *)(font + 1);
+            font->Data = info;
+            for (i = 0; i < count; i++) {           /* Relocate characters */
+                info[i].xSize = chars[i].xSize;
+                info[i].ySize = chars[i].ySize;
+                info[i].xPos = chars[i].xPos;
+                info[i].yPos = chars[i].yPos;
+                info[i].xMargin = chars[i].xMargin;
+                info[i].Data = pack->Base + chars[i].DataOffset;
+            }
+        }
+    }
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return font;
+}
+
+uint8_t GUI_RESPACK_FreeFont(const GUI_FONT_t* font) {
+    void* ptr = (void *)font;
+    
+    __GUI_ASSERTPARAMS(font);                       /* Check input parameters */
+    __GUI_ENTER();                                  /* Enter GUI */
+    __GUI_MEMFREE(ptr);
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return 1;
+}
+
+uint8_t GUI_RESPACK_GetImage(const GUI_RESPACK_t* pack, const GUI_Char* name, GUI_IMAGE_DESC_t* img) {
+    const GUI_RESPACK_Entry_t* e;
+    const GUI_RESPACK_Image_t* rec;
+    
+    if (!img || (e = GUI_RESPACK_Find(pack, name)) == 0 || e->Type != GUI_RESPACK_TYPE_IMAGE) {
+        return 0;
+    }
+    rec = (const GUI_RESPACK_Image_t *)(pack->Base + e->Offset);
+    if (!__CheckImage(pack, rec)) {                 /* Image data must be inside pack */
+        return 0;
+    }
+    __SetImage(pack, rec, img);                     /* Fill descriptor, data stay in pack */
+    return 1;
+}
+
+const GUI_SPRITE_DESC_t* GUI_RESPACK_GetSprite(const GUI_RESPACK_t* pack, const GUI_Char* name) {
+    const GUI_RESPACK_Entry_t* e;
+    const GUI_RESPACK_Sprite_t* rec;
+    const GUI_RESPACK_SpriteFrame_t* frames;
+    const GUI_RESPACK_SpriteRect_t* rects;
+    GUI_SPRITE_DESC_t* sprite = 0;
+    GUI_SPRITE_FRAME_t* f;
+    GUI_SPRITE_RECT_t* r;
+    uint32_t i, k, count = 0;
+    
+    if ((e = GUI_RESPACK_Find(pack, name)) == 0 || e->Type != GUI_RESPACK_TYPE_SPRITE) {
+        return 0;
+    }
+    
+    /**
+     * Verify record, frames and rectangles before allocation,
+     * all offsets must point inside pack
+     */
+    rec = (const GUI_RESPACK_Sprite_t *)(pack->Base + e->Offset);
+    if (rec->Width < 0 || rec->Height < 0 || !__IsAligned(rec->FramesOffset) ||
+        !__InPack(pack, rec->FramesOffset, rec->FramesCount, sizeof(GUI_RESPACK_SpriteFrame_t))) {
+        return 0;
+    }
+    frames = (const GUI_RESPACK_SpriteFrame_t *)(pack->Base + rec->FramesOffset);
+    for (i = 0; i < rec->FramesCount; i++) {
+        if (!__IsAligned(frames[i].RectsOffset) ||
+            !__InPack(pack, frames[i].RectsOffset, frames[i].RectsCount, sizeof(GUI_RESPACK_SpriteRect_t))) {
+            return 0;
+        }
+        rects = (const GUI_RESPACK_SpriteRect_t *)(pack->Base + frames[i].RectsOffset);
+        for (k = 0; k < frames[i].RectsCount; k++) {
+            if (!__CheckImage(pack, &rects[k].Image)) {
+                return 0;
+            }
+        }
+        count += frames[i].RectsCount;
+    }
+    
+    __GUI_ENTER();                                  /* Enter GUI */
+    sprite = __GUI_MEMALLOC(sizeof(*sprite) + rec->FramesCount * sizeof(*f) + count * sizeof(*r), GUI_MEM_TYPE_IMAGE);    /* Allocate sprite, frames and rectangles in one block */
+    if (sprite) {
+        f = (GUI_SPRITE_FRAME_t *)(sprite + 1);
+        r = (GUI_SPRITE_RECT_t *)(f + rec->FramesCount);
+        sprite->Width = rec->Width;
+        sprite->Height = rec->Height;
+        sprite->Frames = f;
+        sprite->FramesCount = rec->FramesCount;
+        for (i = 0; i < rec->FramesCount; i++, f++) {   /* Relocate frames */
+            rects = (const GUI_RESPACK_SpriteRect_t *)(pack->Base + frames[i].RectsOffset);
+            f->Rects = r;
+            f->RectsCount = frames[i].RectsCount;
+            f->Duration = frames[i].Duration;
+            for (k = 0; k < frames[i].RectsCount; k++, r++) {   /* Relocate rectangles */
+                r->X = rects[k].X;
+                r->Y = rects[k].Y;
+                __SetImage(pack, &rects[k].Image, &r->Image);
+            }
+        }
+    }
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return sprite;
+}
+
+uint8_t GUI_RESPACK_FreeSprite(const GUI_SPRITE_DESC_t* sprite) {
+    void* ptr = (void *)sprite;
+    
+    __GUI_ASSERTPARAMS(sprite);                     /* Check input parameters */
+    __GUI_ENTER();                                  /* Enter GUI */
+    __GUI_MEMFREE(ptr);
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return 1;
+}
@@ -0,0 +1,313 @@
+/**
+ * \author  Tilen Majerle <tilen@majerle.eu>
+ * \brief   GUI resource pack
+ *  
+\verbatim
+   ----------------------------------------------------------------------
+    Copyright (c) 2016 Tilen Majerle
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge,
+    publish, distribute, sublicense, and/or sell copies of the Software, 
+    and to permit persons to whom the Software is furnished to do so, 
+    subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+    AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+   ----------------------------------------------------------------------
+\endverbatim
+ */
+#ifndef GUI_RESPACK_H
+#define GUI_RESPACK_H
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup      GUI_UTILS
+ * \{
+ */
+#include "gui_utils.h"
+
+/**
+ * \defgroup        GUI_RESPACK Resource pack
+ * \brief           Binary container for fonts, images and other resources
+ * \{
+ *
+ * Resource pack is single binary blob, generated on host and stored to external (QSPI) flash or file.
+ * GUI reads resources directly from memory-mapped pack, no bitmap or image data is copied to RAM.
+ *
+ * \par Binary format
+ *
+ * All values are little-endian. Pack starts with \ref GUI_RESPACK_Header_t structure,
+ * followed by index table of \ref GUI_RESPACK_Entry_t structures, sorted by name hash in ascending order.
+ * Name of each entry is 0-terminated string anywhere in the pack, data of each entry
+ * starts at offset aligned to \ref GUI_RESPACK_ALIGN bytes.
+ *
+\verbatim
++--------------------+ 0
+| Header             |
++--------------------+ Header.IndexOffset
+| Entry 0            |
+| ...                |
+| Entry Count - 1    |
++--------------------+
+| Names              |
++--------------------+
+| Data (aligned)     |
++--------------------+ Header.Size
+\endverbatim
+ *
+ * Name hash is 32-bit FNV-1a hash of entry name, see \ref GUI_RESPACK_Hash function.
+ *
+ * Font, image and sprite entries are stored as \ref GUI_RESPACK_Font_t, \ref GUI_RESPACK_Image_t
+ * and \ref GUI_RESPACK_Sprite_t records, which reference their tables and bitmaps with offsets from start of pack.
+ * Pack is therefore position independent and can be memory-mapped to any address,
+ * either to QSPI flash on MCU or with \c mmap on host.
+ *
+ * Character table of font has the same layout as \ref GUI_FONT_CharInfo_t on 32-bit targets,
+ * with bitmap offset in place of pointer. \ref GUI_RESPACK_GetFont allocates only \ref GUI_FONT_t structure,
+ * which uses character table directly in pack with \ref GUI_FONT_t.Base set to start of pack.
+ * Table is copied to GUI memory only on targets with different pointer size, for example 64-bit host.
+ * \ref GUI_RESPACK_GetSprite relocates frame and rectangle records to descriptor allocated in GUI memory,
+ * \ref GUI_RESPACK_GetImage fills image descriptor provided by user. Bitmaps always stay in pack memory.
+ *
+ * \note            Descriptors point to pack memory, pack must stay mapped until they are freed
+ *                  with \ref GUI_RESPACK_FreeFont or \ref GUI_RESPACK_FreeSprite and images are not used anymore
+ */
+
+#define GUI_RESPACK_MAGIC           0x52495547UL/*!< Pack magic number, "GUIR" in ASCII */
+#define GUI_RESPACK_VERSION         0x0003      /*!< Supported pack format version */
+#define GUI_RESPACK_ALIGN           4           /*!< Alignment of entry data in units of bytes */
+
+/**
+ * \brief           List of resource types in pack
+ */
+typedef enum GUI_RESPACK_Type_t {
+    GUI_RESPACK_TYPE_RAW = 0x00,            /*!< Raw binary data */
+    GUI_RESPACK_TYPE_FONT = 0x01,           /*!< Font, entry data starts with \ref GUI_RESPACK_Font_t structure */
+    GUI_RESPACK_TYPE_IMAGE = 0x02,          /*!< Image, entry data starts with \ref GUI_RESPACK_Image_t structure */
+    GUI_RESPACK_TYPE_SPRITE = 0x03,         /*!< Sprite animation, entry data starts with \ref GUI_RESPACK_Sprite_t structure */
+} GUI_RESPACK_Type_t;
+
+/**
+ * \brief           Resource pack header as stored in memory
+ */
+typedef struct GUI_RESPACK_Header_t {
+    uint32_t Magic;                         /*!< Magic number, must be \ref GUI_RESPACK_MAGIC */
+    uint16_t Version;                       /*!< Format version, must be \ref GUI_RESPACK_VERSION */
+    uint16_t HeaderSize;                    /*!< Size of header in units of bytes */
+    uint32_t Size;                          /*!< Total size of pack in units of bytes, including header */
+    uint32_t Count;                         /*!< Number of entries in index table */
+    uint32_t IndexOffset;                   /*!< Offset of index table from start of pack */
+    uint32_t Reserved;                      /*!< Reserved for future use, must be set to 0 */
+} GUI_RESPACK_Header_t;
+
+/**
+ * \brief           Single entry in pack index table
+ */
+typedef struct GUI_RESPACK_Entry_t {
+    uint32_t Hash;                          /*!< FNV-1a hash of entry name */
+    uint32_t NameOffset;                    /*!< Offset of 0-terminated entry name from start of pack */
+    uint32_t Offset;                        /*!< Offset of entry data from start of pack */
+    uint32_t Size;                          /*!< Size of entry data in units of bytes */
+    uint16_t Type;                          /*!< Entry type, member of \ref GUI_RESPACK_Type_t enumeration */
+    uint16_t Flags;                         /*!< Entry flags, reserved for future use */
+} GUI_RESPACK_Entry_t;
+
+/**
+ * \brief           Font record as stored in pack
+ */
+typedef struct GUI_RESPACK_Font_t {
+    uint32_t NameOffset;                    /*!< Offset of 0-terminated font name from start of pack */
+    uint32_t CharsOffset;                   /*!< Offset of \ref GUI_RESPACK_FontChar_t table, one entry for each character from StartChar to EndChar */
+    uint16_t StartChar;                     /*!< Start character number in list */
+    uint16_t EndChar;                       /*!< End character number in list */
+    uint8_t Size;                           /*!< Font size in units of pixels */
+    uint8_t Flags;                          /*!< List of flags for font */
+    uint16_t Reserved;                      /*!< Reserved for future use, must be set to 0 */
+} GUI_RESPACK_Font_t;
+
+/**
+ * \brief           Font character record as stored in pack
+ * \note            Layout is the same as \ref GUI_FONT_CharInfo_t with 32-bit pointers
+ */
+typedef struct GUI_RESPACK_FontChar_t {
+    uint8_t xSize;                          /*!< Character x size in units of pixels */
+    uint8_t ySize;                          /*!< Character y size in units of pixels */
+    uint8_t xPos;                           /*!< Character relative x offset in units of pixels */
+    uint8_t yPos;                           /*!< Character relative y offset in units of pixels */
+    uint8_t xMargin;                        /*!< Right margin after character in units of pixels */
+    uint8_t Reserved[3];                    /*!< Padding before offset, must be set to 0 */
+    uint32_t DataOffset;                    /*!< Offset of character bitmap from start of pack */
+} GUI_RESPACK_FontChar_t;
+
+/**
+ * \brief           Image record as stored in pack
+ * \note            Size must be set for all image formats, not only for compressed ones
+ */
+typedef struct GUI_RESPACK_Image_t {
+    int16_t Width;                          /*!< Image width in units of pixels */
+    int16_t Height;                         /*!< Image height in units of pixels */
+    uint32_t DataOffset;                    /*!< Offset of image data from start of pack, aligned to \ref GUI_RESPACK_ALIGN bytes */
+    uint32_t Size;                          /*!< Size of image data in units of bytes */
+    uint32_t CLUTOffset;                    /*!< Offset of color lookup table from start of pack. Used for \ref GUI_IMAGE_FORMAT_L8 format */
+    uint16_t CLUTSize;                      /*!< Number of colors in lookup table, up to 256 */
+    uint8_t Format;                         /*!< Pixel format, member of \ref GUI_IMAGE_Format_t enumeration */
+    uint8_t Reserved;                       /*!< Reserved for future use, must be set to 0 */
+} GUI_RESPACK_Image_t;
+
+/**
+ * \brief           Sprite animation record as stored in pack
+ */
+typedef struct GUI_RESPACK_Sprite_t {
+    int16_t Width;                          /*!< Sprite width in units of pixels */
+    int16_t Height;                         /*!< Sprite height in units of pixels */
+    uint32_t FramesOffset;                  /*!< Offset of \ref GUI_RESPACK_SpriteFrame_t table from start of pack */
+    uint16_t FramesCount;                   /*!< Number of frames */
+    uint16_t Reserved;                      /*!< Reserved for future use, must be set to 0 */
+} GUI_RESPACK_Sprite_t;
+
+/**
+ * \brief           Sprite frame record as stored in pack
+ */
+typedef struct GUI_RESPACK_SpriteFrame_t {
+    uint32_t RectsOffset;                   /*!< Offset of \ref GUI_RESPACK_SpriteRect_t table from start of pack */
+    uint16_t RectsCount;                    /*!< Number of changed rectangles */
+    uint16_t Duration;                      /*!< Frame display time in units of milliseconds */
+} GUI_RESPACK_SpriteFrame_t;
+
+/**
+ * \brief           Sprite rectangle record as stored in pack
+ */
+typedef struct GUI_RESPACK_SpriteRect_t {
+    int16_t X;                              /*!< Rectangle X position relative to sprite top left corner */
+    int16_t Y;                              /*!< Rectangle Y position relative to sprite top left corner */
+    GUI_RESPACK_Image_t Image;              /*!< Image of rectangle */
+} GUI_RESPACK_SpriteRect_t;
+
+/**
+ * \brief           Opened resource pack handle
+ */
+typedef struct GUI_RESPACK_t {
+    const uint8_t* Base;                    /*!< Pointer to first byte of pack in memory */
+    const GUI_RESPACK_Header_t* Header;     /*!< Pointer to pack header */
+    const GUI_RESPACK_Entry_t* Entries;     /*!< Pointer to index table */
+} GUI_RESPACK_t;
+
+/**
+ * \brief           Calculate hash of resource name
+ * \param[in]       *name: Resource name
+ * \retval          32-bit FNV-1a hash of name
+ */
+uint32_t GUI_RESPACK_Hash(const GUI_Char* name);
+
+/**
+ * \brief           Open resource pack from memory-mapped storage
+ * \note            Header and index table are verified once, on open. Data stays in place
+ * \param[out]      *pack: Pointer to \ref GUI_RESPACK_t structure to fill
+ * \param[in]       *addr: Address where pack is mapped in memory. Must be aligned to \ref GUI_RESPACK_ALIGN bytes
+ * \param[in]       size: Number of bytes available at address
+ * \retval          Member of \ref GUI_Result_t enumeration
+ */
+GUI_Result_t GUI_RESPACK_Open(GUI_RESPACK_t* pack, const void* addr, uint32_t size);
+
+/**
+ * \brief           Find resource entry by name
+ * \param[in]       *pack: Opened pack handle
+ * \param[in]       *name: Resource name
+ * \retval          > 0: Pointer to \ref GUI_RESPACK_Entry_t in pack
+ * \retval          0: Entry does not exists
+ */
+const GUI_RESPACK_Entry_t* GUI_RESPACK_Find(const GUI_RESPACK_t* pack, const GUI_Char* name);
+
+/**
+ * \brief           Get pointer to resource data by name
+ * \param[in]       *pack: Opened pack handle
+ * \param[in]       *name: Resource name
+ * \param[out]      *size: Pointer to output variable to save data size to. Set to NULL if not used
+ * \retval          > 0: Pointer to data in memory-mapped pack
+ * \retval          0: Entry does not exists
+ */
+const void* GUI_RESPACK_GetData(const GUI_RESPACK_t* pack, const GUI_Char* name, uint32_t* size);
+
+/**
+ * \brief           Get font from resource pack
+ * \note            Font descriptor is allocated in GUI memory and must be freed with \ref GUI_RESPACK_FreeFont
+ *                  when not used anymore. Character table and bitmaps are used in place on 32-bit targets
+ * \param[in]       *pack: Opened pack handle
+ * \param[in]       *name: Font name in pack
+ * \retval          > 0: Pointer to \ref GUI_FONT_t ready to use with widgets
+ * \retval          0: Font does not exists, it is not valid or there is no memory for descriptor
+ * \sa              GUI_RESPACK_FreeFont
+ */
+const GUI_FONT_t* GUI_RESPACK_GetFont(const GUI_RESPACK_t* pack, const GUI_Char* name);
+
+/**
+ * \brief           Free font descriptor returned by \ref GUI_RESPACK_GetFont
+ * \note            Font must not be used by any widget anymore
+ * \param[in]       *font: Font to free
+ * \retval          1: Font was freed ok
+ * \retval          0: Font was not freed
+ */
+uint8_t GUI_RESPACK_FreeFont(const GUI_FONT_t* font);
+
+/**
+ * \brief           Get image from resource pack
+ * \note            Nothing is allocated, image data and color lookup table stay in pack memory
+ * \param[in]       *pack: Opened pack handle
+ * \param[in]       *name: Image name in pack
+ * \param[out]      *img: Pointer to \ref GUI_IMAGE_DESC_t structure to fill, ready to use with image widget and \ref GUI_DRAW_Image
+ * \retval          1: Image was found and is valid
+ * \retval          0: Image does not exists or it is not valid
+ */
+uint8_t GUI_RESPACK_GetImage(const GUI_RESPACK_t* pack, const GUI_Char* name, GUI_IMAGE_DESC_t* img);
+
+/**
+ * \brief           Get sprite animation from resource pack
+ * \note            Sprite descriptor is allocated in GUI memory and must be freed with \ref GUI_RESPACK_FreeSprite
+ *                  when not used anymore. Image data is not copied
+ * \param[in]       *pack: Opened pack handle
+ * \param[in]       *name: Sprite name in pack
+ * \retval          > 0: Pointer to \ref GUI_SPRITE_DESC_t ready to use with sprite widget
+ * \retval          0: Sprite does not exists, it is not valid or there is no memory for descriptor
+ * \sa              GUI_RESPACK_FreeSprite
+ */
+const GUI_SPRITE_DESC_t* GUI_RESPACK_GetSprite(const GUI_RESPACK_t* pack, const GUI_Char* name);
+
+/**
+ * \brief           Free sprite descriptor returned by \ref GUI_RESPACK_GetSprite
+ * \note            Sprite must not be used by any sprite widget anymore
+ * \param[in]       *sprite: Sprite to free
+ * \retval          1: Sprite was freed ok
+ * \retval          0: Sprite was not freed
+ */
+uint8_t GUI_RESPACK_FreeSprite(const GUI_SPRITE_DESC_t* sprite);
+
+/**
+ * \}
+ */
+
+/**
+ * \}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
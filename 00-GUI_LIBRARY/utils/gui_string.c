@@ -25,30 +25,235 @@
  */
 #define GUI_INTERNAL
 #include "gui_string.h"
+#include "stdarg.h"
 
 /******************************************************************************/
 /******************************************************************************/
 /***                           Private structures                            **/
 /******************************************************************************/
 /******************************************************************************/
+/* Output buffer of formatting functions */
+typedef struct __GUI_STRING_Out_t {
+    GUI_Char* Dst;                          /* Destination buffer */
+    size_t Size;                            /* Size of destination buffer including zero termination */
+    size_t Len;                             /* Number of characters written */
+} __GUI_STRING_Out_t;
 
 /******************************************************************************/
 /******************************************************************************/
 /***                           Private definitions                           **/
 /******************************************************************************/
 /******************************************************************************/
+#define UTF8_ACCEPT         0               /* Character is decoded */
+#define UTF8_REJECT         12              /* Invalid byte sequence */
+
+#define FORMAT_MAX_PRECISION    9           /* Maximal number of digits after decimal point */
+#define FORMAT_NUMBER_SIZE      32          /* Maximal number of characters in number without sign and padding */
 
 /******************************************************************************/
 /******************************************************************************/
 /***                            Private variables                            **/
 /******************************************************************************/
 /******************************************************************************/
+static const uint32_t Pow10[FORMAT_MAX_PRECISION + 1] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+};
+static const GUI_STRING_FORMAT_t FormatDefault;     /* No padding and no decimal digits */
+
+#if GUI_USE_UNICODE
+/**
+ * UTF-8 decoder state machine by Bjoern Hoehrmann.
+ * First 256 bytes map byte to character class, remaining bytes map state and class to next state.
+ * Overlong sequences, surrogates and characters above 0x10FFFF are rejected
+ */
+static const uint8_t Utf8Dfa[] = {
+     0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+     0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+     0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+     0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+     1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9,
+     7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+     8, 8, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    10, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 4, 3, 3,11, 6, 6, 6, 5, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8,
+    
+     0,12,24,36,60,96,84,12,12,12,48,72,12,12,12,12,12,12,12,12,12,12,12,12,
+    12, 0,12,12,12,12,12, 0,12, 0,12,12,12,24,12,12,12,12,12,24,12,24,12,12,
+    12,12,12,12,12,12,12,24,12,12,12,12,12,24,12,12,12,12,12,12,12,24,12,12,
+    12,12,12,12,12,12,12,36,12,36,12,12,12,36,12,12,12,12,12,36,12,36,12,12,
+    12,36,12,12,12,12,12,12,12,12,12,12,
+};
+#endif /* GUI_USE_UNICODE */
 
 /******************************************************************************/
 /******************************************************************************/
 /***                            Private functions                            **/
 /******************************************************************************/
 /******************************************************************************/
+/* Add characters to output, characters which do not fit are dropped */
+static
+void __FormatPut(__GUI_STRING_Out_t* o, const GUI_Char* str, size_t len) {
+    while (len-- && (o->Len + 1) < o->Size) {
+        o->Dst[o->Len++] = *str++;
+    }
+}
+
+/* Add character to output multiple times */
+static
+void __FormatFill(__GUI_STRING_Out_t* o, GUI_Char ch, size_t count) {
+    while (count-- && (o->Len + 1) < o->Size) {
+        o->Dst[o->Len++] = ch;
+    }
+}
+
+/* Terminate output and get number of characters written */
+static
+size_t __FormatEnd(__GUI_STRING_Out_t* o) {
+    if (o->Size) {
+        o->Dst[o->Len] = 0;
+    }
+    return o->Len;
+}
+
+/* Add text padded to width */
+static
+void __FormatText(__GUI_STRING_Out_t* o, const GUI_Char* str, size_t len, const GUI_STRING_FORMAT_t* fmt) {
+    size_t pad = fmt->Width > len ? fmt->Width - len : 0;
+    
+    if (!(fmt->Flags & GUI_STRING_FORMAT_FLAG_LEFT)) {
+        __FormatFill(o, ' ', pad);
+    }
+    __FormatPut(o, str, len);
+    if (fmt->Flags & GUI_STRING_FORMAT_FLAG_LEFT) {
+        __FormatFill(o, ' ', pad);
+    }
+}
+
+/* Add number from integer part and fraction digits with sign, grouping and padding */
+static
+void __FormatNumber(__GUI_STRING_Out_t* o, uint8_t neg, uint32_t ip, uint32_t frac, uint8_t prec, uint8_t base, uint8_t upper, const GUI_STRING_FORMAT_t* fmt) {
+    static const char digits[] = "0123456789abcdef0123456789ABCDEF";
+    GUI_Char buff[FORMAT_NUMBER_SIZE];
+    GUI_Char sign = neg ? '-' : ((fmt->Flags & GUI_STRING_FORMAT_FLAG_PLUS) ? '+' : 0);
+    uint8_t i = sizeof(buff), n;
+    size_t len, pad;
+    
+    if (prec) {                                     /* Fraction digits from the last one */
+        for (n = 0; n < prec; n++) {
+            buff[--i] = '0' + frac % 10;
+            frac /= 10;
+        }
+        buff[--i] = '.';
+    }
+    n = 0;
+    do {                                            /* Integer digits from the last one */
+        if (n && !(n % 3) && (fmt->Flags & GUI_STRING_FORMAT_FLAG_GROUP)) {
+            buff[--i] = fmt->Separator ? fmt->Separator : ',';
+        }
+        buff[--i] = digits[(upper ? 16 : 0) + ip % base];
+        ip /= base;
+        n++;
+    } while (ip);
+    
+    len = sizeof(buff) - i + (sign ? 1 : 0);
+    pad = fmt->Width > len ? fmt->Width - len : 0;
+    if (!(fmt->Flags & (GUI_STRING_FORMAT_FLAG_LEFT | GUI_STRING_FORMAT_FLAG_ZERO))) {
+        __FormatFill(o, ' ', pad);
+    }
+    if (sign) {
+        __FormatPut(o, &sign, 1);
+    }
+    if ((fmt->Flags & (GUI_STRING_FORMAT_FLAG_LEFT | GUI_STRING_FORMAT_FLAG_ZERO)) == GUI_STRING_FORMAT_FLAG_ZERO) {
+        __FormatFill(o, '0', pad);
+    }
+    __FormatPut(o, &buff[i], sizeof(buff) - i);
+    if (fmt->Flags & GUI_STRING_FORMAT_FLAG_LEFT) {
+        __FormatFill(o, ' ', pad);
+    }
+}
+
+/* Add signed integer */
+static
+void __FormatInt(__GUI_STRING_Out_t* o, int32_t value, const GUI_STRING_FORMAT_t* fmt) {
+    __FormatNumber(o, value < 0, value < 0 ? 0U - (uint32_t)value : (uint32_t)value, 0, 0, 10, 0, fmt);
+}
+
+/* Add Q16.16 fixed-point number, fraction is rounded with integer multiplication */
+static
+void __FormatFixed(__GUI_STRING_Out_t* o, GUI_Fixed_t value, const GUI_STRING_FORMAT_t* fmt) {
+    uint8_t prec = __GUI_MIN(fmt->Precision, FORMAT_MAX_PRECISION);
+    uint32_t a = value < 0 ? 0U - (uint32_t)value : (uint32_t)value;
+    uint32_t ip = a >> 16;
+    uint32_t frac = (uint32_t)(((uint64_t)(a & 0xFFFF) * Pow10[prec] + 0x8000) >> 16);
+    
+    if (frac >= Pow10[prec]) {                      /* Rounding carry to integer part */
+        frac -= Pow10[prec];
+        ip++;
+    }
+    __FormatNumber(o, value < 0, ip, frac, prec, 10, 0, fmt);
+}
+
+/* Add float number, integer part and fraction are converted to integers once */
+static
+void __FormatFloat(__GUI_STRING_Out_t* o, float value, const GUI_STRING_FORMAT_t* fmt) {
+    uint8_t prec = __GUI_MIN(fmt->Precision, FORMAT_MAX_PRECISION);
+    uint8_t neg = value < 0.0f;
+    uint32_t ip, frac;
+    
+    if (value != value) {                           /* Not a number */
+        __FormatText(o, (const GUI_Char *)"nan", 3, fmt);
+        return;
+    }
+    if (neg) {
+        value = -value;
+    }
+    if (value >= 4294967296.0f) {                   /* Integer part does not fit */
+        if (value > 3.4028235e38f) {
+            __FormatText(o, (const GUI_Char *)(neg ? "-inf" : "inf"), neg ? 4 : 3, fmt);
+        } else {
+            __FormatFill(o, '#', fmt->Width ? fmt->Width : 1);
+        }
+        return;
+    }
+    ip = (uint32_t)value;
+    frac = (uint32_t)((value - (float)ip) * (float)Pow10[prec] + 0.5f);
+    if (frac >= Pow10[prec]) {                      /* Rounding carry to integer part */
+        frac -= Pow10[prec];
+        ip++;
+    }
+    __FormatNumber(o, neg, ip, frac, prec, 10, 0, fmt);
+}
+
+/* Add double number for \c f conversion, all digits up to maximal precision are exact */
+static
+void __FormatDouble(__GUI_STRING_Out_t* o, double value, const GUI_STRING_FORMAT_t* fmt) {
+    uint8_t prec = __GUI_MIN(fmt->Precision, FORMAT_MAX_PRECISION);
+    uint8_t neg = value < 0.0;
+    uint32_t ip, frac;
+    
+    if (value != value) {                           /* Not a number */
+        __FormatText(o, (const GUI_Char *)"nan", 3, fmt);
+        return;
+    }
+    if (neg) {
+        value = -value;
+    }
+    if (value >= 4294967296.0) {                    /* Integer part does not fit */
+        if (value > 1.7976931348623157e308) {
+            __FormatText(o, (const GUI_Char *)(neg ? "-inf" : "inf"), neg ? 4 : 3, fmt);
+        } else {
+            __FormatFill(o, '#', fmt->Width ? fmt->Width : 1);
+        }
+        return;
+    }
+    ip = (uint32_t)value;
+    frac = (uint32_t)((value - (double)ip) * (double)Pow10[prec] + 0.5);
+    if (frac >= Pow10[prec]) {                      /* Rounding carry to integer part */
+        frac -= Pow10[prec];
+        ip++;
+    }
+    __FormatNumber(o, neg, ip, frac, prec, 10, 0, fmt);
+}
+
 
 /******************************************************************************/
 /******************************************************************************/
@@ -121,13 +326,10 @@ size_t GUI_STRING_Length(const GUI_Char* src) {
 #if GUI_USE_UNICODE
     size_t out = 0;
     const GUI_Char* tmp = src;
-    GUI_STRING_UNICODE_t s;
+    uint32_t ch;
     
-    GUI_STRING_UNICODE_Init(&s);            /* Init unicode */
-    while (*tmp) {                          /* Process string */
-        if (GUI_STRING_UNICODE_Decode(&s, *tmp++) == UNICODE_OK) {  /* Process character */
-            out++;                          /* Increase number of characters */
-        }
+    while (GUI_STRING_GetCh(&tmp, &ch, NULL)) { /* Process string */
+        out++;                              /* Increase number of characters */
     }
     return out;
 #else
@@ -154,29 +356,43 @@ int GUI_STRING_Compare(const GUI_Char* s1, const GUI_Char* s2) {
 uint8_t GUI_STRING_GetCh(const GUI_Char** str, uint32_t* out, uint8_t* len) {
     const GUI_Char* ch = *str;              /* Save character pointer */
 #if GUI_USE_UNICODE
-    GUI_STRING_UNICODE_t s;
-    GUI_STRING_UNICODE_Result_t r;
-    
-    if (!*ch) {                             /* End of string check */
-        return 0;
-    }
+    const GUI_Char* start = ch;
+    uint32_t state = UTF8_ACCEPT, res = 0;
+    uint8_t type;
     
-    GUI_STRING_UNICODE_Init(&s);            /* Init UTF-8 */
-    while (*ch) {
+    if (*ch < 0x80) {                       /* ASCII characters are most common, no decoding needed */
         if (!*ch) {                         /* End of string check */
             return 0;
         }
-        r = GUI_STRING_UNICODE_Decode(&s, *ch++);   /* Try to decode */
-        *str += 1;                          /* Increase string pointer */
-        if (r == UNICODE_OK) {              /* Decode next character */
-            break;
+        *str += 1;
+        *out = (uint32_t)*ch;
+        if (len) {
+            *len = 1;
         }
+        return 1;
     }
-    *out = s.res;                           /* Save character for output */
-    if (len) {                              /* Save number of bytes in this character */
-        *len = s.t;                         /* Number of bytes according to UTF-8 encoding */
+    
+    for (; *ch; ch++) {
+        type = Utf8Dfa[*ch];                /* Get character class of byte */
+        res = state != UTF8_ACCEPT ? ((res << 6) | (*ch & 0x3F)) : ((0xFFUL >> type) & *ch);
+        state = Utf8Dfa[256 + state + type];    /* Go to next state */
+        if (state == UTF8_ACCEPT) {         /* Character is decoded */
+            *str = ch + 1;                  /* Set pointer after character */
+            *out = res;                     /* Save character for output */
+            if (len) {                      /* Save number of bytes in this character */
+                *len = (uint8_t)(*str - start); /* Number of bytes according to UTF-8 encoding */
+            }
+            return 1;                       /* Return valid character sign */
+        } else if (state == UTF8_REJECT) {  /* Invalid sequence is skipped */
+            state = UTF8_ACCEPT;
+            if (ch != start) {              /* Byte may start new character, process it again */
+                ch--;
+            }
+            start = ch + 1;
+        }
     }
-    return 1;                               /* Return valid character sign */
+    *str = ch;                              /* Sequence is not complete at the end of string */
+    return 0;
 #else
     *str += 1;                              /* Increase input pointer where it points to */
     *out = (uint32_t)*ch;                   /* Save character for output */
@@ -241,3 +457,141 @@ uint8_t GUI_STRING_GetChReverse(const GUI_Char** str, uint32_t* out, uint8_t* le
 uint8_t GUI_STRING_IsPrintable(uint32_t ch) {
     return (ch >= 32 && ch != 127) || (ch == '\r') || (ch == '\n');
 }
+
+size_t GUI_STRING_FormatInt(GUI_Char* dst, size_t size, int32_t value, const GUI_STRING_FORMAT_t* fmt) {
+    __GUI_STRING_Out_t o = {dst, size, 0};
+    
+    __FormatInt(&o, value, fmt ? fmt : &FormatDefault);
+    return __FormatEnd(&o);
+}
+
+size_t GUI_STRING_FormatFixed(GUI_Char* dst, size_t size, GUI_Fixed_t value, const GUI_STRING_FORMAT_t* fmt) {
+    __GUI_STRING_Out_t o = {dst, size, 0};
+    
+    __FormatFixed(&o, value, fmt ? fmt : &FormatDefault);
+    return __FormatEnd(&o);
+}
+
+size_t GUI_STRING_FormatFloat(GUI_Char* dst, size_t size, float value, const GUI_STRING_FORMAT_t* fmt) {
+    __GUI_STRING_Out_t o = {dst, size, 0};
+    
+    __FormatFloat(&o, value, fmt ? fmt : &FormatDefault);
+    return __FormatEnd(&o);
+}
+
+size_t GUI_STRING_Format(GUI_Char* dst, size_t size, const GUI_Char* format, ...) {
+    __GUI_STRING_Out_t o = {dst, size, 0};
+    GUI_STRING_FORMAT_t f;
+    const GUI_Char* str;
+    const GUI_Char* spec;
+    GUI_Char ch;
+    uint8_t precSet;
+    int32_t v;
+    va_list ap;
+    
+    va_start(ap, format);
+    while (*format) {
+        if (*format != '%') {                       /* Copy normal characters */
+            str = format;
+            while (*format && *format != '%') {
+                format++;
+            }
+            __FormatPut(&o, str, format - str);
+            continue;
+        }
+        spec = format++;                            /* Start of conversion specification */
+        
+        /**
+         * Parse flags, width and precision
+         */
+        memset(&f, 0x00, sizeof(f));
+        for (;; format++) {
+            if (*format == '-') {
+                f.Flags |= GUI_STRING_FORMAT_FLAG_LEFT;
+            } else if (*format == '0') {
+                f.Flags |= GUI_STRING_FORMAT_FLAG_ZERO;
+            } else if (*format == '+') {
+                f.Flags |= GUI_STRING_FORMAT_FLAG_PLUS;
+            } else if (*format == '\'') {
+                f.Flags |= GUI_STRING_FORMAT_FLAG_GROUP;
+            } else {
+                break;
+            }
+        }
+        if (*format == '*') {                       /* Width from argument */
+            v = va_arg(ap, int);
+            if (v < 0) {
+                f.Flags |= GUI_STRING_FORMAT_FLAG_LEFT;
+                v = -v;
+            }
+            f.Width = __GUI_MIN(v, 0xFF);
+            format++;
+        } else {
+            for (v = 0; *format >= '0' && *format <= '9'; format++) {
+                v = __GUI_MIN(v * 10 + (*format - '0'), 0xFF);
+            }
+            f.Width = v;
+        }
+        precSet = 0;
+        if (*format == '.') {                       /* Precision */
+            format++;
+            precSet = 1;
+            if (*format == '*') {
+                v = va_arg(ap, int);
+                format++;
+            } else {
+                for (v = 0; *format >= '0' && *format <= '9'; format++) {
+                    v = __GUI_MIN(v * 10 + (*format - '0'), 0xFF);
+                }
+            }
+            f.Precision = __GUI_MAX(v, 0);
+        }
+        
+        /**
+         * Format argument
+         */
+        switch (*format) {
+            case 'd':
+            case 'i':
+                __FormatInt(&o, va_arg(ap, int), &f);
+                break;
+            case 'u':
+                __FormatNumber(&o, 0, va_arg(ap, unsigned int), 0, 0, 10, 0, &f);
+                break;
+            case 'x':
+            case 'X':
+                f.Flags &= ~GUI_STRING_FORMAT_FLAG_GROUP;
+                __FormatNumber(&o, 0, va_arg(ap, unsigned int), 0, 0, 16, *format == 'X', &f);
+                break;
+            case 'f':
+                f.Precision = precSet ? f.Precision : 6;
+                __FormatDouble(&o, va_arg(ap, double), &f);
+                break;
+            case 'k':
+                f.Precision = precSet ? f.Precision : 6;
+                __FormatFixed(&o, (GUI_Fixed_t)va_arg(ap, int), &f);
+                break;
+            case 'c':
+                ch = (GUI_Char)va_arg(ap, int);
+                __FormatText(&o, &ch, 1, &f);
+                break;
+            case 's':
+                str = va_arg(ap, const GUI_Char *);
+                for (v = 0; str[v] && (!precSet || v < f.Precision); v++) {}
+                __FormatText(&o, str, v, &f);
+                break;
+            case '%':
+                __FormatPut(&o, format, 1);
+                break;
+            case 0:                                 /* Format ends with percent sign */
+                format--;
+                break;
+            default:                                /* Unknown conversion is copied */
+                __FormatPut(&o, spec, format - spec + 1);
+                break;
+        }
+        format++;
+    }
+    va_end(ap);
+    return __FormatEnd(&o);
+}
@@ -249,6 +249,101 @@ while (GUI_STRING_GetChReverse(&ptr, &ch, &i)) {       //Go through entire strin
  * \sa              GUI_STRING_GetCh
  */
 uint8_t GUI_STRING_GetChReverse(const GUI_Char** str, uint32_t* out, uint8_t* len);
+
+/**
+ * \defgroup        GUI_STRING_FORMAT Number formatting
+ * \brief           Allocation-free formatting of numbers to caller buffers
+ *
+ * Integer, fixed-point and float numbers are converted with integer operations only,
+ * floats need single multiplication and conversions to integer.
+ * Functions do not use heap or large stack buffers and can replace \c sprintf for widget values.
+ *
+ * Fraction digits are rounded half away from zero.
+ * Output is always terminated with zero when buffer size is not zero.
+ * When output does not fit, it is truncated and function returns number of characters written.
+ *
+ * \par             Example
+ *
+\code{c}
+GUI_Char buff[20];
+GUI_STRING_FORMAT_t fmt = { 8, 2, GUI_STRING_FORMAT_FLAG_GROUP, 0 };
+
+GUI_STRING_FormatFloat(buff, sizeof(buff), 12345.678f, &fmt);      //buff = "12,345.68"
+GUI_STRING_Format(buff, sizeof(buff), _T("%'d V, %5.1f%%"), 12000, 9.96f); //buff = "12,000 V,  10.0%"
+GUI_STRING_Format(buff, sizeof(buff), _T("%.3k"), GUI_FIXED_FROM_INT(3) / 4);  //buff = "0.750"
+\endcode
+ * \{
+ */
+
+#define GUI_STRING_FORMAT_FLAG_LEFT         0x01    /*!< Align output left inside width and pad it with spaces on the right */
+#define GUI_STRING_FORMAT_FLAG_ZERO         0x02    /*!< Pad output with zeros after sign instead of spaces before sign */
+#define GUI_STRING_FORMAT_FLAG_PLUS         0x04    /*!< Print plus sign for positive numbers */
+#define GUI_STRING_FORMAT_FLAG_GROUP        0x08    /*!< Separate groups of thousands in integer part */
+
+/**
+ * \brief           Number formatting options
+ */
+typedef struct GUI_STRING_FORMAT_t {
+    uint8_t Width;                          /*!< Minimal number of characters, shorter output is padded */
+    uint8_t Precision;                      /*!< Number of digits after decimal point, up to 9. Ignored for integers */
+    uint8_t Flags;                          /*!< List of GUI_STRING_FORMAT_FLAG_x flags */
+    GUI_Char Separator;                     /*!< Thousands separator with \ref GUI_STRING_FORMAT_FLAG_GROUP flag. Comma is used when set to 0 */
+} GUI_STRING_FORMAT_t;
+
+/**
+ * \brief           Format signed integer number
+ * \param[out]      *dst: Destination buffer
+ * \param[in]       size: Size of destination buffer including zero termination
+ * \param[in]       value: Number to format
+ * \param[in]       *fmt: Pointer to \ref GUI_STRING_FORMAT_t options or NULL for default
+ * \retval          Number of characters written, without zero termination
+ */
+size_t GUI_STRING_FormatInt(GUI_Char* dst, size_t size, int32_t value, const GUI_STRING_FORMAT_t* fmt);
+
+/**
+ * \brief           Format Q16.16 fixed-point number
+ * \param[out]      *dst: Destination buffer
+ * \param[in]       size: Size of destination buffer including zero termination
+ * \param[in]       value: Fixed-point number to format
+ * \param[in]       *fmt: Pointer to \ref GUI_STRING_FORMAT_t options or NULL for default
+ * \retval          Number of characters written, without zero termination
+ */
+size_t GUI_STRING_FormatFixed(GUI_Char* dst, size_t size, GUI_Fixed_t value, const GUI_STRING_FORMAT_t* fmt);
+
+/**
+ * \brief           Format float number
+ * \note            Numbers with integer part above 4294967295 are printed as \c # characters
+ * \param[out]      *dst: Destination buffer
+ * \param[in]       size: Size of destination buffer including zero termination
+ * \param[in]       value: Number to format
+ * \param[in]       *fmt: Pointer to \ref GUI_STRING_FORMAT_t options or NULL for default
+ * \retval          Number of characters written, without zero termination
+ */
+size_t GUI_STRING_FormatFloat(GUI_Char* dst, size_t size, float value, const GUI_STRING_FORMAT_t* fmt);
+
+/**
+ * \brief           Format string with subset of \c printf conversions
+ *
+ *                  Supported conversions are \c d, \c i, \c u, \c x, \c X, \c c, \c s, \c f, \c % and \c k
+ *                  for Q16.16 fixed-point numbers of \ref GUI_Fixed_t type.
+ *                  Supported flags are \c -, \c 0, \c + and \c ' for thousands grouping.
+ *                  Width and precision may be set with \c * from argument.
+ *                  Default precision for \c f and \c k is 6 digits, maximal is 9.
+ *
+ * \note            \c f conversion formats \c double argument with double precision arithmetic,
+ *                  which is emulated in software on cores with single precision FPU.
+ *                  Use \ref GUI_STRING_FormatFloat for faster formatting of \c float values there
+ * \param[out]      *dst: Destination buffer
+ * \param[in]       size: Size of destination buffer including zero termination
+ * \param[in]       *format: Format string
+ * \param[in]       ...: Arguments for conversions in format string
+ * \retval          Number of characters written, without zero termination
+ */
+size_t GUI_STRING_Format(GUI_Char* dst, size_t size, const GUI_Char* format, ...);
+
+/**
+ * \}
+ */
     
 /**
  * \}
@@ -0,0 +1,167 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#define GUI_INTERNAL
+#include "gui_strtable.h"
+#include "../gui_draw.h"
+#include "../widgets/gui_widget.h"
+
+#if GUI_USE_STRTABLE
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private structures                            **/
+/******************************************************************************/
+/******************************************************************************/
+typedef struct __GUI_STRTABLE_Entry_t {
+    struct __GUI_STRTABLE_Entry_t* Next;    /* Next entry in hash bucket */
+    uint16_t ID;                            /* String ID */
+    const GUI_FONT_t* Font;                 /* Font used for drawing */
+    GUI_DRAW_TEXTRUN_t* Run;                /* Decoded and measured string of current language */
+} __GUI_STRTABLE_Entry_t;
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private definitions                           **/
+/******************************************************************************/
+/******************************************************************************/
+#define __BUCKETS                   __GUI_STRTABLE_BUCKETS
+#define __Bucket(id, font)          (((uint32_t)(id) ^ ((uint32_t)(uintptr_t)(font) >> 2)) % __BUCKETS)
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private variables                            **/
+/******************************************************************************/
+/******************************************************************************/
+/* Language and strings in use are part of GUI context */
+#define Table                       (GUI.StrTable.Table)
+#define Buckets                     (GUI.StrTable.Buckets)
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private functions                            **/
+/******************************************************************************/
+/******************************************************************************/
+/* Set text again to all children widgets with text from string table */
+static
+void __SetWidgetsText(GUI_HANDLE_p parent) {
+    GUI_HANDLE_p h;
+    
+    for (h = __GUI_LINKEDLIST_WidgetGetNext(__GHR(parent), 0); h; h = __GUI_LINKEDLIST_WidgetGetNext(0, h)) {
+        if (__GH(h)->Flags & GUI_FLAG_TEXTID) {     /* Widget text is from string table */
+            __GUI_WIDGET_SetText(h, __GUI_STRTABLE_Get(__GH(h)->TextID));
+        }
+        if (__GUI_WIDGET_AllowChildren(h)) {        /* Process children widgets */
+            __SetWidgetsText(h);
+        }
+    }
+}
+
+/* Release all decoded and measured strings */
+static
+void __FreeEntries(void) {
+    __GUI_STRTABLE_Entry_t* e;
+    uint8_t i;
+    
+    for (i = 0; i < __BUCKETS; i++) {
+        while ((e = Buckets[i]) != 0) {
+            Buckets[i] = e->Next;
+            __GUI_DRAW_TextRunFree(&e->Run);
+            __GUI_MEMFREE(e);
+        }
+    }
+}
+
+/******************************************************************************/
+/******************************************************************************/
+/***                                Public API                               **/
+/******************************************************************************/
+/******************************************************************************/
+GUI_DRAW_TEXTRUN_t* __GUI_STRTABLE_GetRun(uint16_t id, const GUI_FONT_t* font) {
+    __GUI_STRTABLE_Entry_t* e;
+    uint32_t b = __Bucket(id, font);
+    
+    for (e = Buckets[b]; e; e = e->Next) {          /* Find pair used before */
+        if (e->ID == id && e->Font == font) {
+            break;
+        }
+    }
+    if (!e) {                                       /* New pair, keep it for all further languages */
+        e = (__GUI_STRTABLE_Entry_t *)__GUI_MEMALLOC(sizeof(*e), GUI_MEM_TYPE_TEXT);
+        if (!e) {
+            return 0;
+        }
+        e->ID = id;
+        e->Font = font;
+        e->Run = 0;
+        e->Next = Buckets[b];
+        Buckets[b] = e;
+    }
+    return __GUI_DRAW_TextRunGet(&e->Run, font, __GUI_STRTABLE_Get(id));   /* Decoded only when string changed */
+}
+
+const GUI_Char* __GUI_STRTABLE_Get(uint16_t id) {
+    if (Table && id < Table->Count && Table->Strings[id]) {
+        return Table->Strings[id];
+    }
+    return _T("");                                  /* Unknown string is empty */
+}
+
+GUI_Result_t GUI_STRTABLE_SetLanguage(const GUI_STRTABLE_t* table) {
+    __GUI_STRTABLE_Entry_t* e;
+    uint8_t i;
+    
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    Table = table;                                  /* Set new language */
+    if (table) {
+        for (i = 0; i < __BUCKETS; i++) {           /* Decode and measure strings in use before redraw */
+            for (e = Buckets[i]; e; e = e->Next) {
+                __GUI_DRAW_TextRunGet(&e->Run, e->Font, __GUI_STRTABLE_Get(e->ID));
+            }
+        }
+    } else {
+        __FreeEntries();
+    }
+    __SetWidgetsText(NULL);                         /* Set new strings to widgets */
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return guiOK;
+}
+
+const GUI_STRTABLE_t* GUI_STRTABLE_GetLanguage(void) {
+    return Table;
+}
+
+const GUI_Char* GUI_STRTABLE_Get(uint16_t id) {
+    const GUI_Char* str;
+    
+    __GUI_ENTER();                                  /* Enter GUI */
+    str = __GUI_STRTABLE_Get(id);
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return str;
+}
+
+#endif /* GUI_USE_STRTABLE */
@@ -0,0 +1,147 @@
+/**
+ * \author  Tilen Majerle <tilen@majerle.eu>
+ * \brief   GUI localized string tables
+ *  
+\verbatim
+   ----------------------------------------------------------------------
+    Copyright (c) 2016 Tilen Majerle
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge,
+    publish, distribute, sublicense, and/or sell copies of the Software, 
+    and to permit persons to whom the Software is furnished to do so, 
+    subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+    AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+   ----------------------------------------------------------------------
+\endverbatim
+ */
+#ifndef GUI_STRTABLE_H
+#define GUI_STRTABLE_H
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup      GUI_UTILS
+ * \{
+ */
+#include "gui_utils.h"
+
+/**
+ * \defgroup        GUI_STRTABLE String tables
+ * \brief           Localized strings with pre-measured text
+ * \{
+ *
+ * Each language is table of UTF-8 strings indexed by string ID.
+ * Widgets get text with \ref GUI_WIDGET_SetTextID instead of \ref GUI_WIDGET_SetText
+ * and are updated automatically when language is changed with \ref GUI_STRTABLE_SetLanguage.
+ *
+ * For every string ID and font pair in use, string is decoded and its lines
+ * are measured only once for each text rectangle width widget draws it to.
+ * On language change, all strings in use are decoded and measured again for the same rectangles
+ * before redraw, therefore switching language and drawing screens shown before needs no text measurement.
+ *
+ * \par             Example
+ *
+\code{c}
+enum { STR_OK, STR_CANCEL, STR_COUNT };
+
+static const GUI_Char* const strings_en[STR_COUNT] = { _T("OK"), _T("Cancel") };
+static const GUI_Char* const strings_de[STR_COUNT] = { _T("OK"), _T("Abbrechen") };
+static const GUI_STRTABLE_t lang_en = { strings_en, STR_COUNT };
+static const GUI_STRTABLE_t lang_de = { strings_de, STR_COUNT };
+
+GUI_STRTABLE_SetLanguage(&lang_en);
+GUI_WIDGET_SetTextID(btn_cancel, STR_CANCEL);
+
+GUI_STRTABLE_SetLanguage(&lang_de);         //Button shows "Abbrechen"
+\endcode
+ */
+
+/**
+ * \brief           Table of strings for single language
+ */
+typedef struct GUI_STRTABLE_t {
+    GUI_Const GUI_Char* GUI_Const* Strings; /*!< Pointer to array of UTF-8 strings, indexed by string ID */
+    uint16_t Count;                         /*!< Number of strings in array */
+} GUI_STRTABLE_t;
+
+#if GUI_USE_STRTABLE || defined(DOXYGEN)
+
+#if defined(GUI_INTERNAL) || defined(DOXYGEN)
+
+/**
+ * \brief           Get shared text run for string ID and font
+ * \note            Since this function is private, it can only be used by user inside GUI library
+ * \note            All widgets with the same string ID and font share one run with measured lines
+ * \param[in]       id: String ID
+ * \param[in]       *font: Font used for drawing
+ * \retval          > 0: Pointer to valid run for string of current language
+ * \retval          0: Memory is not available, string must be decoded while drawing
+ */
+struct GUI_DRAW_TEXTRUN_t* __GUI_STRTABLE_GetRun(uint16_t id, const GUI_FONT_t* font);
+
+/**
+ * \brief           Get string for ID from current language
+ * \note            Since this function is private, it can only be used by user inside GUI library
+ * \param[in]       id: String ID
+ * \retval          Pointer to string, empty string when ID is not in table
+ */
+const GUI_Char* __GUI_STRTABLE_Get(uint16_t id);
+
+#endif /* defined(GUI_INTERNAL) || defined(DOXYGEN) */
+
+/**
+ * \brief           Set current language
+ * \note            Strings in use are decoded and measured for new language
+ *                  and all widgets with text from string table are updated
+ * \param[in]       *table: Pointer to \ref GUI_STRTABLE_t table for language. Structure and strings must stay valid while table is used.
+ *                      Set to NULL to release all decoded and measured strings
+ * \retval          Member of \ref GUI_Result_t enumeration
+ */
+GUI_Result_t GUI_STRTABLE_SetLanguage(const GUI_STRTABLE_t* table);
+
+/**
+ * \brief           Get current language
+ * \retval          Pointer to current \ref GUI_STRTABLE_t table or NULL if not set
+ */
+const GUI_STRTABLE_t* GUI_STRTABLE_GetLanguage(void);
+
+/**
+ * \brief           Get string for ID from current language
+ * \param[in]       id: String ID
+ * \retval          Pointer to string, empty string when ID is not in table
+ */
+const GUI_Char* GUI_STRTABLE_Get(uint16_t id);
+
+#endif /* GUI_USE_STRTABLE || defined(DOXYGEN) */
+
+/**
+ * \}
+ */
+
+/**
+ * \}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -58,7 +58,7 @@
 GUI_TIMER_t* __GUI_TIMER_Create(uint16_t period, void (*callback)(GUI_TIMER_t *), void* params, uint8_t flags) {
     GUI_TIMER_t* ptr;
     
-    ptr = (GUI_TIMER_t *)__GUI_MEMALLOC(sizeof(GUI_TIMER_t));  /* Allocate memory for timer */
+    ptr = (GUI_TIMER_t *)__GUI_MEMALLOC(sizeof(GUI_TIMER_t), GUI_MEM_TYPE_TIMER);  /* Allocate memory for timer */
     if (ptr) {
         memset(ptr, 0x00, sizeof(GUI_TIMER_t));     /* Reset memory */
         
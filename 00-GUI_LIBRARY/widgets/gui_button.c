@@ -117,6 +117,7 @@ uint8_t GUI_BUTTON_Callback(GUI_HANDLE_p h, GUI_WC_t ctrl, void* param, void* re
                 f.Align = GUI_HALIGN_CENTER | GUI_VALIGN_CENTER;
                 f.Color1Width = f.Width;
                 f.Color1 = c2;
+                f.Run = __GUI_WIDGET_GetTextRun(h); /* Use pre-decoded text */
                 GUI_DRAW_WriteText(disp, __GH(h)->Font, __GH(h)->Text, &f);
             }
             return 1;
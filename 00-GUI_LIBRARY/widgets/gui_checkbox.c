@@ -155,6 +155,7 @@ uint8_t GUI_CHECKBOX_Callback(GUI_HANDLE_p h, GUI_WC_t ctrl, void* param, void*
                 f.Align = GUI_HALIGN_LEFT | GUI_VALIGN_CENTER;
                 f.Color1Width = f.Width;
                 f.Color1 = __GUI_WIDGET_GetColor(h, GUI_CHECKBOX_COLOR_FG);
+                f.Run = __GUI_WIDGET_GetTextRun(h); /* Use pre-decoded text */
                 GUI_DRAW_WriteText(disp, __GH(h)->Font, __GH(h)->Text, &f);
             }
             
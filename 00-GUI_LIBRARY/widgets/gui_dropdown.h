@@ -104,6 +104,9 @@ typedef struct GUI_DROPDOWN_t {
     
     GUI_Dim_t SliderWidth;                  /*!< Slider width in units of pixels */
     uint8_t Flags;                          /*!< Widget flags */
+#if GUI_USE_TOUCH || defined(DOXYGEN)
+    GUI_iDim_t TouchY;                      /*!< Last relative touch Y position for sliding */
+#endif /* GUI_USE_TOUCH || defined(DOXYGEN) */
 } GUI_DROPDOWN_t;
 #endif /* defined(GUI_INTERNAL) || defined(DOXYGEN) */
 
@@ -106,6 +106,7 @@ uint8_t GUI_EDITTEXT_Callback(GUI_HANDLE_p h, GUI_WC_t ctrl, void* param, void*
                 f.Color1Width = f.Width;
                 f.Color1 = __GUI_WIDGET_GetColor(h, GUI_EDITTEXT_COLOR_FG);
                 f.Flags |= GUI_FLAG_FONT_RIGHTALIGN;
+                f.Run = __GUI_WIDGET_GetTextRun(h); /* Use pre-decoded text */
                 GUI_DRAW_WriteText(disp, __GH(h)->Font, __GH(h)->Text, &f);
             }
             return 1;
@@ -80,26 +80,46 @@ void __GUI_GRAPH_Reset(GUI_HANDLE_p h) {
     g->VisibleMinY = g->MinY;
 }
 
+/* Add point to curve drawn with thick line, first point of segment is added only to empty curve */
+static
+void __GUI_GRAPH_AddPoint(GUI_DRAW_Poly_t* points, uint32_t* count, GUI_Real_t x1, GUI_Real_t y1, GUI_Real_t x2, GUI_Real_t y2) {
+    if (!*count) {
+        points[*count].X = GUI_REAL_TO_INT(x1);
+        points[*count].Y = GUI_REAL_TO_INT(y1);
+        (*count)++;
+    }
+    points[*count].X = GUI_REAL_TO_INT(x2);
+    points[*count].Y = GUI_REAL_TO_INT(y2);
+    (*count)++;
+}
+
+/* Draw thin curve segment, anti-aliased only when enabled for data object */
+static
+void __GUI_GRAPH_DrawLine(const GUI_Display_t* disp, GUI_GRAPH_DATA_p data, GUI_Real_t x1, GUI_Real_t y1, GUI_Real_t x2, GUI_Real_t y2) {
+    if (data->AntiAlias) {
+        GUI_DRAW_LineAA(disp, GUI_REAL_TO_INT(x1), GUI_REAL_TO_INT(y1), GUI_REAL_TO_INT(x2), GUI_REAL_TO_INT(y2), data->Color);
+    } else {
+        GUI_DRAW_Line(disp, GUI_REAL_TO_INT(x1), GUI_REAL_TO_INT(y1), GUI_REAL_TO_INT(x2), GUI_REAL_TO_INT(y2), data->Color);
+    }
+}
+
 /* Zoom plot */
 static
-void __GUI_GRAPH_Zoom(GUI_HANDLE_p h, float zoom, float xpos, float ypos) {
-    if (xpos < 0) { xpos = 0.5; }
-    if (xpos > 1) { xpos = 0.5; }
-    if (ypos < 0) { ypos = 0.5; }
-    if (ypos > 1) { ypos = 0.5; }
+void __GUI_GRAPH_Zoom(GUI_HANDLE_p h, GUI_Real_t zoom, GUI_Real_t xpos, GUI_Real_t ypos) {
+    if (xpos < 0) { xpos = GUI_REAL(0.5f); }
+    if (xpos > GUI_REAL(1.0f)) { xpos = GUI_REAL(0.5f); }
+    if (ypos < 0) { ypos = GUI_REAL(0.5f); }
+    if (ypos > GUI_REAL(1.0f)) { ypos = GUI_REAL(0.5f); }
            
-    g->VisibleMinX += (g->VisibleMaxX - g->VisibleMinX) * (zoom - 1.0f) * xpos;
-    g->VisibleMaxX -= (g->VisibleMaxX - g->VisibleMinX) * (zoom - 1.0f) * (1.0f - xpos);
+    g->VisibleMinX += GUI_REAL_MUL(GUI_REAL_MUL(g->VisibleMaxX - g->VisibleMinX, zoom - GUI_REAL(1.0f)), xpos);
+    g->VisibleMaxX -= GUI_REAL_MUL(GUI_REAL_MUL(g->VisibleMaxX - g->VisibleMinX, zoom - GUI_REAL(1.0f)), GUI_REAL(1.0f) - xpos);
 
-    g->VisibleMinY += (g->VisibleMaxY - g->VisibleMinY) * (zoom - 1.0f) * ypos;
-    g->VisibleMaxY -= (g->VisibleMaxY - g->VisibleMinY) * (zoom - 1.0f) * (1.0f - ypos);
+    g->VisibleMinY += GUI_REAL_MUL(GUI_REAL_MUL(g->VisibleMaxY - g->VisibleMinY, zoom - GUI_REAL(1.0f)), ypos);
+    g->VisibleMaxY -= GUI_REAL_MUL(GUI_REAL_MUL(g->VisibleMaxY - g->VisibleMinY, zoom - GUI_REAL(1.0f)), GUI_REAL(1.0f) - ypos);
 }
 
 static
 uint8_t GUI_GRAPH_Callback(GUI_HANDLE_p h, GUI_WC_t ctrl, void* param, void* result) {
-#if GUI_USE_TOUCH
-static GUI_iDim_t tX[GUI_TOUCH_MAX_PRESSES], tY[GUI_TOUCH_MAX_PRESSES];
-#endif /* GUI_USE_TOUCH */    
     switch (ctrl) {                                 /* Handle control function if required */
         case GUI_WC_Draw: {                         /* Draw widget */
             GUI_GRAPH_DATA_p data;
@@ -127,32 +147,34 @@ static GUI_iDim_t tX[GUI_TOUCH_MAX_PRESSES], tY[GUI_TOUCH_MAX_PRESSES];
             
             /* Draw horizontal lines */
             if (g->Rows) {
-                float step;
-                step = (float)(height - bt - bb) / (float)g->Rows;
+                GUI_Real_t step;
+                step = GUI_REAL_FROM_INT(height - bt - bb) / g->Rows;
                 for (i = 1; i < g->Rows; i++) {
-                    GUI_DRAW_HLine(disp, x + bl, y + bt + i * step, width - bl - br, __GUI_WIDGET_GetColor(h, GUI_GRAPH_COLOR_GRID));
+                    GUI_DRAW_HLine(disp, x + bl, y + bt + GUI_REAL_TO_INT(GUI_REAL_MUL_INT(step, i)), width - bl - br, __GUI_WIDGET_GetColor(h, GUI_GRAPH_COLOR_GRID));
                 }
             }
             /* Draw vertical lines */
             if (g->Columns) {
-                float step;
-                step = (float)(width - bl - br) / (float)g->Columns;
+                GUI_Real_t step;
+                step = GUI_REAL_FROM_INT(width - bl - br) / g->Columns;
                 for (i = 1; i < g->Columns; i++) {
-                    GUI_DRAW_VLine(disp, x + bl + i * step, y + bt, height - bt - bb, __GUI_WIDGET_GetColor(h, GUI_GRAPH_COLOR_GRID));
+                    GUI_DRAW_VLine(disp, x + bl + GUI_REAL_TO_INT(GUI_REAL_MUL_INT(step, i)), y + bt, height - bt - bb, __GUI_WIDGET_GetColor(h, GUI_GRAPH_COLOR_GRID));
                 }
             }
             
             /* Check if any data attached to this graph */
             if (g->Root.First) {                    /* We have attached plots */
                 GUI_Display_t display;
-                register float x1, y1, x2, y2;      /* Try to add these variables to core registers */
-                float xSize = g->VisibleMaxX - g->VisibleMinX;  /* Calculate X size */
-                float ySize = g->VisibleMaxY - g->VisibleMinY;  /* Calculate Y size */
-                float xStep = (float)(width - bl - br) / (float)xSize;  /* Calculate X step */
-                float yStep = (float)(height - bt - bb) / (float)ySize; /* calculate Y step */
-                GUI_Dim_t yBottom = y + height - bb - 1;    /* Bottom Y value */
-                GUI_Dim_t xLeft = x + bl;                   /* Left X position */
-                uint32_t read, write;
+                register GUI_Real_t x1, y1, x2, y2; /* Try to add these variables to core registers */
+                GUI_Real_t xSize = g->VisibleMaxX - g->VisibleMinX; /* Calculate X size */
+                GUI_Real_t ySize = g->VisibleMaxY - g->VisibleMinY; /* Calculate Y size */
+                GUI_Real_t xStep = GUI_REAL_DIV(GUI_REAL_FROM_INT(width - bl - br), xSize); /* Calculate X step */
+                GUI_Real_t yStep = GUI_REAL_DIV(GUI_REAL_FROM_INT(height - bt - bb), ySize);/* calculate Y step */
+                GUI_Real_t yBottom = GUI_REAL_FROM_INT(y + height - bb - 1);    /* Bottom Y value */
+                GUI_Real_t xLeft = GUI_REAL_FROM_INT(x + bl);   /* Left X position */
+                GUI_Real_t clipX1, clipX2;          /* Clipping region in real numbers */
+                GUI_DRAW_Poly_t* points;            /* Points of curve drawn with thick line */
+                uint32_t read, write, count;
                 
                 memcpy(&display, disp, sizeof(GUI_Display_t));  /* Save GUI display data */
                 
@@ -169,6 +191,8 @@ static GUI_iDim_t tX[GUI_TOUCH_MAX_PRESSES], tY[GUI_TOUCH_MAX_PRESSES];
                 if ((y + height - bb) < disp->Y2) {
                     disp->Y2 = y + height - bb;
                 }
+                clipX1 = GUI_REAL_FROM_INT(disp->X1);
+                clipX2 = GUI_REAL_FROM_INT(disp->X2);
                 
                 /* Draw all plot attached to graph */
                 for (link = __GUI_LINKEDLIST_MULTI_GETNEXT_GEN(&g->Root, 0); link; link = __GUI_LINKEDLIST_MULTI_GETNEXT_GEN(0, link)) {
@@ -177,24 +201,37 @@ static GUI_iDim_t tX[GUI_TOUCH_MAX_PRESSES], tY[GUI_TOUCH_MAX_PRESSES];
                     read = data->Ptr;               /* Get start read pointer */
                     write = data->Ptr;              /* Get start write pointer */
                     
+                    points = NULL;
+                    count = 0;
+                    if (data->LineWidth > 1) {      /* Thick curve is drawn at once, thin line is used when there is no memory */
+                        points = (GUI_DRAW_Poly_t *)__GUI_MEMALLOC(data->Length * sizeof(GUI_DRAW_Poly_t), GUI_MEM_TYPE_GRAPH);
+                    }
+                    
                     if (data->Type == GUI_GRAPH_TYPE_YT) {  /* Draw YT plot */
                         /* Calculate first point */
-                        x1 = xLeft - g->VisibleMinX * xStep;/* Calculate start X */
-                        y1 = yBottom - (data->Data[read] - g->VisibleMinY) * yStep;    /* Calculate start Y */
+                        x1 = xLeft - GUI_REAL_MUL(g->VisibleMinX, xStep);   /* Calculate start X */
+                        y1 = yBottom - GUI_REAL_MUL(GUI_REAL_FROM_INT(data->Data[read]) - g->VisibleMinY, yStep);  /* Calculate start Y */
                         if (++read == data->Length) {   /* Check overflow */
                             read = 0;
                         }
                         
                         /* Outside of right || outside on left */
-                        if (x1 > disp->X2 || (x1 + (data->Length * xStep)) < disp->X1) {    /* Plot start is on the right of active area */
+                        if (x1 > clipX2 || (x1 + GUI_REAL_MUL_INT(xStep, data->Length)) < clipX1) {    /* Plot start is on the right of active area */
+                            if (points) {
+                                __GUI_MEMFREE(points);  /* Plot is not drawn, release points memory */
+                            }
                             continue;
                         }
                         
-                        while (read != write && x1 <= disp->X2) {   /* Calculate next points */
+                        while (read != write && x1 <= clipX2) { /* Calculate next points */
                             x2 = x1 + xStep;                /* Calculate next X */
-                            y2 = yBottom - ((float)data->Data[read] - g->VisibleMinY) * yStep;  /* Calculate next Y */
-                            if ((x1 >= disp->X1 || x2 >= disp->X1) && (x1 < disp->X2 || x2 < disp->X2)) {
-                                GUI_DRAW_Line(disp, x1, y1, x2, y2, data->Color);   /* Draw actual line */
+                            y2 = yBottom - GUI_REAL_MUL(GUI_REAL_FROM_INT(data->Data[read]) - g->VisibleMinY, yStep);  /* Calculate next Y */
+                            if ((x1 >= clipX1 || x2 >= clipX1) && (x1 < clipX2 || x2 < clipX2)) {
+                                if (points) {
+                                    __GUI_GRAPH_AddPoint(points, &count, x1, y1, x2, y2);
+                                } else {
+                                    __GUI_GRAPH_DrawLine(disp, data, x1, y1, x2, y2);    /* Draw actual line */
+                                }
                             }
                             x1 = x2, y1 = y2;       /* Copy values as old */
                             
@@ -204,16 +241,20 @@ static GUI_iDim_t tX[GUI_TOUCH_MAX_PRESSES], tY[GUI_TOUCH_MAX_PRESSES];
                         }
                     } else if (data->Type == GUI_GRAPH_TYPE_XY) {   /* Draw XY plot */                        
                         /* Calculate first point */
-                        x1 = xLeft + ((float)data->Data[2 * read + 0] - g->VisibleMinX) * xStep;
-                        y1 = yBottom - ((float)data->Data[2 * read + 1] - g->VisibleMinY) * yStep;
+                        x1 = xLeft + GUI_REAL_MUL(GUI_REAL_FROM_INT(data->Data[2 * read + 0]) - g->VisibleMinX, xStep);
+                        y1 = yBottom - GUI_REAL_MUL(GUI_REAL_FROM_INT(data->Data[2 * read + 1]) - g->VisibleMinY, yStep);
                         if (++read == data->Length) {   /* Check overflow */
                             read = 0;
                         }
                         
                         while (read != write) {     /* Calculate next points */
-                            x2 = xLeft + ((float)(data->Data[2 * read + 0] - g->VisibleMinX) * xStep);
-                            y2 = yBottom - ((float)(data->Data[2 * read + 1] - g->VisibleMinY) * yStep);
-                            GUI_DRAW_Line(disp, x1, y1, x2, y2, data->Color);   /* Draw actual line */
+                            x2 = xLeft + GUI_REAL_MUL(GUI_REAL_FROM_INT(data->Data[2 * read + 0]) - g->VisibleMinX, xStep);
+                            y2 = yBottom - GUI_REAL_MUL(GUI_REAL_FROM_INT(data->Data[2 * read + 1]) - g->VisibleMinY, yStep);
+                            if (points) {
+                                __GUI_GRAPH_AddPoint(points, &count, x1, y1, x2, y2);
+                            } else {
+                                __GUI_GRAPH_DrawLine(disp, data, x1, y1, x2, y2);    /* Draw actual line */
+                            }
                             x1 = x2, y1 = y2;       /* Check overflow */
                             
                             if (++read == data->Length) {   /* Check overflow */
@@ -221,6 +262,10 @@ static GUI_iDim_t tX[GUI_TOUCH_MAX_PRESSES], tY[GUI_TOUCH_MAX_PRESSES];
                             }
                         }
                     }
+                    if (points) {
+                        GUI_DRAW_PolyLine(disp, points, count, data->LineWidth, GUI_DRAW_JOIN_ROUND, data->Color);
+                        __GUI_MEMFREE(points);
+                    }
                 }
                 memcpy(disp, &display, sizeof(GUI_Display_t));  /* Copy data back */
             }
@@ -231,8 +276,8 @@ static GUI_iDim_t tX[GUI_TOUCH_MAX_PRESSES], tY[GUI_TOUCH_MAX_PRESSES];
             __GUI_TouchData_t* ts = (__GUI_TouchData_t *)param;
             uint8_t i = 0;
             for (i = 0; i < ts->TS.Count; i++) {
-                tX[i] = ts->RelX[i];                /* Relative X position on widget */
-                tY[i] = ts->RelY[i];                /* Relative Y position on widget */
+                g->TouchX[i] = ts->RelX[i];         /* Relative X position on widget */
+                g->TouchY[i] = ts->RelY[i];         /* Relative Y position on widget */
             }
             *(__GUI_TouchStatus_t *)result = touchHANDLED;  /* Set touch status */
             return 1;
@@ -241,35 +286,36 @@ static GUI_iDim_t tX[GUI_TOUCH_MAX_PRESSES], tY[GUI_TOUCH_MAX_PRESSES];
             __GUI_TouchData_t* ts = (__GUI_TouchData_t *)param;
             uint8_t i;
             GUI_iDim_t x, y;
-            float diff, step;
+            GUI_Real_t diff, step;
             
             if (ts->TS.Count == 1) {                /* Move graph on single widget */
                 x = ts->RelX[0];
                 y = ts->RelY[0];
                 
-                step = (float)(__GUI_WIDGET_GetWidth(h) - g->Border[GUI_GRAPH_BORDER_LEFT] - g->Border[GUI_GRAPH_BORDER_RIGHT]) / (float)(g->VisibleMaxX - g->VisibleMinX);
-                diff = (float)(x - tX[0]) / step;
+                step = GUI_REAL_DIV(GUI_REAL_FROM_INT(__GUI_WIDGET_GetWidth(h) - g->Border[GUI_GRAPH_BORDER_LEFT] - g->Border[GUI_GRAPH_BORDER_RIGHT]), g->VisibleMaxX - g->VisibleMinX);
+                diff = GUI_REAL_DIV(GUI_REAL_FROM_INT(x - g->TouchX[0]), step);
                 g->VisibleMinX -= diff;
                 g->VisibleMaxX -= diff;
                 
-                step = (float)(__GUI_WIDGET_GetHeight(h) - g->Border[GUI_GRAPH_BORDER_TOP] - g->Border[GUI_GRAPH_BORDER_BOTTOM]) / (float)(g->VisibleMaxY - g->VisibleMinY);
-                diff = (float)(y - tY[0]) / step;
+                step = GUI_REAL_DIV(GUI_REAL_FROM_INT(__GUI_WIDGET_GetHeight(h) - g->Border[GUI_GRAPH_BORDER_TOP] - g->Border[GUI_GRAPH_BORDER_BOTTOM]), g->VisibleMaxY - g->VisibleMinY);
+                diff = GUI_REAL_DIV(GUI_REAL_FROM_INT(y - g->TouchY[0]), step);
                 g->VisibleMinY += diff;
                 g->VisibleMaxY += diff;
 #if GUI_TOUCH_MAX_PRESSES > 1
-            } else if (ts->TS.Count == 2) {         /* Scale widget on multiple widgets */
-                float centerX, centerY, zoom;
+            } else if (ts->TS.Count == 2 && ts->DistanceOld > 0) {  /* Scale widget on multiple widgets */
+                GUI_Real_t centerX, centerY, zoom;
                 
-                GUI_MATH_CenterOfXY(ts->RelX[0], ts->RelY[0], ts->RelX[1], ts->RelY[1], &centerX, &centerY);    /* Calculate center position between points */
-                zoom = ts->Distance / ts->DistanceOld;  /* Calculate zoom value */
+                centerX = GUI_REAL_FROM_INT(ts->RelX[0] + ts->RelX[1]) / 2; /* Calculate center position between points */
+                centerY = GUI_REAL_FROM_INT(ts->RelY[0] + ts->RelY[1]) / 2;
+                zoom = GUI_REAL_DIV(ts->Distance, ts->DistanceOld); /* Calculate zoom value */
                 
-                __GUI_GRAPH_Zoom(h, zoom, (float)centerX / (float)__GUI_WIDGET_GetWidth(h), (float)centerY / (float)__GUI_WIDGET_GetHeight(h));
+                __GUI_GRAPH_Zoom(h, zoom, GUI_REAL_DIV(centerX, GUI_REAL_FROM_INT(__GUI_WIDGET_GetWidth(h))), GUI_REAL_DIV(centerY, GUI_REAL_FROM_INT(__GUI_WIDGET_GetHeight(h))));
 #endif /* GUI_TOUCH_MAX_PRESSES > 1 */
             }
             
             for (i = 0; i < ts->TS.Count; i++) {
-                tX[i] = ts->RelX[i];                /* Relative X position on widget */
-                tY[i] = ts->RelY[i];                /* Relative Y position on widget */
+                g->TouchX[i] = ts->RelX[i];         /* Relative X position on widget */
+                g->TouchY[i] = ts->RelY[i];         /* Relative Y position on widget */
             }
             
             __GUI_WIDGET_Invalidate(h);
@@ -282,6 +328,10 @@ static GUI_iDim_t tX[GUI_TOUCH_MAX_PRESSES], tY[GUI_TOUCH_MAX_PRESSES];
             __GUI_GRAPH_Reset(h);                   /* Reset zoom */
             __GUI_WIDGET_Invalidate(h);             /* Invalidate widget */
             return 1;
+        case GUI_WC_Restore: {                      /* Data objects are not part of snapshot */
+            memset(&g->Root, 0x00, sizeof(g->Root));
+            return 1;
+        }
 #if GUI_WIDGET_GRAPH_DATA_AUTO_INVALIDATE
         case GUI_WC_Remove: {                       /* When widget is about to be removed */
             GUI_GRAPH_DATA_p data;
@@ -290,9 +340,10 @@ static GUI_iDim_t tX[GUI_TOUCH_MAX_PRESSES], tY[GUI_TOUCH_MAX_PRESSES];
             /**
              * Go through all data objects in this widget
              */
-            for (link = __GUI_LINKEDLIST_MULTI_GETNEXT_GEN(&g->Root, NULL); link; link = __GUI_LINKEDLIST_MULTI_GETNEXT_GEN(0, link)) {
+            while ((link = __GUI_LINKEDLIST_MULTI_GETNEXT_GEN(&g->Root, NULL)) != NULL) {
                 data = (GUI_GRAPH_DATA_p)__GUI_LINKEDLIST_MULTI_GetData(link);  /* Get data from list */
                 __GUI_LINKEDLIST_MULTI_FIND_REMOVE(&data->Root, h); /* Remove element from linked list with search */
+                __GUI_LINKEDLIST_MULTI_REMOVE_GEN(&g->Root, link);  /* Release link to data */
             }
             
             return 1;
@@ -344,10 +395,10 @@ GUI_HANDLE_p GUI_GRAPH_Create(GUI_ID_t id, GUI_iDim_t x, GUI_iDim_t y, GUI_Dim_t
         ptr->Border[GUI_GRAPH_BORDER_BOTTOM] = 5;
         ptr->Border[GUI_GRAPH_BORDER_LEFT] = 5;
         
-        ptr->MaxX = 10;
-        ptr->MinX = -10;
-        ptr->MaxY = 10;
-        ptr->MinY = -20;
+        ptr->MaxX = GUI_REAL_FROM_INT(10);
+        ptr->MinX = GUI_REAL_FROM_INT(-10);
+        ptr->MaxY = GUI_REAL_FROM_INT(10);
+        ptr->MinY = GUI_REAL_FROM_INT(-20);
         __GUI_GRAPH_Reset((GUI_HANDLE_p)ptr);       /* Reset plot */
         
         ptr->Rows = 8;                              /* Number of rows */
@@ -415,11 +466,13 @@ uint8_t GUI_GRAPH_DetachData(GUI_HANDLE_p h, GUI_GRAPH_DATA_p data) {
 }
 
 uint8_t GUI_GRAPH_SetMinX(GUI_HANDLE_p h, float v) {
+    GUI_Real_t val = GUI_REAL_FROM_FLOAT(v);
+    
     __GUI_ASSERTPARAMS(h && __GH(h)->Widget == &Widget);    /* Check input parameters */
     __GUI_ENTER();                                  /* Enter GUI */
     
-    if (__GG(h)->MinX != v) {
-        __GG(h)->MinX = v;                          /* Set new parameter */
+    if (__GG(h)->MinX != val) {
+        __GG(h)->MinX = val;                        /* Set new parameter */
         __GUI_WIDGET_Invalidate(h);                 /* Invalidate widget */
     }
     
@@ -428,11 +481,13 @@ uint8_t GUI_GRAPH_SetMinX(GUI_HANDLE_p h, float v) {
 }
 
 uint8_t GUI_GRAPH_SetMaxX(GUI_HANDLE_p h, float v) {
+    GUI_Real_t val = GUI_REAL_FROM_FLOAT(v);
+    
     __GUI_ASSERTPARAMS(h && __GH(h)->Widget == &Widget);    /* Check input parameters */
     __GUI_ENTER();                                  /* Enter GUI */
     
-    if (__GG(h)->MaxX != v) {
-        __GG(h)->MaxX = v;                          /* Set new parameter */
+    if (__GG(h)->MaxX != val) {
+        __GG(h)->MaxX = val;                        /* Set new parameter */
         __GUI_WIDGET_Invalidate(h);                 /* Invalidate widget */
     }
     
@@ -441,11 +496,13 @@ uint8_t GUI_GRAPH_SetMaxX(GUI_HANDLE_p h, float v) {
 }
 
 uint8_t GUI_GRAPH_SetMinY(GUI_HANDLE_p h, float v) {
+    GUI_Real_t val = GUI_REAL_FROM_FLOAT(v);
+    
     __GUI_ASSERTPARAMS(h && __GH(h)->Widget == &Widget);    /* Check input parameters */
     __GUI_ENTER();                                  /* Enter GUI */
     
-    if (__GG(h)->MinY != v) {
-        __GG(h)->MinY = v;                          /* Set new parameter */
+    if (__GG(h)->MinY != val) {
+        __GG(h)->MinY = val;                        /* Set new parameter */
         __GUI_WIDGET_Invalidate(h);                 /* Invalidate widget */
     }
     
@@ -454,11 +511,13 @@ uint8_t GUI_GRAPH_SetMinY(GUI_HANDLE_p h, float v) {
 }
 
 uint8_t GUI_GRAPH_SetMaxY(GUI_HANDLE_p h, float v) {
+    GUI_Real_t val = GUI_REAL_FROM_FLOAT(v);
+    
     __GUI_ASSERTPARAMS(h && __GH(h)->Widget == &Widget);    /* Check input parameters */
     __GUI_ENTER();                                  /* Enter GUI */
     
-    if (__GG(h)->MaxY != v) {
-        __GG(h)->MaxY = v;                          /* Set new parameter */
+    if (__GG(h)->MaxY != val) {
+        __GG(h)->MaxY = val;                        /* Set new parameter */
         __GUI_WIDGET_Invalidate(h);                 /* Invalidate widget */
     }
     
@@ -481,7 +540,7 @@ uint8_t GUI_GRAPH_Zoom(GUI_HANDLE_p h, float zoom, float x, float y) {
     __GUI_ASSERTPARAMS(h && __GH(h)->Widget == &Widget);    /* Check input parameters */
     __GUI_ENTER();                                  /* Enter GUI */
     
-    __GUI_GRAPH_Zoom(h, zoom, x, y);                /* Reset zoom */
+    __GUI_GRAPH_Zoom(h, GUI_REAL_FROM_FLOAT(zoom), GUI_REAL_FROM_FLOAT(x), GUI_REAL_FROM_FLOAT(y));  /* Zoom plot */
     
     __GUI_LEAVE();                                  /* Leave GUI */
     return 1;
@@ -494,19 +553,19 @@ GUI_GRAPH_DATA_p GUI_GRAPH_DATA_Create(GUI_GRAPH_TYPE_t type, uint16_t length) {
     GUI_GRAPH_DATA_p data;
     __GUI_ENTER();                                  /* Enter GUI */
 
-    data = (GUI_GRAPH_DATA_p)__GUI_MEMALLOC(sizeof(GUI_GRAPH_DATA_t));  /* Allocate memory for basic widget */
+    data = (GUI_GRAPH_DATA_p)__GUI_MEMALLOC(sizeof(GUI_GRAPH_DATA_t), GUI_MEM_TYPE_GRAPH);  /* Allocate memory for basic widget */
     if (data) {
         memset((void *)data, 0x00, sizeof(GUI_GRAPH_DATA_t));   /* Reset memory */
         
         data->Type = type;
         data->Length = length;
         if (type == GUI_GRAPH_TYPE_YT) {            /* Only Y values are stored */
-            data->Data = __GUI_MEMALLOC(length * sizeof(int16_t));
+            data->Data = __GUI_MEMALLOC(length * sizeof(int16_t), GUI_MEM_TYPE_GRAPH);
             if (data->Data) {
                 memset(data->Data, 0x00, length * sizeof(int16_t));
             }
         } else {
-            data->Data = __GUI_MEMALLOC(length * 2 * sizeof(int16_t));  /* Store X and Y value for plot */
+            data->Data = __GUI_MEMALLOC(length * 2 * sizeof(int16_t), GUI_MEM_TYPE_GRAPH);  /* Store X and Y value for plot */
             if (data->Data) {
                 memset(data->Data, 0x00, length * 2 * sizeof(int16_t));
             }
@@ -543,3 +602,34 @@ uint8_t GUI_GRAPH_DATA_AddValue(GUI_GRAPH_DATA_p data, int16_t x, int16_t y) {
     __GUI_LEAVE();                                  /* Leave GUI */
     return 1;
 }
+
+uint8_t GUI_GRAPH_DATA_SetLineWidth(GUI_GRAPH_DATA_p data, GUI_Dim_t width) {
+    __GUI_ASSERTPARAMS(data);                       /* Check input parameters */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    if (data->LineWidth != width) {
+        data->LineWidth = width;                    /* Set new width */
+#if GUI_WIDGET_GRAPH_DATA_AUTO_INVALIDATE
+        InvalidateGraphs(data);                     /* Invalidate graphs attached to this data object */
+#endif /* GUI_WIDGET_GRAPH_DATA_AUTO_INVALIDATE */
+    }
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return 1;
+}
+
+uint8_t GUI_GRAPH_DATA_SetAntiAlias(GUI_GRAPH_DATA_p data, uint8_t aa) {
+    __GUI_ASSERTPARAMS(data);                       /* Check input parameters */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    aa = aa ? 1 : 0;
+    if (data->AntiAlias != aa) {
+        data->AntiAlias = aa;                       /* Set new anti-alias mode */
+#if GUI_WIDGET_GRAPH_DATA_AUTO_INVALIDATE
+        InvalidateGraphs(data);                     /* Invalidate graphs attached to this data object */
+#endif /* GUI_WIDGET_GRAPH_DATA_AUTO_INVALIDATE */
+    }
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return 1;
+}
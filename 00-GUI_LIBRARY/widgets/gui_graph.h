@@ -90,6 +90,8 @@ typedef struct GUI_GRAPH_DATA_p {
     uint32_t Ptr;                           /*!< Read/Write start pointer */
     
     GUI_Color_t Color;                      /*!< Curve color */
+    GUI_Dim_t LineWidth;                    /*!< Curve line width in units of pixels, thin line is used for 0 and 1 */
+    uint8_t AntiAlias;                      /*!< Thin curve is drawn with anti-aliased line when set to 1 */
     GUI_GRAPH_TYPE_t Type;                  /*!< Plot data type */
 } GUI_GRAPH_DATA_t;
 
@@ -106,14 +108,18 @@ typedef struct GUI_GRAPH_t {
     GUI_Dim_t Border[4];                    /*!< Borders for widgets */
     uint8_t Rows;                           /*!< Number of rows in plot represented with lines */
     uint8_t Columns;                        /*!< Number of columns in plot represented with lines */
-    float MinX;                             /*!< Minimal X value for plot */
-    float MaxX;                             /*!< Maximal X value for plot */
-    float MinY;                             /*!< Minimal Y value for plot */
-    float MaxY;                             /*!< Maximal Y value for plot */
-    float VisibleMinX;                      /*!< Visible minimal X value for plot */
-    float VisibleMaxX;                      /*!< Visible maximal X value for plot */
-    float VisibleMinY;                      /*!< Visible minimal Y value for plot */
-    float VisibleMaxY;                      /*!< Visible maximal Y value for plot */
+    GUI_Real_t MinX;                        /*!< Minimal X value for plot */
+    GUI_Real_t MaxX;                        /*!< Maximal X value for plot */
+    GUI_Real_t MinY;                        /*!< Minimal Y value for plot */
+    GUI_Real_t MaxY;                        /*!< Maximal Y value for plot */
+    GUI_Real_t VisibleMinX;                 /*!< Visible minimal X value for plot */
+    GUI_Real_t VisibleMaxX;                 /*!< Visible maximal X value for plot */
+    GUI_Real_t VisibleMinY;                 /*!< Visible minimal Y value for plot */
+    GUI_Real_t VisibleMaxY;                 /*!< Visible maximal Y value for plot */
+#if GUI_USE_TOUCH || defined(DOXYGEN)
+    GUI_iDim_t TouchX[GUI_TOUCH_MAX_PRESSES];   /*!< Last relative touch X positions for move and zoom */
+    GUI_iDim_t TouchY[GUI_TOUCH_MAX_PRESSES];   /*!< Last relative touch Y positions for move and zoom */
+#endif /* GUI_USE_TOUCH || defined(DOXYGEN) */
 } GUI_GRAPH_t;
 #endif /* defined(GUI_INTERNAL) || defined(DOXYGEN) */
 
@@ -248,6 +254,28 @@ GUI_GRAPH_DATA_p GUI_GRAPH_DATA_Create(GUI_GRAPH_TYPE_t type, uint16_t length);
  * \retval          0: Value was not added to data object
  */
 uint8_t GUI_GRAPH_DATA_AddValue(GUI_GRAPH_DATA_p data, int16_t x, int16_t y);
+
+/**
+ * \brief           Set line width of data curve
+ * \note            Curves wider than 1 pixel are drawn with round joins between points and need
+ *                  temporary memory for points during drawing, thin line is drawn when memory is not available
+ * \param[in]       data: Data object handle
+ * \param[in]       width: Line width in units of pixels
+ * \retval          1: Line width was set ok
+ * \retval          0: Line width was not set
+ */
+uint8_t GUI_GRAPH_DATA_SetLineWidth(GUI_GRAPH_DATA_p data, GUI_Dim_t width);
+
+/**
+ * \brief           Enable or disable anti-aliased drawing of thin data curve
+ * \note            Anti-aliased line is about 3 times slower than normal line and is disabled by default.
+ *                  It is not used for curves wider than 1 pixel
+ * \param[in]       data: Data object handle
+ * \param[in]       aa: Set to 1 to enable anti-aliased curve or 0 to disable it
+ * \retval          1: Anti-alias mode was set ok
+ * \retval          0: Anti-alias mode was not set
+ */
+uint8_t GUI_GRAPH_DATA_SetAntiAlias(GUI_GRAPH_DATA_p data, uint8_t aa);
  
 /**
  * \}
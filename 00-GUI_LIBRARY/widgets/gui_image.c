@@ -0,0 +1,396 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2017 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#define GUI_INTERNAL
+#include "gui_image.h"
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private structures                            **/
+/******************************************************************************/
+/******************************************************************************/
+/**
+ * \brief           State of image loaded in background
+ */
+typedef struct GUI_IMAGE_LOAD_t {
+    GUI_HANDLE_p h;                         /*!< Widget handle */
+    GUI_JOB_t* Job;                         /*!< Background job */
+    uint32_t Offset;                        /*!< Offset of next byte to read */
+    GUI_Byte* Buff;                         /*!< Buffer for current read */
+    uint32_t Len;                           /*!< Number of bytes of current read */
+    GUI_IMGDEC_t Dec;                       /*!< Decoder for compressed images */
+    GUI_Byte* In;                           /*!< Buffer for compressed data */
+    uint32_t InLen;                         /*!< Number of bytes in compressed data buffer */
+    uint32_t InSize;                        /*!< Size of compressed data buffer */
+    uint8_t Started;                        /*!< Decoder is initialized */
+} GUI_IMAGE_LOAD_t;
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private definitions                           **/
+/******************************************************************************/
+/******************************************************************************/
+#define __GI(x)             ((GUI_IMAGE_t *)(x))
+#define __HEADER_SIZE       14                      /* Bytes needed to initialize decoder, size of QOI header */
+
+static
+uint8_t GUI_IMAGE_Callback(GUI_HANDLE_p h, GUI_WC_t ctrl, void* param, void* result);
+    
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private variables                            **/
+/******************************************************************************/
+/******************************************************************************/
+const static GUI_Color_t Colors[] = {
+    GUI_COLOR_BLACK,                                /*!< Default color for alpha only images */
+    GUI_COLOR_LIGHTGRAY,                            /*!< Default color for part of image not loaded yet */
+};
+
+const static GUI_WIDGET_t Widget = {
+    .Name = _T("IMAGE"),                            /*!< Widget name */ 
+    .Size = sizeof(GUI_IMAGE_t),                    /*!< Size of widget for memory allocation */
+    .Flags = 0,                                     /*!< List of widget flags */
+    .Callback = GUI_IMAGE_Callback,                 /*!< Control function */
+    .Colors = Colors,                               /*!< List of default colors */
+    .ColorsCount = GUI_COUNT_OF(Colors),            /*!< Number of colors */
+};
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private functions                            **/
+/******************************************************************************/
+/******************************************************************************/
+/* Get number of bytes for single line of image */
+static
+uint32_t __GetLineSize(const GUI_IMAGE_DESC_t* img) {
+    switch (img->Format) {
+        case GUI_IMAGE_FORMAT_RGB565:   return (uint32_t)img->Width * 2;
+        case GUI_IMAGE_FORMAT_L8:
+        case GUI_IMAGE_FORMAT_A8:       return (uint32_t)img->Width;
+        case GUI_IMAGE_FORMAT_A4:       return ((uint32_t)img->Width + 1) / 2;
+        default:                        return (uint32_t)img->Width * 4;    /* Compressed images are decoded to ARGB8888 */
+    }
+}
+
+/* Stop loading and release loading state */
+static
+void __StopLoad(GUI_IMAGE_t* img) {
+    GUI_IMAGE_LOAD_t* l = img->Load;
+    
+    if (l) {
+        if (l->Job) {
+            __GUI_JOB_Remove(&l->Job);              /* Job is not called anymore */
+        }
+        if (l->In) {
+            __GUI_MEMFREE(l->In);
+        }
+        __GUI_MEMFREE(img->Load);
+    }
+}
+
+/* Release memory of loaded image */
+static
+void __FreeImage(GUI_IMAGE_t* img) {
+    GUI_Byte* data = (GUI_Byte *)img->Loaded.Data;
+    
+    __StopLoad(img);
+#if GUI_USE_IMAGE_CACHE
+    GUI_DRAW_ImageCacheRemove(&img->Loaded);        /* Converted image is not valid anymore */
+#endif /* GUI_USE_IMAGE_CACHE */
+    if (data) {
+        __GUI_MEMFREE(data);
+    }
+    memset(&img->Loaded, 0x00, sizeof(img->Loaded));
+}
+
+/* Prepare next read from storage */
+static
+void __LoadRequest(GUI_IMAGE_t* img, GUI_IMAGE_LOAD_t* l) {
+    const GUI_IMAGE_DESC_t* desc = img->Image;
+    uint32_t lineSize = __GetLineSize(desc), consumed, total;
+    
+    if (!GUI_IMGDEC_IsCompressed(desc->Format)) {   /* Read complete lines directly to image memory */
+        total = lineSize * (uint32_t)desc->Height;
+        l->Buff = (GUI_Byte *)img->Loaded.Data + l->Offset;
+        l->Len = __GUI_MAX(GUI_IMAGE_LOAD_CHUNK / lineSize, 1) * lineSize;
+        l->Len = __GUI_MIN(l->Len, total - l->Offset);
+        return;
+    }
+    
+    consumed = l->Started ? GUI_IMGDEC_GetConsumed(&l->Dec, l->In) : 0;
+    if (consumed) {                                 /* Move not decoded data to beginning */
+        l->InLen -= consumed;
+        memmove(l->In, l->In + consumed, l->InLen);
+        GUI_IMGDEC_SetInput(&l->Dec, l->In, l->InLen);
+    }
+    l->Buff = l->In + l->InLen;
+    l->Len = 0;
+    if (l->InLen < GUI_IMGDEC_MAX_BYTES(desc->Width) && l->Offset < desc->Size) {   /* Not enough data for next line */
+        l->Len = __GUI_MIN(l->InSize - l->InLen, desc->Size - l->Offset);
+    }
+}
+
+/* Process read data, returns 0 when image data are not valid */
+static
+uint8_t __LoadProcess(GUI_IMAGE_t* img, GUI_IMAGE_LOAD_t* l, uint32_t len) {
+    const GUI_IMAGE_DESC_t* desc = img->Image;
+    uint32_t lineSize = __GetLineSize(desc), lines;
+    
+    l->Offset += len;
+    if (!GUI_IMGDEC_IsCompressed(desc->Format)) {
+        img->Loaded.Height = (GUI_Dim_t)__GUI_MIN(l->Offset / lineSize, (uint32_t)desc->Height);
+        return 1;
+    }
+    
+    l->InLen += len;
+    if (!l->Started) {                              /* Initialize decoder with image header */
+        GUI_IMAGE_DESC_t tmp;
+        if (l->InLen < __HEADER_SIZE && l->Offset < desc->Size) {
+            return 1;                               /* Wait for complete header */
+        }
+        memcpy(&tmp, desc, sizeof(tmp));
+        tmp.Data = l->In;
+        if (!GUI_IMGDEC_Init(&l->Dec, &tmp)) {
+            return 0;
+        }
+        l->Started = 1;
+    }
+    GUI_IMGDEC_SetInput(&l->Dec, l->Dec.Ptr, (uint32_t)(l->In + l->InLen - l->Dec.Ptr));  /* Include new data */
+    
+    /* Decode lines with enough data available */
+    lines = __GUI_MAX(GUI_IMAGE_LOAD_CHUNK / lineSize, 1);
+    while (lines-- && img->Loaded.Height < desc->Height &&
+        ((l->InLen - GUI_IMGDEC_GetConsumed(&l->Dec, l->In)) >= GUI_IMGDEC_MAX_BYTES(desc->Width) || l->Offset >= desc->Size)) {
+        if (!GUI_IMGDEC_Read(&l->Dec, (GUI_Color_t *)(img->Loaded.Data + img->Loaded.Height * lineSize), desc->Width)) {
+            return 0;
+        }
+        img->Loaded.Height++;
+    }
+    return 1;
+}
+
+/* Background job to load image from storage */
+static
+PT_THREAD(__LoadJob(GUI_JOB_t* job)) {
+    GUI_IMAGE_LOAD_t* l = (GUI_IMAGE_LOAD_t *)GUI_JOB_GetParams(job);
+    GUI_HANDLE_p h = l->h;
+    GUI_IMAGE_t* img = (GUI_IMAGE_t *)h;
+    GUI_Dim_t lines = img->Loaded.Height;
+    int32_t r = 0;
+    
+    PT_BEGIN(&job->pt);
+    
+    while (img->Loaded.Height < img->Image->Height) {
+        __LoadRequest(img, l);                      /* Prepare next read */
+        if (l->Len) {
+            PT_WAIT_UNTIL(&job->pt, (r = img->Read(img->ReadParam, l->Offset, l->Buff, l->Len)) != 0);
+            if (r < 0 || (uint32_t)r > l->Len) {    /* Read failed */
+                break;
+            }
+        } else {
+            r = 0;
+        }
+        if (!__LoadProcess(img, l, (uint32_t)r)) {  /* Image data are not valid */
+            break;
+        }
+        if (img->Loaded.Height != lines) {          /* Show new lines */
+#if GUI_USE_IMAGE_CACHE
+            GUI_DRAW_ImageCacheRemove(&img->Loaded);
+#endif /* GUI_USE_IMAGE_CACHE */
+            __GUI_WIDGET_InvalidateRect(h, 0, lines, img->Image->Width, img->Loaded.Height - lines);
+        } else if (!r) {                            /* No progress is possible */
+            break;
+        }
+        PT_YIELD(&job->pt);                         /* Give time to other jobs and GUI */
+    }
+    
+    /* Loading finished, remove placeholder of lines not loaded */
+    __GUI_WIDGET_InvalidateRect(h, 0, img->Loaded.Height, img->Image->Width, img->Image->Height - img->Loaded.Height);
+    __StopLoad(img);                                /* Job memory is released after exit */
+    PT_EXIT(&job->pt);
+    
+    PT_END(&job->pt);
+}
+
+/* Allocate image memory and start loading */
+static
+uint8_t __StartLoad(GUI_IMAGE_t* img) {
+    const GUI_IMAGE_DESC_t* desc = img->Image;
+    GUI_IMAGE_LOAD_t* l;
+    uint32_t lineSize = __GetLineSize(desc);
+    
+    memcpy(&img->Loaded, desc, sizeof(img->Loaded));
+    img->Loaded.Height = 0;
+    img->Loaded.Data = 0;
+    if (GUI_IMGDEC_IsCompressed(desc->Format)) {
+        img->Loaded.Format = GUI_IMAGE_FORMAT_ARGB8888;
+    }
+    img->Loaded.Size = lineSize * (uint32_t)desc->Height;
+    
+    l = (GUI_IMAGE_LOAD_t *)__GUI_MEMALLOC(sizeof(*l), GUI_MEM_TYPE_IMAGE);
+    img->Loaded.Data = (GUI_Byte *)__GUI_MEMALLOC(img->Loaded.Size, GUI_MEM_TYPE_IMAGE);
+    if (!l || !img->Loaded.Data) {
+        if (l) {
+            __GUI_MEMFREE(l);
+        }
+        __FreeImage(img);
+        return 0;
+    }
+    memset(l, 0x00, sizeof(*l));
+    l->h = (GUI_HANDLE_p)img;
+    img->Load = l;
+    if (GUI_IMGDEC_IsCompressed(desc->Format)) {    /* Buffer for compressed data */
+        l->InSize = GUI_IMGDEC_MAX_BYTES(desc->Width) + GUI_IMAGE_LOAD_CHUNK;
+        l->In = (GUI_Byte *)__GUI_MEMALLOC(l->InSize, GUI_MEM_TYPE_IMAGE);
+    }
+    if ((GUI_IMGDEC_IsCompressed(desc->Format) && !l->In) ||
+        !__GUI_JOB_Create(__LoadJob, l, &l->Job)) {
+        __FreeImage(img);
+        return 0;
+    }
+    return 1;
+}
+
+#define i           ((GUI_IMAGE_t *)h)
+static
+uint8_t GUI_IMAGE_Callback(GUI_HANDLE_p h, GUI_WC_t ctrl, void* param, void* result) {
+    __GUI_ASSERTPARAMS(h && __GH(h)->Widget == &Widget);    /* Check input parameters */
+    switch (ctrl) {                                 /* Handle control function if required */
+        case GUI_WC_Draw: {
+            GUI_Display_t* disp = (GUI_Display_t *)param;
+            GUI_Dim_t x, y;
+            
+            if (i->Image) {                         /* Draw only when source is set */
+                x = __GUI_WIDGET_GetAbsoluteX(h);   /* Get absolute position on screen */
+                y = __GUI_WIDGET_GetAbsoluteY(h);   /* Get absolute position on screen */
+                
+                if (!i->Read) {
+                    GUI_DRAW_Image(disp, x, y, i->Image, __GUI_WIDGET_GetColor(h, GUI_IMAGE_COLOR_FG));
+                } else {                            /* Draw loaded part of image */
+                    if (i->Loaded.Data && i->Loaded.Height) {
+                        GUI_DRAW_Image(disp, x, y, &i->Loaded, __GUI_WIDGET_GetColor(h, GUI_IMAGE_COLOR_FG));
+                    }
+                    if (i->Load) {                  /* Draw placeholder instead of remaining lines */
+                        GUI_DRAW_FilledRectangle(disp, x, y + i->Loaded.Height, i->Image->Width, i->Image->Height - i->Loaded.Height, __GUI_WIDGET_GetColor(h, GUI_IMAGE_COLOR_PLACEHOLDER));
+                    }
+                }
+            }
+            return 1;
+        }
+        case GUI_WC_Restore: {                      /* Image memory is not part of snapshot */
+            i->Load = 0;
+            i->Loaded.Data = 0;
+            if (i->Image && i->Read) {
+                __StartLoad(i);                     /* Load image again */
+            }
+            return 1;
+        }
+        case GUI_WC_Remove: {                       /* When widget is about to be removed */
+            __FreeImage(i);                         /* Stop loading and free image memory */
+            return 1;
+        }
+        default:                                    /* Handle default option */
+            __GUI_UNUSED3(h, param, result);        /* Unused elements to prevent compiler warnings */
+            return 0;                               /* Command was not processed */
+    }
+}
+#undef i
+
+/******************************************************************************/
+/******************************************************************************/
+/***                                Public API                               **/
+/******************************************************************************/
+/******************************************************************************/
+GUI_HANDLE_p GUI_IMAGE_Create(GUI_ID_t id, GUI_iDim_t x, GUI_iDim_t y, GUI_Dim_t width, GUI_Dim_t height, GUI_HANDLE_p parent, GUI_WIDGET_CALLBACK_t cb, uint16_t flags) {
+    GUI_IMAGE_t* ptr;
+    
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    ptr = (GUI_IMAGE_t *)__GUI_WIDGET_Create(&Widget, id, x, y, width, height, parent, cb, flags);    /* Allocate memory for basic widget */
+
+    __GUI_LEAVE();                                  /* Leave GUI */
+    
+    return (GUI_HANDLE_p)ptr;
+}
+
+uint8_t GUI_IMAGE_SetColor(GUI_HANDLE_p h, GUI_IMAGE_COLOR_t index, GUI_Color_t color) {
+    uint8_t ret;
+    
+    __GUI_ASSERTPARAMS(h && __GH(h)->Widget == &Widget);    /* Check input parameters */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    ret = __GUI_WIDGET_SetColor(h, (uint8_t)index, color);  /* Set color */
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return ret;
+}
+
+uint8_t GUI_IMAGE_SetSource(GUI_HANDLE_p h, const GUI_IMAGE_DESC_t* img) {
+    __GUI_ASSERTPARAMS(h && __GH(h)->Widget == &Widget);    /* Check input parameters */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    if (__GI(h)->Image != img || __GI(h)->Read) {   /* Any parameter changed */
+        __FreeImage(__GI(h));                       /* Stop loading previous image */
+        __GI(h)->Read = 0;
+        __GI(h)->Image = img;                       /* Set parameter */
+        __GUI_WIDGET_InvalidateWithParent(h);       /* Redraw object with parent as image may be transparent */
+    }
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return 1;
+}
+
+uint8_t GUI_IMAGE_SetSourceAsync(GUI_HANDLE_p h, const GUI_IMAGE_DESC_t* img, GUI_IMAGE_Read_t read, void* param) {
+    uint8_t ret;
+    
+    __GUI_ASSERTPARAMS(h && __GH(h)->Widget == &Widget && img && read && img->Width && img->Height);   /* Check input parameters */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    __FreeImage(__GI(h));                           /* Stop loading previous image */
+    __GI(h)->Image = img;                           /* Set parameters */
+    __GI(h)->Read = read;
+    __GI(h)->ReadParam = param;
+    ret = __StartLoad(__GI(h));                     /* Start loading in background */
+    if (!ret) {
+        __GI(h)->Image = 0;
+        __GI(h)->Read = 0;
+    }
+    __GUI_WIDGET_InvalidateWithParent(h);           /* Redraw object with parent as image may be transparent */
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return ret;
+}
+
+uint8_t GUI_IMAGE_IsLoading(GUI_HANDLE_p h) {
+    uint8_t ret;
+    
+    __GUI_ASSERTPARAMS(h && __GH(h)->Widget == &Widget);    /* Check input parameters */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    ret = __GI(h)->Load != 0;
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return ret;
+}
@@ -0,0 +1,168 @@
+/**
+ * \author  Tilen Majerle <tilen@majerle.eu>
+ * \brief   GUI image widget
+ *	
+\verbatim
+   ----------------------------------------------------------------------
+    Copyright (c) 2017 Tilen Majerle
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge,
+    publish, distribute, sublicense, and/or sell copies of the Software, 
+    and to permit persons to whom the Software is furnished to do so, 
+    subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+    AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+   ----------------------------------------------------------------------
+\endverbatim
+ */
+#ifndef GUI_IMAGE_H
+#define GUI_IMAGE_H
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup      GUI_WIDGETS
+ * \{
+ */
+#include "gui_widget.h"
+
+/**
+ * \defgroup        GUI_IMAGE Image
+ * \brief           Static image display
+ * \{
+ */
+
+/**
+ * \brief           List of available colors for image
+ */
+typedef enum GUI_IMAGE_COLOR_t {
+    GUI_IMAGE_COLOR_FG = 0x00,              /*!< Color index for \ref GUI_IMAGE_FORMAT_A8 and \ref GUI_IMAGE_FORMAT_A4 images */
+    GUI_IMAGE_COLOR_PLACEHOLDER,            /*!< Color index for part of image not loaded yet */
+} GUI_IMAGE_COLOR_t;
+
+/**
+ * \brief           Function to read image data from storage, such as SD card or external flash
+ *
+ *                  Function is called repeatedly with the same parameters until it returns non-zero value,
+ *                  which allows to start transfer on first call and check for completion on next calls
+ *                  without blocking GUI processing
+ *
+ * \note            Buffer is valid only during function call, data must be copied to buffer when read is completed
+ * \param[in]       param: User parameter from \ref GUI_IMAGE_SetSourceAsync
+ * \param[in]       offset: Offset of first byte to read, relative to start of image data
+ * \param[out]      buff: Buffer to copy read data to
+ * \param[in]       len: Number of bytes to read
+ * \retval          > 0: Read completed, number of bytes copied to buffer
+ * \retval          0: Read is in progress
+ * \retval          < 0: Read failed, loading is stopped
+ */
+typedef int32_t (*GUI_IMAGE_Read_t)(void* param, uint32_t offset, void* buff, uint32_t len);
+
+#if defined(GUI_INTERNAL) || defined(DOXYGEN)
+
+/**
+ * \brief           Image object structure
+ */
+typedef struct GUI_IMAGE_t {
+    GUI_HANDLE C;                           /*!< Global widget object */
+    
+    const GUI_IMAGE_DESC_t* Image;          /*!< Pointer to image descriptor to draw */
+    
+    GUI_IMAGE_Read_t Read;                  /*!< Function to read image from storage, image descriptor describes stored data */
+    void* ReadParam;                        /*!< User parameter for read function */
+    GUI_IMAGE_DESC_t Loaded;                /*!< Image in memory, height is number of loaded lines */
+    struct GUI_IMAGE_LOAD_t* Load;          /*!< Loading state when image is being loaded */
+} GUI_IMAGE_t;
+#endif /* defined(GUI_INTERNAL) || defined(DOXYGEN) */
+
+/**
+ * \brief           Create new image widget
+ * \param[in]       id: Widget unique ID to use for identity for callback processing
+ * \param[in]       x: Widget X position relative to parent widget
+ * \param[in]       y: Widget Y position relative to parent widget
+ * \param[in]       width: Widget width in units of pixels
+ * \param[in]       height: Widget height in uints of pixels
+ * \param[in]       parent: Parent widget handle. Set to NULL to use current active parent widget
+ * \param[in]       cb: Pointer to \ref GUI_WIDGET_CALLBACK_t callback function. Set to NULL to use default widget callback
+ * \param[in]       flags: Flags for widget creation
+ * \retval          > 0: \ref GUI_HANDLE_p object of created widget
+ * \retval          0: Widget creation failed
+ */
+GUI_HANDLE_p GUI_IMAGE_Create(GUI_ID_t id, GUI_iDim_t x, GUI_iDim_t y, GUI_Dim_t width, GUI_Dim_t height, GUI_HANDLE_p parent, GUI_WIDGET_CALLBACK_t cb, uint16_t flags);
+
+/**
+ * \brief           Set color to specific part of widget
+ * \param[in,out]   h: Widget handle
+ * \param[in]       index: Color index. This parameter can be a value of \ref GUI_IMAGE_COLOR_t enumeration
+ * \param[in]       color: Color value
+ * \retval          1: Color was set ok
+ * \retval          0: Color was not set
+ */
+uint8_t GUI_IMAGE_SetColor(GUI_HANDLE_p h, GUI_IMAGE_COLOR_t index, GUI_Color_t color);
+
+/**
+ * \brief           Set image to display
+ * \note            Image descriptor and its data must stay valid while widget uses it
+ * \param[in,out]   h: Widget handle
+ * \param[in]       *img: Pointer to \ref GUI_IMAGE_DESC_t image descriptor or NULL to clear image
+ * \retval          1: Image was set ok
+ * \retval          0: Image was not set
+ */
+uint8_t GUI_IMAGE_SetSource(GUI_HANDLE_p h, const GUI_IMAGE_DESC_t* img);
+
+/**
+ * \brief           Set image stored outside of memory and load it in background
+ *
+ *                  Memory for image is allocated and data are read with background job.
+ *                  Compressed images are decoded to \ref GUI_IMAGE_FORMAT_ARGB8888 format while loading.
+ *                  Loaded lines are shown as soon as they are available,
+ *                  \ref GUI_IMAGE_COLOR_PLACEHOLDER color is drawn instead of remaining lines
+ *
+ * \note            Image descriptor must stay valid while widget uses it, its data pointer is not used
+ * \param[in,out]   h: Widget handle
+ * \param[in]       *img: Pointer to \ref GUI_IMAGE_DESC_t image descriptor of stored image
+ * \param[in]       read: Function to read stored image data
+ * \param[in]       param: User parameter for read function
+ * \retval          1: Loading was started
+ * \retval          0: Loading was not started
+ */
+uint8_t GUI_IMAGE_SetSourceAsync(GUI_HANDLE_p h, const GUI_IMAGE_DESC_t* img, GUI_IMAGE_Read_t read, void* param);
+
+/**
+ * \brief           Check if image is still being loaded
+ * \param[in,out]   h: Widget handle
+ * \retval          1: Image is being loaded
+ * \retval          0: Image is loaded, loading failed or image is not loaded in background
+ */
+uint8_t GUI_IMAGE_IsLoading(GUI_HANDLE_p h);
+
+/**
+ * \}
+ */
+ 
+/**
+ * \}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -97,8 +97,9 @@ uint8_t GUI_LED_Callback(GUI_HANDLE_p h, GUI_WC_t ctrl, void* param, void* resul
                 GUI_DRAW_FilledRectangle(disp, x + 1, y + 1, width - 2, height - 2, c1);
                 GUI_DRAW_Rectangle(disp, x, y, width, height, c2);
             } else {
-                GUI_DRAW_FilledCircle(disp, x + width / 2, y + height / 2, width / 2, c1);
-                GUI_DRAW_Circle(disp, x + width / 2, y + height / 2, width / 2, c2);
+                GUI_iDim_t r = (width - 1) / 2;     /* Anti-aliased circle is 2 * r + 1 pixels wide */
+                GUI_DRAW_FilledCircleAA(disp, x + r, y + r, r - 1, c1);
+                GUI_DRAW_CircleAA(disp, x + r, y + r, r, c2);
             }
         }
         default:                                    /* Handle default option */
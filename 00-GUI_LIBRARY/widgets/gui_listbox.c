@@ -202,6 +202,7 @@ uint8_t __DeleteItem(GUI_HANDLE_p h, uint16_t index) {
     item = __GetItem(h, index);                     /* Get list item from handle */
     if (item) {
         __GUI_LINKEDLIST_REMOVE_GEN(&__GL(h)->Root, &item->List);
+        __GUI_MEMFREE(item);                        /* Free memory for entry */
         __GL(h)->Count--;                           /* Decrease count */
         
         if (o->Selected == index) {
@@ -217,11 +218,50 @@ uint8_t __DeleteItem(GUI_HANDLE_p h, uint16_t index) {
 
 static
 uint8_t GUI_LISTBOX_Callback(GUI_HANDLE_p h, GUI_WC_t ctrl, void* param, void* result) {
-#if GUI_USE_TOUCH
-    static GUI_iDim_t tY;
-#endif /* GUI_USE_TOUCH */
-    
     switch (ctrl) {                                 /* Handle control function if required */
+        case GUI_WC_Save: {                         /* Save text pointers of entries */
+            GUI_WIDGET_SnapshotData_t* d = (GUI_WIDGET_SnapshotData_t *)param;
+            GUI_LISTBOX_ITEM_t* item;
+            GUI_Byte* ptr = (GUI_Byte *)d->Data;
+            
+            d->Size = (uint32_t)__GL(h)->Count * sizeof(item->Text);
+            if (ptr) {
+                for (item = (GUI_LISTBOX_ITEM_t *)__GUI_LINKEDLIST_GETNEXT_GEN(&o->Root, NULL); item;
+                    item = (GUI_LISTBOX_ITEM_t *)__GUI_LINKEDLIST_GETNEXT_GEN(NULL, &item->List)) {
+                    memcpy(ptr, &item->Text, sizeof(item->Text));   /* Snapshot memory may not be aligned for pointers */
+                    ptr += sizeof(item->Text);
+                }
+            }
+            return 1;
+        }
+        case GUI_WC_Restore: {                      /* Create entries again, texts are in static memory */
+            const GUI_WIDGET_SnapshotData_t* d = (const GUI_WIDGET_SnapshotData_t *)param;
+            GUI_LISTBOX_ITEM_t* item;
+            uint32_t i;
+            
+            memset(&__GL(h)->Root, 0x00, sizeof(__GL(h)->Root));
+            __GL(h)->Count = 0;
+            for (i = 0; d && i < d->Size / sizeof(item->Text); i++) {
+                item = (GUI_LISTBOX_ITEM_t *)__GUI_MEMALLOC(sizeof(*item), GUI_MEM_TYPE_ITEM);
+                if (!item) {
+                    break;
+                }
+                memcpy(&item->Text, (const GUI_Byte *)d->Data + i * sizeof(item->Text), sizeof(item->Text));
+                __GUI_LINKEDLIST_ADD_GEN(&__GL(h)->Root, &item->List);
+                __GL(h)->Count++;
+            }
+            __CheckValues(h);                       /* Selection must stay inside restored entries */
+            return 1;
+        }
+        case GUI_WC_Remove: {                       /* When widget is about to be removed */
+            GUI_LISTBOX_ITEM_t* item;
+            while ((item = (GUI_LISTBOX_ITEM_t *)__GL(h)->Root.First) != NULL) {
+                __GUI_LINKEDLIST_REMOVE_GEN(&__GL(h)->Root, &item->List);
+                __GUI_MEMFREE(item);                /* Free memory for entry */
+            }
+            __GL(h)->Count = 0;
+            return 1;
+        }
         case GUI_WC_Draw: {
             GUI_Display_t* disp = (GUI_Display_t *)param;
             GUI_Dim_t x, y, width, height;
@@ -306,7 +346,7 @@ uint8_t GUI_LISTBOX_Callback(GUI_HANDLE_p h, GUI_WC_t ctrl, void* param, void* r
 #if GUI_USE_TOUCH
         case GUI_WC_TouchStart: {
             __GUI_TouchData_t* ts = (__GUI_TouchData_t *)param;
-            tY = ts->RelY[0];
+            o->TouchY = ts->RelY[0];
             
             *(__GUI_TouchStatus_t *)result = touchHANDLED;
             return 1;
@@ -315,11 +355,11 @@ uint8_t GUI_LISTBOX_Callback(GUI_HANDLE_p h, GUI_WC_t ctrl, void* param, void* r
             __GUI_TouchData_t* ts = (__GUI_TouchData_t *)param;
             if (__GH(h)->Font) {
                 GUI_Dim_t height = __ItemHeight(h, NULL);   /* Get element height */
-                GUI_iDim_t diff = tY - ts->RelY[0];
+                GUI_iDim_t diff = o->TouchY - ts->RelY[0];
                 
                 if (__GUI_ABS(diff) > height) {
                     __Slide(h, diff > 0 ? 1 : -1);  /* Slide widget */
-                    tY = ts->RelY[0];               /* Save pointer */
+                    o->TouchY = ts->RelY[0];        /* Save pointer */
                 }
             }
             return 1;
@@ -414,7 +454,7 @@ uint8_t GUI_LISTBOX_AddString(GUI_HANDLE_p h, const GUI_Char* text) {
     __GUI_ASSERTPARAMS(h && __GH(h)->Widget == &Widget);    /* Check input parameters */
     __GUI_ENTER();                                  /* Enter GUI */
     
-    item = (GUI_LISTBOX_ITEM_t *)__GUI_MEMALLOC(sizeof(*item)); /* Allocate memory for entry */
+    item = (GUI_LISTBOX_ITEM_t *)__GUI_MEMALLOC(sizeof(*item), GUI_MEM_TYPE_ITEM); /* Allocate memory for entry */
     if (item) {
         item->Text = (GUI_Char *)text;              /* Add text to entry */
         __GUI_LINKEDLIST_ADD_GEN(&__GL(h)->Root, &item->List);  /* Add to linked list */
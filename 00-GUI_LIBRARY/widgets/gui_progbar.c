@@ -101,10 +101,10 @@ uint8_t GUI_PROGBAR_Callback(GUI_HANDLE_p h, GUI_WC_t ctrl, void* param, void* r
             /* Draw text if possible */
             if (__GH(h)->Font) {
                 const GUI_Char* text = NULL;
-                GUI_Char buff[5];
+                GUI_Char buff[13];
                 
                 if (p->Flags & GUI_PROGBAR_FLAG_PERCENT) {
-                    sprintf((char *)buff, "%d%%", ((p->Value - p->Min) * 100) / (p->Max - p->Min));
+                    GUI_STRING_Format(buff, sizeof(buff), _T("%d%%"), ((p->Value - p->Min) * 100) / (p->Max - p->Min));
                     text = buff;
                 } else if (__GUI_WIDGET_IsFontAndTextSet(h)) {
                     text = __GH(h)->Text;
@@ -125,6 +125,7 @@ uint8_t GUI_PROGBAR_Callback(GUI_HANDLE_p h, GUI_WC_t ctrl, void* param, void* r
                     GUI_DRAW_WriteText(disp, __GH(h)->Font, text, &f);
                 }
             }
+            return 1;
         }
 #if GUI_USE_TOUCH
         case GUI_WC_TouchStart: {
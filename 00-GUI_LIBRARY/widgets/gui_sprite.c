@@ -0,0 +1,290 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2017 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#define GUI_INTERNAL
+#include "gui_sprite.h"
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private structures                            **/
+/******************************************************************************/
+/******************************************************************************/
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private definitions                           **/
+/******************************************************************************/
+/******************************************************************************/
+#define __GS(x)             ((GUI_SPRITE_t *)(x))
+
+static
+uint8_t GUI_SPRITE_Callback(GUI_HANDLE_p h, GUI_WC_t ctrl, void* param, void* result);
+    
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private variables                            **/
+/******************************************************************************/
+/******************************************************************************/
+const static GUI_WIDGET_t Widget = {
+    .Name = _T("SPRITE"),                           /*!< Widget name */ 
+    .Size = sizeof(GUI_SPRITE_t),                   /*!< Size of widget for memory allocation */
+    .Flags = 0,                                     /*!< List of widget flags */
+    .Callback = GUI_SPRITE_Callback,                /*!< Control function */
+    .Colors = NULL,                                 /*!< List of default colors */
+    .ColorsCount = 0,                               /*!< Number of colors */
+};
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private functions                            **/
+/******************************************************************************/
+/******************************************************************************/
+/* Add sprite to list of playing sprites */
+static
+void __Start(GUI_SPRITE_t* s) {
+    if (!(s->Flags & GUI_SPRITE_FLAG_PLAYING)) {
+        s->Flags |= GUI_SPRITE_FLAG_PLAYING;
+        s->Next = GUI.Sprites;                      /* Sprites are playing in current context */
+        GUI.Sprites = s;
+    }
+    s->FrameTime = GUI.Time;                        /* Current frame starts now */
+}
+
+/* Remove sprite from list of playing sprites */
+static
+void __Stop(GUI_SPRITE_t* s) {
+    GUI_SPRITE_t** p;
+    
+    if (s->Flags & GUI_SPRITE_FLAG_PLAYING) {
+        for (p = &GUI.Sprites; *p; p = &(*p)->Next) {
+            if (*p == s) {
+                *p = s->Next;
+                break;
+            }
+        }
+        s->Flags &= ~GUI_SPRITE_FLAG_PLAYING;
+        s->Next = 0;
+    }
+}
+
+/* Apply changed rectangles of frame to current image and invalidate them */
+static
+void __ApplyFrame(GUI_SPRITE_t* s, uint16_t frame) {
+    const GUI_SPRITE_FRAME_t* f = &s->Sprite->Frames[frame];
+    const GUI_SPRITE_RECT_t* r;
+    uint16_t i;
+    
+    s->Frame = frame;
+    if (!s->Image.Data) {
+        return;
+    }
+    for (i = 0; i < f->RectsCount; i++) {
+        r = &f->Rects[i];
+        if ((r->X + r->Image.Width) > s->Image.Width || (r->Y + r->Image.Height) > s->Image.Height) {
+            continue;                               /* Rectangle is out of sprite */
+        }
+        GUI_DRAW_ImageDecode(&r->Image, (GUI_Color_t *)s->Image.Data + (uint32_t)r->Y * s->Image.Width + r->X, s->Image.Width, GUI_COLOR_BLACK);
+        __GUI_WIDGET_InvalidateRect(__GH(s), r->X, r->Y, r->Image.Width, r->Image.Height);
+    }
+}
+
+/* Release frame memory */
+static
+void __FreeImage(GUI_SPRITE_t* s) {
+    GUI_Color_t* data = (GUI_Color_t *)s->Image.Data;
+    if (data) {
+        __GUI_MEMFREE(data);
+    }
+    s->Image.Data = 0;
+}
+
+/* Allocate frame memory and decode frames up to current one */
+static
+uint8_t __LoadImage(GUI_SPRITE_t* s) {
+    const GUI_SPRITE_DESC_t* sprite = s->Sprite;
+    uint16_t frame = s->Frame, i;
+    
+    s->Image.Width = sprite->Width;
+    s->Image.Height = sprite->Height;
+    s->Image.Format = GUI_IMAGE_FORMAT_ARGB8888;
+    s->Image.Data = (GUI_Byte *)__GUI_MEMALLOC((uint32_t)sprite->Width * (uint32_t)sprite->Height * sizeof(GUI_Color_t), GUI_MEM_TYPE_IMAGE);
+    if (!s->Image.Data) {
+        return 0;
+    }
+    memset((void *)s->Image.Data, 0x00, (uint32_t)sprite->Width * (uint32_t)sprite->Height * sizeof(GUI_Color_t));
+    for (i = 0; i <= frame && i < sprite->FramesCount; i++) {
+        __ApplyFrame(s, i);                         /* Decode key frame and all deltas */
+    }
+    return 1;
+}
+
+#define s           ((GUI_SPRITE_t *)h)
+static
+uint8_t GUI_SPRITE_Callback(GUI_HANDLE_p h, GUI_WC_t ctrl, void* param, void* result) {
+    __GUI_ASSERTPARAMS(h && __GH(h)->Widget == &Widget);    /* Check input parameters */
+    switch (ctrl) {                                 /* Handle control function if required */
+        case GUI_WC_Draw: {
+            GUI_Display_t* disp = (GUI_Display_t *)param;
+            
+            if (s->Image.Data) {                    /* Draw only when frame is available */
+                GUI_DRAW_Image(disp, __GUI_WIDGET_GetAbsoluteX(h), __GUI_WIDGET_GetAbsoluteY(h), &s->Image, 0);
+            }
+            return 1;
+        }
+        case GUI_WC_Restore: {                      /* Frame memory is not part of snapshot */
+            uint8_t playing = !!(s->Flags & GUI_SPRITE_FLAG_PLAYING);
+            
+            s->Image.Data = 0;
+            s->Next = 0;
+            s->Flags &= ~GUI_SPRITE_FLAG_PLAYING;
+            if (s->Sprite && s->Sprite->FramesCount && __LoadImage(s) && playing) {
+                __Start(s);                         /* Continue playing */
+            }
+            return 1;
+        }
+        case GUI_WC_Remove: {                       /* When widget is about to be removed */
+            __Stop(s);                              /* Stop playing */
+            __FreeImage(s);                         /* Free frame memory */
+            return 1;
+        }
+        default:                                    /* Handle default option */
+            __GUI_UNUSED3(h, param, result);        /* Unused elements to prevent compiler warnings */
+            return 0;                               /* Command was not processed */
+    }
+}
+#undef s
+
+/******************************************************************************/
+/******************************************************************************/
+/***                                Public API                               **/
+/******************************************************************************/
+/******************************************************************************/
+void __GUI_SPRITE_Process(void) {
+    GUI_SPRITE_t *s, *next;
+    const GUI_SPRITE_FRAME_t* f;
+    uint16_t frame, count;
+    
+    for (s = GUI.Sprites; s; s = next) {
+        next = s->Next;                             /* Sprite may be removed from list */
+        f = &s->Sprite->Frames[s->Frame];
+        for (count = 0; (GUI.Time - s->FrameTime) >= (f->Duration ? f->Duration : 1); count++) {
+            /**
+             * Frames are stored as differences and can not be skipped.
+             * Apply at most one animation cycle per call and drop remaining lag,
+             * otherwise long stall would replay all missed frames at once
+             */
+            if (count >= s->Sprite->FramesCount) {
+                s->FrameTime = GUI.Time;
+                break;
+            }
+            frame = s->Frame + 1;
+            if (frame >= s->Sprite->FramesCount) {  /* After last frame */
+                if (!(s->Flags & GUI_SPRITE_FLAG_LOOP)) {
+                    __Stop(s);
+                    break;
+                }
+                frame = 0;                          /* Key frame covers complete sprite */
+            }
+            s->FrameTime += f->Duration ? f->Duration : 1;
+            __ApplyFrame(s, frame);                 /* Decode and invalidate changed parts only */
+            f = &s->Sprite->Frames[frame];
+        }
+    }
+}
+
+GUI_HANDLE_p GUI_SPRITE_Create(GUI_ID_t id, GUI_iDim_t x, GUI_iDim_t y, GUI_Dim_t width, GUI_Dim_t height, GUI_HANDLE_p parent, GUI_WIDGET_CALLBACK_t cb, uint16_t flags) {
+    GUI_SPRITE_t* ptr;
+    
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    ptr = (GUI_SPRITE_t *)__GUI_WIDGET_Create(&Widget, id, x, y, width, height, parent, cb, flags);    /* Allocate memory for basic widget */
+
+    __GUI_LEAVE();                                  /* Leave GUI */
+    
+    return (GUI_HANDLE_p)ptr;
+}
+
+uint8_t GUI_SPRITE_SetSource(GUI_HANDLE_p h, const GUI_SPRITE_DESC_t* sprite) {
+    uint8_t ret = 1;
+    
+    __GUI_ASSERTPARAMS(h && __GH(h)->Widget == &Widget);    /* Check input parameters */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    if (__GS(h)->Sprite != sprite) {                /* Any parameter changed */
+        __Stop(__GS(h));                            /* Stop previous animation */
+        __FreeImage(__GS(h));
+        __GS(h)->Sprite = sprite;
+        __GS(h)->Frame = 0;
+        if (sprite && sprite->FramesCount) {
+            ret = __LoadImage(__GS(h));             /* Allocate memory and decode key frame */
+        }
+        __GUI_WIDGET_InvalidateWithParent(h);       /* Redraw object with parent as sprite may be transparent */
+    }
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return ret;
+}
+
+uint8_t GUI_SPRITE_Play(GUI_HANDLE_p h, uint8_t loop) {
+    uint8_t ret = 0;
+    
+    __GUI_ASSERTPARAMS(h && __GH(h)->Widget == &Widget);    /* Check input parameters */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    if (__GS(h)->Sprite && __GS(h)->Sprite->FramesCount) {
+        if (loop) {
+            __GS(h)->Flags |= GUI_SPRITE_FLAG_LOOP;
+        } else {
+            __GS(h)->Flags &= ~GUI_SPRITE_FLAG_LOOP;
+        }
+        __Start(__GS(h));                           /* Add to playing list */
+        ret = 1;
+    }
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return ret;
+}
+
+uint8_t GUI_SPRITE_Stop(GUI_HANDLE_p h) {
+    __GUI_ASSERTPARAMS(h && __GH(h)->Widget == &Widget);    /* Check input parameters */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    __Stop(__GS(h));                                /* Remove from playing list */
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return 1;
+}
+
+uint8_t GUI_SPRITE_IsPlaying(GUI_HANDLE_p h) {
+    uint8_t ret;
+    
+    __GUI_ASSERTPARAMS(h && __GH(h)->Widget == &Widget);    /* Check input parameters */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    ret = !!(__GS(h)->Flags & GUI_SPRITE_FLAG_PLAYING);
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return ret;
+}
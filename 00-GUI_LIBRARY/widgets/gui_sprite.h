@@ -0,0 +1,147 @@
+/**
+ * \author  Tilen Majerle <tilen@majerle.eu>
+ * \brief   GUI sprite widget
+ *	
+\verbatim
+   ----------------------------------------------------------------------
+    Copyright (c) 2017 Tilen Majerle
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge,
+    publish, distribute, sublicense, and/or sell copies of the Software, 
+    and to permit persons to whom the Software is furnished to do so, 
+    subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+    AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+   ----------------------------------------------------------------------
+\endverbatim
+ */
+#ifndef GUI_SPRITE_H
+#define GUI_SPRITE_H
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup      GUI_WIDGETS
+ * \{
+ */
+#include "gui_widget.h"
+
+/**
+ * \defgroup        GUI_SPRITE Sprite
+ * \brief           Animated image playing frame sequence
+ * \{
+ *
+ * Current frame is kept in RAM. On frame change only rectangles changed
+ * from previous frame (see \ref GUI_SPRITE_FRAME_t) are decoded and invalidated.
+ *
+ * Playback is processed by \ref GUI_Process function, no timer is used.
+ */
+
+#if defined(GUI_INTERNAL) || defined(DOXYGEN)
+
+#define GUI_SPRITE_FLAG_PLAYING     0x01    /*!< Indicates sprite is playing */
+#define GUI_SPRITE_FLAG_LOOP        0x02    /*!< Indicates sprite restarts after last frame */
+
+/**
+ * \brief           Sprite object structure
+ */
+typedef struct GUI_SPRITE_t {
+    GUI_HANDLE C;                           /*!< Global widget object */
+    
+    const GUI_SPRITE_DESC_t* Sprite;        /*!< Pointer to sprite animation */
+    GUI_IMAGE_DESC_t Image;                 /*!< Current frame in ARGB8888 format */
+    uint16_t Frame;                         /*!< Current frame index */
+    uint32_t FrameTime;                     /*!< Time when current frame was shown */
+    GUI_Byte Flags;                         /*!< Flags management for sprite */
+    struct GUI_SPRITE_t* Next;              /*!< Next playing sprite */
+} GUI_SPRITE_t;
+
+/**
+ * \brief           Advance frames of all playing sprites
+ * \note            Since this function is private, it can only be used by user inside GUI library
+ * \retval          None
+ */
+void __GUI_SPRITE_Process(void);
+
+#endif /* defined(GUI_INTERNAL) || defined(DOXYGEN) */
+
+/**
+ * \brief           Create new sprite widget
+ * \param[in]       id: Widget unique ID to use for identity for callback processing
+ * \param[in]       x: Widget X position relative to parent widget
+ * \param[in]       y: Widget Y position relative to parent widget
+ * \param[in]       width: Widget width in units of pixels
+ * \param[in]       height: Widget height in uints of pixels
+ * \param[in]       parent: Parent widget handle. Set to NULL to use current active parent widget
+ * \param[in]       cb: Pointer to \ref GUI_WIDGET_CALLBACK_t callback function. Set to NULL to use default widget callback
+ * \param[in]       flags: Flags for widget creation
+ * \retval          > 0: \ref GUI_HANDLE_p object of created widget
+ * \retval          0: Widget creation failed
+ */
+GUI_HANDLE_p GUI_SPRITE_Create(GUI_ID_t id, GUI_iDim_t x, GUI_iDim_t y, GUI_Dim_t width, GUI_Dim_t height, GUI_HANDLE_p parent, GUI_WIDGET_CALLBACK_t cb, uint16_t flags);
+
+/**
+ * \brief           Set sprite animation and show its first frame
+ * \note            Memory for one frame in ARGB8888 format is allocated
+ * \param[in,out]   h: Widget handle
+ * \param[in]       *sprite: Pointer to \ref GUI_SPRITE_DESC_t animation or NULL to clear sprite
+ * \retval          1: Sprite was set ok
+ * \retval          0: Sprite was not set
+ */
+uint8_t GUI_SPRITE_SetSource(GUI_HANDLE_p h, const GUI_SPRITE_DESC_t* sprite);
+
+/**
+ * \brief           Start playing animation from current frame
+ * \param[in,out]   h: Widget handle
+ * \param[in]       loop: Set to 1 to restart animation after last frame or 0 to stop on last frame
+ * \retval          1: Animation started
+ * \retval          0: Animation was not started
+ */
+uint8_t GUI_SPRITE_Play(GUI_HANDLE_p h, uint8_t loop);
+
+/**
+ * \brief           Stop playing animation on current frame
+ * \param[in,out]   h: Widget handle
+ * \retval          1: Animation stopped
+ * \retval          0: Animation was not stopped
+ */
+uint8_t GUI_SPRITE_Stop(GUI_HANDLE_p h);
+
+/**
+ * \brief           Check if animation is playing
+ * \param[in,out]   h: Widget handle
+ * \retval          1: Animation is playing
+ * \retval          0: Animation is not playing
+ */
+uint8_t GUI_SPRITE_IsPlaying(GUI_HANDLE_p h);
+
+/**
+ * \}
+ */
+ 
+/**
+ * \}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
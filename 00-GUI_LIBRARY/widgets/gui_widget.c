@@ -32,10 +32,6 @@
 /***                           Private structures                            **/
 /******************************************************************************/
 /******************************************************************************/
-typedef struct {
-    const GUI_FONT_t* Font;
-} GUI_WIDGET_Def_t;
-GUI_WIDGET_Def_t WIDGET_Default;
 
 /******************************************************************************/
 /******************************************************************************/
@@ -54,6 +50,30 @@ GUI_WIDGET_Def_t WIDGET_Default;
 /***                            Private functions                            **/
 /******************************************************************************/
 /******************************************************************************/
+/* Calculate FNV-1a hash of string and its length in units of bytes */
+static
+uint32_t __TextHash(const GUI_Char* text, uint32_t* len) {
+    uint32_t hash = 0x811C9DC5UL, l = 0;            /* FNV-1a offset basis */
+    if (text) {
+        while (text[l]) {                           /* Process all bytes until end of string */
+            hash ^= (uint32_t)text[l++];
+            hash *= 0x01000193UL;                   /* FNV-1a prime */
+        }
+    }
+    *len = l;                                       /* Save length of string */
+    return hash ^ l;                                /* Include length to hash */
+}
+
+/* Process text change of widget */
+static
+void __TextChanged(GUI_HANDLE_p h) {
+    if (__GH(h)->TextRun) {                         /* Text content may be different with the same pointer */
+        __GH(h)->TextRun->Text = 0;                 /* Decode text again on next draw */
+    }
+    __GUI_WIDGET_Invalidate(h);                     /* Redraw object */
+    __GUI_WIDGET_Callback(h, GUI_WC_TextChanged, NULL, NULL);   /* Process callback */
+}
+
 /* Removes widget and children widgets */
 static 
 void __RemoveWidget(GUI_HANDLE_p h) {
@@ -102,6 +122,9 @@ void __RemoveWidget(GUI_HANDLE_p h) {
     if (__GH(h)->Colors) {                          /* Free allocate colors if exists */
         __GUI_MEMFREE(__GH(h)->Colors);
     }
+    if (__GH(h)->TextRun) {                         /* Free decoded text */
+        __GUI_DRAW_TextRunFree(&__GH(h)->TextRun);
+    }
     __GUI_LINKEDLIST_WidgetRemove(h);               /* Remove entry from linked list */
     __GUI_MEMWIDFREE(h);                            /* Free memory for widget */
 }
@@ -109,22 +132,22 @@ void __RemoveWidget(GUI_HANDLE_p h) {
 /* Recursive function to delete all widgets with checking for flag */
 static
 void __RemoveWidgets(GUI_HANDLE_p parent) {
-    GUI_HANDLE_p h;
+    GUI_HANDLE_p h, next;
     if (parent && __GH(parent)->Flags & GUI_FLAG_REMOVE) {
         __RemoveWidget(parent);                     /* Remove widgets and all children */
         return;
     }
 
-    for (h = __GUI_LINKEDLIST_WidgetGetNext((GUI_HANDLE_ROOT_t *)parent, 0); h; h = __GUI_LINKEDLIST_WidgetGetNext(NULL, h)) {
+    for (h = __GUI_LINKEDLIST_WidgetGetNext((GUI_HANDLE_ROOT_t *)parent, 0); h; h = next) {
+        next = __GUI_LINKEDLIST_WidgetGetNext(NULL, h); /* Get next before widget memory is released */
         if (__GUI_WIDGET_AllowChildren(h)) {        /* Check children if any has flag */
             __RemoveWidgets(h);                     /* Run recursive function */
-        } else if (__GH(parent)->Flags & GUI_FLAG_REMOVE) {
-            __RemoveWidget(parent);                 /* Remove widget directly */
+        } else if (__GH(h)->Flags & GUI_FLAG_REMOVE) {
+            __RemoveWidget(h);                      /* Remove widget directly */
         }
     }
 }
 
-static
 void __GUI_WIDGET_SetClippingRegion(GUI_HANDLE_p h) {
     GUI_Dim_t x1, y1, x2, y2;
     
@@ -398,6 +421,37 @@ uint8_t __GUI_WIDGET_InvalidateWithParent(GUI_HANDLE_p h) {
     return 1;
 }
 
+uint8_t __GUI_WIDGET_InvalidateRect(GUI_HANDLE_p h, GUI_iDim_t x, GUI_iDim_t y, GUI_Dim_t width, GUI_Dim_t height) {
+    GUI_iDim_t x1, y1, x2, y2;
+    
+    __GUI_WIDGET_GetLCDAbsPosAndVisibleWidthHeight(h, &x1, &y1, &x2, &y2);  /* Get visible widget part */
+    x += __GUI_WIDGET_GetAbsoluteX(h);              /* Get absolute rectangle position */
+    y += __GUI_WIDGET_GetAbsoluteY(h);
+    
+    /* Limit rectangle to visible part */
+    if (x1 < x)                 { x1 = x; }
+    if (x2 > x + width)         { x2 = x + width; }
+    if (y1 < y)                 { y1 = y; }
+    if (y2 > y + height)        { y2 = y + height; }
+    if (x1 >= x2 || y1 >= y2) {                     /* Nothing to redraw */
+        return 0;
+    }
+    
+    if (!__GUI_WIDGET_InvalidatePrivate(h, 0)) {    /* Invalidate object without clipping */
+        return 0;
+    }
+    if (__GH(h)->Parent) {
+        __GUI_WIDGET_InvalidatePrivate(__GH(h)->Parent, 0); /* Invalidate parent object */
+    }
+    
+    /* Extend clipping region only for rectangle */
+    if (GUI.Display.X1 > x1)    { GUI.Display.X1 = x1; }
+    if (GUI.Display.X2 < x2)    { GUI.Display.X2 = x2; }
+    if (GUI.Display.Y1 > y1)    { GUI.Display.Y1 = y1; }
+    if (GUI.Display.Y2 < y2)    { GUI.Display.Y2 = y2; }
+    return 1;
+}
+
 uint8_t __GUI_WIDGET_SetXY(GUI_HANDLE_p h, GUI_iDim_t x, GUI_iDim_t y) {       
     if (__GH(h)->X != x || __GH(h)->Y != y) {            
         __GUI_WIDGET_InvalidateWithParent(h);       /* Set new clipping region */
@@ -443,31 +497,33 @@ uint8_t __GUI_WIDGET_SetFont(GUI_HANDLE_p h, GUI_Const GUI_FONT_t* font) {
 }
 
 uint8_t __GUI_WIDGET_SetText(GUI_HANDLE_p h, const GUI_Char* text) {
-   if (__GH(h)->Flags & GUI_FLAG_DYNAMICTEXTALLOC) {    /* Memory for text is dynamically allocated */
-        if (__GH(h)->TextMemSize) {
-            if (GUI_STRING_LengthTotal(text) > (__GH(h)->TextMemSize - 1)) {    /* Check string length */
+    uint32_t hash, len;
+    if (__GH(h)->Flags & GUI_FLAG_DYNAMICTEXTALLOC) {   /* Memory for text is dynamically allocated */
+        if (__GH(h)->TextMemSize && (!text || GUI_STRING_Compare(__GH(h)->Text, text))) {   /* Copy only when content is different */
+            if (!text) {
+                __GH(h)->Text[0] = 0;               /* Clear text */
+            } else if (GUI_STRING_LengthTotal(text) > (__GH(h)->TextMemSize - 1)) {    /* Check string length */
                 GUI_STRING_CopyN(__GH(h)->Text, text, __GH(h)->TextMemSize - 1);    /* Do not copy all bytes because of memory overflow */
             } else {
                 GUI_STRING_Copy(__GH(h)->Text, text);   /* Copy entire string */
             }
-            __GUI_WIDGET_Invalidate(h);             /* Redraw object */
-            __GUI_WIDGET_Callback(h, GUI_WC_TextChanged, NULL, NULL);   /* Process callback */
+            __TextChanged(h);                       /* Redraw object and process callback */
         }
+        __GH(h)->TextHash = __TextHash(__GH(h)->Text, &len);    /* Save content hash */
     } else {                                        /* Memory allocated by user */
-        if (__GH(h)->Text && __GH(h)->Text == text) {   /* In case the same pointer is passed to WIDGET */
-            if (GUI_STRING_Compare(__GH(h)->Text, text)) {/* If strings does not match, source string updated? */
-                __GUI_WIDGET_Invalidate(h);         /* Redraw object */
-                __GUI_WIDGET_Callback(h, GUI_WC_TextChanged, NULL, NULL);   /* Process callback */
-            }
-        }
+        hash = __TextHash(text, &len);              /* Get hash of new text content */
         
-        if (__GH(h)->Text != text) {                /* Check if pointer do not match */
+        /**
+         * When the same pointer is passed, user may have modified buffer in place.
+         * Pointer compare cannot detect that, content hash of last set text is used instead
+         */
+        if (__GH(h)->Text != text || __GH(h)->TextHash != hash) {
             __GH(h)->Text = (GUI_Char *)text;       /* Set parameter */
-            __GUI_WIDGET_Invalidate(h);             /* Redraw object */
-            __GUI_WIDGET_Callback(h, GUI_WC_TextChanged, NULL, NULL);   /* Process callback */
+            __GH(h)->TextHash = hash;               /* Save content hash */
+            __TextChanged(h);                       /* Redraw object and process callback */
         }
     }
-    __GH(h)->TextCursor = GUI_STRING_LengthTotal(__GH(h)->Text);    /* Set cursor to the end of string */
+    __GH(h)->TextCursor = len;                      /* Set cursor to the end of string */
     return 1;
 }
 
@@ -479,15 +535,14 @@ uint8_t __GUI_WIDGET_AllocateTextMemory(GUI_HANDLE_p h, uint32_t size) {
     __GH(h)->Text = 0;                              /* Reset pointer */
     
     __GH(h)->TextMemSize = size * sizeof(GUI_Char); /* Allocate text memory */
-    __GH(h)->Text = (GUI_Char *)__GUI_MEMALLOC(__GH(h)->TextMemSize);   /* Allocate memory for text */
+    __GH(h)->Text = (GUI_Char *)__GUI_MEMALLOC(__GH(h)->TextMemSize, GUI_MEM_TYPE_TEXT);   /* Allocate memory for text */
     if (__GH(h)->Text) {                            /* Check if allocated */
         __GH(h)->Flags |= GUI_FLAG_DYNAMICTEXTALLOC;/* Dynamically allocated */
     } else {
         __GH(h)->TextMemSize = 0;                   /* No dynamic bytes available */
         __GH(h)->Flags &= ~GUI_FLAG_DYNAMICTEXTALLOC;   /* Not allocated */
     }
-    __GUI_WIDGET_Invalidate(h);                     /* Redraw object */
-    __GUI_WIDGET_Callback(h, GUI_WC_TextChanged, NULL, NULL);   /* Process callback */
+    __TextChanged(h);                               /* Redraw object and process callback */
     return 1;
 }
 
@@ -497,14 +552,27 @@ uint8_t __GUI_WIDGET_FreeTextMemory(GUI_HANDLE_p h) {
         __GH(h)->Text = 0;                          /* Reset memory */
         __GH(h)->TextMemSize = 0;                   /* Reset memory size */
         __GH(h)->Flags &= ~GUI_FLAG_DYNAMICTEXTALLOC;   /* Not allocated */
-        __GUI_WIDGET_Invalidate(h);                 /* Redraw object */
-        __GUI_WIDGET_Callback(h, GUI_WC_TextChanged, NULL, NULL);   /* Process callback */
+        __TextChanged(h);                           /* Redraw object and process callback */
     }
     return 1;
 }
 
 uint8_t __GUI_WIDGET_IsFontAndTextSet(GUI_HANDLE_p h) {
-    return __GH(h)->Text && __GH(h)->Font && GUI_STRING_Length(__GH(h)->Text);  /* Check if conditions are met for drawing string */
+    return __GH(h)->Text && __GH(h)->Font && __GH(h)->Text[0];  /* Check if conditions are met for drawing string */
+}
+
+GUI_DRAW_TEXTRUN_t* __GUI_WIDGET_GetTextRun(GUI_HANDLE_p h) {
+    if (__GH(h)->Text && __GH(h)->Font) {
+#if GUI_USE_STRTABLE
+        if ((__GH(h)->Flags & GUI_FLAG_TEXTID) && __GH(h)->Text == __GUI_STRTABLE_Get(__GH(h)->TextID)) {   /* Text is not copied to widget memory */
+            return __GUI_STRTABLE_GetRun(__GH(h)->TextID, __GH(h)->Font);
+        }
+#endif /* GUI_USE_STRTABLE */
+#if GUI_USE_TEXT_RUN
+        return __GUI_DRAW_TextRunGet(&__GH(h)->TextRun, __GH(h)->Font, __GH(h)->Text);
+#endif /* GUI_USE_TEXT_RUN */
+    }
+    return 0;
 }
 
 uint8_t __GUI_WIDGET_ProcessTextKey(GUI_HANDLE_p h, __GUI_KeyboardData_t* kb) {
@@ -534,8 +602,7 @@ uint8_t __GUI_WIDGET_ProcessTextKey(GUI_HANDLE_p h, __GUI_KeyboardData_t* kb) {
             }
             __GH(h)->Text[tlen + l] = 0;            /* Add 0 to the end */
             
-            __GUI_WIDGET_Invalidate(h);             /* Invalidate widget */
-            __GUI_WIDGET_Callback(h, GUI_WC_TextChanged, NULL, NULL);   /* Process callback */
+            __TextChanged(h);                       /* Redraw object and process callback */
             return 1;
         }
     } else if (ch == 8 || ch == 127) {              /* Backspace character */
@@ -552,8 +619,7 @@ uint8_t __GUI_WIDGET_ProcessTextKey(GUI_HANDLE_p h, __GUI_KeyboardData_t* kb) {
             __GH(h)->TextCursor -= l;               /* Decrease text cursor by number of bytes for character deleted */
             __GH(h)->Text[tlen - l] = 0;            /* Set 0 to the end of string */
             
-            __GUI_WIDGET_Invalidate(h);             /* Invalidate widget */
-            __GUI_WIDGET_Callback(h, GUI_WC_TextChanged, NULL, NULL);   /* Process callback */
+            __TextChanged(h);                       /* Redraw object and process callback */
             return 1;
         }
     }
@@ -566,7 +632,7 @@ GUI_HANDLE_p __GUI_WIDGET_Create(const GUI_WIDGET_t* widget, GUI_ID_t id, GUI_iD
     
     __GUI_ASSERTPARAMS(widget && widget->Callback); /* Check input parameters */
     
-    h = (GUI_HANDLE_p)__GUI_MEMALLOC(widget->Size);
+    h = (GUI_HANDLE_p)__GUI_MEMWIDALLOC(widget);
     if (h) {
         memset(h, 0x00, widget->Size);              /* Set memory to 0 */
         
@@ -585,7 +651,7 @@ GUI_HANDLE_p __GUI_WIDGET_Create(const GUI_WIDGET_t* widget, GUI_ID_t id, GUI_iD
         }
         
         /* Set widget default values */
-        __GH(h)->Font = WIDGET_Default.Font;        /* Set default font */
+        __GH(h)->Font = GUI.WidgetFont;             /* Set default font of context */
         
         __GH(h)->Flags |= GUI_FLAG_IGNORE_INVALIDATE;   /* Ignore invalidate flag */
         __GUI_WIDGET_SetSize(h, width, height);     /* Set widget size */
@@ -742,7 +808,7 @@ uint8_t __GUI_WIDGET_SetColor(GUI_HANDLE_p h, uint8_t index, GUI_Color_t color)
     uint8_t ret = 1;
     if (!__GH(h)->Colors) {                         /* Do we need to allocate color memory? */
         if (__GH(h)->Widget->ColorsCount) {         /* Check if at least some colors should be used */
-            __GH(h)->Colors = __GUI_MEMALLOC(__GH(h)->Widget->ColorsCount * sizeof(*__GH(h)->Colors));
+            __GH(h)->Colors = __GUI_MEMALLOC(__GH(h)->Widget->ColorsCount * sizeof(*__GH(h)->Colors), GUI_MEM_TYPE_COLORS);
             if (__GH(h)->Colors) {                  /* Copy all colors to new memory first */
                 memcpy(__GH(h)->Colors, __GH(h)->Widget->Colors, __GH(h)->Widget->ColorsCount * sizeof(*__GH(h)->Colors));
             } else {
@@ -922,12 +988,32 @@ uint8_t GUI_WIDGET_SetText(GUI_HANDLE_p h, const GUI_Char* text) {
     __GUI_ASSERTPARAMS(__GUI_WIDGET_IsWidget(h));   /* Check valid parameter */
     __GUI_ENTER();                                  /* Enter GUI */
     
+    __GH(h)->Flags &= ~GUI_FLAG_TEXTID;             /* Text is not from string table anymore */
     res = __GUI_WIDGET_SetText(h, text);            /* Set text for widget */
     
     __GUI_LEAVE();                                  /* Leave GUI */
     return res;
 }
 
+#if GUI_USE_STRTABLE || defined(DOXYGEN)
+uint8_t GUI_WIDGET_SetTextID(GUI_HANDLE_p h, uint16_t id) {
+    uint8_t res;
+    
+    __GUI_ASSERTPARAMS(__GUI_WIDGET_IsWidget(h));   /* Check valid parameter */
+    __GUI_ENTER();                                  /* Enter GUI */
+    
+    __GH(h)->TextID = id;                           /* Set string ID */
+    __GH(h)->Flags |= GUI_FLAG_TEXTID;              /* Text is changed with language */
+    if (__GH(h)->TextRun) {                         /* Run of string table is used instead */
+        __GUI_DRAW_TextRunFree(&__GH(h)->TextRun);
+    }
+    res = __GUI_WIDGET_SetText(h, __GUI_STRTABLE_Get(id));  /* Set text of current language */
+    
+    __GUI_LEAVE();                                  /* Leave GUI */
+    return res;
+}
+#endif /* GUI_USE_STRTABLE || defined(DOXYGEN) */
+
 const GUI_Char* GUI_WIDGET_GetText(GUI_HANDLE_p h) {
     GUI_Char* t;
     
@@ -1175,7 +1261,9 @@ uint8_t GUI_WIDGET_SetScrollY(GUI_HANDLE_p h, GUI_iDim_t scroll) {
 }
 
 uint8_t GUI_WIDGET_SetFontDefault(const GUI_FONT_t* font) {
-    WIDGET_Default.Font = font;                     /* Set default font */
+    __GUI_ENTER();                                  /* Enter GUI */
+    GUI.WidgetFont = font;                          /* Set default font of current context */
+    __GUI_LEAVE();                                  /* Leave GUI */
     return 1;
 }
 
@@ -209,6 +209,20 @@ uint8_t __GUI_WIDGET_Invalidate(GUI_HANDLE_p h);
  */
 uint8_t __GUI_WIDGET_InvalidateWithParent(GUI_HANDLE_p h);
 
+/**
+ * \brief           Invalidate only part of widget and parent widget for redraw
+ * \note            Since this function is private, it can only be used by user inside GUI library
+ * \param[in,out]   h: Widget handle
+ * \param[in]       x: Rectangle X position relative to widget
+ * \param[in]       y: Rectangle Y position relative to widget
+ * \param[in]       width: Rectangle width
+ * \param[in]       height: Rectangle height
+ * \retval          1: Successful
+ * \retval          0: Failed or rectangle is not visible
+ * \hideinitializer
+ */
+uint8_t __GUI_WIDGET_InvalidateRect(GUI_HANDLE_p h, GUI_iDim_t x, GUI_iDim_t y, GUI_Dim_t width, GUI_Dim_t height);
+
 /**
  * \brief           Set X and Y coordinates relative to parent object
  * \note            Since this function is private, it can only be used by user inside GUI library
@@ -449,6 +463,17 @@ uint8_t __GUI_WIDGET_IsChildOf(GUI_HANDLE_p h, GUI_HANDLE_p parent);
  */
 uint8_t __GUI_WIDGET_IsFontAndTextSet(GUI_HANDLE_p h);
 
+/**
+ * \brief           Get pre-decoded widget text for drawing
+ * \note            Since this function is private, it can only be used by user inside GUI library
+ * \note            Text is decoded again only when text or font changes.
+ *                  Widgets with text from string table use run shared with other widgets with the same string and font
+ * \param[in]       h: Widget handle
+ * \retval          > 0: Pointer to \ref GUI_DRAW_TEXTRUN_t for \ref GUI_DRAW_FONT_t.Run field
+ * \retval          0: Text run is disabled or not available, text is decoded while drawing
+ */
+struct GUI_DRAW_TEXTRUN_t* __GUI_WIDGET_GetTextRun(GUI_HANDLE_p h);
+
 /**
  * \brief           Process text key (add character, remove it, move cursor, etc)
  * \note            Since this function is private, it can only be used by user inside GUI library
@@ -766,6 +791,9 @@ uint8_t GUI_WIDGET_FreeTextMemory(GUI_HANDLE_p h);
  * \note            If dynamic memory allocation was used then content will be copied to allocated memory
  *                     otherwise only pointer to input text will be used 
  *                     and each further change of input pointer text will affect to output
+ *
+ * \note            Widget is redrawn only when text content changed since last call.
+ *                     When user buffer is modified in place, call this function with the same pointer to redraw widget
  * \param[in,out]   h: Widget handle
  * \param[in]       *text: Pointer to text to set to widget
  * \retval          1: Text was set ok
@@ -778,6 +806,20 @@ uint8_t GUI_WIDGET_FreeTextMemory(GUI_HANDLE_p h);
  */
 uint8_t GUI_WIDGET_SetText(GUI_HANDLE_p h, const GUI_Char* text);
 
+#if GUI_USE_STRTABLE || defined(DOXYGEN)
+/**
+ * \brief           Set text of widget from string table
+ * \note            Text is changed automatically when language is changed with \ref GUI_STRTABLE_SetLanguage.
+ *                     Call \ref GUI_WIDGET_SetText to set text not related to string table
+ * \param[in,out]   h: Widget handle
+ * \param[in]       id: String ID in \ref GUI_STRTABLE_t table
+ * \retval          1: Text was set ok
+ * \retval          0: Text was not set
+ * \sa              GUI_STRTABLE_SetLanguage
+ */
+uint8_t GUI_WIDGET_SetTextID(GUI_HANDLE_p h, uint16_t id);
+#endif /* GUI_USE_STRTABLE || defined(DOXYGEN) */
+
 /**
  * \brief           Get text from widget
  * \param[in,out]   h: Widget handle
@@ -999,6 +1041,7 @@ uint8_t GUI_WIDGET_SetScrollY(GUI_HANDLE_p h, GUI_iDim_t scroll);
 
 /**
  * \brief           Set default font for widgets used on widget creation
+ * \note            Font is set for current GUI context only and is reset when context is initialized
  * \param[in]       *font: Pointer to \ref GUI_FONT_t with font
  * \retval          1: Font was set ok
  * \retval          0: Font was not set
@@ -71,10 +71,6 @@ const static GUI_WIDGET_t Widget = {
 #define w          ((GUI_WINDOW_t *)h)
 static
 uint8_t GUI_WINDOW_Callback(GUI_HANDLE_p h, GUI_WC_t ctrl, void* param, void* result) {
-#if GUI_USE_TOUCH
-   static GUI_iDim_t tX, tY, Mode = 0;
-#endif /* GUI_USE_TOUCH */
-    
     __GUI_ASSERTPARAMS(h && __GH(h)->Widget == &Widget);    /* Check input parameters */
     switch (ctrl) {                                 /* Handle control function if required */
         case GUI_WC_Draw: {
@@ -156,6 +152,7 @@ uint8_t GUI_WINDOW_Callback(GUI_HANDLE_p h, GUI_WC_t ctrl, void* param, void* re
                     f.Align = GUI_HALIGN_CENTER | GUI_VALIGN_CENTER;
                     f.Color1Width = f.Width;
                     f.Color1 = __GUI_WIDGET_GetColor(h, GUI_WINDOW_COLOR_TEXT);
+                    f.Run = __GUI_WIDGET_GetTextRun(h); /* Use pre-decoded text */
                     GUI_DRAW_WriteText(disp, __GH(h)->Font, __GH(h)->Text, &f);
                 }
             }
@@ -175,9 +172,9 @@ uint8_t GUI_WINDOW_Callback(GUI_HANDLE_p h, GUI_WC_t ctrl, void* param, void* re
                 wi = __GUI_WIDGET_GetWidth(h);      /* Get widget width */
                 
                 if (ts->RelY[0] < pt && ts->RelX[0] < wi - pt) {
-                    Mode = 1;
-                    tX = ts->RelX[0];
-                    tY = ts->RelY[0];
+                    w->Moving = 1;
+                    w->TouchX = ts->RelX[0];
+                    w->TouchY = ts->RelY[0];
                 }
                 *(__GUI_TouchStatus_t *)result = touchHANDLED;  /* Set handled status */
             } else {
@@ -188,11 +185,11 @@ uint8_t GUI_WINDOW_Callback(GUI_HANDLE_p h, GUI_WC_t ctrl, void* param, void* re
         case GUI_WC_TouchMove: {
             __GUI_TouchData_t* ts = (__GUI_TouchData_t *)param; /* Get touch parameters */
             
-            if (Mode == 1) {
+            if (w->Moving) {
                 GUI_iDim_t pX, pY;
                 pX = __GUI_WIDGET_GetParentAbsoluteX(__GH(h));
                 pY = __GUI_WIDGET_GetParentAbsoluteY(__GH(h));
-                __GUI_WIDGET_SetXY(h, ts->TS.X[0] - pX - tX, ts->TS.Y[0] - pY - tY);
+                __GUI_WIDGET_SetXY(h, ts->TS.X[0] - pX - w->TouchX, ts->TS.Y[0] - pY - w->TouchY);
                 
                 if (__GUI_WIDGET_IsExpanded(h)) {   /* If it is expanded */
                     __GUI_WIDGET_SetExpanded(h, 0); /* Clear expanded mode */
@@ -202,7 +199,7 @@ uint8_t GUI_WINDOW_Callback(GUI_HANDLE_p h, GUI_WC_t ctrl, void* param, void* re
             return 1;
         }
         case GUI_WC_TouchEnd: {
-            Mode = 0;
+            w->Moving = 0;
             return 1;
         }
 #endif /* GUI_USE_TOUCH */
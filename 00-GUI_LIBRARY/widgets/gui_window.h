@@ -71,6 +71,11 @@ typedef struct GUI_WINDOW_t {
     
     GUI_Dim_t BorderRadius;                 /*!< Radius in units of pixels for children windows */
     GUI_Dim_t BorderWidth;                  /*!< Border width */
+#if GUI_USE_TOUCH || defined(DOXYGEN)
+    GUI_iDim_t TouchX;                      /*!< Relative touch X position when window move started */
+    GUI_iDim_t TouchY;                      /*!< Relative touch Y position when window move started */
+    uint8_t Moving;                         /*!< Set to 1 when window is moved by touch on top bar */
+#endif /* GUI_USE_TOUCH || defined(DOXYGEN) */
 } GUI_WINDOW_t;
 #endif /* defined(GUI_INTERNAL) || defined(DOXYGEN) */
     
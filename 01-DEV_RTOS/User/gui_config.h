@@ -58,6 +58,320 @@
  */
 #define GUI_USE_UNICODE                 1
 
+/**
+ * \brief           Enables (1) or disables (0) fixed-point math instead of floating-point
+ *
+ *                  When enabled, touch distance, graph scaling and antialiased text blending
+ *                    use Q16.16 fixed-point numbers and integer square root.
+ *
+ * \note            Use on targets without FPU (Cortex-M0) where each float operation is library call
+ */
+#define GUI_USE_FIXED_POINT             0
+
+/**
+ * \brief           Enables (1) or disables (0) glyph cache for fonts in external storage
+ *
+ *                  Fonts with \ref GUI_FONT_t.Ext set keep only character table in memory.
+ *                  Bitmaps are read on demand with read callback to RAM cache with LRU replacement
+ */
+#define GUI_USE_FONT_CACHE              0
+
+/**
+ * \brief           Number of glyphs in font cache
+ */
+#define GUI_FONT_CACHE_ENTRIES          32
+
+/**
+ * \brief           Maximal size of single glyph bitmap in font cache in units of bytes
+ *
+ * \note            Glyphs with bigger bitmap are not drawn.
+ *                  Fonts with \ref GUI_FLAG_FONT_AA4 or \ref GUI_FLAG_FONT_AA8 flag use 2 or 4 times more memory per glyph than 2-bit anti-aliased fonts
+ */
+#define GUI_FONT_CACHE_GLYPH_SIZE       128
+
+/**
+ * \brief           Timestamp used to measure glyph read latency in font cache statistics
+ *
+ * \note            Set to high resolution counter (for example CPU cycle counter) for precise results
+ */
+#define GUI_FONT_CACHE_TIMESTAMP()      (GUI.Time)
+
+/**
+ * \brief           Enables (1) or disables (0) scalable outline fonts
+ *
+ *                  Fonts of any pixel size are created from single outline font,
+ *                  glyphs are rasterized to font cache on first use
+ *
+ * \note            \ref GUI_USE_FONT_CACHE must be enabled
+ * \sa              GUI_OUTLINE
+ */
+#define GUI_USE_OUTLINE_FONT            0
+
+/**
+ * \brief           Enables (1) or disables (0) vector paths
+ *
+ *                  Shapes of lines and quadratic and cubic curves are filled
+ *                  with anti-aliasing at any size
+ *
+ * \sa              GUI_PATH
+ */
+#define GUI_USE_PATH                    0
+
+/**
+ * \brief           Number of coverage cells for vector path rasterizer
+ *
+ *                  Path is rasterized in blocks, each pixel of block uses 16 cells of 4 bytes, one per sampled scanline,
+ *                  and each pixel row one more pixel for crossings on right edge.
+ *                  Shape is rasterized in single block when buffer is big enough, minimal value is 32
+ */
+#define GUI_PATH_CELLS                  4096
+
+/**
+ * \brief           Enables (1) or disables (0) cache of images converted to ARGB8888 format
+ *
+ *                  Used when low-level driver can not draw image in its original format (RGB565, L8)
+ *                  and software conversion is used
+ */
+#define GUI_USE_IMAGE_CACHE             0
+
+/**
+ * \brief           Maximal number of images in converted image cache
+ */
+#define GUI_IMAGE_CACHE_ENTRIES         4
+
+/**
+ * \brief           Maximal memory for converted images in units of bytes
+ */
+#define GUI_IMAGE_CACHE_SIZE            (64 * 1024)
+
+/**
+ * \brief           Get pointer to GUI context of current thread
+ *
+ *                  By default, context selected with \ref GUI_CTX_Set is used for all threads.
+ *                  To process multiple contexts from different threads in parallel,
+ *                  set it to read context pointer from thread local storage of operating system
+ *                  and set \ref GUI_MEM_LOCK to protect memory statistics shared by all contexts.
+ *
+ *                  With FreeRTOS, set configNUM_THREAD_LOCAL_STORAGE_POINTERS to at least 1,
+ *                  call vTaskSetThreadLocalStoragePointer(NULL, 0, ctx) at start of each GUI task and use:
+ *                  \code{c}
+ *                  #define GUI_CONTEXT_GET()   (pvTaskGetThreadLocalStoragePointer(NULL, 0) ? \
+ *                                              (GUI_t *)pvTaskGetThreadLocalStoragePointer(NULL, 0) : __GUI_Context)
+ *                  \endcode
+ *
+ * \note            Default value is one pointer for all threads. When two tasks process different
+ *                  contexts at the same time, they both use context set last with \ref GUI_CTX_Set
+ */
+#define GUI_CONTEXT_GET()               (__GUI_Context)
+
+/**
+ * \brief           Enables (1) or disables (0) pipelined rendering
+ *
+ *                  When enabled with \ref GUI_PIPELINE_Enable, \ref GUI_Process only records drawing commands
+ *                  and another task rasterizes them with \ref GUI_PIPELINE_Process
+ */
+#define GUI_USE_PIPELINE                0
+
+/**
+ * \brief           Maximal number of recorded frames waiting for rasterization
+ */
+#define GUI_PIPELINE_FRAMES             2
+
+/**
+ * \brief           Number of command blocks shared between recording and rasterization
+ */
+#define GUI_PIPELINE_BLOCKS             4
+
+/**
+ * \brief           Size of single command block in units of bytes, up to 65532 bytes
+ */
+#define GUI_PIPELINE_BLOCK_SIZE         (8 * 1024)
+
+/**
+ * \brief           Called by pipeline task while waiting for the other one
+ *
+ *                  Must let other task run, set to RTOS delay function (sched_yield() on host).
+ *                  Function must be declared when \ref GUI_USE_PIPELINE is enabled
+ */
+#define GUI_PIPELINE_YIELD()            osDelay(1)
+
+/**
+ * \brief           Number of \ref GUI_PIPELINE_YIELD calls \ref GUI_PIPELINE_Disable waits for rasterization task
+ *
+ *                  When \ref GUI_PIPELINE_Process is not called for this number of yields,
+ *                  there is no rasterization task and remaining commands are rasterized by caller of \ref GUI_PIPELINE_Disable
+ */
+#define GUI_PIPELINE_STOP_TIMEOUT       100
+
+/**
+ * \brief           Full memory barrier between recording and rasterization task
+ */
+#define GUI_PIPELINE_BARRIER()          __sync_synchronize()
+
+/**
+ * \brief           Enables (1) or disables (0) remote display streaming
+ *
+ *                  Changed parts of each frame are sent with \ref GUI_REMOTE_Enable transport
+ *                  and remote input is received with \ref GUI_REMOTE_Receive
+ */
+#define GUI_USE_REMOTE                  0
+
+/**
+ * \brief           Size of remote display output buffer in units of bytes
+ */
+#define GUI_REMOTE_BUFFER_SIZE          128
+
+/**
+ * \brief           Lock remote display pointer of context
+ *
+ *                  Protects remote display against \ref GUI_REMOTE_Disable while it is used
+ *                  by \ref GUI_REMOTE_Receive in interrupt or other thread and by rasterization task of pipeline.
+ *                  Lock is held only for a few instructions, disabling interrupts is sufficient
+ */
+#define GUI_REMOTE_LOCK()               __disable_irq()
+
+/**
+ * \brief           Unlock remote display pointer locked with \ref GUI_REMOTE_LOCK
+ */
+#define GUI_REMOTE_UNLOCK()             __enable_irq()
+
+/**
+ * \brief           Called by \ref GUI_REMOTE_Disable while waiting for other users of remote display to finish
+ *
+ *                  Must let other task run, set to RTOS delay function (sched_yield() on host)
+ */
+#define GUI_REMOTE_YIELD()              osDelay(1)
+
+#if GUI_USE_PIPELINE || GUI_USE_REMOTE
+#include "cmsis_os.h"                       /* Functions used by pipeline and remote display */
+#endif /* GUI_USE_PIPELINE || GUI_USE_REMOTE */
+
+/**
+ * \brief           Enables (1) or disables (0) debug overlay
+ *
+ *                  Overlay with frame statistics and dirty regions is controlled with \ref GUI_HUD_SetFlags
+ */
+#define GUI_USE_HUD                     0
+
+/**
+ * \brief           Number of frames dirty region outline is visible
+ */
+#define GUI_HUD_FLASH_FRAMES            4
+
+/**
+ * \brief           Maximal number of pixels below overlay saved for restore on next frame
+ */
+#define GUI_HUD_SAVE_PIXELS             8192
+
+/**
+ * \brief           Get number of bytes currently allocated from heap, shown on overlay
+ *
+ *                  Used only when \ref GUI_USE_MEM_STATS is disabled,
+ *                  otherwise memory allocated by GUI is read with \ref GUI_MEM_GetStats
+ */
+#define GUI_HUD_HEAP_USED()             0
+
+/**
+ * \brief           Time for background jobs in each \ref GUI_Process call in units of milliseconds
+ */
+#define GUI_JOB_SLICE                   5
+
+/**
+ * \brief           Maximal number of background job steps in each \ref GUI_Process call
+ *
+ *                  Limits processing when GUI time is not updated during processing
+ */
+#define GUI_JOB_MAX_STEPS               1000
+
+/**
+ * \brief           Number of bytes read or decoded in each step of background image loading
+ *
+ *                  See \ref GUI_IMAGE_SetSourceAsync
+ */
+#define GUI_IMAGE_LOAD_CHUNK            2048
+
+/**
+ * \brief           Enables (1) or disables (0) memory accounting
+ *
+ *                  Each allocation is counted to its category, statistics are available with \ref GUI_MEM_GetStats
+ */
+#define GUI_USE_MEM_STATS               1
+
+/**
+ * \brief           Number of widget types with separate memory statistics
+ */
+#define GUI_MEM_WIDGET_TYPES            16
+
+/**
+ * \brief           Get number of free bytes in heap from allocator
+ */
+#define GUI_MEM_HEAP_FREE()             0
+
+/**
+ * \brief           Get size of largest free block in heap from allocator
+ */
+#define GUI_MEM_HEAP_LARGEST()          0
+
+/**
+ * \brief           Lock memory statistics, shared by all GUI contexts
+ *
+ *                  Allocator and its statistics are common for all contexts.
+ *                  When contexts are processed from different threads in parallel,
+ *                  set it to lock OS mutex and \ref GUI_MEM_UNLOCK to unlock it
+ */
+#define GUI_MEM_LOCK()
+
+/**
+ * \brief           Unlock memory statistics locked with \ref GUI_MEM_LOCK
+ */
+#define GUI_MEM_UNLOCK()
+
+/**
+ * \brief           Enables (1) or disables (0) pre-decoded widget text
+ *
+ *                  Widget text is decoded to characters and font glyphs once when text or font changes,
+ *                  instead of several times on each redraw. It uses 8 bytes of memory per character on 32-bit systems.
+ *
+ * \note            When text buffer is modified in place, \ref GUI_WIDGET_SetText must be called to decode it again
+ */
+#define GUI_USE_TEXT_RUN                0
+
+/**
+ * \brief           Number of text rectangles with measured lines kept in each text run
+ *
+ *                  Lines of string are measured once for each rectangle width, line height and drawing flags
+ *                  and reused on each redraw. Must be at least 1.
+ */
+#define GUI_TEXT_RUN_LAYOUTS            2
+
+/**
+ * \brief           Enables (1) or disables (0) localized string tables
+ *
+ *                  Widgets take text from table of current language by string ID,
+ *                  strings are decoded and measured once and shared between widgets.
+ *                  Language switch updates all widgets without text measurement during redraw
+ *
+ * \sa              GUI_STRTABLE
+ */
+#define GUI_USE_STRTABLE                1
+
+/**
+ * \brief           Enables (1) or disables (0) font fallback chain
+ *
+ *                  Characters not in font are taken from first font in \ref GUI_FONT_t.Fallback chain with character.
+ *                  Resolved characters are kept in small direct-mapped cache
+ *
+ * \note            Fallback chain must not be changed after font is used for drawing
+ */
+#define GUI_USE_FONT_FALLBACK           1
+
+/**
+ * \brief           Number of entries in cache of characters resolved in fallback chain
+ *
+ *                  Each entry uses 12 bytes of memory on 32-bit systems
+ */
+#define GUI_FONT_FALLBACK_CACHE_SIZE    32
+
 /**
  * \brief           Maximal number of touch entries in buffer
  */
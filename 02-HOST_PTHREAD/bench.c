@@ -0,0 +1,31 @@
+/**
+ * \brief   List of host benchmarks
+ */
+#include "bench.h"
+#include <string.h>
+
+typedef struct bench_t {
+    const char* Name;
+    void (*Run)(void);
+} bench_t;
+
+static const bench_t benchs[] = {
+    {"primitives", bench_primitives},
+    {"imgdec", bench_imgdec},
+    {"format", bench_format},
+};
+
+/* Run all benchmarks or only benchmark with name, return 0 when name is unknown */
+uint8_t bench_run(const char* name) {
+    uint8_t found = 0;
+    uint32_t i;
+
+    for (i = 0; i < GUI_COUNT_OF(benchs); i++) {
+        if (name && strcmp(name, benchs[i].Name)) {
+            continue;
+        }
+        benchs[i].Run();
+        found = 1;
+    }
+    return found;
+}
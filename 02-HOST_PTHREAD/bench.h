@@ -0,0 +1,19 @@
+/**
+ * \brief   Host benchmarks of library modules
+ *
+ *          Benchmarks are run with "./gui_host bench" or "./gui_host bench <name>"
+ *          and print average time of single operation in units of nanoseconds
+ */
+#ifndef BENCH_H
+#define BENCH_H
+
+#include "gui.h"
+#include <stdio.h>
+
+uint8_t bench_run(const char* name);
+
+void bench_primitives(void);
+void bench_imgdec(void);
+void bench_format(void);
+
+#endif
@@ -0,0 +1,55 @@
+/**
+ * \brief   Number formatting of GUI_STRING_Format functions compared with snprintf
+ */
+#include "bench.h"
+#include "gui_string.h"
+#include <time.h>
+
+#define COUNT           100
+
+/* Get monotonic time in units of nanoseconds */
+static
+uint64_t time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+void bench_format(void) {
+    static const float values[] = {0.0f, 3.14159f, -273.15f, 1234.5678f, 99999.99f, -0.005f, 4000000.0f};
+    GUI_STRING_FORMAT_t fmt = {0, 2, 0, 0};
+    GUI_Char buff[32];
+    uint64_t start, t[6] = {0};
+    uint32_t i, k;
+
+    for (k = 0; k < COUNT; k++) {
+        for (i = 0; i < GUI_COUNT_OF(values); i++) {
+            start = time_ns();
+            snprintf((char *)buff, sizeof(buff), "%d", (int)(values[i] * 100.0f));
+            t[0] += time_ns() - start;
+
+            start = time_ns();
+            GUI_STRING_FormatInt(buff, sizeof(buff), (int32_t)(values[i] * 100.0f), NULL);
+            t[1] += time_ns() - start;
+
+            start = time_ns();
+            snprintf((char *)buff, sizeof(buff), "%.2f", values[i]);
+            t[2] += time_ns() - start;
+
+            start = time_ns();
+            GUI_STRING_FormatFloat(buff, sizeof(buff), values[i], &fmt);
+            t[3] += time_ns() - start;
+
+            start = time_ns();
+            GUI_STRING_FormatFixed(buff, sizeof(buff), GUI_FIXED_FROM_FLOAT(values[i] / 1000.0f), &fmt);
+            t[4] += time_ns() - start;
+
+            start = time_ns();
+            GUI_STRING_Format(buff, sizeof(buff), _T("%.2f"), values[i]);
+            t[5] += time_ns() - start;
+        }
+    }
+    k = COUNT * GUI_COUNT_OF(values);
+    printf("Format int: snprintf %u, GUI %u; float: snprintf %u, GUI %u, fixed %u, GUI_STRING_Format %u\r\n",
+        (unsigned)(t[0] / k), (unsigned)(t[1] / k), (unsigned)(t[2] / k), (unsigned)(t[3] / k), (unsigned)(t[4] / k), (unsigned)(t[5] / k));
+}
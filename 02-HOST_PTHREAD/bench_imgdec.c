@@ -0,0 +1,82 @@
+/**
+ * \brief   Drawing of RLE compressed images compared with raw images
+ *
+ *          Image with long runs and image without runs are measured, the latter is the worst case of decoder
+ */
+#include "bench.h"
+#include "gui_draw.h"
+#include "gui_imgdec.h"
+#include <string.h>
+#include <time.h>
+
+#define COUNT           20
+
+/* Get monotonic time in units of nanoseconds */
+static
+uint64_t time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/* Encode ARGB8888 pixels to RLE format of image decoder, returns number of bytes */
+static
+uint32_t rle_encode(const uint32_t* raw, uint32_t count, uint8_t* out) {
+    uint32_t i = 0, n, len = 0;
+
+    while (i < count) {
+        for (n = 1; i + n < count && n < 128 && raw[i + n] == raw[i]; n++);
+        if (n > 1) {                                /* Repeated pixel */
+            out[len++] = 0x80 | (n - 1);
+            memcpy(&out[len], &raw[i], 4);
+            len += 4;
+        } else {                                    /* Literal pixels until next repeat */
+            for (; i + n < count && n < 128 && (i + n + 1 == count || raw[i + n] != raw[i + n + 1]); n++);
+            out[len++] = n - 1;
+            memcpy(&out[len], &raw[i], 4 * n);
+            len += 4 * n;
+        }
+        i += n;
+    }
+    return len;
+}
+
+void bench_imgdec(void) {
+    static uint32_t raw[64 * 64];
+    static uint8_t rle[64 * 64 * 4 + 64];
+    static GUI_Color_t line[64];
+    GUI_Display_t disp = {0, 0, 480, 272};
+    GUI_IMAGE_DESC_t img_raw = {64, 64, GUI_IMAGE_FORMAT_ARGB8888, (const GUI_Byte *)raw, NULL, 0, sizeof(raw)};
+    GUI_IMAGE_DESC_t img_rle = {64, 64, GUI_IMAGE_FORMAT_RLE, rle, NULL, 0, 0};
+    GUI_IMGDEC_t dec;
+    uint64_t start, t[6] = {0};
+    uint32_t i, k, y, size[2];
+
+    GUI_Init();
+    for (k = 0; k < 2; k++) {
+        for (i = 0; i < GUI_COUNT_OF(raw); i++) {   /* Stripes with long runs first, then noise without runs */
+            raw[i] = k ? 0xFF000000UL | (i * 2654435761UL >> 8) : 0xFF000000UL | ((i / 256) * 0x00102030UL);
+        }
+        size[k] = img_rle.Size = rle_encode(raw, GUI_COUNT_OF(raw), rle);
+        for (i = 0; i < COUNT; i++) {
+            start = time_ns();
+            GUI_DRAW_Image(&disp, 10 + i, 10, &img_raw, GUI_COLOR_WHITE);
+            t[3 * k + 0] += time_ns() - start;
+
+#if GUI_USE_IMAGE_CACHE
+            GUI_DRAW_ImageCacheRemove(&img_rle);    /* Measure decoding, not cache */
+#endif /* GUI_USE_IMAGE_CACHE */
+            start = time_ns();
+            GUI_DRAW_Image(&disp, 10 + i, 10, &img_rle, GUI_COLOR_WHITE);
+            t[3 * k + 1] += time_ns() - start;
+
+            start = time_ns();
+            GUI_IMGDEC_Init(&dec, &img_rle);
+            for (y = 0; y < img_rle.Height && GUI_IMGDEC_Read(&dec, line, GUI_COUNT_OF(line)); y++);
+            t[3 * k + 2] += time_ns() - start;
+        }
+    }
+    printf("Image 64x64 stripes: raw %u, RLE %u, decode only %u (RLE %u bytes); noise: raw %u, RLE %u, decode only %u (RLE %u bytes)\r\n",
+        (unsigned)(t[0] / COUNT), (unsigned)(t[1] / COUNT), (unsigned)(t[2] / COUNT), (unsigned)size[0],
+        (unsigned)(t[3] / COUNT), (unsigned)(t[4] / COUNT), (unsigned)(t[5] / COUNT), (unsigned)size[1]);
+}
@@ -0,0 +1,70 @@
+/**
+ * \brief   Anti-aliased primitives compared with aliased ones
+ *
+ *          Anti-aliased version is expected to take about 2 times longer than aliased one
+ */
+#include "bench.h"
+#include "gui_draw.h"
+#include <time.h>
+
+#define COUNT           100
+
+/* Get monotonic time in units of nanoseconds */
+static
+uint64_t time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+void bench_primitives(void) {
+    GUI_Display_t disp = {0, 0, 480, 272};
+    uint64_t start, t[10] = {0};
+    uint32_t i;
+
+    GUI_Init();
+    for (i = 0; i < COUNT; i++) {
+        start = time_ns();
+        GUI_DRAW_Line(&disp, 10, 10 + i, 470, 262 - i, GUI_COLOR_RED);
+        t[0] += time_ns() - start;
+
+        start = time_ns();
+        GUI_DRAW_LineAA(&disp, 10, 10 + i, 470, 262 - i, GUI_COLOR_RED);
+        t[1] += time_ns() - start;
+
+        start = time_ns();
+        GUI_DRAW_Circle(&disp, 240, 136, 20 + i, GUI_COLOR_RED);
+        t[2] += time_ns() - start;
+
+        start = time_ns();
+        GUI_DRAW_CircleAA(&disp, 240, 136, 20 + i, GUI_COLOR_RED);
+        t[3] += time_ns() - start;
+
+        start = time_ns();
+        GUI_DRAW_FilledCircle(&disp, 240, 136, 20 + i, GUI_COLOR_RED);
+        t[4] += time_ns() - start;
+
+        start = time_ns();
+        GUI_DRAW_FilledCircleAA(&disp, 240, 136, 20 + i, GUI_COLOR_RED);
+        t[5] += time_ns() - start;
+
+        start = time_ns();
+        GUI_DRAW_RoundedRectangle(&disp, 10, 10, 460, 252, 5 + i / 2, GUI_COLOR_RED);
+        t[6] += time_ns() - start;
+
+        start = time_ns();
+        GUI_DRAW_RoundedRectangleAA(&disp, 10, 10, 460, 252, 5 + i / 2, GUI_COLOR_RED);
+        t[7] += time_ns() - start;
+
+        start = time_ns();
+        GUI_DRAW_FilledRoundedRectangle(&disp, 10, 10, 460, 252, 5 + i / 2, GUI_COLOR_RED);
+        t[8] += time_ns() - start;
+
+        start = time_ns();
+        GUI_DRAW_FilledRoundedRectangleAA(&disp, 10, 10, 460, 252, 5 + i / 2, GUI_COLOR_RED);
+        t[9] += time_ns() - start;
+    }
+    printf("Line %u/%u, circle %u/%u, filled circle %u/%u, rounded rectangle %u/%u, filled rounded rectangle %u/%u (aliased/AA)\r\n",
+        (unsigned)(t[0] / COUNT), (unsigned)(t[1] / COUNT), (unsigned)(t[2] / COUNT), (unsigned)(t[3] / COUNT), (unsigned)(t[4] / COUNT),
+        (unsigned)(t[5] / COUNT), (unsigned)(t[6] / COUNT), (unsigned)(t[7] / COUNT), (unsigned)(t[8] / COUNT), (unsigned)(t[9] / COUNT));
+}
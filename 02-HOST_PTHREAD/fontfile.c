@@ -0,0 +1,75 @@
+/**
+ * \brief   Font with glyph bitmaps in file, read by font cache with simulated latency of external storage
+ */
+#include "fontfile.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Get number of bytes of character bitmap, the same as font cache reads */
+static
+uint32_t data_size(const GUI_FONT_t* font, const GUI_FONT_CharInfo_t* c) {
+    uint32_t ppb = 8;                               /* Pixels per byte */
+
+    if (font->Flags & GUI_FLAG_FONT_AA8) {
+        ppb = 1;
+    } else if (font->Flags & GUI_FLAG_FONT_AA4) {
+        ppb = 2;
+    } else if (font->Flags & GUI_FLAG_FONT_AA) {
+        ppb = 4;
+    }
+    return (uint32_t)((c->xSize + ppb - 1) / ppb) * c->ySize;
+}
+
+/* Read callback of font cache, waits for simulated latency before data are read */
+static
+uint8_t fontfile_read(void* param, uint32_t addr, GUI_Byte* data, uint32_t len) {
+    fontfile_t* f = (fontfile_t *)param;
+    struct timespec ts = {f->Latency / 1000000, (long)(f->Latency % 1000000) * 1000L};
+
+    if (f->Latency) {
+        nanosleep(&ts, NULL);
+    }
+    f->Reads++;
+    return !fseek(f->File, (long)addr, SEEK_SET) && fread(data, 1, len, f->File) == len;
+}
+
+/* Write bitmaps of font in memory to file and create font reading them with latency in microseconds */
+uint8_t fontfile_create(fontfile_t* f, const GUI_FONT_t* font, uint32_t latency) {
+    uint32_t i, count = font->EndChar - font->StartChar + 1, size;
+    long addr;
+
+    memset(f, 0x00, sizeof(*f));
+    f->Latency = latency;
+    f->File = tmpfile();
+    f->Chars = malloc(count * sizeof(*f->Chars));
+    if (!f->File || !f->Chars) {
+        fontfile_close(f);
+        return 0;
+    }
+    for (i = 0; i < count; i++) {
+        f->Chars[i] = font->Data[i];
+        size = data_size(font, &font->Data[i]);
+        addr = ftell(f->File);
+        if (size && fwrite(font->Data[i].Data, 1, size, f->File) != size) {
+            fontfile_close(f);
+            return 0;
+        }
+        f->Chars[i].Data = (const GUI_Byte *)(uintptr_t)addr;   /* Offset in file instead of pointer */
+    }
+    f->Ext.Read = fontfile_read;
+    f->Ext.Param = f;
+    f->Font = *font;
+    f->Font.Data = f->Chars;
+    f->Font.Ext = &f->Ext;
+    return 1;
+}
+
+void fontfile_close(fontfile_t* f) {
+    if (f->File) {
+        fclose(f->File);
+    }
+    free(f->Chars);
+    f->File = NULL;
+    f->Chars = NULL;
+}
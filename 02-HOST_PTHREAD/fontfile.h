@@ -0,0 +1,25 @@
+/**
+ * \brief   Font with glyph bitmaps in file, read by font cache with simulated latency of external storage
+ *
+ *          Bitmaps of font in memory are written to temporary file,
+ *          copy of character table holds file offsets as used with \ref GUI_FONT_t.Ext member
+ */
+#ifndef FONTFILE_H
+#define FONTFILE_H
+
+#include "gui.h"
+#include <stdio.h>
+
+typedef struct fontfile_t {
+    FILE* File;                                     /* Temporary file with glyph bitmaps */
+    uint32_t Latency;                               /* Simulated access time of single read in units of microseconds */
+    uint32_t Reads;                                 /* Number of reads from file */
+    GUI_FONT_CharInfo_t* Chars;                     /* Character table with file offsets */
+    GUI_FONT_Ext_t Ext;                             /* External storage description */
+    GUI_FONT_t Font;                                /* Font to draw with */
+} fontfile_t;
+
+uint8_t fontfile_create(fontfile_t* f, const GUI_FONT_t* font, uint32_t latency);
+void fontfile_close(fontfile_t* f);
+
+#endif
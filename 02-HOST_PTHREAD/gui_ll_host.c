@@ -0,0 +1,160 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2017 Tilen Majerle
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#define GUI_INTERNAL
+#include "gui_ll.h"
+
+/******************************************************************************/
+/******************************************************************************/
+/***                           Private definitions                           **/
+/******************************************************************************/
+/******************************************************************************/
+#define LCD_WIDTH                   480
+#define LCD_HEIGHT                  272
+#define GUI_LAYERS                  2
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private variables                            **/
+/******************************************************************************/
+/******************************************************************************/
+static GUI_Layer_t Layers[GUI_LAYERS];
+static uint32_t FrameBuffer[GUI_LAYERS][LCD_WIDTH * LCD_HEIGHT];    /* ARGB8888 frame buffers in memory */
+
+/******************************************************************************/
+/******************************************************************************/
+/***                            Private functions                            **/
+/******************************************************************************/
+/******************************************************************************/
+static
+void LCD_Init(GUI_LCD_t* LCD) {
+    memset(FrameBuffer, 0x00, sizeof(FrameBuffer));
+}
+
+static
+void LCD_SetPixel(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y, GUI_Color_t color) {
+    FrameBuffer[layer][(uint32_t)y * LCD->Width + x] = color;
+}
+
+static
+GUI_Color_t LCD_GetPixel(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y) {
+    return FrameBuffer[layer][(uint32_t)y * LCD->Width + x];
+}
+
+static
+void LCD_BlendPixel(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y, GUI_Color_t color) {
+    uint32_t* addr = &FrameBuffer[layer][(uint32_t)y * LCD->Width + x];
+    uint32_t bg = *addr, a = color >> 24, rb, ag;
+    
+    /* Same blending as target driver, 2 channels in single multiplication */
+    rb = bg & 0x00FF00FFUL;                         /* Red and blue channel */
+    rb += (((color & 0x00FF00FFUL) - rb) * a) >> 8;
+    ag = (bg >> 8) & 0x00FF00FFUL;                  /* Alpha and green channel, alpha moves towards opaque */
+    ag += (((((color >> 8) & 0xFFUL) | 0x00FF0000UL) - ag) * a) >> 8;
+    *addr = ((ag & 0x00FF00FFUL) << 8) | (rb & 0x00FF00FFUL);
+}
+
+static
+void LCD_Fill(GUI_LCD_t* LCD, uint8_t layer, void* dst, GUI_Dim_t xSize, GUI_Dim_t ySize, GUI_Dim_t offLine, GUI_Color_t color) {
+    uint32_t* d = (uint32_t *)dst;
+    GUI_Dim_t x, y;
+    
+    for (y = 0; y < ySize; y++, d += offLine) {
+        for (x = 0; x < xSize; x++) {
+            *d++ = color;
+        }
+    }
+}
+
+static
+void LCD_Copy(GUI_LCD_t* LCD, uint8_t layer, void* src, void* dst, GUI_Dim_t xSize, GUI_Dim_t ySize, GUI_Dim_t offLineSrc, GUI_Dim_t offLineDst) {
+    uint32_t* s = (uint32_t *)src;
+    uint32_t* d = (uint32_t *)dst;
+    GUI_Dim_t y;
+    
+    for (y = 0; y < ySize; y++, s += xSize + offLineSrc, d += xSize + offLineDst) {
+        memcpy(d, s, (size_t)xSize * 4);
+    }
+}
+
+static
+void LCD_FillRect(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t xSize, GUI_Dim_t ySize, GUI_Color_t color) {
+    LCD_Fill(LCD, layer, &FrameBuffer[layer][(uint32_t)y * LCD->Width + x], xSize, ySize, LCD->Width - xSize, color);
+}
+
+static
+void LCD_DrawHLine(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t length, GUI_Color_t color) {
+    LCD_FillRect(LCD, layer, x, y, length, 1, color);
+}
+
+static
+void LCD_DrawVLine(GUI_LCD_t* LCD, uint8_t layer, GUI_Dim_t x, GUI_Dim_t y, GUI_Dim_t length, GUI_Color_t color) {
+    LCD_FillRect(LCD, layer, x, y, 1, length, color);
+}
+
+/******************************************************************************/
+/******************************************************************************/
+/***                                Public API                               **/
+/******************************************************************************/
+/******************************************************************************/
+uint8_t GUI_LL_Init(GUI_LCD_t* LCD, GUI_LL_t* LL) {
+    uint8_t i;
+    
+    LCD->Width = LCD_WIDTH;
+    LCD->Height = LCD_HEIGHT;
+    LCD->LayersCount = GUI_LAYERS;
+    LCD->Layers = Layers;
+    for (i = 0; i < GUI_LAYERS; i++) {
+        Layers[i].Num = i;
+        Layers[i].StartAddress = (uint32_t)(uintptr_t)FrameBuffer[i];  /* Frame buffer must be in low 4GB, link with -no-pie */
+    }
+    
+    LL->Init = &LCD_Init;
+    LL->GetPixel = &LCD_GetPixel;
+    LL->SetPixel = &LCD_SetPixel;
+    LL->BlendPixel = &LCD_BlendPixel;
+    LL->Copy = &LCD_Copy;
+    LL->DrawHLine = &LCD_DrawHLine;
+    LL->DrawVLine = &LCD_DrawVLine;
+    LL->Fill = &LCD_Fill;
+    LL->FillRect = &LCD_FillRect;
+    return 0;
+}
+
+uint8_t GUI_LL_Control(GUI_LCD_t* LCD, GUI_LL_Command_t cmd, void* data) {
+    switch (cmd) {
+        case GUI_LL_Command_SetActiveLayer: {   /* There is no vertical sync, layer is shown immediately */
+            GUI_LCD_ConfirmActiveLayer(*(GUI_Byte *)data);
+            break;
+        }
+        default:
+            break;
+    }
+    return 1;
+}
+
+uint32_t* GUI_LL_GetFrameBuffer(uint8_t layer) {
+    return FrameBuffer[layer];
+}
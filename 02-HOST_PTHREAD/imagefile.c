@@ -0,0 +1,54 @@
+/**
+ * \brief   Image data in file, read in background by image widget with simulated latency of storage
+ */
+#include "imagefile.h"
+#include <string.h>
+#include <time.h>
+
+/* Get monotonic time in units of microseconds */
+static
+uint32_t time_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000UL + (uint64_t)ts.tv_nsec / 1000);
+}
+
+/* Write image data to file, reads of it take latency in microseconds */
+uint8_t imagefile_create(imagefile_t* f, const void* data, uint32_t len, uint32_t latency) {
+    memset(f, 0x00, sizeof(*f));
+    f->Latency = latency;
+    f->File = tmpfile();
+    if (!f->File || fwrite(data, 1, len, f->File) != len) {
+        imagefile_close(f);
+        return 0;
+    }
+    return 1;
+}
+
+/* Read function for GUI_IMAGE_SetSourceAsync, returns 0 until read is completed */
+int32_t imagefile_read(void* param, uint32_t offset, void* buff, uint32_t len) {
+    imagefile_t* f = (imagefile_t *)param;
+    size_t r;
+
+    if (!f->Busy) {                                 /* Start new read */
+        f->Busy = 1;
+        f->Start = time_us();
+    }
+    if ((time_us() - f->Start) < f->Latency) {      /* Transfer is not finished yet */
+        f->Polls++;
+        return 0;
+    }
+    f->Busy = 0;
+    f->Reads++;
+    if (fseek(f->File, (long)offset, SEEK_SET) || (r = fread(buff, 1, len, f->File)) == 0) {
+        return -1;
+    }
+    return (int32_t)r;
+}
+
+void imagefile_close(imagefile_t* f) {
+    if (f->File) {
+        fclose(f->File);
+    }
+    f->File = NULL;
+}
@@ -0,0 +1,26 @@
+/**
+ * \brief   Image data in file, read in background by image widget with simulated latency of storage
+ *
+ *          Read is started on first call of read function and completes after latency,
+ *          calls before that return 0 the same as non-blocking transfer of SD card or external flash
+ */
+#ifndef IMAGEFILE_H
+#define IMAGEFILE_H
+
+#include "gui.h"
+#include <stdio.h>
+
+typedef struct imagefile_t {
+    FILE* File;                                     /* Temporary file with image data */
+    uint32_t Latency;                               /* Simulated time of single read in units of microseconds */
+    uint32_t Start;                                 /* Start time of read in progress */
+    uint8_t Busy;                                   /* Read is in progress */
+    uint32_t Reads;                                 /* Number of completed reads */
+    uint32_t Polls;                                 /* Number of calls while read was in progress */
+} imagefile_t;
+
+uint8_t imagefile_create(imagefile_t* f, const void* data, uint32_t len, uint32_t latency);
+int32_t imagefile_read(void* param, uint32_t offset, void* buff, uint32_t len);
+void imagefile_close(imagefile_t* f);
+
+#endif
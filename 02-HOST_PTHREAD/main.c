@@ -0,0 +1,174 @@
+/**
+ * Host example for pipelined rendering with POSIX threads
+ *
+ * Frame buffers are kept in memory, no display is shown.
+ * Same scene is drawn first with single task (GUI_Process draws everything)
+ * and then with pipeline, where main thread records frames and second thread rasterizes them.
+ * Average frame time is printed for both, together with check that final screens are the same.
+ *
+ * Application logic of each frame is emulated with sleep, its time is set with first argument in microseconds.
+ * It stands for logic waiting for sensors or communication, rasterization of previous frame runs meanwhile
+ * even on single CPU core, as it does on MCU. With "busy" as second argument, logic is emulated with busy loop
+ * and pipeline can only be faster when both threads run on separate CPU cores.
+ *
+ * With "test" as first argument, host tests of library modules are run instead, see tests.h
+ * and with "bench" as first argument, host benchmarks of library modules are run, see bench.h
+ *
+ * \par Build and run from this directory
+ *
+ * All library sources are compiled except target low-level driver gui_ll.c, which is replaced with gui_ll_host.c
+ *
+\verbatim
+L=../00-GUI_LIBRARY
+gcc -O2 -no-pie -fno-pie -I. -I$L -I$L/utils -I$L/widgets -I$L/input \
+    $(ls $L/gui*.c | grep -v gui_ll.c) $L/utils/gui_*.c $L/widgets/gui_*.c $L/input/gui_*.c \
+    ../01-DEV_RTOS/User/Arial_Bold_AA.c *.c -lm -lpthread -o gui_host
+./gui_host 2000
+./gui_host 2000 busy
+./gui_host test
+./gui_host bench
+\endverbatim
+ */
+#include "gui.h"
+#include "gui_pipeline.h"
+#include "gui_window.h"
+#include "gui_button.h"
+#include "gui_led.h"
+#include "gui_progbar.h"
+#include "gui_graph.h"
+#include "tests.h"
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+
+#define FRAMES          200
+
+extern GUI_Const GUI_FONT_t GUI_Font_Arial_Bold_18;
+
+static volatile uint8_t raster_run;
+static uint8_t logic_busy;
+static GUI_HANDLE_p progbar, led, graph;
+static GUI_GRAPH_DATA_p graphdata;
+static uint32_t screen[480 * 272];
+
+/* Get monotonic time in units of microseconds */
+static
+uint32_t time_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000UL + (uint64_t)ts.tv_nsec / 1000);
+}
+
+/* Rasterization task */
+static
+void* raster_thread(void* arg) {
+    GUI_t* ctx = (GUI_t *)arg;
+    struct timespec ts = {0, 20000};
+
+    while (raster_run) {
+        if (!GUI_PIPELINE_Process(ctx)) {           /* Sleep when idle, yielding only would take CPU from logic on single core */
+            nanosleep(&ts, NULL);
+        }
+    }
+    return NULL;
+}
+
+/* Create widgets for benchmark */
+static
+void scene_create(void) {
+    GUI_HANDLE_p win, h;
+    uint32_t i;
+
+    GUI_WIDGET_SetFontDefault(&GUI_Font_Arial_Bold_18);
+    win = GUI_WINDOW_GetDesktop();
+    for (i = 0; i < 6; i++) {
+        h = GUI_BUTTON_Create(i, 5 + (i % 3) * 160, 5 + (i / 3) * 50, 150, 40, win, 0, 0);
+        GUI_WIDGET_SetText(h, _T("Button"));
+    }
+    progbar = GUI_PROGBAR_Create(10, 5, 110, 470, 30, win, 0, 0);
+    led = GUI_LED_Create(11, 440, 150, 30, 30, win, 0, 0);
+    GUI_LED_SetType(led, GUI_LED_TYPE_CIRCLE);
+    graph = GUI_GRAPH_Create(12, 5, 150, 420, 117, win, 0, 0);
+    graphdata = GUI_GRAPH_DATA_Create(GUI_GRAPH_TYPE_YT, 64);
+    GUI_GRAPH_AttachData(graph, graphdata);
+}
+
+/* Emulate application logic and update widgets for next frame */
+static
+void scene_update(uint32_t frame, uint32_t logic) {
+    uint32_t start = time_us();
+    struct timespec ts = {0, (long)logic * 1000L};
+
+    if (logic_busy) {
+        while ((time_us() - start) < logic);        /* Busy application logic */
+    } else {
+        nanosleep(&ts, NULL);                       /* Application logic waiting for data */
+    }
+    GUI_PROGBAR_SetValue(progbar, frame % 100);
+    GUI_LED_Toggle(led);
+    GUI_GRAPH_DATA_AddValue(graphdata, 0, (int16_t)((frame * 37) % 100));
+    GUI_WIDGET_Invalidate(GUI_WINDOW_GetDesktop());    /* Redraw full screen */
+}
+
+/* Draw all frames and return average frame time in microseconds */
+static
+uint32_t run(uint32_t logic) {
+    GUI_PIPELINE_t* p;
+    uint32_t i, start;
+
+    start = time_us();
+    for (i = 0; i < FRAMES; i++) {
+        scene_update(i, logic);
+        while (!GUI_Process()) {                    /* Wait until frame is drawn or recorded */
+            sched_yield();
+        }
+    }
+    p = GUI_CTX_GetDefault()->Pipeline;
+    while (p && p->Consumed != p->Submitted) {      /* Wait for rasterization of last frames */
+        sched_yield();
+    }
+    return (time_us() - start) / FRAMES;
+}
+
+int main(int argc, char** argv) {
+    GUI_t* ctx = GUI_CTX_GetDefault();
+    GUI_PIPELINE_t* p;
+    pthread_t thread;
+    uint32_t logic = argc > 1 ? atoi(argv[1]) : 2000;
+    uint32_t single, pipelined, diff, i;
+
+    if (argc > 1 && !strcmp(argv[1], "test")) {     /* Run host tests */
+        return tests_run(argc > 2 ? argv[2] : NULL) ? 0 : 1;
+    }
+    if (argc > 1 && !strcmp(argv[1], "bench")) {    /* Run host benchmarks */
+        return bench_run(argc > 2 ? argv[2] : NULL) ? 0 : 1;
+    }
+    logic_busy = argc > 2 && !strcmp(argv[2], "busy");
+
+    GUI_Init();                                     /* Single task drawing */
+    scene_create();
+    single = run(logic);
+    memcpy(screen, GUI_LL_GetFrameBuffer(ctx->LCD.ActiveLayer), sizeof(screen));
+
+    GUI_Init();                                     /* Pipelined drawing */
+    GUI_PIPELINE_Enable();
+    raster_run = 1;
+    pthread_create(&thread, NULL, raster_thread, ctx);
+    scene_create();
+    pipelined = run(logic);
+    p = ctx->Pipeline;
+    printf("Pipeline: %u frames recorded, %u blocks, %u flushes\r\n", (unsigned)p->FramesRecorded, (unsigned)p->Submitted, (unsigned)p->Flushes);
+    GUI_PIPELINE_Disable();                         /* Rasterizes remaining frames, thread must still run */
+    raster_run = 0;
+    pthread_join(thread, NULL);
+
+    for (diff = 0, i = 0; i < GUI_COUNT_OF(screen); i++) {
+        diff += screen[i] != GUI_LL_GetFrameBuffer(ctx->LCD.ActiveLayer)[i];
+    }
+    printf("Frame time with %u us %s logic: single task %u us, pipelined %u us, %u different pixels\r\n",
+        (unsigned)logic, logic_busy ? "busy" : "waiting", (unsigned)single, (unsigned)pipelined, (unsigned)diff);
+    return 0;
+}
@@ -0,0 +1,66 @@
+/**
+ * \brief   Socket transport of remote display
+ */
+#include "remotesock.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+pthread_mutex_t remotesock_mutex = PTHREAD_MUTEX_INITIALIZER;   /* Used by GUI_REMOTE_LOCK on host */
+
+/* Create connected sockets, reads on device end do not block */
+uint8_t remotesock_open(remotesock_t* s) {
+    int fd[2];
+
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, fd)) {
+        return 0;
+    }
+    s->Device = fd[0];
+    s->Viewer = fd[1];
+    fcntl(s->Device, F_SETFL, fcntl(s->Device, F_GETFL) | O_NONBLOCK);
+    return 1;
+}
+
+/* Transport function for GUI_REMOTE_Enable, waits until viewer takes all data */
+uint8_t remotesock_send(const void* data, uint32_t len, void* param) {
+    remotesock_t* s = (remotesock_t *)param;
+    const uint8_t* d = (const uint8_t *)data;
+    ssize_t r;
+
+    while (len) {
+        r = write(s->Device, d, len);
+        if (r < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+            sched_yield();                          /* Socket buffer is full, viewer reads it */
+            continue;
+        }
+        if (r <= 0) {
+            return 0;
+        }
+        d += r;
+        len -= (uint32_t)r;
+    }
+    return 1;
+}
+
+/* Pass data received from viewer to remote display of context, returns number of processed packets */
+uint32_t remotesock_poll(remotesock_t* s, GUI_t* ctx) {
+    uint8_t buff[64];
+    uint32_t cnt = 0;
+    ssize_t r;
+
+    while ((r = read(s->Device, buff, sizeof(buff))) > 0) {
+        cnt += GUI_REMOTE_Receive(ctx, buff, (uint32_t)r);
+    }
+    return cnt;
+}
+
+void remotesock_close(remotesock_t* s) {
+    if (s->Device >= 0) {
+        close(s->Device);
+    }
+    if (s->Viewer >= 0) {
+        close(s->Viewer);
+    }
+    s->Device = s->Viewer = -1;
+}
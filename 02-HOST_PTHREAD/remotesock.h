@@ -0,0 +1,24 @@
+/**
+ * \brief   Socket transport of remote display
+ *
+ *          Connected pair of local sockets, device end is used by GUI and viewer end by viewer.
+ *          Frames are written to device end with \ref GUI_REMOTE_Enable transport function,
+ *          data written by viewer are passed to \ref GUI_REMOTE_Receive with remotesock_poll
+ */
+#ifndef REMOTESOCK_H
+#define REMOTESOCK_H
+
+#include "gui.h"
+#include "gui_remote.h"
+
+typedef struct remotesock_t {
+    int Device;                                     /* Device end of connection */
+    int Viewer;                                     /* Viewer end of connection */
+} remotesock_t;
+
+uint8_t remotesock_open(remotesock_t* s);
+uint8_t remotesock_send(const void* data, uint32_t len, void* param);
+uint32_t remotesock_poll(remotesock_t* s, GUI_t* ctx);
+void remotesock_close(remotesock_t* s);
+
+#endif
@@ -0,0 +1,70 @@
+/**
+ * \brief   Pixel formats of images drawn in software
+ */
+#include "tests.h"
+#include "gui_draw.h"
+#include <string.h>
+
+/* First pixel of each byte is in low nibble of A4 image, the same as DMA2D reads it */
+static
+uint8_t test_a4(void) {
+    static const GUI_Byte data[] = {0x0F, 0x80};
+    GUI_IMAGE_DESC_t img = {0};
+    GUI_Color_t buff[4];
+    GUI_Display_t disp = {0, 0, 480, 272};
+    GUI_t* ctx = GUI_CTX_GetDefault();
+    uint32_t* fb;
+
+    img.Width = 4;
+    img.Height = 1;
+    img.Format = GUI_IMAGE_FORMAT_A4;
+    img.Data = data;
+    TEST_ASSERT(GUI_DRAW_ImageDecode(&img, buff, 4, 0xFF00FF00));
+    TEST_ASSERT(buff[0] == 0xFF00FF00 && buff[1] == 0x0000FF00);
+    TEST_ASSERT(buff[2] == 0x0000FF00 && buff[3] == 0x8800FF00);
+
+    fb = GUI_LL_GetFrameBuffer(ctx->LCD.DrawingLayer);
+    GUI_DRAW_HLine(&disp, 0, 0, 4, 0xFF000000);
+    GUI_DRAW_Image(&disp, 0, 0, &img, 0xFF00FF00);
+    TEST_ASSERT(fb[0] == 0xFF00FF00 && fb[1] == 0xFF000000);
+    TEST_ASSERT(fb[2] == 0xFF000000 && fb[3] == 0xFF008800);
+    return 1;
+}
+
+/* Anti-aliased line drawn fully visible must have the same pixels as the same line clipped to smaller region */
+static
+uint8_t test_line_aa(void) {
+    static uint32_t screen[480 * 272];
+    static const GUI_Color_t colors[] = {0xFF3366CC, 0x80CC2211};
+    GUI_Display_t disp = {0, 0, 480, 272}, clip = {100, 50, 300, 200};
+    GUI_t* ctx = GUI_CTX_GetDefault();
+    uint32_t* fb = GUI_LL_GetFrameBuffer(ctx->LCD.DrawingLayer);
+    uint32_t i, k;
+    GUI_iDim_t x, y;
+
+    for (i = 0; i < GUI_COUNT_OF(colors); i++) {
+        for (k = 0; k < 2; k++) {
+            GUI_DRAW_FilledRectangle(&disp, 0, 0, 480, 272, 0xFF000000);
+            GUI_DRAW_LineAA(k ? &clip : &disp, 6, 5, 469, 258, colors[i]);
+            GUI_DRAW_LineAA(k ? &clip : &disp, 250, 3, 120, 268, colors[i]);
+            if (!k) {
+                memcpy(screen, fb, sizeof(screen));
+            }
+        }
+        for (y = 0; y < 272; y++) {
+            for (x = 0; x < 480; x++) {
+                if (x >= clip.X1 && x < clip.X2 && y >= clip.Y1 && y < clip.Y2) {
+                    TEST_ASSERT(fb[y * 480 + x] == screen[y * 480 + x]);
+                } else {
+                    TEST_ASSERT(fb[y * 480 + x] == 0xFF000000);
+                }
+            }
+        }
+    }
+    return 1;
+}
+
+uint8_t test_draw(void) {
+    GUI_Init();
+    return test_a4() && test_line_aa();
+}
@@ -0,0 +1,111 @@
+/**
+ * \brief   Font cache with glyph bitmaps read from file
+ *
+ *          Glyphs are read with simulated latency, least recently used glyph is replaced on miss
+ */
+#include "tests.h"
+#include "fontfile.h"
+#include "gui_draw.h"
+#include "gui_fontcache.h"
+#include <string.h>
+#include <time.h>
+
+#define LATENCY         1000                        /* Access time of file in units of microseconds */
+
+extern GUI_Const GUI_FONT_t GUI_Font_Arial_Bold_18;
+
+static uint32_t screen[480 * 30];
+
+/* Get monotonic time in units of microseconds */
+static
+uint32_t time_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000UL + (uint64_t)ts.tv_nsec / 1000);
+}
+
+/* Clear top of screen and draw text there */
+static
+void draw_text(const GUI_FONT_t* font, const GUI_Char* str) {
+    GUI_Display_t disp = {0, 0, 480, 272};
+    GUI_DRAW_FONT_t draw;
+
+    GUI_DRAW_FilledRectangle(&disp, 0, 0, 480, 30, 0xFFFFFFFF);
+    GUI_DRAW_FONT_Init(&draw);
+    draw.Width = 480;
+    draw.Height = 30;
+    draw.Color1Width = 480;
+    draw.Color1 = 0xFF000000;
+    GUI_DRAW_WriteText(&disp, font, str, &draw);
+}
+
+/* Glyphs from file are drawn the same as from memory, each of them is read only once */
+static
+uint8_t test_read(fontfile_t* f) {
+    GUI_FONTCACHE_Stats_t stats;
+    uint32_t* fb = GUI_LL_GetFrameBuffer(GUI_CTX_GetDefault()->LCD.DrawingLayer);
+    uint32_t start;
+
+    draw_text(&GUI_Font_Arial_Bold_18, _T("Hello"));
+    memcpy(screen, fb, sizeof(screen));
+
+    start = time_us();
+    draw_text(&f->Font, _T("Hello"));
+    TEST_ASSERT((time_us() - start) >= 4 * LATENCY);  /* 4 different glyphs are read */
+    TEST_ASSERT(!memcmp(screen, fb, sizeof(screen)));
+    TEST_ASSERT(GUI_FONTCACHE_GetStats(&stats, 1));
+    TEST_ASSERT(stats.Misses == 4 && stats.Hits == 1 && stats.Fetches == 4 && stats.Errors == 0);
+    TEST_ASSERT(f->Reads == 4);
+
+    draw_text(&f->Font, _T("Hello"));               /* All glyphs are in cache now */
+    TEST_ASSERT(!memcmp(screen, fb, sizeof(screen)));
+    TEST_ASSERT(GUI_FONTCACHE_GetStats(&stats, 1));
+    TEST_ASSERT(stats.Misses == 0 && stats.Hits == 5);
+    TEST_ASSERT(f->Reads == 4);
+    return 1;
+}
+
+/* When cache is full, least recently used glyph is replaced */
+static
+uint8_t test_lru(fontfile_t* f) {
+    GUI_FONTCACHE_Stats_t stats;
+    GUI_Char str[GUI_FONT_CACHE_ENTRIES + 1];
+    uint32_t i;
+
+    TEST_ASSERT(GUI_FONTCACHE_Flush());
+    f->Reads = 0;
+    for (i = 0; i < GUI_FONT_CACHE_ENTRIES; i++) {  /* Different glyph for each entry */
+        str[i] = (GUI_Char)('!' + i);
+    }
+    str[i] = 0;
+    draw_text(&f->Font, str);                       /* Fill cache, '!' is least recently used */
+    draw_text(&f->Font, _T("~"));                   /* Replaces '!' */
+    draw_text(&f->Font, &str[1]);                   /* All other glyphs stay in cache */
+    TEST_ASSERT(GUI_FONTCACHE_GetStats(&stats, 1));
+    TEST_ASSERT(stats.Misses == GUI_FONT_CACHE_ENTRIES + 1 && stats.Hits == GUI_FONT_CACHE_ENTRIES - 1);
+
+    draw_text(&f->Font, _T("!"));                   /* Read again, replaces '~' as least recently used */
+    draw_text(&f->Font, &str[1]);
+    TEST_ASSERT(GUI_FONTCACHE_GetStats(&stats, 1));
+    TEST_ASSERT(stats.Misses == 1 && stats.Hits == GUI_FONT_CACHE_ENTRIES - 1);
+    draw_text(&f->Font, _T("~"));
+    TEST_ASSERT(GUI_FONTCACHE_GetStats(&stats, 1));
+    TEST_ASSERT(stats.Misses == 1 && stats.Hits == 0);
+    TEST_ASSERT(f->Reads == GUI_FONT_CACHE_ENTRIES + 3);
+    return 1;
+}
+
+uint8_t test_fontcache(void) {
+    GUI_FONTCACHE_Stats_t stats;
+    fontfile_t f;
+    uint8_t res;
+
+    GUI_Init();
+    TEST_ASSERT(fontfile_create(&f, &GUI_Font_Arial_Bold_18, LATENCY));
+    GUI_FONTCACHE_Flush();
+    GUI_FONTCACHE_GetStats(&stats, 1);
+    res = test_read(&f) && test_lru(&f);
+    GUI_FONTCACHE_Flush();                          /* Character table is released, entries must not match new one */
+    fontfile_close(&f);
+    return res;
+}
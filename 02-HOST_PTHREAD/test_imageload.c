@@ -0,0 +1,84 @@
+/**
+ * \brief   Image loaded in background from file with latency
+ *
+ *          Lines are shown as they are read, placeholder color is drawn instead of lines not read yet
+ */
+#include "tests.h"
+#include "imagefile.h"
+#include "gui_image.h"
+#include "gui_window.h"
+
+#define WIDTH           64
+#define HEIGHT          40
+#define X               10
+#define Y               20
+#define PLACEHOLDER     0xFF123456
+#define LATENCY         2000                        /* Time of single read in units of microseconds */
+
+static uint32_t pixels[WIDTH * HEIGHT];
+
+/* Get number of image lines on screen, returns -1 when lines below them are not placeholder */
+static
+int32_t shown_lines(void) {
+    GUI_t* ctx = GUI_CTX_GetDefault();
+    const uint32_t* fb = GUI_LL_GetFrameBuffer(ctx->LCD.ActiveLayer);
+    uint32_t x, y, lines;
+
+    for (lines = 0; lines < HEIGHT; lines++) {      /* Lines equal to image */
+        if (memcmp(&fb[(Y + lines) * 480 + X], &pixels[lines * WIDTH], WIDTH * 4)) {
+            break;
+        }
+    }
+    for (y = lines; y < HEIGHT; y++) {              /* Remaining lines are placeholder */
+        for (x = 0; x < WIDTH; x++) {
+            if (fb[(Y + y) * 480 + X + x] != PLACEHOLDER) {
+                return -1;
+            }
+        }
+    }
+    return (int32_t)lines;
+}
+
+uint8_t test_imageload(void) {
+    GUI_IMAGE_DESC_t desc = {0};
+    GUI_HANDLE_p h;
+    imagefile_t f;
+    uint32_t i, x, y, steps = 0;
+    int32_t lines, prev = 0;
+
+    for (y = 0; y < HEIGHT; y++) {                  /* Different color on each line */
+        for (x = 0; x < WIDTH; x++) {
+            pixels[y * WIDTH + x] = 0xFF000000 | (y << 16) | (x << 8) | 0x80;
+        }
+    }
+    desc.Width = WIDTH;
+    desc.Height = HEIGHT;
+    desc.Format = GUI_IMAGE_FORMAT_ARGB8888;
+    desc.Size = sizeof(pixels);
+
+    GUI_Init();
+    TEST_ASSERT(imagefile_create(&f, pixels, sizeof(pixels), LATENCY));
+    h = GUI_IMAGE_Create(0, X, Y, WIDTH, HEIGHT, GUI_WINDOW_GetDesktop(), 0, 0);
+    TEST_ASSERT(h);
+    GUI_IMAGE_SetColor(h, GUI_IMAGE_COLOR_PLACEHOLDER, PLACEHOLDER);
+    TEST_ASSERT(GUI_IMAGE_SetSourceAsync(h, &desc, imagefile_read, &f));
+
+    for (i = 0; i < 1000000 && GUI_IMAGE_IsLoading(h); i++) {
+        GUI_Process();                              /* Redraw and read in background */
+        lines = shown_lines();
+        TEST_ASSERT(lines >= prev);                 /* Loaded lines are never replaced with placeholder */
+        steps += lines != prev;
+        prev = lines;
+    }
+    GUI_Process();                                  /* Redraw last lines */
+    TEST_ASSERT(!GUI_IMAGE_IsLoading(h));
+    TEST_ASSERT(shown_lines() == HEIGHT);
+    TEST_ASSERT(f.Reads == (sizeof(pixels) + GUI_IMAGE_LOAD_CHUNK - 1) / GUI_IMAGE_LOAD_CHUNK);
+    TEST_ASSERT(steps >= f.Reads - 1);              /* Each read was shown before next one completed */
+    TEST_ASSERT(f.Polls > 0);                       /* GUI was not blocked while read was in progress */
+
+    GUI_WIDGET_Remove(&h);
+    GUI_Process();
+    imagefile_close(&f);
+    return 1;
+}
@@ -0,0 +1,65 @@
+/**
+ * \brief   Fixed-point math checked against float math
+ *
+ *          Error is relative to result, or absolute for results below 1
+ */
+#include "tests.h"
+#include "gui_math.h"
+#include <math.h>
+
+#define MAX_ERROR       2e-5f                       /* Resolution of Q16.16 number is 1.5e-5, results are rounded down */
+
+/* Input values, zero is checked separately as functions do not write result for it */
+static const float values[] = {0.001f, 0.5f, 1.0f, 2.0f, 3.14159f, 100.0f, 1234.5678f, 30000.0f};
+
+/* Get error of fixed-point result against float result */
+static
+float error(GUI_Fixed_t fr, float r) {
+    return fabsf(GUI_FIXED_TO_FLOAT(fr) - r) / (r > 1.0f ? r : 1.0f);
+}
+
+/* Square root of 0 is invalid input for both versions */
+static
+uint8_t test_zero(void) {
+    GUI_Fixed_t fr = 0;
+    float r = 0;
+
+    TEST_ASSERT(!GUI_MATH_Sqrt(0.0f, &r));
+    TEST_ASSERT(!GUI_MATH_SqrtFixed(0, &fr));
+    TEST_ASSERT(!GUI_MATH_DistanceBetweenXY(1.0f, 2.0f, 1.0f, 2.0f, &r));
+    TEST_ASSERT(!GUI_MATH_DistanceBetweenXYFixed(GUI_FIXED_FROM_INT(1), GUI_FIXED_FROM_INT(2), GUI_FIXED_FROM_INT(1), GUI_FIXED_FROM_INT(2), &fr));
+    return 1;
+}
+
+static
+uint8_t test_ops(void) {
+    GUI_Fixed_t fx, fy, fr;
+    float r;
+    uint32_t i;
+
+    for (i = 0; i < GUI_COUNT_OF(values); i++) {
+        fx = GUI_FIXED_FROM_FLOAT(values[i]);
+        fy = GUI_FIXED_FROM_FLOAT(values[GUI_COUNT_OF(values) - 1 - i] / 4.0f);
+
+        TEST_ASSERT(GUI_MATH_Sqrt(GUI_FIXED_TO_FLOAT(fx), &r));   /* Compare with the same rounded input */
+        TEST_ASSERT(GUI_MATH_SqrtFixed(fx, &fr));
+        TEST_ASSERT(error(fr, r) < MAX_ERROR);
+
+        TEST_ASSERT(GUI_MATH_DistanceBetweenXY(0, 0, GUI_FIXED_TO_FLOAT(fx), GUI_FIXED_TO_FLOAT(fy), &r));
+        TEST_ASSERT(GUI_MATH_DistanceBetweenXYFixed(0, 0, fx, fy, &fr));
+        TEST_ASSERT(error(fr, r) < MAX_ERROR);
+
+        r = GUI_FIXED_TO_FLOAT(fx) * 0.75f;
+        fr = GUI_FIXED_MUL(fx, GUI_FIXED_FROM_FLOAT(0.75f));
+        TEST_ASSERT(error(fr, r) < MAX_ERROR);
+
+        r = GUI_FIXED_TO_FLOAT(fx) / 3.0f;
+        fr = GUI_FIXED_DIV(fx, GUI_FIXED_FROM_INT(3));
+        TEST_ASSERT(error(fr, r) < MAX_ERROR);
+    }
+    return 1;
+}
+
+uint8_t test_math(void) {
+    return test_zero() && test_ops();
+}
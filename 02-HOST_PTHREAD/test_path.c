@@ -0,0 +1,128 @@
+/**
+ * \brief   Fill rules of vector paths and outline fonts on partially covered pixel rows
+ *
+ *          Sub-paths meet in the middle of pixel row, so the row is covered
+ *          by different windings in upper and lower half of the pixel
+ */
+#include "tests.h"
+#include "gui_path.h"
+#include "gui_outline.h"
+#include <string.h>
+
+/* Add rectangle with corners in path units, reversed rectangle has opposite direction */
+static
+void path_rect(GUI_PATH_t* p, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint8_t reversed) {
+    GUI_PATH_MoveTo(p, x1, y1);
+    if (reversed) {
+        GUI_PATH_LineTo(p, x1, y2);
+        GUI_PATH_LineTo(p, x2, y2);
+        GUI_PATH_LineTo(p, x2, y1);
+    } else {
+        GUI_PATH_LineTo(p, x2, y1);
+        GUI_PATH_LineTo(p, x2, y2);
+        GUI_PATH_LineTo(p, x1, y2);
+    }
+    GUI_PATH_Close(p);
+}
+
+/* Get alpha value of pixel in rendered image */
+static
+uint8_t img_alpha(const GUI_IMAGE_DESC_t* img, uint32_t x, uint32_t y) {
+    return img->Data[y * img->Width + x];
+}
+
+/* Two squares in the same direction overlap, their top edge is at y = 10.5 */
+static
+uint8_t test_overlap(GUI_PATH_FILL_t rule) {
+    GUI_PATH_Elem_t elems[16];
+    GUI_IMAGE_DESC_t img;
+    GUI_PATH_t p;
+    uint32_t x;
+
+    GUI_PATH_Init(&p, elems, GUI_COUNT_OF(elems), 2);   /* 2 units per pixel */
+    path_rect(&p, 4, 21, 24, 40, 0);                /* Pixels 2 to 12 */
+    path_rect(&p, 12, 21, 32, 40, 0);               /* Pixels 6 to 16 */
+    TEST_ASSERT(GUI_PATH_RenderImage(&p, 1, rule, &img));
+    TEST_ASSERT(img.Width == 16 && img.Height == 20);
+    for (x = 2; x < 16; x++) {
+        if (x >= 6 && x < 12) {                     /* Winding 2 in lower half of row */
+            TEST_ASSERT(img_alpha(&img, x, 10) == (rule == GUI_PATH_FILL_EVENODD ? 0 : 128));
+            TEST_ASSERT(img_alpha(&img, x, 12) == (rule == GUI_PATH_FILL_EVENODD ? 0 : 255));
+        } else {
+            TEST_ASSERT(img_alpha(&img, x, 10) == 128);
+            TEST_ASSERT(img_alpha(&img, x, 12) == 255);
+        }
+        TEST_ASSERT(img_alpha(&img, x, 9) == 0);
+    }
+    GUI_PATH_FreeImage(&img);
+    return 1;
+}
+
+/* Two rectangles with opposite direction meet at y = 10.5, windings +1 and -1 cancel only in sum of the row */
+static
+uint8_t test_cancel(GUI_PATH_FILL_t rule) {
+    GUI_PATH_Elem_t elems[16];
+    GUI_IMAGE_DESC_t img;
+    GUI_PATH_t p;
+    uint32_t x, y;
+
+    GUI_PATH_Init(&p, elems, GUI_COUNT_OF(elems), 2);
+    path_rect(&p, 4, 0, 24, 21, 0);
+    path_rect(&p, 4, 21, 24, 40, 1);
+    TEST_ASSERT(GUI_PATH_RenderImage(&p, 1, rule, &img));
+    for (y = 0; y < 20; y++) {
+        for (x = 2; x < 12; x++) {
+            TEST_ASSERT(img_alpha(&img, x, y) == 255);
+        }
+    }
+    GUI_PATH_FreeImage(&img);
+    return 1;
+}
+
+/* Outline glyph with 2 contours of opposite direction meeting in the middle of pixel row */
+static const uint16_t glyph_ends[] = {3, 7};
+static const GUI_OUTLINE_Point_t glyph_points[] = {
+    {0, 11, 1}, {0, 32, 1}, {20, 32, 1}, {20, 11, 1},
+    {0, 0, 1}, {20, 0, 1}, {20, 11, 1}, {0, 11, 1},
+};
+
+/* Square extending 4 pixels left of pen position and above ascender */
+static const uint16_t square_ends[] = {3};
+static const GUI_OUTLINE_Point_t square_points[] = {
+    {-8, 0, 1}, {-8, 40, 1}, {12, 40, 1}, {12, 0, 1},
+};
+static const GUI_OUTLINE_Glyph_t glyphs[] = {
+    {0, 0, 20, 32, 24, 2, glyph_ends, glyph_points},
+    {-8, 0, 12, 40, 24, 1, square_ends, square_points},
+};
+static const GUI_OUTLINE_FONT_t outline = {_T("Test"), 32, 0, 'A', 'B', glyphs};
+
+static
+uint8_t test_outline(void) {
+    const GUI_FONT_t* font;
+    GUI_Byte data[80];
+    uint32_t i;
+
+    font = GUI_OUTLINE_CreateFont(&outline, 16);    /* 2 font units per pixel */
+    TEST_ASSERT(font);
+    TEST_ASSERT(font->Data[0].xSize == 10 && font->Data[0].ySize == 16);
+    TEST_ASSERT(font->Ext->Read(font->Ext->Param, 0, data, sizeof(data)));
+    for (i = 0; i < sizeof(data); i++) {            /* Every pixel is fully covered with 4-bit alpha */
+        TEST_ASSERT(data[i] == 0xFF);
+    }
+    TEST_ASSERT(font->Data[1].xSize == 6 && font->Data[1].ySize == 16 && font->Data[1].yPos == 0);
+    memset(data, 0x00, sizeof(data));
+    TEST_ASSERT(font->Ext->Read(font->Ext->Param, 1, data, 48));
+    for (i = 0; i < 48; i++) {                      /* Bitmap is clipped to the same box, not moved */
+        TEST_ASSERT(data[i] == 0xFF);
+    }
+    GUI_OUTLINE_DeleteFont(font);
+    return 1;
+}
+
+uint8_t test_path(void) {
+    GUI_Init();
+    return test_overlap(GUI_PATH_FILL_EVENODD) && test_overlap(GUI_PATH_FILL_NONZERO)
+        && test_cancel(GUI_PATH_FILL_NONZERO) && test_cancel(GUI_PATH_FILL_EVENODD)
+        && test_outline();
+}
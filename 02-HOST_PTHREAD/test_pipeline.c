@@ -0,0 +1,44 @@
+/**
+ * \brief   Pipeline stopped without rasterization task
+ *
+ *          Recorded frame must be rasterized by \ref GUI_PIPELINE_Disable itself
+ */
+#include "tests.h"
+#include "gui_pipeline.h"
+#include "gui_button.h"
+#include "gui_window.h"
+#include <string.h>
+
+extern GUI_Const GUI_FONT_t GUI_Font_Arial_Bold_18;
+
+static uint32_t screen[480 * 272];
+
+/* Create button on desktop and draw frame, return 1 when frame is drawn or recorded */
+static
+uint8_t draw_frame(void) {
+    GUI_HANDLE_p h;
+    uint32_t i;
+
+    GUI_WIDGET_SetFontDefault(&GUI_Font_Arial_Bold_18);
+    h = GUI_BUTTON_Create(0, 10, 10, 150, 40, GUI_WINDOW_GetDesktop(), 0, 0);
+    GUI_WIDGET_SetText(h, _T("Button"));
+    for (i = 0; i < 10 && !GUI_Process(); i++);
+    return i < 10;
+}
+
+uint8_t test_pipeline(void) {
+    GUI_t* ctx = GUI_CTX_GetDefault();
+
+    GUI_Init();                                     /* Reference frame drawn directly */
+    TEST_ASSERT(draw_frame());
+    memcpy(screen, GUI_LL_GetFrameBuffer(ctx->LCD.ActiveLayer), sizeof(screen));
+
+    GUI_Init();
+    TEST_ASSERT(GUI_PIPELINE_Enable() == guiOK);
+    TEST_ASSERT(draw_frame());
+    TEST_ASSERT(ctx->Pipeline && ctx->Pipeline->Submitted && !ctx->Pipeline->Consumed);
+    TEST_ASSERT(GUI_PIPELINE_Disable() == guiOK);   /* Must return with no task calling GUI_PIPELINE_Process */
+    TEST_ASSERT(!ctx->Pipeline);
+    TEST_ASSERT(!memcmp(screen, GUI_LL_GetFrameBuffer(ctx->LCD.ActiveLayer), sizeof(screen)));
+    return 1;
+}
@@ -0,0 +1,165 @@
+/**
+ * \brief   Remote display stream sent over socket and decoded as viewer does it
+ *
+ *          Each decoded frame must be the same as screen of device in RGB565 format
+ */
+#include "tests.h"
+#include "remotesock.h"
+#include "gui_button.h"
+#include "gui_window.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#define FRAMES          3
+
+extern GUI_Const GUI_FONT_t GUI_Font_Arial_Bold_18;
+
+/* Data received by viewer */
+typedef struct viewer_t {
+    int Fd;                                         /* Viewer end of connection */
+    uint8_t* Data;                                  /* Received stream */
+    uint32_t Len;                                   /* Number of received bytes */
+    uint32_t Pos;                                   /* Position of next packet to decode */
+    uint16_t Screen[480 * 272];                     /* Decoded screen */
+} viewer_t;
+
+static viewer_t viewer;
+static uint16_t screens[FRAMES][480 * 272];         /* Device screens after each frame */
+
+/* Read stream until device closes connection */
+static
+void* viewer_thread(void* arg) {
+    viewer_t* v = (viewer_t *)arg;
+    uint8_t buff[4096];
+    ssize_t r;
+
+    while ((r = read(v->Fd, buff, sizeof(buff))) > 0) {
+        v->Data = realloc(v->Data, v->Len + (uint32_t)r);
+        memcpy(v->Data + v->Len, buff, (size_t)r);
+        v->Len += (uint32_t)r;
+    }
+    return NULL;
+}
+
+/* Get 16-bit little-endian value from stream */
+static
+uint16_t get16(viewer_t* v) {
+    uint16_t val = (uint16_t)(v->Data[v->Pos] | (v->Data[v->Pos + 1] << 8));
+    v->Pos += 2;
+    return val;
+}
+
+/* Decode packets until end of frame, returns 1 when frame was decoded and sets full when it had complete screen */
+static
+uint8_t viewer_decode(viewer_t* v, uint8_t* full) {
+    uint32_t x, y, w, h, i, n;
+    uint8_t type, op;
+    uint16_t color;
+
+    *full = 0;
+    while (v->Pos + 2 <= v->Len) {
+        TEST_ASSERT(v->Data[v->Pos] == GUI_REMOTE_SYNC);
+        type = v->Data[v->Pos + 1];
+        v->Pos += 2;
+        if (type == 0x02) {                         /* End of frame */
+            return 1;
+        } else if (type == 0x03) {                  /* Screen size */
+            TEST_ASSERT(get16(v) == 480 && get16(v) == 272);
+            *full = 1;
+        } else if (type == 0x01) {                  /* Rectangle */
+            x = get16(v);
+            y = get16(v);
+            w = get16(v);
+            h = get16(v);
+            TEST_ASSERT(w && h && x + w <= 480 && y + h <= 272);
+            for (i = 0; i < w * h; ) {
+                TEST_ASSERT(v->Pos < v->Len);
+                op = v->Data[v->Pos++];
+                n = (op & 0x3F) + 1;
+                TEST_ASSERT(i + n <= w * h);
+                color = (op & 0xC0) == 0x40 ? get16(v) : 0;
+                for (; n; n--, i++) {
+                    if ((op & 0xC0) == 0x40) {      /* Repeated color */
+                        v->Screen[(y + i / w) * 480 + x + i % w] = color;
+                    } else if ((op & 0xC0) == 0x80) {   /* Literal color */
+                        v->Screen[(y + i / w) * 480 + x + i % w] = get16(v);
+                    } else {
+                        TEST_ASSERT(op < 0x40); /* Skipped pixel keeps color from previous frame */
+                    }
+                }
+            }
+        } else {
+            TEST_ASSERT(0);                         /* Unknown packet */
+        }
+    }
+    return 0;
+}
+
+/* Draw frame and save device screen in RGB565 format */
+static
+uint8_t draw_frame(uint16_t* screen) {
+    const uint32_t* fb;
+    uint32_t i, c;
+
+    for (i = 0; i < 10 && !GUI_Process(); i++);
+    TEST_ASSERT(i < 10);
+    fb = GUI_LL_GetFrameBuffer(GUI_CTX_GetDefault()->LCD.ActiveLayer);
+    for (i = 0; i < 480 * 272; i++) {
+        c = fb[i];
+        screen[i] = (uint16_t)(((c >> 8) & 0xF800) | ((c >> 5) & 0x07E0) | ((c >> 3) & 0x001F));
+    }
+    return 1;
+}
+
+uint8_t test_remote(void) {
+    static const uint8_t refresh[] = {GUI_REMOTE_SYNC, 0x12};
+    GUI_t* ctx = GUI_CTX_GetDefault();
+    remotesock_t s;
+    pthread_t thread;
+    GUI_HANDLE_p h;
+    uint32_t sizes[FRAMES], i, pos;
+    uint8_t full;
+
+    GUI_Init();
+    TEST_ASSERT(remotesock_open(&s));
+    memset(&viewer, 0x00, sizeof(viewer));
+    viewer.Fd = s.Viewer;
+    pthread_create(&thread, NULL, viewer_thread, &viewer);
+    TEST_ASSERT(GUI_REMOTE_Enable(remotesock_send, &s) == guiOK);
+
+    GUI_WIDGET_SetFontDefault(&GUI_Font_Arial_Bold_18);
+    h = GUI_BUTTON_Create(0, 20, 20, 150, 40, GUI_WINDOW_GetDesktop(), 0, 0);
+    GUI_WIDGET_SetText(h, _T("Remote"));
+    TEST_ASSERT(draw_frame(screens[0]));            /* Complete screen */
+
+    GUI_WIDGET_SetText(h, _T("Changed"));
+    TEST_ASSERT(draw_frame(screens[1]));            /* Only changed pixels */
+
+    TEST_ASSERT(write(s.Viewer, refresh, sizeof(refresh)) == sizeof(refresh));
+    for (i = 0; i < 1000 && !remotesock_poll(&s, ctx); i++) {
+        usleep(100);                                /* Wait until request is received */
+    }
+    TEST_ASSERT(i < 1000);
+    TEST_ASSERT(draw_frame(screens[2]));            /* Complete screen on request of viewer */
+
+    TEST_ASSERT(GUI_REMOTE_Disable() == guiOK);
+    shutdown(s.Device, SHUT_WR);                    /* Viewer reads until end of stream */
+    pthread_join(thread, NULL);
+
+    for (i = 0; i < FRAMES; i++) {
+        pos = viewer.Pos;
+        TEST_ASSERT(viewer_decode(&viewer, &full));
+        TEST_ASSERT(full == (i != 1));
+        TEST_ASSERT(!memcmp(viewer.Screen, screens[i], sizeof(viewer.Screen)));
+        sizes[i] = viewer.Pos - pos;
+    }
+    TEST_ASSERT(viewer.Pos == viewer.Len);
+    TEST_ASSERT(sizes[1] < sizes[0] / 4);           /* Changes are much smaller than complete screen */
+
+    free(viewer.Data);
+    remotesock_close(&s);
+    return 1;
+}
@@ -0,0 +1,163 @@
+/**
+ * \brief   Fonts and images used directly from resource pack memory
+ *
+ *          Small pack is built in memory with one font and one image entry
+ */
+#include "tests.h"
+#include "gui_draw.h"
+#include "gui_respack.h"
+#include <string.h>
+
+static uint32_t pack_mem[64];                       /* Pack memory, aligned to GUI_RESPACK_ALIGN */
+static uint32_t pack_glyph;                         /* Offset of glyph bitmap in pack */
+
+/* Copy data to pack at offset, move offset to next aligned position and return start offset */
+static
+uint32_t pack_put(uint32_t* off, const void* data, uint32_t len) {
+    uint32_t start = *off;
+
+    memcpy((uint8_t *)pack_mem + start, data, len);
+    *off = (start + len + GUI_RESPACK_ALIGN - 1) & ~(GUI_RESPACK_ALIGN - 1);
+    return start;
+}
+
+/* Build pack with font "font" with single 2x2 character 'A' and 2x1 image "img" */
+static
+uint32_t pack_build(void) {
+    static const GUI_Byte glyph[] = {0xFF, 0xFF, 0xFF, 0xFF};
+    static const uint32_t pixels[] = {0xFF112233, 0xFF445566};
+    GUI_RESPACK_Header_t hdr = {0};
+    GUI_RESPACK_Font_t font = {0};
+    GUI_RESPACK_FontChar_t ch = {0};
+    GUI_RESPACK_Image_t img = {0};
+    GUI_RESPACK_Entry_t e[2], tmp;
+    uint32_t off = sizeof(hdr);
+
+    memset(pack_mem, 0x00, sizeof(pack_mem));
+    memset(e, 0x00, sizeof(e));
+
+    pack_glyph = pack_put(&off, glyph, sizeof(glyph));
+    ch.xSize = 2;
+    ch.ySize = 2;
+    ch.xMargin = 1;
+    ch.DataOffset = pack_glyph;
+    font.CharsOffset = pack_put(&off, &ch, sizeof(ch));
+    font.StartChar = 'A';
+    font.EndChar = 'A';
+    font.Size = 2;
+    font.Flags = GUI_FLAG_FONT_AA8;
+    e[0].Offset = pack_put(&off, &font, sizeof(font));
+    e[0].Size = sizeof(font);
+    e[0].Type = GUI_RESPACK_TYPE_FONT;
+    e[0].NameOffset = pack_put(&off, "font", 5);
+    e[0].Hash = GUI_RESPACK_Hash(_T("font"));
+
+    img.Width = 2;
+    img.Height = 1;
+    img.Format = GUI_IMAGE_FORMAT_ARGB8888;
+    img.Size = sizeof(pixels);
+    img.DataOffset = pack_put(&off, pixels, sizeof(pixels));
+    e[1].Offset = pack_put(&off, &img, sizeof(img));
+    e[1].Size = sizeof(img);
+    e[1].Type = GUI_RESPACK_TYPE_IMAGE;
+    e[1].NameOffset = pack_put(&off, "img", 4);
+    e[1].Hash = GUI_RESPACK_Hash(_T("img"));
+
+    if (e[0].Hash > e[1].Hash) {                    /* Index is sorted by hash */
+        tmp = e[0];
+        e[0] = e[1];
+        e[1] = tmp;
+    }
+    hdr.IndexOffset = pack_put(&off, e, sizeof(e));
+    hdr.Magic = GUI_RESPACK_MAGIC;
+    hdr.Version = GUI_RESPACK_VERSION;
+    hdr.HeaderSize = sizeof(hdr);
+    hdr.Size = off;
+    hdr.Count = 2;
+    memcpy(pack_mem, &hdr, sizeof(hdr));
+    return off;
+}
+
+/* Draw "A" at top left corner and check 2x2 pixels are drawn with color */
+static
+uint8_t draw_char(const GUI_FONT_t* font) {
+    GUI_Display_t disp = {0, 0, 480, 272};
+    GUI_DRAW_FONT_t draw;
+    uint32_t* fb = GUI_LL_GetFrameBuffer(GUI_CTX_GetDefault()->LCD.DrawingLayer);
+    uint32_t x, y;
+
+    for (y = 0; y < 4; y++) {
+        memset(&fb[y * 480], 0x00, 4 * sizeof(*fb));
+    }
+    GUI_DRAW_FONT_Init(&draw);
+    draw.Width = 10;
+    draw.Height = 2;
+    draw.Color1Width = 10;
+    draw.Color1 = 0xFF00FF00;
+    GUI_DRAW_WriteText(&disp, font, _T("A"), &draw);
+    for (y = 0; y < 4; y++) {
+        for (x = 0; x < 4; x++) {
+            TEST_ASSERT(fb[y * 480 + x] == (x < 2 && y < 2 ? 0xFF00FF00 : 0));
+        }
+    }
+    return 1;
+}
+
+/* Character table is read from pack, relocated only when pointers are not 32-bit */
+static
+uint8_t test_font(const GUI_RESPACK_t* pack) {
+    const GUI_FONT_t* font;
+
+    font = GUI_RESPACK_GetFont(pack, _T("font"));
+    TEST_ASSERT(font);
+    TEST_ASSERT(font->StartChar == 'A' && font->Data[0].xSize == 2 && font->Data[0].xMargin == 1);
+    if (sizeof(void *) == sizeof(uint32_t)) {
+        TEST_ASSERT(font->Base == pack->Base);
+        TEST_ASSERT((const uint8_t *)font->Data == pack->Base + ((const GUI_RESPACK_Font_t *)(pack->Base + GUI_RESPACK_Find(pack, _T("font"))->Offset))->CharsOffset);
+    } else {
+        TEST_ASSERT(font->Base == 0 && font->Data[0].Data == pack->Base + pack_glyph);
+    }
+    TEST_ASSERT(draw_char(font));
+    GUI_RESPACK_FreeFont(font);
+    return 1;
+}
+
+/* Font with bitmap offsets relative to base, as used in place on 32-bit targets */
+static
+uint8_t test_font_base(const GUI_RESPACK_t* pack) {
+    GUI_FONT_CharInfo_t ch = {2, 2, 0, 0, 1, 0};
+    GUI_FONT_t font = {0};
+
+    ch.Data = (const GUI_Byte *)(uintptr_t)pack_glyph;
+    font.Size = 2;
+    font.StartChar = 'A';
+    font.EndChar = 'A';
+    font.Flags = GUI_FLAG_FONT_AA8;
+    font.Data = &ch;
+    font.Base = pack->Base;
+    return draw_char(&font);
+}
+
+/* Image descriptor points to pack data, nothing is allocated */
+static
+uint8_t test_image(const GUI_RESPACK_t* pack) {
+    GUI_IMAGE_DESC_t img;
+
+    TEST_ASSERT(GUI_RESPACK_GetImage(pack, _T("img"), &img));
+    TEST_ASSERT(img.Width == 2 && img.Height == 1 && img.Format == GUI_IMAGE_FORMAT_ARGB8888);
+    TEST_ASSERT(((const uint32_t *)img.Data)[0] == 0xFF112233 && ((const uint32_t *)img.Data)[1] == 0xFF445566);
+    TEST_ASSERT(img.Data > pack->Base && img.Data < pack->Base + pack->Header->Size);
+    TEST_ASSERT(!GUI_RESPACK_GetImage(pack, _T("font"), &img));    /* Wrong type */
+    TEST_ASSERT(!GUI_RESPACK_GetImage(pack, _T("none"), &img));
+    return 1;
+}
+
+uint8_t test_respack(void) {
+    GUI_RESPACK_t pack;
+    uint32_t size;
+
+    GUI_Init();
+    size = pack_build();
+    TEST_ASSERT(GUI_RESPACK_Open(&pack, pack_mem, size) == guiOK);
+    return test_font(&pack) && test_font_base(&pack) && test_image(&pack);
+}
@@ -0,0 +1,36 @@
+/**
+ * \brief   Number formatting checked against snprintf
+ *
+ *          Values are exact in binary or far from rounding boundary, where both round the same way
+ */
+#include "tests.h"
+#include "gui_string.h"
+#include <string.h>
+
+/* Format value with GUI_STRING_Format and snprintf with the same format and compare outputs */
+static
+uint8_t check(const char* format, double value) {
+    GUI_Char buff[40];
+    char ref[40];
+
+    GUI_STRING_Format(buff, sizeof(buff), (const GUI_Char *)format, value);
+    snprintf(ref, sizeof(ref), format, value);
+    if (strcmp((const char *)buff, ref)) {
+        printf("\"%s\": \"%s\", expected \"%s\"\r\n", format, (const char *)buff, ref);
+        return 0;
+    }
+    return 1;
+}
+
+uint8_t test_string(void) {
+    static const double values[] = {0.0, 0.1, 3.14159, -273.15, 1234.5678, 99999.99, -0.005, 4000000.0, 16777217.375, 4294967295.0};
+    static const char* formats[] = {"%f", "%.2f", "%.9f", "%12.3f", "%-8.1f|", "%+.4f"};
+    uint32_t i, k;
+
+    for (i = 0; i < GUI_COUNT_OF(values); i++) {    /* Double arguments keep all 9 digits of precision */
+        for (k = 0; k < GUI_COUNT_OF(formats); k++) {
+            TEST_ASSERT(check(formats[k], values[i]));
+        }
+    }
+    return 1;
+}
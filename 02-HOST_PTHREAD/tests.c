@@ -0,0 +1,38 @@
+/**
+ * \brief   List of host tests
+ */
+#include "tests.h"
+#include <string.h>
+
+typedef struct test_t {
+    const char* Name;
+    uint8_t (*Run)(void);
+} test_t;
+
+static const test_t tests[] = {
+    {"path", test_path},
+    {"draw", test_draw},
+    {"respack", test_respack},
+    {"math", test_math},
+    {"pipeline", test_pipeline},
+    {"fontcache", test_fontcache},
+    {"imageload", test_imageload},
+    {"remote", test_remote},
+    {"string", test_string},
+};
+
+/* Run all tests or only test with name, return 1 when all of them passed */
+uint8_t tests_run(const char* name) {
+    uint8_t ok = 1, res;
+    uint32_t i;
+
+    for (i = 0; i < GUI_COUNT_OF(tests); i++) {
+        if (name && strcmp(name, tests[i].Name)) {
+            continue;
+        }
+        res = tests[i].Run();
+        printf("%s: %s\r\n", tests[i].Name, res ? "OK" : "FAILED");
+        ok &= res;
+    }
+    return ok;
+}
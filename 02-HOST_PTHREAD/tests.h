@@ -0,0 +1,35 @@
+/**
+ * \brief   Host tests of library modules
+ *
+ *          Each test returns 1 when all checks passed and 0 on first failed check.
+ *          Tests are run with "./gui_host test" or "./gui_host test <name>"
+ */
+#ifndef TESTS_H
+#define TESTS_H
+
+#include "gui.h"
+#include <stdio.h>
+
+/* Fail test with location when condition is not true */
+#define TEST_ASSERT(c)      do {                    \
+    if (!(c)) {                                     \
+        printf("%s:%d: check failed: %s\r\n", __FILE__, __LINE__, #c); \
+        return 0;                                   \
+    }                                               \
+} while (0)
+
+uint32_t* GUI_LL_GetFrameBuffer(uint8_t layer);
+
+uint8_t tests_run(const char* name);
+
+uint8_t test_path(void);
+uint8_t test_draw(void);
+uint8_t test_respack(void);
+uint8_t test_math(void);
+uint8_t test_pipeline(void);
+uint8_t test_fontcache(void);
+uint8_t test_imageload(void);
+uint8_t test_remote(void);
+uint8_t test_string(void);
+
+#endif
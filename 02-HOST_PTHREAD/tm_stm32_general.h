@@ -0,0 +1,21 @@
+/**
+ * \brief   Host replacement for STM32 general library used by GUI core
+ *
+ *          DWT cycle counter is replaced with monotonic time in units of microseconds
+ */
+#ifndef TM_GENERAL_H
+#define TM_GENERAL_H
+
+#include <stdint.h>
+#include <time.h>
+
+static inline
+uint32_t TM_GENERAL_DWTCounterGetValue(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000UL + (uint64_t)ts.tv_nsec / 1000);
+}
+
+#define TM_GENERAL_GetSystemClockMHz()      1
+
+#endif